@@ -0,0 +1,92 @@
+#pragma once
+
+#include <MxEngine.h>
+
+#include <chrono>
+#include <limits>
+
+namespace Benchmarks
+{
+    using namespace MxEngine;
+
+    /*
+    benchmark suite is a group of measurements and checks of one engine subsystem. Suites are run one after another,
+    each of them is updated once per frame until it reports that it is finished. Most suites measure everything in one update,
+    but some of them depend on renderer or asynchronous uploads and are spread over multiple frames
+    */
+    class BenchmarkSuite
+    {
+        size_t failedChecks = 0;
+    public:
+        virtual ~BenchmarkSuite() = default;
+
+        virtual void OnStart() { }
+        // returns true when suite is finished
+        virtual bool OnFrame() = 0;
+        virtual void OnFinish() { }
+
+        void Report(const MxString& measurement, double value, const char* unit);
+        void Check(bool condition, const MxString& description);
+        size_t GetFailedCheckCount() const { return this->failedChecks; }
+    };
+
+    class BenchmarkTimer
+    {
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start = Clock::now();
+    public:
+        void Reset() { this->start = Clock::now(); }
+        double GetMilliseconds() const { return std::chrono::duration<double, std::milli>(Clock::now() - this->start).count(); }
+    };
+
+    // results of measured code are added here, so compiler cannot throw the code away
+    inline volatile size_t BenchmarkSink = 0;
+
+    // runs function multiple times and returns fastest run in milliseconds, as it is least affected by other processes
+    template<typename Func>
+    double MeasureBest(size_t runs, Func&& func)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < runs; i++)
+        {
+            BenchmarkTimer timer;
+            func();
+            best = std::min(best, timer.GetMilliseconds());
+        }
+        return best;
+    }
+
+    // writes .obj file with grid of gridSize x gridSize quads, so suites do not depend on sample resources
+    void GenerateGridObject(const FilePath& path, size_t gridSize);
+    // writes .gltf file with the same grid as GenerateGridObject(). Buffer is embedded as base64 data uri, so file is self-contained
+    void GenerateGridGLTF(const FilePath& path, size_t gridSize);
+    // returns total count of global operator new calls made by application so far
+    size_t GetHeapAllocationCount();
+
+    using BenchmarkSuiteFactory = UniqueRef<BenchmarkSuite>(*)();
+
+    struct BenchmarkSuiteInfo
+    {
+        const char* Name;
+        BenchmarkSuiteFactory Create;
+    };
+
+    // returns all suites registered with REGISTER_BENCHMARK_SUITE, in order of static initialization
+    MxVector<BenchmarkSuiteInfo>& GetRegisteredSuites();
+
+    struct BenchmarkSuiteRegistrar
+    {
+        BenchmarkSuiteRegistrar(const char* name, BenchmarkSuiteFactory create)
+        {
+            GetRegisteredSuites().push_back(BenchmarkSuiteInfo{ name, create });
+        }
+    };
+
+    /*
+    registers suite class under name, which can be passed as command line argument to run only selected suites
+    placed in source file of suite after its class definition, so adding a suite does not require changes in other files
+    */
+    #define REGISTER_BENCHMARK_SUITE(class_name, name) \
+    static Benchmarks::BenchmarkSuiteRegistrar MXENGINE_CONCAT(class_name, Registrar)(name,\
+        []() -> MxEngine::UniqueRef<Benchmarks::BenchmarkSuite> { return MxEngine::MakeUnique<class_name>(); })
+}
@@ -0,0 +1,251 @@
+#include "Benchmark.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include <algorithm>
+
+// global allocation functions are replaced to count heap allocations of whole application, including engine containers
+// over-aligned allocations keep default implementation and are not counted
+static std::atomic<size_t> HeapAllocationCount{ 0 };
+
+static void* CountedAllocate(size_t size) noexcept
+{
+    HeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(size_t size)
+{
+    void* ptr = CountedAllocate(size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    void* ptr = CountedAllocate(size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+namespace Benchmarks
+{
+    void BenchmarkSuite::Report(const MxString& measurement, double value, const char* unit)
+    {
+        std::cout << "    " << measurement.c_str() << ": " << value << ' ' << unit << std::endl;
+    }
+
+    void BenchmarkSuite::Check(bool condition, const MxString& description)
+    {
+        std::cout << "    " << (condition ? "[ok] " : "[FAILED] ") << description.c_str() << std::endl;
+        if (!condition) this->failedChecks++;
+    }
+
+    size_t GetHeapAllocationCount()
+    {
+        return HeapAllocationCount.load(std::memory_order_relaxed);
+    }
+
+    void GenerateGridObject(const FilePath& path, size_t gridSize)
+    {
+        std::ofstream file(path);
+        for (size_t z = 0; z <= gridSize; z++)
+        {
+            for (size_t x = 0; x <= gridSize; x++)
+            {
+                file << "v " << float(x) << ' ' << std::sin(float(x + z) * 0.1f) << ' ' << float(z) << '\n';
+                file << "vt " << float(x) / gridSize << ' ' << float(z) / gridSize << '\n';
+            }
+        }
+        file << "vn 0 1 0\n";
+        for (size_t z = 0; z < gridSize; z++)
+        {
+            for (size_t x = 0; x < gridSize; x++)
+            {
+                size_t i0 = z * (gridSize + 1) + x + 1;
+                size_t i1 = i0 + 1;
+                size_t i2 = i0 + gridSize + 1;
+                size_t i3 = i2 + 1;
+                file << "f " << i0 << '/' << i0 << "/1 " << i2 << '/' << i2 << "/1 " << i1 << '/' << i1 << "/1\n";
+                file << "f " << i1 << '/' << i1 << "/1 " << i2 << '/' << i2 << "/1 " << i3 << '/' << i3 << "/1\n";
+            }
+        }
+    }
+
+    static MxString EncodeBase64(const MxVector<uint8_t>& data)
+    {
+        constexpr const char* Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        MxString result;
+        result.reserve((data.size() + 2) / 3 * 4);
+        for (size_t i = 0; i < data.size(); i += 3)
+        {
+            uint32_t chunk = uint32_t(data[i]) << 16;
+            if (i + 1 < data.size()) chunk |= uint32_t(data[i + 1]) << 8;
+            if (i + 2 < data.size()) chunk |= uint32_t(data[i + 2]);
+
+            result.push_back(Alphabet[(chunk >> 18) & 63]);
+            result.push_back(Alphabet[(chunk >> 12) & 63]);
+            result.push_back(i + 1 < data.size() ? Alphabet[(chunk >> 6) & 63] : '=');
+            result.push_back(i + 2 < data.size() ? Alphabet[chunk & 63] : '=');
+        }
+        return result;
+    }
+
+    template<typename T>
+    static void AppendBytes(MxVector<uint8_t>& buffer, const T& value)
+    {
+        auto bytes = (const uint8_t*)&value;
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void GenerateGridGLTF(const FilePath& path, size_t gridSize)
+    {
+        // layout of single embedded buffer: positions, normals, texture coordinates, indicies
+        size_t vertexCount = (gridSize + 1) * (gridSize + 1);
+        size_t indexCount = gridSize * gridSize * 6;
+        MxVector<uint8_t> buffer;
+        buffer.reserve(vertexCount * 8 * sizeof(float) + indexCount * sizeof(uint32_t));
+
+        float minY = 0.0f, maxY = 0.0f;
+        for (size_t z = 0; z <= gridSize; z++)
+        {
+            for (size_t x = 0; x <= gridSize; x++)
+            {
+                float y = std::sin(float(x + z) * 0.1f);
+                minY = Min(minY, y);
+                maxY = Max(maxY, y);
+                AppendBytes(buffer, Vector3(float(x), y, float(z)));
+            }
+        }
+        for (size_t i = 0; i < vertexCount; i++)
+            AppendBytes(buffer, Vector3(0.0f, 1.0f, 0.0f));
+        for (size_t z = 0; z <= gridSize; z++)
+        {
+            for (size_t x = 0; x <= gridSize; x++)
+                AppendBytes(buffer, Vector2(float(x) / gridSize, float(z) / gridSize));
+        }
+        for (size_t z = 0; z < gridSize; z++)
+        {
+            for (size_t x = 0; x < gridSize; x++)
+            {
+                uint32_t i0 = uint32_t(z * (gridSize + 1) + x);
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + uint32_t(gridSize + 1);
+                uint32_t i3 = i2 + 1;
+                for (uint32_t index : { i0, i2, i1, i1, i2, i3 })
+                    AppendBytes(buffer, index);
+            }
+        }
+
+        size_t positionsSize = vertexCount * sizeof(Vector3);
+        size_t texcoordsSize = vertexCount * sizeof(Vector2);
+        size_t indicesSize = indexCount * sizeof(uint32_t);
+        std::ofstream file(path);
+        file << "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],"
+             << "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3}]}],"
+             << "\"buffers\":[{\"byteLength\":" << buffer.size() << ",\"uri\":\"data:application/octet-stream;base64," << EncodeBase64(buffer).c_str() << "\"}],"
+             << "\"bufferViews\":["
+             << "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":" << positionsSize << "},"
+             << "{\"buffer\":0,\"byteOffset\":" << positionsSize << ",\"byteLength\":" << positionsSize << "},"
+             << "{\"buffer\":0,\"byteOffset\":" << 2 * positionsSize << ",\"byteLength\":" << texcoordsSize << "},"
+             << "{\"buffer\":0,\"byteOffset\":" << 2 * positionsSize + texcoordsSize << ",\"byteLength\":" << indicesSize << "}],"
+             << "\"accessors\":["
+             << "{\"bufferView\":0,\"componentType\":5126,\"count\":" << vertexCount << ",\"type\":\"VEC3\","
+             << "\"min\":[0," << minY << ",0],\"max\":[" << gridSize << ',' << maxY << ',' << gridSize << "]},"
+             << "{\"bufferView\":1,\"componentType\":5126,\"count\":" << vertexCount << ",\"type\":\"VEC3\"},"
+             << "{\"bufferView\":2,\"componentType\":5126,\"count\":" << vertexCount << ",\"type\":\"VEC2\"},"
+             << "{\"bufferView\":3,\"componentType\":5125,\"count\":" << indexCount << ",\"type\":\"SCALAR\"}]}";
+    }
+
+    MxVector<BenchmarkSuiteInfo>& GetRegisteredSuites()
+    {
+        // constructed on first use, as suites are registered during static initialization of other translation units
+        static MxVector<BenchmarkSuiteInfo> suites;
+        return suites;
+    }
+
+    /*
+    this application runs engine benchmarks and correctness checks which require full engine environment
+    suites can be selected by passing their names as command line arguments, otherwise all suites are run
+    application exits with non-zero code if any check failed
+    */
+    class BenchmarkApplication : public Application
+    {
+        MxVector<const BenchmarkSuiteInfo*> selectedSuites;
+        UniqueRef<BenchmarkSuite> currentSuite;
+        size_t nextSuite = 0;
+        size_t failedChecks = 0;
+    public:
+        BenchmarkApplication(int argc, char** argv)
+        {
+            // static initialization order depends on linker, so suites are run in order of their names
+            auto& suites = GetRegisteredSuites();
+            std::sort(suites.begin(), suites.end(), [](const BenchmarkSuiteInfo& s1, const BenchmarkSuiteInfo& s2)
+            {
+                return std::strcmp(s1.Name, s2.Name) < 0;
+            });
+
+            for (const auto& suite : suites)
+            {
+                bool isSelected = argc <= 1;
+                for (int i = 1; i < argc; i++)
+                    isSelected |= std::strcmp(argv[i], suite.Name) == 0;
+
+                if (isSelected) this->selectedSuites.push_back(&suite);
+            }
+        }
+
+        virtual void OnCreate() override { }
+
+        virtual void OnUpdate() override
+        {
+            if (this->currentSuite == nullptr)
+            {
+                if (this->nextSuite == this->selectedSuites.size())
+                {
+                    this->CloseApplication();
+                    return;
+                }
+                const auto& info = *this->selectedSuites[this->nextSuite++];
+                std::cout << info.Name << ':' << std::endl;
+                this->currentSuite = info.Create();
+                this->currentSuite->OnStart();
+            }
+
+            if (this->currentSuite->OnFrame())
+            {
+                this->currentSuite->OnFinish();
+                this->failedChecks += this->currentSuite->GetFailedCheckCount();
+                this->currentSuite.reset();
+            }
+        }
+
+        virtual void OnDestroy() override { }
+
+        size_t GetFailedCheckCount() const
+        {
+            return this->failedChecks;
+        }
+    };
+}
+
+int main(int argc, char** argv)
+{
+    MxEngine::LaunchFromSourceDirectory();
+    Benchmarks::BenchmarkApplication app(argc, argv);
+    app.Run();
+    return app.GetFailedCheckCount() == 0 ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+#include "Benchmark.h"
+
+namespace Benchmarks
+{
+    // component used only by this suite, so its pool does not contain components of other objects
+    class StaleHandleComponent
+    {
+        MAKE_COMPONENT(StaleHandleComponent);
+    public:
+        StaleHandleComponent() = default;
+
+        size_t Value = 0;
+    };
+
+    /*
+    checks that handles of destroyed components are safely reported as invalid and can be dropped,
+    both while their slot still exists and after component pool was compacted and slot was released
+    */
+    class ComponentHandleChecks : public BenchmarkSuite
+    {
+        constexpr static size_t ComponentCount = 256;
+
+        void CheckDestroyedComponent()
+        {
+            auto object = MxObject::Create();
+            auto component = object->AddComponent<StaleHandleComponent>();
+            auto stale = component;
+
+            object->RemoveComponent<StaleHandleComponent>();
+            this->Check(!stale.IsValid(), "handle of removed component is invalid");
+            this->Check(!component.IsValid(), "original handle of removed component is invalid");
+
+            stale = StaleHandleComponent::Handle{ };
+            component = StaleHandleComponent::Handle{ };
+            this->Check(!object->HasComponent<StaleHandleComponent>(), "object has no removed component");
+            MxObject::Destroy(object);
+        }
+
+        void CheckCompactedComponents()
+        {
+            MxVector<MxObject::Handle> objects;
+            MxVector<StaleHandleComponent::Handle> staleHandles;
+            for (size_t i = 0; i < ComponentCount; i++)
+            {
+                auto& object = objects.emplace_back(MxObject::Create());
+                auto component = object->AddComponent<StaleHandleComponent>();
+                component->Value = i;
+                staleHandles.push_back(component);
+            }
+
+            // keep only first component alive, so compaction releases handle range of all other components
+            for (size_t i = 1; i < ComponentCount; i++)
+                objects[i]->RemoveComponent<StaleHandleComponent>();
+
+            bool allInvalid = true;
+            for (size_t i = 1; i < ComponentCount; i++)
+                allInvalid &= !staleHandles[i].IsValid();
+            this->Check(allInvalid, "handles of removed components are invalid before compaction");
+
+            this->Check(ComponentFactory::CompactPools() > 0, "fragmented component pool is compacted");
+            auto alive = staleHandles.front();
+            this->Check(alive.IsValid() && alive->Value == 0, "handle of alive component survives compaction");
+
+            auto& pool = ComponentFactory::GetPool<StaleHandleComponent>();
+            this->Check(!pool.IsAllocated(staleHandles.back().GetHandle()), "handle range of removed components is released");
+
+            allInvalid = true;
+            for (size_t i = 1; i < ComponentCount; i++)
+                allInvalid &= !staleHandles[i].IsValid();
+            this->Check(allInvalid, "handles of removed components are invalid after compaction");
+
+            // released slots are reused by new components, which must not be reachable through old handles
+            auto reused = objects.back()->AddComponent<StaleHandleComponent>();
+            bool noneAliased = true;
+            for (size_t i = 1; i < ComponentCount; i++)
+                noneAliased &= !staleHandles[i].IsValid() && staleHandles[i] != reused;
+            this->Check(reused.IsValid() && noneAliased, "reused component slot is not reachable through stale handles");
+
+            // dropping stale handles must not touch pool slots they were pointing to
+            staleHandles.clear();
+            this->Check(reused.IsValid() && alive.IsValid(), "dropping stale handles does not affect alive components");
+            alive = StaleHandleComponent::Handle{ };
+
+            for (auto& object : objects)
+                MxObject::Destroy(object);
+        }
+    public:
+        virtual bool OnFrame() override
+        {
+            this->CheckDestroyedComponent();
+            this->CheckCompactedComponents();
+            return true;
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(ComponentHandleChecks, "component-handles");
+}
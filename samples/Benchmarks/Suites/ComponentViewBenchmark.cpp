@@ -0,0 +1,138 @@
+#include "Benchmark.h"
+
+namespace Benchmarks
+{
+    /*
+    compares iteration over objects owning both MeshSource and MeshRenderer through joint component view
+    with iteration over MeshSource view and GetComponent<MeshRenderer> lookup for each object, as renderer did before
+    only half of objects have MeshRenderer, so both paths also have to skip objects which do not own it
+    objects are created and destroyed in one frame, so renderer never builds render units for them
+    per-object lookup is also compared with linear ComponentId scan, which GetComponent did before type indices were added
+    */
+    class ComponentViewBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t ObjectCount = 100000;
+        constexpr static size_t RunCount = 10;
+
+        // same layout as component entry of ComponentManager before type indices: resource, ComponentId and deleter
+        struct LegacyComponent
+        {
+            std::aligned_storage_t<sizeof(MeshRenderer::Handle)> resource;
+            StringId type;
+            void (*deleter)(void*);
+        };
+        using LegacyComponentList = MxVector<LegacyComponent>;
+
+        template<typename T>
+        static void AddLegacyComponent(LegacyComponentList& components, StringId type, typename T::Handle component)
+        {
+            using Handle = typename T::Handle;
+            static_assert(sizeof(Handle) == sizeof(LegacyComponent::resource), "storage must fit resource size");
+
+            auto& data = components.emplace_back();
+            data.type = type;
+            data.deleter = [](void* ptr) { std::launder(reinterpret_cast<Handle*>(ptr))->~Handle(); };
+            new (&data.resource) Handle(std::move(component));
+        }
+
+        template<typename T>
+        static typename T::Handle GetLegacyComponent(const LegacyComponentList& components, StringId type)
+        {
+            for (const auto& component : components)
+            {
+                if (component.type == type)
+                    return *std::launder(reinterpret_cast<const typename T::Handle*>(&component.resource));
+            }
+            return typename T::Handle{ };
+        }
+    public:
+        virtual bool OnFrame() override
+        {
+            auto cube = Primitives::CreateCube();
+            auto material = Factory<Material>::Create();
+            MxVector<MxObject::Handle> objects;
+            objects.reserve(ObjectCount);
+            for (size_t i = 0; i < ObjectCount; i++)
+            {
+                auto& object = objects.emplace_back(MxObject::Create());
+                object->AddComponent<MeshSource>(cube);
+                if (i % 2 == 0) object->AddComponent<MeshRenderer>(material);
+            }
+
+            size_t lookupCount = 0, viewCount = 0;
+            double lookupTime = MeasureBest(RunCount, [&]()
+            {
+                lookupCount = 0;
+                auto meshSourceView = ComponentFactory::GetView<MeshSource>();
+                for (const auto& meshSource : meshSourceView)
+                {
+                    auto meshRenderer = MxObject::GetByComponent(meshSource).GetComponent<MeshRenderer>();
+                    if (meshRenderer.IsValid() && meshSource.IsDrawn())
+                        lookupCount += meshRenderer->GetMaterials().size();
+                }
+            });
+            double viewTime = MeasureBest(RunCount, [&]()
+            {
+                viewCount = 0;
+                auto meshView = ComponentFactory::GetView<MeshSource, MeshRenderer>();
+                for (auto [meshSource, meshRenderer] : meshView)
+                {
+                    if (meshSource.IsDrawn())
+                        viewCount += meshRenderer.GetMaterials().size();
+                }
+            });
+            BenchmarkSink = lookupCount + viewCount;
+
+            this->Report("GetComponent lookup", double(ObjectCount) / lookupTime, "objects/ms");
+            this->Report("joint view", double(ObjectCount) / viewTime, "objects/ms");
+            this->Report("speedup", lookupTime / viewTime, "x");
+            this->Check(lookupCount == ObjectCount / 2 && viewCount == lookupCount, "joint view visits exactly objects owning both components");
+
+            // components are added in the same order as above, so scan visits MeshSource entry before MeshRenderer one
+            MxVector<LegacyComponentList> legacyComponents(ObjectCount);
+            for (size_t i = 0; i < ObjectCount; i++)
+            {
+                AddLegacyComponent<MeshSource>(legacyComponents[i], STRING_ID("MeshSource"), objects[i]->GetComponent<MeshSource>());
+                if (i % 2 == 0) AddLegacyComponent<MeshRenderer>(legacyComponents[i], STRING_ID("MeshRenderer"), objects[i]->GetComponent<MeshRenderer>());
+            }
+
+            size_t maskCount = 0, scanCount = 0;
+            double maskTime = MeasureBest(RunCount, [&]()
+            {
+                maskCount = 0;
+                for (const auto& object : objects)
+                {
+                    auto meshRenderer = object->GetComponent<MeshRenderer>();
+                    if (meshRenderer.IsValid()) maskCount += meshRenderer->GetMaterials().size();
+                }
+            });
+            double scanTime = MeasureBest(RunCount, [&]()
+            {
+                scanCount = 0;
+                for (const auto& components : legacyComponents)
+                {
+                    auto meshRenderer = GetLegacyComponent<MeshRenderer>(components, STRING_ID("MeshRenderer"));
+                    if (meshRenderer.IsValid()) scanCount += meshRenderer->GetMaterials().size();
+                }
+            });
+            BenchmarkSink = maskCount + scanCount;
+
+            this->Report("GetComponent, type mask", double(ObjectCount) / maskTime, "objects/ms");
+            this->Report("GetComponent, linear ComponentId scan", double(ObjectCount) / scanTime, "objects/ms");
+            this->Report("type mask speedup", scanTime / maskTime, "x");
+            this->Check(maskCount == ObjectCount / 2 && scanCount == maskCount, "type mask and linear scan find the same components");
+
+            for (auto& components : legacyComponents)
+            {
+                for (auto& component : components)
+                    component.deleter(&component.resource);
+            }
+
+            for (auto& object : objects)
+                MxObject::Destroy(object);
+            return true;
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(ComponentViewBenchmark, "component-views");
+}
@@ -0,0 +1,73 @@
+#include "Benchmark.h"
+
+namespace Benchmarks
+{
+    class DispatchBenchmarkEvent : public EventBase
+    {
+        MAKE_EVENT(DispatchBenchmarkEvent);
+    public:
+        size_t Value;
+        DispatchBenchmarkEvent(size_t value) : Value(value) { }
+    };
+
+    /*
+    dispatches 1M events to 100 listeners. Separate dispatcher is used, so application listeners are not invoked
+    events constructed in channel storage are compared with type-erased events, which are allocated one by one
+    */
+    class EventDispatchBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t EventCount = 1000000;
+        constexpr static size_t ListenerCount = 100;
+        constexpr static size_t RunCount = 3;
+    public:
+        virtual bool OnFrame() override
+        {
+            EventDispatcherImpl<EventBase> dispatcher;
+            size_t sum = 0;
+            MxVector<EventListenerHandle> listeners;
+            for (size_t i = 0; i < ListenerCount; i++)
+                listeners.push_back(dispatcher.AddEventListener<DispatchBenchmarkEvent>([&sum](DispatchBenchmarkEvent& e) { sum += e.Value; }));
+
+            // first run grows channel storage, best run shows steady state without allocations
+            size_t expectedSum = ListenerCount * (EventCount * (EventCount - 1) / 2);
+            bool isTypedSumValid = true;
+            double typedTime = MeasureBest(RunCount, [&]()
+            {
+                sum = 0;
+                for (size_t i = 0; i < EventCount; i++)
+                    dispatcher.AddEvent<DispatchBenchmarkEvent>(i);
+                dispatcher.InvokeAll();
+                isTypedSumValid &= sum == expectedSum;
+            });
+
+            bool isDynamicSumValid = true;
+            double dynamicTime = MeasureBest(RunCount, [&]()
+            {
+                sum = 0;
+                for (size_t i = 0; i < EventCount; i++)
+                    dispatcher.AddEvent(MakeUnique<DispatchBenchmarkEvent>(i));
+                dispatcher.InvokeAll();
+                isDynamicSumValid &= sum == expectedSum;
+            });
+
+            this->Report("typed events", double(EventCount) / typedTime, "events/ms");
+            this->Report("typed events, listener calls", double(EventCount * ListenerCount) / typedTime, "calls/ms");
+            this->Report("type-erased events", double(EventCount) / dynamicTime, "events/ms");
+            this->Report("typed events speedup", dynamicTime / typedTime, "x");
+            this->Check(isTypedSumValid, "every typed event is dispatched to every listener");
+            this->Check(isDynamicSumValid, "every type-erased event is dispatched to every listener");
+
+            // listeners removed by handle are skipped starting from the next dispatch
+            for (size_t i = 0; i < ListenerCount / 2; i++)
+                dispatcher.RemoveEventListener(listeners[i]);
+            sum = 0;
+            dispatcher.AddEvent<DispatchBenchmarkEvent>(1);
+            dispatcher.InvokeAll();
+            this->Check(sum == ListenerCount - ListenerCount / 2, "removed listeners are not invoked");
+            this->Check(!dispatcher.HasEventListener(listeners.front()) && dispatcher.HasEventListener(listeners.back()), "listener presence is tracked by handle");
+            return true;
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(EventDispatchBenchmark, "event-dispatch");
+}
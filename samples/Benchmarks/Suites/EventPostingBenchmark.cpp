@@ -0,0 +1,100 @@
+#include "Benchmark.h"
+
+#include <thread>
+#include <atomic>
+
+namespace Benchmarks
+{
+    class PostingBenchmarkEvent : public EventBase
+    {
+        MAKE_EVENT(PostingBenchmarkEvent);
+    public:
+        size_t Value;
+        PostingBenchmarkEvent(size_t value) : Value(value) { }
+    };
+
+    /*
+    measures posting of events from 1 to 16 producer threads into one dispatcher at the same time
+    total count of events is the same for all producer counts, so results show cost of contention on queue
+    events are drained on this thread afterwards, drain limits are also checked
+    */
+    class EventPostingBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t EventCount = 320000;
+        constexpr static size_t DrainCountLimit = 1000;
+        // large enough to never be reached, but still representable as clock duration
+        constexpr static float NoTimeLimit = 1000000.0f;
+
+        static double PostEvents(EventDispatcherImpl<EventBase>& dispatcher, size_t producerCount)
+        {
+            std::atomic<size_t> readyProducers{ 0 };
+            std::atomic<bool> isStarted{ false };
+            size_t eventsPerProducer = EventCount / producerCount;
+
+            MxVector<std::thread> producers;
+            for (size_t producer = 0; producer < producerCount; producer++)
+            {
+                producers.emplace_back([&, producer]()
+                {
+                    readyProducers++;
+                    while (!isStarted.load()) std::this_thread::yield();
+
+                    size_t first = producer * eventsPerProducer;
+                    for (size_t i = first; i < first + eventsPerProducer; i++)
+                        dispatcher.PostEvent<PostingBenchmarkEvent>(i);
+                });
+            }
+
+            // producers are started together, so they contend for queue during whole measurement
+            while (readyProducers.load() != producerCount) std::this_thread::yield();
+            BenchmarkTimer timer;
+            isStarted = true;
+            for (auto& producer : producers)
+                producer.join();
+            return timer.GetMilliseconds();
+        }
+    public:
+        virtual bool OnFrame() override
+        {
+            EventDispatcherImpl<EventBase> dispatcher;
+            size_t dispatchedCount = 0, dispatchedSum = 0;
+            dispatcher.AddEventListener<PostingBenchmarkEvent>([&](PostingBenchmarkEvent& e) { dispatchedCount++; dispatchedSum += e.Value; });
+
+            size_t expectedSum = EventCount * (EventCount - 1) / 2;
+            for (size_t producerCount : { 1, 2, 4, 8, 16 })
+            {
+                double postTime = PostEvents(dispatcher, producerCount);
+
+                dispatchedCount = 0;
+                dispatchedSum = 0;
+                dispatcher.SetPostedEventsLimit(NoTimeLimit, EventCount);
+                BenchmarkTimer drainTimer;
+                dispatcher.InvokeAll();
+                double drainTime = drainTimer.GetMilliseconds();
+
+                this->Report(MxFormat("{} producers, posting", producerCount), double(EventCount) / postTime, "events/ms");
+                this->Report(MxFormat("{} producers, draining", producerCount), double(EventCount) / drainTime, "events/ms");
+                this->Check(dispatchedCount == EventCount && dispatchedSum == expectedSum, MxFormat("all events posted by {} producers are dispatched once", producerCount));
+            }
+
+            // events which do not fit into per-call limit stay queued for next calls
+            PostEvents(dispatcher, 4);
+            dispatchedCount = 0;
+            dispatcher.SetPostedEventsLimit(NoTimeLimit, DrainCountLimit);
+            dispatcher.InvokeAll();
+            this->Check(dispatchedCount == DrainCountLimit && dispatcher.GetPostedEventsCount() == EventCount - DrainCountLimit, "posted events are drained within count limit");
+
+            dispatcher.SetPostedEventsLimit(1.0f, EventCount);
+            BenchmarkTimer limitTimer;
+            dispatcher.InvokeAll();
+            this->Report("drain call with 1 ms limit", limitTimer.GetMilliseconds(), "ms");
+
+            dispatcher.SetPostedEventsLimit(NoTimeLimit, EventCount);
+            dispatcher.InvokeAll();
+            this->Check(dispatchedCount == EventCount && dispatcher.GetPostedEventsCount() == 0, "remaining posted events are dispatched by next calls");
+            return true;
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(EventPostingBenchmark, "event-posting");
+}
@@ -0,0 +1,153 @@
+#include "Benchmark.h"
+#include "Utilities/Memory/FrameArena.h"
+
+namespace Benchmarks
+{
+    /*
+    counts global heap allocations per application frame in scene with camera, lights, meshes, debug shapes and colliding rigid bodies
+    frame-scoped containers are first measured with frame arena, then with arena heap fallback, where each of their allocations
+    goes to general heap as it did before frame arena. Allocations are counted by global operator new of benchmark application
+    */
+    class FrameAllocationBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t MeshObjectCount = 1000;
+        constexpr static size_t BodyCount = 200;
+        constexpr static size_t PointLightCount = 4;
+        // enough for physics bodies to fall onto the ground and for arena to reach its steady size
+        constexpr static size_t WarmupFrameCount = 60;
+        // memory allocated before fallback is enabled stays in arena for one more frame
+        constexpr static size_t FallbackWarmupFrameCount = 2;
+        constexpr static size_t MeasuredFrameCount = 120;
+
+        enum class Stage
+        {
+            WARMUP,
+            MEASURE_ARENA,
+            WARMUP_FALLBACK,
+            MEASURE_FALLBACK,
+        };
+
+        MxVector<MxObject::Handle> objects;
+        Stage stage = Stage::WARMUP;
+        size_t stageFrame = 0;
+        size_t lastAllocationCount = 0;
+        size_t stageAllocations = 0;
+        size_t arenaBytes = 0;
+        double arenaAllocations = 0.0;
+
+        void NextStage(Stage next)
+        {
+            this->stage = next;
+            this->stageFrame = 0;
+            this->stageAllocations = 0;
+        }
+    public:
+        virtual void OnStart() override
+        {
+            auto& camera = this->objects.emplace_back(MxObject::Create());
+            camera->LocalTransform.SetPosition(Vector3(0.0f, 30.0f, -60.0f));
+            auto controller = camera->AddComponent<CameraController>();
+            controller->SetDirection(Normalize(Vector3(0.0f, -0.5f, 1.0f)));
+            Rendering::SetViewport(controller);
+
+            auto& light = this->objects.emplace_back(MxObject::Create());
+            auto directionalLight = light->AddComponent<DirectionalLight>();
+            directionalLight->Direction = Vector3(0.5f, 1.0f, 1.0f);
+            directionalLight->IsFollowingViewport = true;
+
+            for (size_t i = 0; i < PointLightCount; i++)
+            {
+                auto& pointLight = this->objects.emplace_back(MxObject::Create());
+                pointLight->LocalTransform.SetPosition(Vector3(20.0f * float(i) - 30.0f, 5.0f, 0.0f));
+                pointLight->AddComponent<PointLight>()->SetRadius(30.0f);
+            }
+
+            auto cube = Primitives::CreateCube();
+            auto material = Factory<Material>::Create();
+            for (size_t i = 0; i < MeshObjectCount; i++)
+            {
+                auto& object = this->objects.emplace_back(MxObject::Create());
+                object->LocalTransform.SetPosition(Vector3(2.0f * float(i % 50) - 50.0f, 10.0f + 2.0f * float(i / 50 % 2), 2.0f * float(i / 100)));
+                object->AddComponent<MeshSource>(cube);
+                object->AddComponent<MeshRenderer>(material);
+                if (i % 10 == 0) object->AddComponent<DebugDraw>()->RenderBoundingBox = true;
+            }
+
+            // bodies are stacked in columns on static ground, so they stay in contact with ground and with each other
+            auto& ground = this->objects.emplace_back(MxObject::Create());
+            ground->LocalTransform.SetScale(Vector3(100.0f, 1.0f, 100.0f));
+            ground->AddComponent<MeshSource>(cube);
+            ground->AddComponent<MeshRenderer>(material);
+            ground->AddComponent<BoxCollider>();
+            ground->AddComponent<RigidBody>();
+
+            for (size_t i = 0; i < BodyCount; i++)
+            {
+                auto& body = this->objects.emplace_back(MxObject::Create());
+                body->LocalTransform.SetPosition(Vector3(3.0f * float(i / 5 % 10) - 15.0f, 1.0f + float(i % 5), 3.0f * float(i / 50)));
+                body->AddComponent<MeshSource>(cube);
+                body->AddComponent<MeshRenderer>(material);
+                body->AddComponent<BoxCollider>();
+                body->AddComponent<RigidBody>()->MakeDynamic();
+                body->AddComponent<DebugDraw>()->RenderPhysicsCollider = true;
+            }
+            this->lastAllocationCount = GetHeapAllocationCount();
+        }
+
+        virtual bool OnFrame() override
+        {
+            // difference between two calls is the count of allocations made by one whole application frame
+            size_t allocationCount = GetHeapAllocationCount();
+            this->stageAllocations += allocationCount - this->lastAllocationCount;
+            this->stageFrame++;
+
+            switch (this->stage)
+            {
+            case Stage::WARMUP:
+                if (this->stageFrame == WarmupFrameCount)
+                    this->NextStage(Stage::MEASURE_ARENA);
+                break;
+            case Stage::MEASURE_ARENA:
+                if (this->stageFrame == MeasuredFrameCount)
+                {
+                    this->arenaAllocations = double(this->stageAllocations) / MeasuredFrameCount;
+                    this->arenaBytes = FrameArena::GetGlobal().GetLastFrameUsedBytes();
+                    FrameArena::GetGlobal().SetHeapFallback(true);
+                    this->NextStage(Stage::WARMUP_FALLBACK);
+                }
+                break;
+            case Stage::WARMUP_FALLBACK:
+                if (this->stageFrame == FallbackWarmupFrameCount)
+                    this->NextStage(Stage::MEASURE_FALLBACK);
+                break;
+            case Stage::MEASURE_FALLBACK:
+                if (this->stageFrame == MeasuredFrameCount)
+                {
+                    FrameArena::GetGlobal().SetHeapFallback(false);
+                    double fallbackAllocations = double(this->stageAllocations) / MeasuredFrameCount;
+
+                    this->Report("frame arena memory", double(this->arenaBytes), "bytes/frame");
+                    this->Report("heap allocations, frame arena", this->arenaAllocations, "allocations/frame");
+                    this->Report("heap allocations, arena heap fallback", fallbackAllocations, "allocations/frame");
+                    this->Report("removed heap allocations", fallbackAllocations - this->arenaAllocations, "allocations/frame");
+                    this->Check(GetHeapAllocationCount() > 0, "heap allocations are counted by benchmark application");
+                    this->Check(this->arenaAllocations < fallbackAllocations, "frame arena removes heap allocations of frame-scoped containers");
+                    return true;
+                }
+                break;
+            }
+            this->lastAllocationCount = GetHeapAllocationCount();
+            return false;
+        }
+
+        virtual void OnFinish() override
+        {
+            FrameArena::GetGlobal().SetHeapFallback(false);
+            for (auto& object : this->objects)
+                MxObject::Destroy(object);
+            this->objects.clear();
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(FrameAllocationBenchmark, "frame-allocations");
+}
@@ -0,0 +1,51 @@
+#include "Benchmark.h"
+#include "Core/BoundingObjects/FrustrumCuller.h"
+
+#include <random>
+
+namespace Benchmarks
+{
+    /*
+    compares vectorized frustum culling (SSE, or AVX if engine is built with MXENGINE_CULLER_AVX and CPU supports it) with scalar reference
+    boxes are spread around camera, so roughly a quarter of them is visible
+    */
+    class FrustrumCullingBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t RunCount = 20;
+    public:
+        virtual bool OnFrame() override
+        {
+            this->Report("AVX path", FrustrumCuller::IsAVXSupported() ? 1.0 : 0.0, "(1 - enabled, 0 - disabled)");
+
+            auto projection = MakePerspectiveMatrix(Radians(65.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+            auto view = MakeViewMatrix(MakeVector3(0.0f), MakeVector3(0.0f, 0.0f, 1.0f), MakeVector3(0.0f, 1.0f, 0.0f));
+            FrustrumCuller culler(projection * view);
+
+            std::mt19937 generator(42);
+            std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+            std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+            for (size_t boxCount : { 1000, 10000, 100000 })
+            {
+                AABBArray boxes;
+                for (size_t i = 0; i < boxCount; i++)
+                {
+                    Vector3 minp(position(generator), position(generator), position(generator));
+                    boxes.Add(minp, minp + Vector3(size(generator), size(generator), size(generator)));
+                }
+
+                VisibilityMask simdMask, scalarMask((boxCount + 31) / 32);
+                double simdTime = MeasureBest(RunCount, [&]() { culler.CullAABBs(boxes, simdMask); });
+                double scalarTime = MeasureBest(RunCount, [&]() { culler.CullAABBsScalar(boxes, 0, boxCount, scalarMask); });
+
+                this->Report(MxFormat("{} boxes, SIMD", boxCount), double(boxCount) / simdTime, "boxes/ms");
+                this->Report(MxFormat("{} boxes, scalar", boxCount), double(boxCount) / scalarTime, "boxes/ms");
+                this->Report(MxFormat("{} boxes, speedup", boxCount), scalarTime / simdTime, "x");
+                this->Check(simdMask == scalarMask, MxFormat("SIMD and scalar results match for {} boxes", boxCount));
+            }
+            return true;
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(FrustrumCullingBenchmark, "frustrum-culling");
+}
@@ -0,0 +1,174 @@
+#include "Benchmark.h"
+#include "Core/Rendering/RenderAdaptor.h"
+#include "Core/Resources/BufferAllocator.h"
+#include "Platform/Compute/Compute.h"
+
+#include <random>
+
+namespace Benchmarks
+{
+    /*
+    measures data-only instances: their creation, updates of small part of them, upload of changed chunks to instance buffer
+    and culling by InstanceCuller, which uploads indices of visible instances and gathers them on GPU from factory range.
+    Instances are spread around camera, so roughly a quarter of them is visible
+    dirty-only uploads are compared with re-upload of whole instance range, which factory did before dirty tracking.
+    Updated instances are either one contiguous block (moving group of objects) or scattered over all chunks, which is the worst case
+    */
+    class InstanceUploadBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t RunCount = 10;
+        // part of instances which are moved each frame, as most of instances (grass, debris) are usually static
+        constexpr static size_t UpdateRatio = 100;
+
+        void MeasureInstances(size_t instanceCount, const FrustrumCuller& frustrum)
+        {
+            std::mt19937 generator(42);
+            std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+
+            auto object = MxObject::Create();
+            auto factory = object->AddComponent<InstanceFactory>();
+
+            MxVector<Transform> transforms(instanceCount);
+            for (auto& transform : transforms)
+                transform.SetPosition(Vector3(position(generator), position(generator), position(generator)));
+
+            BenchmarkTimer timer;
+            for (const auto& transform : transforms)
+                factory->AddDataInstance(transform);
+            double createTime = timer.GetMilliseconds();
+
+            timer.Reset();
+            factory->UploadDirtyInstances();
+            double initialUploadTime = timer.GetMilliseconds();
+
+            size_t updateCount = instanceCount / UpdateRatio;
+            double updateTime = MeasureBest(RunCount, [&]()
+            {
+                for (size_t i = 0; i < instanceCount; i += UpdateRatio)
+                {
+                    transforms[i].TranslateY(0.01f);
+                    factory->SetDataInstance(i, transforms[i]);
+                }
+            });
+
+            // instances are modified outside of measured part, so only upload of changed chunks is timed
+            auto measureDirtyUpload = [&](size_t first, size_t step, size_t& uploadedCount)
+            {
+                double best = std::numeric_limits<double>::max();
+                for (size_t run = 0; run < RunCount; run++)
+                {
+                    for (size_t i = first; i < instanceCount && i < first + updateCount * step; i += step)
+                    {
+                        transforms[i].TranslateY(0.01f);
+                        factory->SetDataInstance(i, transforms[i]);
+                    }
+                    BenchmarkTimer uploadTimer;
+                    factory->UploadDirtyInstances();
+                    best = std::min(best, uploadTimer.GetMilliseconds());
+                }
+
+                uploadedCount = 0;
+                const auto& versions = factory->GetChunkVersions();
+                for (size_t chunk = 0; chunk < versions.size(); chunk++)
+                {
+                    if (versions[chunk] == factory->GetInstanceVersion())
+                        uploadedCount += Min(InstanceFactory::DirtyChunkSize, instanceCount - chunk * InstanceFactory::DirtyChunkSize);
+                }
+                return best;
+            };
+            size_t blockUploadedCount = 0, scatteredUploadedCount = 0;
+            double blockUploadTime = measureDirtyUpload(instanceCount / 2, 1, blockUploadedCount);
+            double scatteredUploadTime = measureDirtyUpload(0, UpdateRatio, scatteredUploadedCount);
+
+            auto cache = (const float*)factory->GetInstanceCache().data();
+            double fullUploadTime = MeasureBest(RunCount, [&]()
+            {
+                BufferAllocator::GetInstanceVBO()->BufferSubData(cache, instanceCount * InstanceFactory::InstanceDataSize,
+                    factory->GetInstanceBufferOffset() * InstanceFactory::InstanceDataSize);
+            });
+
+            size_t blockChunkCount = (instanceCount / 2 + updateCount - 1) / InstanceFactory::DirtyChunkSize - instanceCount / 2 / InstanceFactory::DirtyChunkSize + 1;
+            this->Check(blockUploadedCount == blockChunkCount * InstanceFactory::DirtyChunkSize,
+                MxFormat("only chunks of updated block are uploaded for {} instances", instanceCount));
+            this->Check(factory->GetInstanceBufferSize() >= instanceCount, MxFormat("instance buffer range fits {} instances", instanceCount));
+
+            // instance bounds and LODs are normally computed by renderer, here they are built directly from unit cube instances
+            AABBArray boxes;
+            MxVector<uint8_t> lods(instanceCount, 0);
+            for (const auto& transform : transforms)
+                boxes.Add(transform.GetPosition() - MakeVector3(0.5f), transform.GetPosition() + MakeVector3(0.5f));
+
+            InstancedObjectUnit unit;
+            unit.InstanceBufferOffset = factory->GetInstanceBufferOffset();
+            unit.InstanceAABBs = &boxes;
+            unit.InstanceLODs = lods.data();
+            unit.InstanceCount = instanceCount;
+
+            // culler of renderer is used, so benchmark gathers into the same instance buffer range as rendered frames do
+            auto& culler = Rendering::GetAdaptor().Renderer.GetInstanceCuller();
+            RenderStatistics statistics;
+            size_t bucket = 0;
+            double cullTime = MeasureBest(RunCount, [&]()
+            {
+                culler.Clear();
+                bucket = culler.AddObject(unit);
+                culler.Cull(frustrum, statistics);
+            });
+            auto range = culler.GetInstanceRange(bucket);
+            size_t uploadedCount = range.InstanceCount;
+
+            // gathered range must contain visible instances in order of their indices
+            MxVector<float> gathered(uploadedCount * InstanceFactory::InstanceDataSize);
+            Compute::SetMemoryBarrier(BarrierType::BUFFER_UPDATE);
+            BufferAllocator::GetInstanceVBO()->GetBufferData(gathered.data(), gathered.size(), range.BaseInstance * InstanceFactory::InstanceDataSize);
+
+            VisibilityMask expected((instanceCount + 31) / 32);
+            frustrum.CullAABBsScalar(boxes, 0, instanceCount, expected);
+            size_t expectedCount = 0;
+            bool isGatheredValid = true;
+            for (size_t i = 0; i < instanceCount; i++)
+            {
+                if (!FrustrumCuller::IsVisible(expected, i)) continue;
+                if (expectedCount < uploadedCount)
+                {
+                    auto instance = (const float*)&factory->GetInstanceCache()[i];
+                    auto target = gathered.data() + expectedCount * InstanceFactory::InstanceDataSize;
+                    isGatheredValid &= std::equal(instance, instance + InstanceFactory::InstanceDataSize, target);
+                }
+                expectedCount++;
+            }
+
+            this->Report(MxFormat("{} instances, creation", instanceCount), double(instanceCount) / createTime, "instances/ms");
+            this->Report(MxFormat("{} instances, update of {}", instanceCount, updateCount), updateTime, "ms");
+            this->Report(MxFormat("{} instances, initial upload", instanceCount), initialUploadTime, "ms");
+            this->Report(MxFormat("{} instances, full re-upload", instanceCount), fullUploadTime, "ms");
+            this->Report(MxFormat("{} instances, dirty upload of {} block", instanceCount, updateCount), blockUploadTime, "ms");
+            this->Report(MxFormat("{} instances, dirty upload of {} block, uploaded", instanceCount, updateCount), double(blockUploadedCount), "instances");
+            this->Report(MxFormat("{} instances, dirty upload of {} block, speedup", instanceCount, updateCount), fullUploadTime / blockUploadTime, "x");
+            this->Report(MxFormat("{} instances, dirty upload of {} scattered", instanceCount, updateCount), scatteredUploadTime, "ms");
+            this->Report(MxFormat("{} instances, dirty upload of {} scattered, uploaded", instanceCount, updateCount), double(scatteredUploadedCount), "instances");
+            this->Report(MxFormat("{} instances, cull and gather", instanceCount), cullTime, "ms");
+            this->Report(MxFormat("{} instances, visible", instanceCount), double(uploadedCount), "instances");
+            this->Report(MxFormat("{} instances, uploaded by culler", instanceCount), double(uploadedCount * sizeof(uint32_t)), "bytes");
+            this->Report(MxFormat("{} instances, uploaded by culler before gather", instanceCount), double(uploadedCount * sizeof(InstanceFactory::InstanceData)), "bytes");
+            this->Check(uploadedCount == expectedCount, MxFormat("only visible instances are gathered for {} instances", instanceCount));
+            this->Check(isGatheredValid, MxFormat("gathered instances match factory data for {} instances", instanceCount));
+
+            culler.Clear();
+            MxObject::Destroy(object);
+        }
+    public:
+        virtual bool OnFrame() override
+        {
+            auto projection = MakePerspectiveMatrix(Radians(65.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+            auto view = MakeViewMatrix(MakeVector3(0.0f), MakeVector3(0.0f, 0.0f, 1.0f), MakeVector3(0.0f, 1.0f, 0.0f));
+            FrustrumCuller frustrum(projection * view);
+
+            for (size_t instanceCount : { 10000, 100000, 1000000 })
+                this->MeasureInstances(instanceCount, frustrum);
+            return true;
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(InstanceUploadBenchmark, "instance-uploads");
+}
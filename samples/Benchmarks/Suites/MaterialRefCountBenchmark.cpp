@@ -0,0 +1,129 @@
+#include "Benchmark.h"
+#include "Core/Rendering/RenderAdaptor.h"
+#include "Core/MxObject/TransformHierarchy.h"
+
+namespace Benchmarks
+{
+    /*
+    counts Texture IncRef/DecRef calls per frame in scene of 10k render units sharing 50 materials
+    renderer with material table is compared with per-unit material copies with default texture fixups, which renderer did before
+    counters are thread local, so submission is done on one thread. Scene has no cameras, so no GPU work is done
+    */
+    class MaterialRefCountBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t ObjectCount = 10000;
+        constexpr static size_t MaterialCount = 50;
+        constexpr static size_t FrameCount = 10;
+
+        MxVector<MxObject::Handle> objects;
+        MxVector<MaterialHandle> materials;
+
+        static size_t GetTextureRefCountOperations()
+        {
+            #if defined(MXENGINE_PROFILING_ENABLED)
+            return ResourceRefCounter<Texture>::Operations;
+            #else
+            return 0;
+            #endif
+        }
+
+        // copies material of each unit and sets default textures, as SubmitRenderUnit did before material table
+        static void CopyUnitMaterials(MxVector<Material>& copies, const MxVector<MaterialHandle>& materials, const EnvironmentUnit& environment)
+        {
+            for (size_t i = 0; i < ObjectCount; i++)
+            {
+                auto& material = copies.emplace_back(*materials[i % materials.size()]);
+                if (!material.AlbedoMap.IsValid())           material.AlbedoMap = environment.DefaultMaterialMap;
+                if (!material.RoughnessMap.IsValid())        material.RoughnessMap = environment.DefaultMaterialMap;
+                if (!material.MetallicMap.IsValid())         material.MetallicMap = environment.DefaultMaterialMap;
+                if (!material.EmissiveMap.IsValid())         material.EmissiveMap = environment.DefaultMaterialMap;
+                if (!material.AmbientOcclusionMap.IsValid()) material.AmbientOcclusionMap = environment.DefaultMaterialMap;
+                if (!material.NormalMap.IsValid())           material.NormalMap = environment.DefaultNormalMap;
+                if (!material.HeightMap.IsValid())           material.HeightMap = environment.DefaultBlackMap;
+            }
+        }
+
+        // returns average count of texture refcount operations per frame
+        double CountFrameOperations(bool changeMaterials)
+        {
+            auto& adaptor = Rendering::GetAdaptor();
+            size_t operations = 0;
+            for (size_t frame = 0; frame < FrameCount; frame++)
+            {
+                for (size_t i = 0; changeMaterials && i < this->materials.size(); i++)
+                    this->materials[i]->RoughnessFactor = frame % 2 == 0 ? 0.5f : 0.75f;
+                TransformHierarchy::Update();
+
+                size_t before = GetTextureRefCountOperations();
+                adaptor.RenderFrame();
+                adaptor.Renderer.ResetPipeline();
+                operations += GetTextureRefCountOperations() - before;
+            }
+            return double(operations) / FrameCount;
+        }
+    public:
+        virtual void OnStart() override
+        {
+            auto cube = Primitives::CreateCube();
+            for (size_t i = 0; i < MaterialCount; i++)
+                this->materials.push_back(Factory<Material>::Create());
+
+            for (size_t i = 0; i < ObjectCount; i++)
+            {
+                auto object = MxObject::Create();
+                object->LocalTransform.SetPosition(Vector3(2.0f * float(i % 100), 0.0f, 2.0f * float(i / 100)));
+                object->AddComponent<MeshSource>(cube);
+                object->AddComponent<MeshRenderer>(this->materials[i % MaterialCount]);
+                this->objects.push_back(std::move(object));
+            }
+        }
+
+        virtual bool OnFrame() override
+        {
+            #if !defined(MXENGINE_PROFILING_ENABLED)
+            this->Check(false, "refcount operations are counted only when MXENGINE_PROFILING_ENABLED is defined (non-shipping builds)");
+            return true;
+            #endif
+
+            auto& adaptor = Rendering::GetAdaptor();
+            size_t previousThreadCount = adaptor.GetSubmitThreadCount();
+            adaptor.SetSubmitThreadCount(1);
+
+            // first frame builds render units and resolves each material once
+            TransformHierarchy::Update();
+            size_t buildBefore = GetTextureRefCountOperations();
+            adaptor.RenderFrame();
+            adaptor.Renderer.ResetPipeline();
+            this->Report("initial build", double(GetTextureRefCountOperations() - buildBefore), "texture refcount ops");
+            this->Check(adaptor.Renderer.GetRenderUnitCount() == ObjectCount, "render unit is built for each object");
+
+            double staticOperations = this->CountFrameOperations(false);
+            double changedOperations = this->CountFrameOperations(true);
+            adaptor.SetSubmitThreadCount(previousThreadCount);
+
+            MxVector<Material> copies;
+            copies.reserve(ObjectCount);
+            size_t copyBefore = GetTextureRefCountOperations();
+            CopyUnitMaterials(copies, this->materials, adaptor.Renderer.GetEnvironment());
+            copies.clear();
+            double copyOperations = double(GetTextureRefCountOperations() - copyBefore);
+
+            this->Report("per-unit material copies", copyOperations, "texture refcount ops/frame");
+            this->Report("material table, static materials", staticOperations, "texture refcount ops/frame");
+            this->Report("material table, all 50 materials changed", changedOperations, "texture refcount ops/frame");
+            this->Report("removed refcount operations, static materials", copyOperations - staticOperations, "ops/frame");
+            this->Check(changedOperations < copyOperations / 10.0, "material table touches textures once per distinct material, not per unit");
+            return true;
+        }
+
+        virtual void OnFinish() override
+        {
+            for (auto& object : this->objects)
+                MxObject::Destroy(object);
+            this->objects.clear();
+            this->materials.clear();
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(MaterialRefCountBenchmark, "material-refcount");
+}
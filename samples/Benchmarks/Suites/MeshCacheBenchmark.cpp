@@ -0,0 +1,63 @@
+#include "Benchmark.h"
+#include "Core/Resources/MeshCache.h"
+
+namespace Benchmarks
+{
+    /*
+    compares loading of the same object file from source (import + cache baking) and from .mxmesh cache
+    object is generated into temporary directory, so suite does not depend on sample resources
+    */
+    class MeshCacheBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t GridSize = 300;
+        constexpr static size_t CachedRunCount = 5;
+
+        FilePath directory;
+        FilePath source;
+    public:
+        virtual void OnStart() override
+        {
+            this->directory = std::filesystem::temp_directory_path() / "MxEngineBenchmarks" / "MeshCache";
+            std::filesystem::create_directories(this->directory);
+            this->source = this->directory / "grid.obj";
+            GenerateGridObject(this->source, GridSize);
+        }
+
+        virtual bool OnFrame() override
+        {
+            auto cachePath = MeshCache::GetCachePath(this->source);
+            std::error_code error;
+            std::filesystem::remove(cachePath, error);
+
+            MeshHandle coldMesh;
+            double coldTime = MeasureBest(1, [this, &coldMesh]()
+            {
+                coldMesh = Factory<Mesh>::Create();
+                coldMesh->Load(this->source);
+            });
+            this->Check(File::Exists(cachePath), "mesh cache is written on first load");
+
+            MeshHandle cachedMesh;
+            double cachedTime = MeasureBest(CachedRunCount, [this, &cachedMesh]()
+            {
+                cachedMesh = Factory<Mesh>::Create();
+                cachedMesh->Load(this->source);
+            });
+
+            this->Report("cold load (import + bake)", coldTime, "ms");
+            this->Report("cached load", cachedTime, "ms");
+            this->Report("speedup", coldTime / cachedTime, "x");
+            this->Check(coldMesh->GetTotalVerteciesCount() == cachedMesh->GetTotalVerteciesCount() &&
+                coldMesh->GetTotalIndiciesCount() == cachedMesh->GetTotalIndiciesCount(), "cached mesh matches imported mesh");
+            return true;
+        }
+
+        virtual void OnFinish() override
+        {
+            std::error_code error;
+            std::filesystem::remove_all(this->directory, error);
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(MeshCacheBenchmark, "mesh-cache");
+}
@@ -0,0 +1,69 @@
+#include "Benchmark.h"
+
+namespace Benchmarks
+{
+    /*
+    measures MxObject::GetByName with different count of objects in scene and compares it with scan of all objects,
+    which is how names were looked up before name registry. Indexed lookup time should not depend on scene size
+    */
+    class NameLookupBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t RunCount = 5;
+        constexpr static size_t LookupCount = 1000;
+        constexpr static size_t ScanLookupCount = 100;
+    public:
+        virtual bool OnFrame() override
+        {
+            MxVector<MxObject::Handle> objects;
+            MxVector<MxString> names;
+            double firstLookupTime = 0.0;
+
+            for (size_t objectCount : { 1000, 10000, 50000 })
+            {
+                while (objects.size() < objectCount)
+                {
+                    auto& object = objects.emplace_back(MxObject::Create());
+                    object->Name = names.emplace_back(MxFormat("object_{}", objects.size() - 1));
+                }
+
+                // names are spread over whole scene, so scan cost is the average, not the best case
+                size_t step = objectCount / LookupCount;
+                bool allFound = true;
+                double lookupTime = MeasureBest(RunCount, [&]()
+                {
+                    for (size_t i = 0; i < LookupCount; i++)
+                        allFound &= MxObject::GetByName(names[i * step]) == objects[i * step];
+                });
+
+                size_t scanStep = objectCount / ScanLookupCount;
+                size_t scanFound = 0;
+                double scanTime = MeasureBest(RunCount, [&]()
+                {
+                    scanFound = 0;
+                    for (size_t i = 0; i < ScanLookupCount; i++)
+                    {
+                        const auto& name = names[i * scanStep];
+                        for (auto& object : MxObject::GetObjects())
+                        {
+                            if (object.Name == name) { scanFound++; break; }
+                        }
+                    }
+                });
+                BenchmarkSink = scanFound;
+
+                if (firstLookupTime == 0.0) firstLookupTime = lookupTime;
+                this->Report(MxFormat("{} objects, indexed lookup", objectCount), double(LookupCount) / lookupTime, "lookups/ms");
+                this->Report(MxFormat("{} objects, scan lookup", objectCount), double(ScanLookupCount) / scanTime, "lookups/ms");
+                this->Report(MxFormat("{} objects, indexed lookup time relative to 1000 objects", objectCount), lookupTime / firstLookupTime, "x");
+                this->Check(allFound && scanFound == ScanLookupCount, MxFormat("all names are found among {} objects", objectCount));
+            }
+
+            for (auto& object : objects)
+                MxObject::Destroy(object);
+            this->Check(MxObject::CountByName(names.front()) == 0, "names of destroyed objects are removed from registry");
+            return true;
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(NameLookupBenchmark, "name-lookups");
+}
@@ -0,0 +1,72 @@
+#include "Benchmark.h"
+#include "Utilities/ObjectLoading/ObjectLoader.h"
+
+namespace Benchmarks
+{
+    /*
+    compares loading of 50 glTF files one by one and with ObjectLoader::LoadMany, which imports files in parallel
+    each import also processes its meshes with nested ParallelFor, so suite checks that nested calls do not stall each other
+    */
+    class ObjectLoadingBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t FileCount = 50;
+        constexpr static size_t GridSize = 100;
+
+        FilePath directory;
+        MxVector<FilePath> paths;
+
+        static size_t CountVerticies(const ObjectInfo& object)
+        {
+            size_t count = 0;
+            for (const auto& mesh : object.meshes)
+                count += mesh.vertecies.size();
+            return count;
+        }
+    public:
+        virtual void OnStart() override
+        {
+            this->directory = std::filesystem::temp_directory_path() / "MxEngineBenchmarks" / "ObjectLoading";
+            std::filesystem::create_directories(this->directory);
+            for (size_t i = 0; i < FileCount; i++)
+            {
+                auto path = this->directory / MxFormat("grid_{}.gltf", i).c_str();
+                GenerateGridGLTF(path, GridSize + i);
+                this->paths.push_back(path);
+            }
+        }
+
+        virtual bool OnFrame() override
+        {
+            MxVector<ObjectInfo> sequential;
+            double sequentialTime = MeasureBest(1, [this, &sequential]()
+            {
+                for (const auto& path : this->paths)
+                    sequential.push_back(ObjectLoader::Load(path));
+            });
+
+            MxVector<ObjectInfo> parallel;
+            double parallelTime = MeasureBest(1, [this, &parallel]()
+            {
+                parallel = ObjectLoader::LoadMany(this->paths);
+            });
+
+            this->Report("one by one", double(FileCount) * 1000.0 / sequentialTime, "files/s");
+            this->Report("LoadMany", double(FileCount) * 1000.0 / parallelTime, "files/s");
+            this->Report("speedup", sequentialTime / parallelTime, "x");
+
+            bool isSame = sequential.size() == parallel.size();
+            for (size_t i = 0; isSame && i < FileCount; i++)
+                isSame &= CountVerticies(sequential[i]) == CountVerticies(parallel[i]) && CountVerticies(parallel[i]) > 0;
+            this->Check(isSame, "LoadMany produces the same objects as sequential loading");
+            return true;
+        }
+
+        virtual void OnFinish() override
+        {
+            std::error_code error;
+            std::filesystem::remove_all(this->directory, error);
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(ObjectLoadingBenchmark, "object-loading");
+}
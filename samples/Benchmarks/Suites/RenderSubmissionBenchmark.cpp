@@ -0,0 +1,89 @@
+#include "Benchmark.h"
+#include "Core/Rendering/RenderAdaptor.h"
+#include "Core/MxObject/TransformHierarchy.h"
+#include "Utilities/Concurrency/ThreadPool.h"
+
+namespace Benchmarks
+{
+    /*
+    measures submission of mesh render units with different count of submission threads
+    scene has no cameras, so renderer stops right after submission and measured time does not include any GPU work
+    render units are kept between frames, so frames where all objects, 1% of objects and no objects are moved are measured separately
+    */
+    class RenderSubmissionBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t ObjectCount = 50000;
+        constexpr static size_t FrameCount = 20;
+
+        MxVector<MxObject::Handle> objects;
+
+        double MeasureFrames(size_t movedObjectStep)
+        {
+            auto& adaptor = Rendering::GetAdaptor();
+            double totalTime = 0.0;
+            for (size_t frame = 0; frame < FrameCount; frame++)
+            {
+                for (size_t i = 0; movedObjectStep != 0 && i < this->objects.size(); i += movedObjectStep)
+                    this->objects[i]->LocalTransform.TranslateY(0.001f);
+                TransformHierarchy::Update();
+
+                BenchmarkTimer timer;
+                adaptor.RenderFrame();
+                totalTime += timer.GetMilliseconds();
+                adaptor.Renderer.ResetPipeline();
+            }
+            return totalTime / FrameCount;
+        }
+    public:
+        virtual void OnStart() override
+        {
+            auto cube = Primitives::CreateCube();
+            auto material = Factory<Material>::Create();
+            size_t side = (size_t)std::cbrt((float)ObjectCount) + 1;
+            for (size_t i = 0; i < ObjectCount; i++)
+            {
+                auto object = MxObject::Create();
+                object->LocalTransform.SetPosition(2.0f * Vector3(float(i % side), float(i / side % side), float(i / side / side)));
+                object->AddComponent<MeshSource>(cube);
+                object->AddComponent<MeshRenderer>(material);
+                this->objects.push_back(std::move(object));
+            }
+        }
+
+        virtual bool OnFrame() override
+        {
+            auto& adaptor = Rendering::GetAdaptor();
+            size_t previousThreadCount = adaptor.GetSubmitThreadCount();
+            this->Report("available threads", double(ThreadPool::GetGlobal().GetThreadCount() + 1), "threads");
+
+            // first frame builds render units of all created objects
+            TransformHierarchy::Update();
+            BenchmarkTimer buildTimer;
+            adaptor.RenderFrame();
+            this->Report("initial build", buildTimer.GetMilliseconds(), "ms");
+            adaptor.Renderer.ResetPipeline();
+            this->Check(adaptor.Renderer.GetRenderUnitCount() == ObjectCount, "render unit is built for each object");
+
+            for (size_t threadCount : { 1, 2, 4, 8 })
+            {
+                adaptor.SetSubmitThreadCount(threadCount);
+                double frameTime = this->MeasureFrames(1);
+                this->Report(MxFormat("{} submission threads, all objects moved", threadCount), double(ObjectCount) / frameTime, "objects/ms");
+            }
+            adaptor.SetSubmitThreadCount(previousThreadCount);
+
+            this->Report("1% objects moved", this->MeasureFrames(100), "ms/frame");
+            this->Report("static frame", this->MeasureFrames(0), "ms/frame");
+            return true;
+        }
+
+        virtual void OnFinish() override
+        {
+            for (auto& object : this->objects)
+                MxObject::Destroy(object);
+            this->objects.clear();
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(RenderSubmissionBenchmark, "render-submission");
+}
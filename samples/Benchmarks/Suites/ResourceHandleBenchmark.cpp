@@ -0,0 +1,85 @@
+#include "Benchmark.h"
+
+namespace Benchmarks
+{
+    struct BenchmarkResource
+    {
+        size_t Value = 0;
+
+        BenchmarkResource(size_t value) : Value(value) { }
+    };
+
+    /*
+    measures resource handle size, validity check cost and creation throughput
+    results depend on MXENGINE_COMPACT_HANDLES option, which replaces UUID ids with pool slot generations
+    */
+    class ResourceHandleBenchmark : public BenchmarkSuite
+    {
+        using ResourceHandle = Resource<BenchmarkResource, Factory<BenchmarkResource>>;
+
+        constexpr static size_t ResourceCount = 100000;
+        constexpr static size_t CheckRepeatCount = 20;
+        constexpr static size_t RunCount = 5;
+    public:
+        virtual void OnStart() override
+        {
+            Factory<BenchmarkResource>::Init();
+        }
+
+        virtual bool OnFrame() override
+        {
+            this->Report("handle size", double(sizeof(ResourceHandle)), "bytes");
+
+            MxVector<ResourceHandle> handles;
+            handles.reserve(ResourceCount);
+            double createTime = MeasureBest(RunCount, [&handles]()
+            {
+                handles.clear();
+                for (size_t i = 0; i < ResourceCount; i++)
+                    handles.push_back(Factory<BenchmarkResource>::Create(i));
+            });
+            this->Report("creation", double(ResourceCount) / createTime, "resources/ms");
+
+            // every second resource is destroyed, so checks hit both alive and stale handles
+            MxVector<ResourceHandle> staleHandles = handles;
+            for (size_t i = 0; i < ResourceCount; i += 2)
+                Factory<BenchmarkResource>::Destroy(handles[i]);
+
+            size_t validCount = 0;
+            double checkTime = MeasureBest(RunCount, [&staleHandles, &validCount]()
+            {
+                validCount = 0;
+                for (size_t repeat = 0; repeat < CheckRepeatCount; repeat++)
+                {
+                    for (const auto& handle : staleHandles)
+                        validCount += (size_t)handle.IsValid();
+                }
+            });
+            BenchmarkSink += validCount;
+            this->Report("IsValid() cost", checkTime * 1000000.0 / double(ResourceCount * CheckRepeatCount), "ns/check");
+            this->Check(validCount == ResourceCount / 2 * CheckRepeatCount, "only handles of alive resources are valid");
+
+            // slots of destroyed resources are reused, but stale handles to them must stay invalid
+            MxVector<ResourceHandle> reused;
+            for (size_t i = 0; i < ResourceCount / 2; i++)
+                reused.push_back(Factory<BenchmarkResource>::Create(i));
+
+            bool staleInvalid = true;
+            for (size_t i = 0; i < ResourceCount; i += 2)
+                staleInvalid &= !staleHandles[i].IsValid();
+            this->Check(staleInvalid, "stale handles to reused slots are invalid");
+
+            reused.clear();
+            staleHandles.clear();
+            handles.clear();
+            return true;
+        }
+
+        virtual void OnFinish() override
+        {
+            Factory<BenchmarkResource>::Destroy();
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(ResourceHandleBenchmark, "resource-handles");
+}
@@ -0,0 +1,110 @@
+#include "Benchmark.h"
+#include "Core/Resources/AsyncAssetLoader.h"
+#include "Utilities/Concurrency/ThreadPool.h"
+#include "Utilities/Image/ImageConverter.h"
+
+#include <fstream>
+
+namespace Benchmarks
+{
+    /*
+    streams textures with AssetManager::LoadTextureAsync and measures frame times while they are decoded and uploaded
+    decoding is done by background tasks of thread pool, so threads which wait for their own work (like main thread) must never execute it
+    */
+    class TextureStreamingBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t TextureCount = 500;
+        constexpr static int TextureSize = 256;
+        constexpr static double TimeoutMilliseconds = 120000.0;
+        // covers clock reads and queue pops which are not part of any single upload
+        constexpr static double UploadOverheadMilliseconds = 0.25;
+
+        FilePath directory;
+        MxVector<TextureHandle> textures;
+        size_t loadedCount = 0;
+        size_t stolenTaskCount = 0;
+        size_t frameCount = 0;
+        double maxFrameTime = 0.0;
+        double maxUploadTime = 0.0;
+        size_t overBudgetFrameCount = 0;
+        BenchmarkTimer streamTimer;
+        BenchmarkTimer frameTimer;
+
+        void GenerateTextures()
+        {
+            MxVector<uint8_t> pixels(TextureSize * TextureSize * 4);
+            for (size_t i = 0; i < TextureCount; i++)
+            {
+                // pseudo-random content, so decoding cost is close to real textures
+                uint32_t state = uint32_t(i * 2654435761u + 1);
+                for (auto& pixel : pixels)
+                {
+                    state = state * 1664525u + 1013904223u;
+                    pixel = uint8_t(state >> 24);
+                }
+                auto png = ImageConverter::ConvertImagePNG(pixels.data(), TextureSize, TextureSize, 4);
+                std::ofstream file(this->directory / MxFormat("texture_{}.png", i).c_str(), std::ios::binary);
+                file.write((const char*)png.data(), png.size());
+            }
+        }
+    public:
+        virtual void OnStart() override
+        {
+            this->directory = std::filesystem::temp_directory_path() / "MxEngineBenchmarks" / "TextureStreaming";
+            std::filesystem::create_directories(this->directory);
+            this->GenerateTextures();
+
+            this->streamTimer.Reset();
+            for (size_t i = 0; i < TextureCount; i++)
+            {
+                auto path = this->directory / MxFormat("texture_{}.png", i).c_str();
+                this->textures.push_back(AssetManager::LoadTextureAsync(path, TextureFormat::RGBA, [this](const TextureHandle&) { this->loadedCount++; }));
+            }
+            this->Report("requests", double(TextureCount), "textures");
+            this->Report("upload time budget", double(AsyncAssetLoader::GetUploadTimeBudget()), "ms/frame");
+            this->frameTimer.Reset();
+        }
+
+        virtual bool OnFrame() override
+        {
+            double frameTime = this->frameTimer.GetMilliseconds();
+            this->frameTimer.Reset();
+            this->maxFrameTime = std::max(this->maxFrameTime, frameTime);
+            this->frameCount++;
+
+            // uploads of this frame are already processed by application before suite is updated
+            double uploadTime = AsyncAssetLoader::GetLastUploadTime();
+            double uploadLimit = AsyncAssetLoader::GetUploadTimeBudget() + AsyncAssetLoader::GetLastLongestUploadTime() + UploadOverheadMilliseconds;
+            this->maxUploadTime = std::max(this->maxUploadTime, uploadTime);
+            if (uploadTime > uploadLimit) this->overBudgetFrameCount++;
+
+            // nothing else is running at this point, so any task main thread can pick up here would be a decoding task
+            while (AsyncAssetLoader::GetPendingCount() > 0 && ThreadPool::GetGlobal().TryExecutePending())
+                this->stolenTaskCount++;
+
+            bool isFinished = AsyncAssetLoader::GetPendingCount() == 0;
+            bool isTimedOut = this->streamTimer.GetMilliseconds() > TimeoutMilliseconds;
+            if (!isFinished && !isTimedOut) return false;
+
+            double totalTime = this->streamTimer.GetMilliseconds();
+            this->Report("total streaming time", totalTime, "ms");
+            this->Report("frames", double(this->frameCount), "frames");
+            this->Report("average frame time", totalTime / double(this->frameCount), "ms");
+            this->Report("worst frame time", this->maxFrameTime, "ms");
+            this->Report("worst upload time", this->maxUploadTime, "ms/frame");
+            this->Check(this->loadedCount == TextureCount, "all textures are uploaded");
+            this->Check(this->stolenTaskCount == 0, "main thread never executes decoding tasks");
+            this->Check(this->overBudgetFrameCount == 0, "uploads stay within time budget plus one upload");
+            return true;
+        }
+
+        virtual void OnFinish() override
+        {
+            this->textures.clear();
+            std::error_code error;
+            std::filesystem::remove_all(this->directory, error);
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(TextureStreamingBenchmark, "texture-streaming");
+}
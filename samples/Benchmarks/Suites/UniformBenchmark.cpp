@@ -0,0 +1,82 @@
+#include "Benchmark.h"
+#include "Core/Rendering/RenderAdaptor.h"
+
+namespace Benchmarks
+{
+    /*
+    compares setting uniforms by name with setting them by precomputed UniformId
+    engine GBuffer shader is used, and the same uniforms which renderer sets for each drawn object and material are set
+    lookup is measured separately, as uniform calls themselves are the same for both paths
+    */
+    class UniformBenchmark : public BenchmarkSuite
+    {
+        constexpr static size_t RunCount = 10;
+        constexpr static size_t SetCount = 100000;
+        constexpr static size_t UniformsPerSet = 8;
+    public:
+        virtual bool OnFrame() override
+        {
+            auto& shader = *Rendering::GetAdaptor().Renderer.GetEnvironment().Shaders["GBuffer"_id];
+            shader.Bind();
+
+            Matrix4x4 model = Matrix4x4(1.0f);
+            Matrix3x3 normal = Matrix3x3(1.0f);
+            Vector3 color = MakeVector3(1.0f);
+            Vector2 uv = MakeVector2(1.0f);
+
+            double nameTime = MeasureBest(RunCount, [&]()
+            {
+                for (size_t i = 0; i < SetCount; i++)
+                {
+                    shader.SetUniform("parentModel", model);
+                    shader.SetUniform("parentNormal", normal);
+                    shader.SetUniform("parentColor", color);
+                    shader.SetUniform("uvMultipliers", uv);
+                    shader.SetUniform("displacement", 0.0f);
+                    shader.SetUniform("material.roughness", 0.5f);
+                    shader.SetUniform("material.metallic", 0.5f);
+                    shader.SetUniform("material.transparency", 1.0f);
+                }
+            });
+            double idTime = MeasureBest(RunCount, [&]()
+            {
+                for (size_t i = 0; i < SetCount; i++)
+                {
+                    shader.SetUniform(UNIFORM_ID("parentModel"), model);
+                    shader.SetUniform(UNIFORM_ID("parentNormal"), normal);
+                    shader.SetUniform(UNIFORM_ID("parentColor"), color);
+                    shader.SetUniform(UNIFORM_ID("uvMultipliers"), uv);
+                    shader.SetUniform(UNIFORM_ID("displacement"), 0.0f);
+                    shader.SetUniform(UNIFORM_ID("material.roughness"), 0.5f);
+                    shader.SetUniform(UNIFORM_ID("material.metallic"), 0.5f);
+                    shader.SetUniform(UNIFORM_ID("material.transparency"), 1.0f);
+                }
+            });
+
+            this->Report("set by name", double(SetCount * UniformsPerSet) / nameTime, "uniforms/ms");
+            this->Report("set by id", double(SetCount * UniformsPerSet) / idTime, "uniforms/ms");
+            this->Report("set speedup", nameTime / idTime, "x");
+
+            size_t nameLocations = 0, idLocations = 0;
+            double nameLookupTime = MeasureBest(RunCount, [&]()
+            {
+                for (size_t i = 0; i < SetCount; i++)
+                    nameLocations += (size_t)shader.GetUniformLocation("material.roughness");
+            });
+            double idLookupTime = MeasureBest(RunCount, [&]()
+            {
+                for (size_t i = 0; i < SetCount; i++)
+                    idLocations += (size_t)shader.GetUniformLocation(UNIFORM_ID("material.roughness"));
+            });
+            BenchmarkSink = nameLocations + idLocations;
+
+            this->Report("lookup by name", double(SetCount) / nameLookupTime, "lookups/ms");
+            this->Report("lookup by id", double(SetCount) / idLookupTime, "lookups/ms");
+            this->Check(nameLocations == idLocations, "name and id lookups find the same location");
+            this->Check(shader.GetUniformLocation(UNIFORM_ID("material.roughness")) != ShaderBase::UniformCache::InvalidLocation, "uniform id is found in location table");
+            return true;
+        }
+    };
+
+    REGISTER_BENCHMARK_SUITE(UniformBenchmark, "uniforms");
+}
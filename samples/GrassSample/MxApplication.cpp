@@ -24,7 +24,7 @@ namespace GrassSample
             grass->Name = "Grass Factory";
 
             auto source = grass->AddComponent<MeshSource>(Primitives::CreatePlane2Side());
-            source->CastsShadow = false;
+            source->SetCastsShadow(false);
 
             auto material = grass->AddComponent<MeshRenderer>()->GetMaterial();
             material->AlbedoMap = AssetManager::LoadTexture("Resources/grass_al.png"_id, TextureFormat::RGBA);
@@ -55,7 +55,7 @@ namespace GrassSample
             this->lights = MxObject::Create();
             this->lights->Name = "Light Instances";
             auto source = this->lights->AddComponent<MeshSource>(Primitives::CreateCube());
-            source->CastsShadow = false;
+            source->SetCastsShadow(false);
             auto material = this->lights->AddComponent<MeshRenderer>()->GetMaterial();
             material->Emission = 200.0f;
             auto lightFactory = this->lights->AddComponent<InstanceFactory>();
@@ -156,6 +156,10 @@ namespace MxEngine
     void Application::DrawObjects()
     {
         MAKE_SCOPE_PROFILER("Application::DrawObjects");
+
+        // propagate transforms changed by physics, components and update callbacks, so renderer uses fresh world matrices
+        TransformHierarchy::Update();
+
         this->GetRenderAdaptor().SetWindowSize({ this->GetWindow().GetWidth(), this->GetWindow().GetHeight() });
         this->GetRenderAdaptor().RenderFrame();
 
@@ -169,10 +173,7 @@ namespace MxEngine
 
     void Application::UpdateComponents()
     {
-        for (const auto& callback : this->updateCallbacks)
-        {
-            callback(this->timeDelta);
-        }
+        this->componentScheduler.Update(this->timeDelta);
     }
 
     void Application::InvokeUpdate()
@@ -183,6 +184,9 @@ namespace MxEngine
             this->GetWindow().OnUpdate();
         }
 
+        // upload assets decoded by worker threads. Done even if application is paused, so loading screens keep streaming
+        AsyncAssetLoader::ProcessUploads();
+
         // do not invoke any events of perform physics if application is paused
         if (!this->IsPaused)
         {
@@ -270,8 +274,8 @@ namespace MxEngine
             previousCollisionEntry++;
         }
 
-        std::swap(currentCollisions, previousCollisions);
-        currentCollisions.clear();
+        previousCollisions.assign(std::make_move_iterator(currentCollisions.begin()), std::make_move_iterator(currentCollisions.end()));
+        currentCollisions = FrameCollisionList();
     }
 
     void Application::InvokeCreate()
@@ -370,7 +374,16 @@ namespace MxEngine
 
             while (this->GetWindow().IsOpen()) //-V807
             {
+                // previous frame scopes are already destroyed here, including Application::Frame()
+                FrameStatistics::EndFrame();
                 MAKE_SCOPE_PROFILER("Application::Frame()");
+                // memory allocated two frames ago is reused, previous frame data stays valid
+                FrameArena::GetGlobal().NextFrame();
+                {
+                    // no components are iterated between frames, so they can be safely relocated here
+                    MAKE_SCOPE_PROFILER("ComponentFactory::CompactPools()");
+                    ComponentFactory::CompactPools();
+                }
                 this->UpdateTimeDelta(frameEnd, secondEnd, frameCount);
                 this->InvokeUpdate();
                 this->DrawObjects();
@@ -428,14 +441,20 @@ namespace MxEngine
 
     Application::ModuleManager::~ModuleManager()
     {
+        // worker threads may still decode assets, so they are joined before pending resources are released
+        ThreadPool::Destroy();
+        AsyncAssetLoader::Destroy();
         PhysicsModule::Destroy();
         GraphicModule::Destroy();
         Factory<AudioBuffer>::Destroy(); // OpenAL is angry when buffers are not deleted
         AudioModule::Destroy();
+        FrameArena::Destroy();
 
         #if defined(MXENGINE_PROFILING_ENABLED)
         Profiler::Finish();
+        FrameStatistics::DumpCSV("frame_statistics.csv");
         #endif
+        FrameStatistics::Destroy();
     }
 
     void Application::InitializeRenderAdaptor(RenderAdaptor& adaptor)
@@ -506,7 +525,7 @@ namespace MxEngine
                 this->counterFPS = framesPerSecond;
                 lastSecondEnd = currentTime;
                 framesPerSecond = 0;
-                Event::AddEvent(MakeUnique<FpsUpdateEvent>(this->counterFPS));
+                Event::AddEvent<FpsUpdateEvent>(this->counterFPS);
             }
 
             this->timeDelta = this->TimeScale * (currentTime - lastFrameEnd);
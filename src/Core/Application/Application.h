@@ -36,8 +36,8 @@
 #include "Core/Config/Config.h"
 #include "Utilities/Profiler/Profiler.h"
 #include "Platform/Window/Window.h"
-
-GENERATE_METHOD_CHECK(OnUpdate, OnUpdate(float()));
+#include "Core/Application/ComponentUpdateScheduler.h"
+#include "Utilities/Memory/FrameArena.h"
 
 namespace MxEngine
 {
@@ -51,17 +51,19 @@ namespace MxEngine
             ~ModuleManager();
         } manager;
 
-        using UpdateCallbackList = MxVector<void(*)(TimeStep)>;
-        using CollisionList = MxVector<std::pair<MxObject::Handle, MxObject::Handle>>;
-        using CollisionSwapPair = std::pair<CollisionList, CollisionList>;
+        using CollisionEntry = std::pair<MxObject::Handle, MxObject::Handle>;
+        using CollisionList = MxVector<CollisionEntry>;
+        // current collisions live for one physics update, previous ones are kept until next update, which is skipped while paused
+        using FrameCollisionList = FrameVector<CollisionEntry>;
+        using CollisionListPair = std::pair<FrameCollisionList, CollisionList>;
     private:
         static inline Application* Current = nullptr;
         UniqueRef<Window> window;
         RenderAdaptor renderAdaptor;
         EventDispatcherImpl<EventBase>* dispatcher;
         RuntimeEditor* editor;
-        UpdateCallbackList updateCallbacks;
-        CollisionSwapPair collisions;
+        ComponentUpdateScheduler componentScheduler;
+        CollisionListPair collisions;
         Config config;
         TimeStep timeDelta = 0.0f;
         size_t counterFPS = 0;
@@ -95,7 +97,7 @@ namespace MxEngine
         float TimeScale = 1.0f;
 
         template<typename T>
-        void RegisterComponentUpdate();
+        void RegisterComponentUpdate(const ComponentUpdateInfo& info = ComponentUpdateTraits<T>::Info);
 
         void ToggleRuntimeEditor(bool isVisible);
         void ToggleWindowUpdates(bool isPolled);
@@ -123,20 +125,9 @@ namespace MxEngine
     };
     
     template<typename T>
-    inline void Application::RegisterComponentUpdate()
+    inline void Application::RegisterComponentUpdate(const ComponentUpdateInfo& info)
     {
-        if constexpr (has_method_OnUpdate<T>::value)
-        {
-            this->updateCallbacks.push_back([](TimeStep dt)
-            {
-                MAKE_SCOPE_PROFILER(typeid(T).name());
-                auto view = ComponentFactory::GetView<T>();
-                for (auto& component : view)
-                {
-                    component.OnUpdate(dt);
-                }
-            });
-        }
+        this->componentScheduler.Register<T>(info);
     }
 
     #if defined(MXENGINE_PROJECT_SOURCE_DIRECTORY) && defined(MXENGINE_PROJECT_BINARY_DIRECTORY)
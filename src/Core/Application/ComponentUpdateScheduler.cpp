@@ -0,0 +1,109 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "ComponentUpdateScheduler.h"
+#include "Utilities/Memory/FrameArena.h"
+
+namespace MxEngine
+{
+    void ComponentUpdateScheduler::BuildStages()
+    {
+        this->stages.clear();
+
+        // each entry is placed into the stage after the last stage containing conflicting entry, which preserves registration order between them
+        FrameVector<size_t> entryStages(this->entries.size());
+        for (size_t i = 0; i < this->entries.size(); i++)
+        {
+            size_t stage = 0;
+            for (size_t j = 0; j < i; j++)
+            {
+                if (this->entries[i].Info.ConflictsWith(this->entries[j].Info))
+                    stage = std::max(stage, entryStages[j] + 1);
+            }
+            entryStages[i] = stage;
+
+            if (stage == this->stages.size()) this->stages.emplace_back();
+            this->stages[stage].push_back(i);
+        }
+        this->isGraphDirty = false;
+    }
+
+    void ComponentUpdateScheduler::InvokeUpdate(const UpdateEntry& entry, TimeStep dt)
+    {
+        entry.Update(dt, entry.Info.IsThreadSafe, entry.Name);
+    }
+
+    void ComponentUpdateScheduler::UpdateStage(const MxVector<size_t>& stage, TimeStep dt)
+    {
+        auto& threadPool = ThreadPool::GetGlobal();
+        if (stage.size() == 1 || threadPool.GetThreadCount() == 0)
+        {
+            for (size_t index : stage)
+                this->InvokeUpdate(this->entries[index], dt);
+            return;
+        }
+
+        FrameVector<const UpdateEntry*> workerEntries;
+        for (size_t index : stage)
+        {
+            const auto& entry = this->entries[index];
+            if (!entry.Info.RequiresMainThread) workerEntries.push_back(&entry);
+        }
+
+        // main thread updates entries bound to it while workers start on the rest, then helps with remaining worker entries
+        threadPool.ParallelFor(workerEntries.size(), [this, &workerEntries, dt](size_t entry)
+        {
+            this->InvokeUpdate(*workerEntries[entry], dt);
+        }, 0, [this, &stage, dt]()
+        {
+            for (size_t index : stage)
+            {
+                const auto& entry = this->entries[index];
+                if (entry.Info.RequiresMainThread)
+                    this->InvokeUpdate(entry, dt);
+            }
+        });
+    }
+
+    void ComponentUpdateScheduler::Update(TimeStep dt)
+    {
+        if (this->isGraphDirty) this->BuildStages();
+
+        for (const auto& stage : this->stages)
+        {
+            this->UpdateStage(stage, dt);
+        }
+    }
+
+    size_t ComponentUpdateScheduler::GetStageCount()
+    {
+        if (this->isGraphDirty) this->BuildStages();
+        return this->stages.size();
+    }
+}
@@ -0,0 +1,140 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include "Utilities/ECS/ComponentFactory.h"
+#include "Utilities/ECS/ComponentUpdateInfo.h"
+#include "Utilities/Concurrency/ThreadPool.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Time/Time.h"
+
+#include <rttr/type.h>
+
+GENERATE_METHOD_CHECK(OnUpdate, OnUpdate(float()));
+
+namespace MxEngine
+{
+    /*!
+    component update scheduler calls OnUpdate() of all registered component types each frame
+    component types are grouped into stages using their ComponentUpdateInfo. Types in one stage do not conflict with each other and are updated concurrently,
+    while stages are executed in order, so conflicting types are still updated in the order of their registration
+    */
+    class ComponentUpdateScheduler
+    {
+        using UpdateFunction = void(*)(TimeStep, bool, const char*);
+
+        struct UpdateEntry
+        {
+            /*!
+            reflected name of component type, used as profiler scope name of its updates
+            */
+            const char* Name;
+            ComponentUpdateInfo Info;
+            UpdateFunction Update;
+        };
+
+        MxVector<UpdateEntry> entries;
+        /*!
+        indices of entries which are updated concurrently. Rebuilt when new component type is registered
+        */
+        MxVector<MxVector<size_t>> stages;
+        bool isGraphDirty = true;
+
+        void BuildStages();
+        void UpdateStage(const MxVector<size_t>& stage, TimeStep dt);
+        void InvokeUpdate(const UpdateEntry& entry, TimeStep dt);
+
+        template<typename T>
+        static void UpdateComponents(TimeStep dt, bool isParallel, const char* name);
+    public:
+        /*!
+        number of components processed by one task when thread-safe component type is updated in parallel
+        */
+        constexpr static size_t ParallelChunkSize = 256;
+
+        /*!
+        registers component type for updates. Does nothing if component has no OnUpdate() method
+        \param info state accessed by component update. Taken from ComponentUpdateTraits if not specified
+        */
+        template<typename T>
+        void Register(const ComponentUpdateInfo& info = ComponentUpdateTraits<T>::Info);
+
+        /*!
+        updates all registered component types. Blocks until all updates are finished
+        \param dt time delta passed to OnUpdate() method
+        */
+        void Update(TimeStep dt);
+
+        /*!
+        gets number of sequential stages which component types are grouped into
+        */
+        size_t GetStageCount();
+    };
+
+    template<typename T>
+    inline void ComponentUpdateScheduler::UpdateComponents(TimeStep dt, bool isParallel, const char* name)
+    {
+        MAKE_SCOPE_PROFILER(name);
+        auto& pool = ComponentFactory::GetPool<T>();
+        if (isParallel && pool.Allocated() > ParallelChunkSize)
+        {
+            size_t chunkCount = ThreadPool::GetChunkCount(pool.DenseSize(), ParallelChunkSize);
+            ThreadPool::GetGlobal().ParallelFor(chunkCount, [&pool, dt](size_t chunk)
+            {
+                size_t end = std::min(pool.DenseSize(), (chunk + 1) * ParallelChunkSize);
+                for (size_t i = chunk * ParallelChunkSize; i < end; i++)
+                {
+                    auto resource = pool.GetDenseOrNull(i);
+                    if (resource != nullptr) resource->value.OnUpdate(dt);
+                }
+            });
+        }
+        else
+        {
+            auto view = ComponentView<T, ComponentPool<T>>{ pool };
+            for (auto& component : view)
+            {
+                component.OnUpdate(dt);
+            }
+        }
+    }
+
+    template<typename T>
+    inline void ComponentUpdateScheduler::Register(const ComponentUpdateInfo& info)
+    {
+        if constexpr (has_method_OnUpdate<T>::value)
+        {
+            // pool is created here, as component pools must not be created concurrently by update tasks
+            (void)ComponentFactory::GetPool<T>();
+            this->entries.push_back(UpdateEntry{ rttr::type::get<T>().get_name().cbegin(), info, ComponentUpdateScheduler::UpdateComponents<T> });
+            this->isGraphDirty = true;
+        }
+    }
+}
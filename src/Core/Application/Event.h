@@ -41,11 +41,12 @@ namespace MxEngine
         Note that multiple listeners may have same name. If so, deleting by name will result in removing all of them
         \param name name of listener (used for deleting listener)
         \param func listener callback functor
+        \returns handle which can be used to remove listener
         */
         template<typename EventType>
-        static void AddEventListener(const MxString& name, std::function<void(EventType&)> func)
+        static EventListenerHandle AddEventListener(const MxString& name, std::function<void(EventType&)> func)
         {
-            Application::GetImpl()->GetEventDispatcher().AddEventListener(name, std::move(func));
+            return Application::GetImpl()->GetEventDispatcher().AddEventListener(name, std::move(func));
         }
 
         /*!
@@ -53,11 +54,32 @@ namespace MxEngine
         Note that multiple listeners may have same name. If so, deleting by name will result in removing all of them
         \param name name of listener (used for deleting listener)
         \param func listener callback functor (should be with signature `void callback(EventType& e)`
+        \returns handle which can be used to remove listener
         */
         template<typename T, typename FunctionType>
-        static void AddEventListener(const MxString& name, FunctionType&& func)
+        static EventListenerHandle AddEventListener(const MxString& name, FunctionType&& func)
         {
-            Application::GetImpl()->GetEventDispatcher().AddEventListener<T>(name, std::forward<FunctionType>(func));
+            return Application::GetImpl()->GetEventDispatcher().AddEventListener<T>(name, std::forward<FunctionType>(func));
+        }
+
+        /*!
+        adds new unnamed event listener to dispatcher (listener is placed in waiting queue until next frame).
+        \param func listener callback functor (should be with signature `void callback(EventType& e)`
+        \returns handle which can be used to remove listener
+        */
+        template<typename T, typename FunctionType>
+        static EventListenerHandle AddEventListener(FunctionType&& func)
+        {
+            return Application::GetImpl()->GetEventDispatcher().AddEventListener<T>(MxFunction<void(T&)>{ std::forward<FunctionType>(func) });
+        }
+
+        /*!
+        removes event listener by its handle. Listener is not invoked after this call
+        \param handle handle returned by AddEventListener()
+        */
+        static void RemoveEventListener(EventListenerHandle handle)
+        {
+            Application::GetImpl()->GetEventDispatcher().RemoveEventListener(handle);
         }
 
         /*!
@@ -80,7 +102,7 @@ namespace MxEngine
         }
 
         /*!
-        Adds event to event queue. All such events will be dispatched in next frames in the order they were added
+        Adds event to event queue. All such events will be dispatched in next frames in the order they were added. Must be called from main thread
         \param event event to shedule dispatch
         */
         static void AddEvent(UniqueRef<EventBase> event)
@@ -88,6 +110,46 @@ namespace MxEngine
             Application::GetImpl()->GetEventDispatcher().AddEvent(std::move(event));
         }
 
+        /*!
+        Adds event to event queue. Event is constructed inside dispatcher storage, so no allocation is performed
+        \param args arguments passed to event constructor
+        */
+        template<typename EventType, typename... Args>
+        static void AddEvent(Args&&... args)
+        {
+            Application::GetImpl()->GetEventDispatcher().AddEvent<EventType>(std::forward<Args>(args)...);
+        }
+
+        /*!
+        Adds event to thread-safe event queue. Unlike AddEvent(), can be called from any thread (asset loaders, physics callbacks and etc.)
+        Event will be dispatched on main thread during next InvokeAll() call
+        \param event event to shedule dispatch
+        */
+        static void PostEvent(UniqueRef<EventBase> event)
+        {
+            Application::GetImpl()->GetEventDispatcher().PostEvent(std::move(event));
+        }
+
+        /*!
+        Constructs event and adds it to thread-safe event queue. Can be called from any thread
+        \param args arguments passed to event constructor
+        */
+        template<typename EventType, typename... Args>
+        static void PostEvent(Args&&... args)
+        {
+            Application::GetImpl()->GetEventDispatcher().PostEvent<EventType>(std::forward<Args>(args)...);
+        }
+
+        /*!
+        sets limits of posted events processing per frame. Events which do not fit into limits are dispatched in the next frames
+        \param timeLimit maximum time in milliseconds spent on draining posted events
+        \param countLimit maximum number of posted events drained
+        */
+        static void SetPostedEventsLimit(float timeLimit, size_t countLimit)
+        {
+            Application::GetImpl()->GetEventDispatcher().SetPostedEventsLimit(timeLimit, countLimit);
+        }
+
         /*!
         Invokes all shedules events in the order they were added. Note that invoke also forces queues to be invalidated
         */
@@ -105,5 +167,15 @@ namespace MxEngine
         {
             return Application::GetImpl()->GetEventDispatcher().HasEventListenerWithName(name);
         }
+
+        /*!
+        Checks if event listener is present
+        \param handle handle of event listener
+        \returns true if event listener present, false otherwise
+        */
+        static bool HasEventListener(EventListenerHandle handle)
+        {
+            return Application::GetImpl()->GetEventDispatcher().HasEventListener(handle);
+        }
     };
 }
\ No newline at end of file
@@ -32,10 +32,14 @@
 #include "Core/Application/Application.h"
 #include "Core/MxObject/MxObject.h"
 #include "Core/Resources/AssetManager.h"
+#include "Core/Resources/AsyncAssetLoader.h"
 #include "Core/Resources/BufferAllocator.h"
 #include "Core/Runtime/RuntimeCompiler.h"
 #include "Core/Serialization/SceneSerializer.h"
 #include "Utilities/FileSystem/FileManager.h"
+#include "Utilities/Concurrency/ThreadPool.h"
+#include "Utilities/Memory/FrameArena.h"
+#include "Utilities/Profiler/FrameStatistics.h"
 #include "Platform/Modules/PhysicsModule.h"
 #include "Platform/Modules/GraphicModule.h"
 #include "Platform/Modules/AudioModule.h"
@@ -46,11 +50,15 @@ namespace MxEngine
     using GlobalContextSerializer = StaticSerializer<
         Application,
         Logger,
+        FrameStatistics,
         FileManager,
         AudioModule,
         GraphicModule,
         PhysicsModule,
         UUIDGenerator,
+        ThreadPool,
+        FrameArena,
+        AsyncAssetLoader,
         Factory<CubeMap>,
         Factory<FrameBuffer>,
         Factory<IndexBuffer>,
@@ -60,6 +68,8 @@ namespace MxEngine
         Factory<VertexArray>,
         Factory<VertexBuffer>,
         Factory<ShaderStorageBuffer>,
+        Factory<DrawIndirectBuffer>,
+        Factory<UniformBuffer>,
         Factory<ComputeShader>,
         ComponentFactory,
         Factory<Material>,
@@ -72,6 +82,8 @@ namespace MxEngine
         Factory<CapsuleShape>,
         Factory<CompoundShape>,
         Factory<NativeRigidBody>,
+        ObjectNameRegistry,
+        TransformHierarchy,
         Factory<MxObject>,
         RuntimeCompiler,
         SceneSerializer,
@@ -103,6 +103,26 @@ namespace MxEngine
         return FWD(IsRenderedToDefaultFrameBuffer);
     }
 
+    void Rendering::SetSubmitThreadCount(size_t threadCount)
+    {
+        FWD(SetSubmitThreadCount, threadCount);
+    }
+
+    size_t Rendering::GetSubmitThreadCount()
+    {
+        return FWD(GetSubmitThreadCount);
+    }
+
+    void Rendering::SetIndirectDrawing(bool value)
+    {
+        FWD(SetIndirectDrawing, value);
+    }
+
+    bool Rendering::IsIndirectDrawingEnabled()
+    {
+        return FWD(IsIndirectDrawingEnabled);
+    }
+
     #define DRW Application::GetImpl()->GetRenderAdaptor().DebugDrawer
 
     void Rendering::Draw(const Line& line, const Vector4& color)
@@ -53,6 +53,10 @@ namespace MxEngine
         static void SetDebugOverlay(bool value = true);
         static void SetRenderToDefaultFrameBuffer(bool value = true);
         static bool IsRenderedToDefaultFrameBuffer();
+        static void SetSubmitThreadCount(size_t threadCount = 0);
+        static size_t GetSubmitThreadCount();
+        static void SetIndirectDrawing(bool value = true);
+        static bool IsIndirectDrawingEnabled();
         static void Draw(const Line& line, const Vector4& color);
         static void Draw(const AABB& box, const Vector4& color);
         static void Draw(const BoundingBox& box, const Vector4& color);
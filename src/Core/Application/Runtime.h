@@ -41,11 +41,21 @@ namespace MxEngine
     public:
         template<typename T>
         static void RegisterComponent()
+        {
+            Runtime::RegisterComponent<T>(ComponentUpdateTraits<T>::Info);
+        }
+
+        /*!
+        registers component type in engine systems
+        \param updateInfo state accessed by component OnUpdate() method, overrides info provided by component type itself
+        */
+        template<typename T>
+        static void RegisterComponent(const ComponentUpdateInfo& updateInfo)
         {
             SceneSerializer::RegisterComponent<T>();
             SceneSerializer::RegisterComponentAsCloneable<T>();
             Application::GetImpl()->GetRuntimeEditor().RegisterComponentEditor<T>();
-            Application::GetImpl()->RegisterComponentUpdate<T>();
+            Application::GetImpl()->RegisterComponentUpdate<T>(updateInfo);
         }
 
         template<typename EventType, typename Func>
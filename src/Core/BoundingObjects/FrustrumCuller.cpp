@@ -0,0 +1,172 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "FrustrumCuller.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MXENGINE_CULLER_SSE
+#endif
+
+#if defined(MXENGINE_CULLER_AVX)
+#include "FrustrumCullerAVX.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace MxEngine
+{
+    void FrustrumCuller::CullAABBs(const AABBArray& boxes, VisibilityMask& visibility) const
+    {
+        visibility.resize((boxes.Size() + 31) / 32);
+        this->CullAABBs(boxes, 0, boxes.Size(), visibility);
+    }
+
+    void FrustrumCuller::CullAABBs(const AABBArray& boxes, size_t begin, size_t end, VisibilityMask& visibility) const
+    {
+        MX_ASSERT(begin % 32 == 0 && end <= boxes.Size());
+        // box is outside of plane if its farthest point along plane normal is behind it:
+        // dot(n, center) + dot(abs(n), extent) + w < 0. This is the same test as for 8 corners in IsAABBVisible
+        std::fill(visibility.begin() + begin / 32, visibility.begin() + (end + 31) / 32, 0u);
+
+        const float* minX = boxes.MinX.data();
+        const float* minY = boxes.MinY.data();
+        const float* minZ = boxes.MinZ.data();
+        const float* maxX = boxes.MaxX.data();
+        const float* maxY = boxes.MaxY.data();
+        const float* maxZ = boxes.MaxZ.data();
+
+        size_t i = begin;
+
+        // AVX path is compiled in separate translation unit and used only if CPU supports it
+        #if defined(MXENGINE_CULLER_AVX)
+        if (FrustrumCuller::IsAVXSupported())
+        {
+            static_assert(sizeof(this->planes) == Planes::COUNT * 4 * sizeof(float), "planes must be tightly packed");
+            FrustrumCullerAVXInput input{ minX, minY, minZ, maxX, maxY, maxZ, &this->planes[0].x };
+            i = CullAABBsAVX(input, i, end, visibility.data());
+        }
+        #endif
+
+        // i is always multiple of 4, so bits of one SSE iteration never cross mask word boundary
+
+        #if defined(MXENGINE_CULLER_SSE)
+        {
+            const __m128 half = _mm_set1_ps(0.5f);
+            const __m128 zero = _mm_setzero_ps();
+            __m128 nx[Planes::COUNT], ny[Planes::COUNT], nz[Planes::COUNT], ax[Planes::COUNT], ay[Planes::COUNT], az[Planes::COUNT], w[Planes::COUNT];
+            for (size_t p = 0; p < Planes::COUNT; p++)
+            {
+                const auto& plane = this->planes[p];
+                nx[p] = _mm_set1_ps(plane.x); ax[p] = _mm_set1_ps(std::abs(plane.x));
+                ny[p] = _mm_set1_ps(plane.y); ay[p] = _mm_set1_ps(std::abs(plane.y));
+                nz[p] = _mm_set1_ps(plane.z); az[p] = _mm_set1_ps(std::abs(plane.z));
+                w[p] = _mm_set1_ps(plane.w);
+            }
+
+            for (; i + 4 <= end; i += 4)
+            {
+                __m128 x0 = _mm_loadu_ps(minX + i), x1 = _mm_loadu_ps(maxX + i);
+                __m128 y0 = _mm_loadu_ps(minY + i), y1 = _mm_loadu_ps(maxY + i);
+                __m128 z0 = _mm_loadu_ps(minZ + i), z1 = _mm_loadu_ps(maxZ + i);
+                __m128 cx = _mm_mul_ps(_mm_add_ps(x1, x0), half), ex = _mm_mul_ps(_mm_sub_ps(x1, x0), half);
+                __m128 cy = _mm_mul_ps(_mm_add_ps(y1, y0), half), ey = _mm_mul_ps(_mm_sub_ps(y1, y0), half);
+                __m128 cz = _mm_mul_ps(_mm_add_ps(z1, z0), half), ez = _mm_mul_ps(_mm_sub_ps(z1, z0), half);
+
+                __m128 outside = zero;
+                for (size_t p = 0; p < Planes::COUNT; p++)
+                {
+                    __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx), _mm_mul_ps(ny[p], cy)), _mm_add_ps(_mm_mul_ps(nz[p], cz), w[p]));
+                    __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex), _mm_mul_ps(ay[p], ey)), _mm_mul_ps(az[p], ez));
+                    outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+                }
+                uint32_t visibleBits = ~(uint32_t)_mm_movemask_ps(outside) & 0xFu;
+                visibility[i / 32] |= visibleBits << (i % 32);
+            }
+        }
+        #endif
+
+        // remaining boxes (or all of them if SIMD is not available)
+        this->CullAABBsTail(boxes, i, end, visibility);
+    }
+
+    void FrustrumCuller::CullAABBsScalar(const AABBArray& boxes, size_t begin, size_t end, VisibilityMask& visibility) const
+    {
+        MX_ASSERT(begin % 32 == 0 && end <= boxes.Size());
+        std::fill(visibility.begin() + begin / 32, visibility.begin() + (end + 31) / 32, 0u);
+        this->CullAABBsTail(boxes, begin, end, visibility);
+    }
+
+    void FrustrumCuller::CullAABBsTail(const AABBArray& boxes, size_t begin, size_t end, VisibilityMask& visibility) const
+    {
+        const float* minX = boxes.MinX.data();
+        const float* minY = boxes.MinY.data();
+        const float* minZ = boxes.MinZ.data();
+        const float* maxX = boxes.MaxX.data();
+        const float* maxY = boxes.MaxY.data();
+        const float* maxZ = boxes.MaxZ.data();
+
+        for (size_t i = begin; i < end; i++)
+        {
+            Vector3 center = 0.5f * Vector3(maxX[i] + minX[i], maxY[i] + minY[i], maxZ[i] + minZ[i]);
+            Vector3 extent = 0.5f * Vector3(maxX[i] - minX[i], maxY[i] - minY[i], maxZ[i] - minZ[i]);
+
+            bool isOutside = false;
+            for (const auto& plane : this->planes)
+            {
+                Vector3 normal = Vector3(plane);
+                Vector3 absNormal = Vector3(std::abs(plane.x), std::abs(plane.y), std::abs(plane.z));
+                isOutside |= Dot(normal, center) + Dot(absNormal, extent) + plane.w < 0.0f;
+            }
+            if (!isOutside) visibility[i / 32] |= 1u << (i % 32);
+        }
+    }
+
+    bool FrustrumCuller::IsAVXSupported()
+    {
+        #if defined(MXENGINE_CULLER_AVX)
+        static const bool isSupported = []()
+        {
+            #if defined(_MSC_VER)
+            // AVX requires both CPU support and OS saving of YMM registers on context switch
+            int info[4];
+            __cpuid(info, 1);
+            bool hasAVX = (info[2] & (1 << 28)) != 0;
+            bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+            return hasAVX && hasOSXSAVE && (_xgetbv(0) & 0x6) == 0x6;
+            #else
+            return __builtin_cpu_supports("avx") != 0;
+            #endif
+        }();
+        return isSupported;
+        #else
+        return false;
+        #endif
+    }
+}
@@ -29,10 +29,47 @@
 #pragma once
 
 #include "Utilities/Math/Math.h"
+#include "Utilities/STL/MxVector.h"
 #include <array>
 
 namespace MxEngine
 {
+    // axis-aligned boxes stored as structure of arrays for batch culling
+    struct AABBArray
+    {
+        MxVector<float> MinX, MinY, MinZ;
+        MxVector<float> MaxX, MaxY, MaxZ;
+
+        void Add(const Vector3& minp, const Vector3& maxp)
+        {
+            this->MinX.push_back(minp.x); this->MinY.push_back(minp.y); this->MinZ.push_back(minp.z);
+            this->MaxX.push_back(maxp.x); this->MaxY.push_back(maxp.y); this->MaxZ.push_back(maxp.z);
+        }
+
+        void Set(size_t index, const Vector3& minp, const Vector3& maxp)
+        {
+            this->MinX[index] = minp.x; this->MinY[index] = minp.y; this->MinZ[index] = minp.z;
+            this->MaxX[index] = maxp.x; this->MaxY[index] = maxp.y; this->MaxZ[index] = maxp.z;
+        }
+
+        void Clear()
+        {
+            this->MinX.clear(); this->MinY.clear(); this->MinZ.clear();
+            this->MaxX.clear(); this->MaxY.clear(); this->MaxZ.clear();
+        }
+
+        void Resize(size_t size)
+        {
+            this->MinX.resize(size); this->MinY.resize(size); this->MinZ.resize(size);
+            this->MaxX.resize(size); this->MaxY.resize(size); this->MaxZ.resize(size);
+        }
+
+        size_t Size() const { return this->MinX.size(); }
+    };
+
+    // one bit per box, bit is set if box is visible
+    using VisibilityMask = MxVector<uint32_t>;
+
     // thanks to https://gist.github.com/podgorskiy/e698d18879588ada9014768e3e82a644
     class FrustrumCuller
     {
@@ -45,7 +82,26 @@ namespace MxEngine
         // http://iquilezles.org/www/articles/frustumcorrect/frustumcorrect.htm
         bool IsAABBVisible(const Vector3& minp, const Vector3& maxp) const;
 
+        // tests all boxes against frustum planes using center-extent form, 4 (SSE) or 8 (AVX, if supported by CPU) boxes at a time
+        void CullAABBs(const AABBArray& boxes, VisibilityMask& visibility) const;
+
+        // tests boxes in range [begin, end). Mask must already be sized for all boxes, begin must be multiple of 32, so ranges never share mask word
+        void CullAABBs(const AABBArray& boxes, size_t begin, size_t end, VisibilityMask& visibility) const;
+
+        // same as CullAABBs, but without SIMD. Used as reference to validate and measure vectorized paths
+        void CullAABBsScalar(const AABBArray& boxes, size_t begin, size_t end, VisibilityMask& visibility) const;
+
+        // true if engine was built with MXENGINE_CULLER_AVX option and current CPU supports AVX
+        static bool IsAVXSupported();
+
+        static bool IsVisible(const VisibilityMask& visibility, size_t index)
+        {
+            return (visibility[index / 32] >> (index % 32)) & 1u;
+        }
+
     private:
+        void CullAABBsTail(const AABBArray& boxes, size_t begin, size_t end, VisibilityMask& visibility) const;
+
         enum Planes
         {
             LEFT = 0,
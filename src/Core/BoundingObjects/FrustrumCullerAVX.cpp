@@ -0,0 +1,77 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "FrustrumCullerAVX.h"
+
+// this file is compiled with AVX enabled (see MXENGINE_CULLER_AVX option), so it includes only intrinsics and does not use any inline code of other headers
+#include <immintrin.h>
+
+namespace MxEngine
+{
+    size_t CullAABBsAVX(const FrustrumCullerAVXInput& input, size_t begin, size_t end, uint32_t* visibility)
+    {
+        constexpr size_t PlaneCount = 6;
+
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        __m256 nx[PlaneCount], ny[PlaneCount], nz[PlaneCount], ax[PlaneCount], ay[PlaneCount], az[PlaneCount], w[PlaneCount];
+        for (size_t p = 0; p < PlaneCount; p++)
+        {
+            const float* plane = input.Planes + p * 4;
+            nx[p] = _mm256_set1_ps(plane[0]); ax[p] = _mm256_andnot_ps(signMask, nx[p]);
+            ny[p] = _mm256_set1_ps(plane[1]); ay[p] = _mm256_andnot_ps(signMask, ny[p]);
+            nz[p] = _mm256_set1_ps(plane[2]); az[p] = _mm256_andnot_ps(signMask, nz[p]);
+            w[p] = _mm256_set1_ps(plane[3]);
+        }
+
+        // begin is multiple of 32, so bits of one iteration never cross mask word boundary
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8)
+        {
+            __m256 x0 = _mm256_loadu_ps(input.MinX + i), x1 = _mm256_loadu_ps(input.MaxX + i);
+            __m256 y0 = _mm256_loadu_ps(input.MinY + i), y1 = _mm256_loadu_ps(input.MaxY + i);
+            __m256 z0 = _mm256_loadu_ps(input.MinZ + i), z1 = _mm256_loadu_ps(input.MaxZ + i);
+            __m256 cx = _mm256_mul_ps(_mm256_add_ps(x1, x0), half), ex = _mm256_mul_ps(_mm256_sub_ps(x1, x0), half);
+            __m256 cy = _mm256_mul_ps(_mm256_add_ps(y1, y0), half), ey = _mm256_mul_ps(_mm256_sub_ps(y1, y0), half);
+            __m256 cz = _mm256_mul_ps(_mm256_add_ps(z1, z0), half), ez = _mm256_mul_ps(_mm256_sub_ps(z1, z0), half);
+
+            __m256 outside = zero;
+            for (size_t p = 0; p < PlaneCount; p++)
+            {
+                __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx[p], cx), _mm256_mul_ps(ny[p], cy)), _mm256_add_ps(_mm256_mul_ps(nz[p], cz), w[p]));
+                __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax[p], ex), _mm256_mul_ps(ay[p], ey)), _mm256_mul_ps(az[p], ez));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_LT_OQ));
+            }
+            uint32_t visibleBits = ~(uint32_t)_mm256_movemask_ps(outside) & 0xFFu;
+            visibility[i / 32] |= visibleBits << (i % 32);
+        }
+        return i;
+    }
+}
@@ -0,0 +1,65 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+// this header is included by AVX translation unit, so it must not include any header with inline functions (glm, EASTL, STL algorithms),
+// otherwise their AVX-encoded copies may be chosen by linker for the whole engine
+#include <cstddef>
+#include <cstdint>
+
+namespace MxEngine
+{
+    /*!
+    boxes in structure of arrays layout and frustrum planes passed to AVX culling kernel
+    */
+    struct FrustrumCullerAVXInput
+    {
+        const float* MinX;
+        const float* MinY;
+        const float* MinZ;
+        const float* MaxX;
+        const float* MaxY;
+        const float* MaxZ;
+        /*!
+        6 planes, 4 floats each (normal and distance)
+        */
+        const float* Planes;
+    };
+
+    /*!
+    tests boxes in range [begin, end) 8 at a time and sets bits of visible ones in visibility. Must be called only if FrustrumCuller::IsAVXSupported() is true
+    \param input pointers to box bounds and frustrum planes
+    \param begin first box to test, must be multiple of 32
+    \param end index after last box to test
+    \param visibility visibility mask words, one bit per box
+    \returns index of first box which was not processed (rest of boxes is less than 8)
+    */
+    size_t CullAABBsAVX(const FrustrumCullerAVXInput& input, size_t begin, size_t end, uint32_t* visibility);
+}
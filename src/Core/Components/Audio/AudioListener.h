@@ -56,6 +56,7 @@ namespace MxEngine
     public:
         AudioListener() = default;
         void OnUpdate(float timeDelta);
+        constexpr static ComponentUpdateInfo UpdateInfo{ UpdateAccess::TRANSFORM | UpdateAccess::CAMERA, UpdateAccess::AUDIO, false, false };
 
         void SetPosition(const Vector3& position);
         void SetOrientation(const Vector3& direction, const Vector3& up);
@@ -54,6 +54,7 @@ namespace MxEngine
         bool isRelative = false;
     public:
         void OnUpdate(float timeDelta);
+        constexpr static ComponentUpdateInfo UpdateInfo{ UpdateAccess::TRANSFORM, UpdateAccess::AUDIO, true, false };
         void Init();
         AudioSource() = default;
         AudioSource(const AudioBufferHandle& buffer);
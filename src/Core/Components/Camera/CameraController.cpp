@@ -293,9 +293,9 @@ namespace MxEngine
         this->verticalAngle = verticalAngle;
     }
 
-    UUID CameraController::GetEventUUID() const
+    MxString CameraController::GetEventUUID() const
     {
-        return this->GetGBuffer().GetUUID();
+        return ToMxString(this->GetGBuffer().GetUUID());
     }
 
     const Vector3& CameraController::GetDirectionDenormalized() const
@@ -77,7 +77,7 @@ namespace MxEngine
 
         void SubmitMatrixProjectionChanges() const;
         void RecalculateRotationAngles();
-        UUID GetEventUUID() const;
+        MxString GetEventUUID() const;
 
         CameraType cameraType = CameraType::PERSPECTIVE;
         bool renderingEnabled = true;
@@ -38,7 +38,7 @@ namespace MxEngine
 {
     InputController::~InputController()
     {    
-        MxString uuid = MxObject::GetComponentUUID(*this);
+        MxString uuid = ToMxString(MxObject::GetComponentUUID(*this));
         Event::RemoveEventListener(uuid);
     }
 
@@ -56,7 +56,7 @@ namespace MxEngine
         this->bindMovement = true;
         MXLOG_DEBUG("MxEngine::InputController", "bound object movement: " + object->Name);
 
-        Event::AddEventListener<KeyEvent>(input.GetUUID(),
+        Event::AddEventListener<KeyEvent>(ToMxString(input.GetUUID()),
             [camera, input, object](auto& event) mutable
             {
                 auto vecForward = MakeVector3(0.0f, 0.0f, 1.0f);
@@ -168,7 +168,7 @@ namespace MxEngine
         }
 
         MXLOG_DEBUG("MxEngine::InputControl", "bound object rotation: " + object.Name);
-        MxString uuid = object.GetComponent<InputController>().GetUUID();
+        MxString uuid = ToMxString(object.GetComponent<InputController>().GetUUID());
 
         Event::AddEventListener<MouseMoveEvent>(uuid, [camera, input](auto& event) mutable
         {
@@ -45,6 +45,8 @@ namespace MxEngine
 
         void OnUpdate(float timeDelta);
 
+        constexpr static ComponentUpdateInfo UpdateInfo{ UpdateAccess::TRANSFORM | UpdateAccess::CAMERA, UpdateAccess::CAMERA | UpdateAccess::RENDERING, false, true };
+
         CameraController::Handle LeftEye;
         CameraController::Handle RightEye;
         float EyeDistance = 0.1f;
@@ -50,6 +50,8 @@ namespace MxEngine
     TEMPLATE_INSTANCIATE_RESOURCE(VertexArray        );
     TEMPLATE_INSTANCIATE_RESOURCE(VertexBuffer       );
     TEMPLATE_INSTANCIATE_RESOURCE(ShaderStorageBuffer);
+    TEMPLATE_INSTANCIATE_RESOURCE(DrawIndirectBuffer );
+    TEMPLATE_INSTANCIATE_RESOURCE(UniformBuffer      );
     TEMPLATE_INSTANCIATE_RESOURCE(ComputeShader      );
     TEMPLATE_INSTANCIATE_RESOURCE(Material           );
     TEMPLATE_INSTANCIATE_RESOURCE(Mesh               );
@@ -62,6 +62,9 @@ namespace MxEngine
     MxObject::Handle Instanciate(MxObject::Handle object);
     MxObject::Handle GetInstanceParent(const MxObject& object);
     MxObject::Handle GetInstanceParent(MxObject::Handle object);
+    /*!
+    gets world transform of object cached by TransformHierarchy. For instances it is composed from cached world transform of their instance factory
+    */
     Transform GetGlobalTransform(const MxObject& object);
     Transform GetGlobalTransform(MxObject::Handle object);
 }
\ No newline at end of file
@@ -1,8 +1,8 @@
 #include "InstanceFactory.h"
 #include "Core/Components/Rendering/MeshSource.h"
+#include "Core/Resources/BufferAllocator.h"
 #include "Utilities/Profiler/Profiler.h"
 #include "Core/Runtime/Reflection.h"
-#include "Core/Resources/BufferAllocator.h"
 
 namespace MxEngine
 {
@@ -18,19 +18,152 @@ namespace MxEngine
     void InstanceFactory::OnUpdate(float timeDelta)
     {
         this->RemoveDanglingHandles();
+        // data-only instances are tracked on modification, so they are updated even for static factories
         if (!this->IsStatic) 
-            this->SendInstancesToGPU();
+            this->UpdateInstanceCache();
     }
 
     void InstanceFactory::SubmitInstances()
     {
         this->RemoveDanglingHandles();
-        this->SendInstancesToGPU();
+        this->UpdateInstanceCache();
     }
 
     void InstanceFactory::DestroyInstances()
     {
         this->FreeInstancePool();
+        this->ClearDataInstances();
+    }
+
+    size_t InstanceFactory::AddDataInstance(const Transform& transform, const Vector3& color)
+    {
+        size_t index = this->dataInstanceCount;
+        auto& data = this->instances.emplace_back();
+        transform.GetMatrix(data.Model);
+        transform.GetNormalMatrix(data.Model, data.Normal);
+        data.Color = color;
+        this->dataInstanceCount++;
+
+        size_t offset = this->instances.size() - 1;
+        this->MarkDirty(offset, offset + 1);
+        return index;
+    }
+
+    void InstanceFactory::SetDataInstance(size_t index, const Transform& transform)
+    {
+        MX_ASSERT(index < this->dataInstanceCount);
+        size_t offset = this->objectInstanceCount + index;
+        auto& data = this->instances[offset];
+        transform.GetMatrix(data.Model);
+        transform.GetNormalMatrix(data.Model, data.Normal);
+        this->MarkDirty(offset, offset + 1);
+    }
+
+    void InstanceFactory::SetDataInstanceColor(size_t index, const Vector3& color)
+    {
+        MX_ASSERT(index < this->dataInstanceCount);
+        size_t offset = this->objectInstanceCount + index;
+        this->instances[offset].Color = color;
+        this->MarkDirty(offset, offset + 1);
+    }
+
+    const InstanceFactory::InstanceData& InstanceFactory::GetDataInstance(size_t index) const
+    {
+        MX_ASSERT(index < this->dataInstanceCount);
+        return this->instances[this->objectInstanceCount + index];
+    }
+
+    void InstanceFactory::RemoveDataInstance(size_t index)
+    {
+        MX_ASSERT(index < this->dataInstanceCount);
+        size_t offset = this->objectInstanceCount + index;
+        size_t last = this->instances.size() - 1;
+        if (offset != last)
+        {
+            this->instances[offset] = this->instances[last];
+            this->MarkDirty(offset, offset + 1);
+        }
+        this->instances.pop_back();
+        this->dataInstanceCount--;
+    }
+
+    void InstanceFactory::ClearDataInstances()
+    {
+        // data-only instances are the tail of buffer, so remaining instances are not moved
+        this->instances.resize(this->objectInstanceCount);
+        this->dataInstanceCount = 0;
+    }
+
+    void InstanceFactory::MarkDirty(size_t begin, size_t end)
+    {
+        if (begin >= end) return;
+
+        size_t lastChunk = (end - 1) / DirtyChunkSize;
+        if (lastChunk >= this->chunkVersions.size())
+            this->chunkVersions.resize(lastChunk + 1, 0);
+
+        // version of pending upload, renderer also recomputes bounds only of chunks with newer version
+        for (size_t chunk = begin / DirtyChunkSize; chunk <= lastChunk; chunk++)
+            this->chunkVersions[chunk] = this->instanceVersion + 1;
+        this->hasDirtyChunks = true;
+    }
+
+    void InstanceFactory::UploadDirtyInstances()
+    {
+        if (!this->hasDirtyChunks) return;
+        MAKE_SCOPE_PROFILER("Instancing::UploadDirtyInstances");
+
+        if (this->instances.size() > this->instanceAllocation.Size)
+            this->ReserveInstanceAllocation(Max(this->instances.size(), this->instanceAllocation.Size * 2));
+
+        // adjacent dirty chunks are merged, so each changed range is uploaded by one call
+        uint32_t dirtyVersion = this->instanceVersion + 1;
+        size_t chunkCount = Min(this->chunkVersions.size(), (this->instances.size() + DirtyChunkSize - 1) / DirtyChunkSize);
+        size_t chunk = 0;
+        while (chunk < chunkCount)
+        {
+            if (this->chunkVersions[chunk] != dirtyVersion)
+            {
+                chunk++;
+                continue;
+            }
+
+            size_t firstChunk = chunk;
+            while (chunk < chunkCount && this->chunkVersions[chunk] == dirtyVersion) chunk++;
+
+            size_t begin = firstChunk * DirtyChunkSize;
+            size_t end = Min(chunk * DirtyChunkSize, this->instances.size());
+            BufferAllocator::GetInstanceVBO()->BufferSubData(
+                (float*)(this->instances.data() + begin),
+                (end - begin) * InstanceDataSize,
+                (this->instanceAllocation.Offset + begin) * InstanceDataSize
+            );
+        }
+        this->instanceVersion = dirtyVersion;
+        this->hasDirtyChunks = false;
+    }
+
+    void InstanceFactory::ReserveInstanceAllocation(size_t count)
+    {
+        if (count <= this->instanceAllocation.Size) return;
+
+        this->FreeInstanceAllocation();
+
+        auto allocation = BufferAllocator::AllocateInInstanceVBO(count * InstanceDataSize);
+        this->instanceAllocation.Offset = allocation.Offset / InstanceDataSize;
+        this->instanceAllocation.Size = allocation.Size / InstanceDataSize;
+
+        // instances are moved to new buffer range, so all of them have to be uploaded again
+        this->MarkDirty(0, this->instances.size());
+    }
+
+    void InstanceFactory::FreeInstanceAllocation()
+    {
+        if (this->instanceAllocation.Size != 0)
+        {
+            BufferAllocator::DeallocateInInstanceVBO({ this->instanceAllocation.Offset * InstanceDataSize, this->instanceAllocation.Size * InstanceDataSize });
+            this->instanceAllocation.Size = 0;
+        }
     }
 
     // see SceneSerializer.cpp
@@ -42,8 +175,8 @@ namespace MxEngine
         auto object = MxObject::GetHandleByComponent(*this);
 
         this->pool.Allocate(instance);
-        this->ReserveInstanceAllocation(this->pool.Capacity());
 
+        // instances are not attached to factory in TransformHierarchy, as their matrices are uploaded relative to factory object
         auto instanceComponent = instance->AddComponent<Instance>(object);
         CloneInstanceInternal(object, instance);
 
@@ -54,15 +187,38 @@ namespace MxEngine
     {
         MAKE_SCOPE_PROFILER("Instancing::UpdateInstanceCache");
 
-        this->instances.resize(this->GetInstanceCount());
-        auto instanceData = this->instances.begin();
-        auto instance = this->GetInstancePool().begin();
+        // data-only instances follow object instances, so they are shifted only when number of pooled objects changes
+        size_t objectCount = this->pool.Allocated();
+        if (objectCount != this->objectInstanceCount)
+        {
+            auto dataBegin = this->instances.begin() + this->objectInstanceCount;
+            if (objectCount > this->objectInstanceCount)
+                this->instances.insert(dataBegin, objectCount - this->objectInstanceCount, InstanceData{ });
+            else
+                this->instances.erase(this->instances.begin() + objectCount, dataBegin);
+
+            this->MarkDirty(Min(objectCount, this->objectInstanceCount), this->instances.size());
+            this->objectInstanceCount = objectCount;
+        }
 
-        for (; instanceData != this->instances.end(); instanceData++, instance++)
+        // only instances which differ from their GPU copy are marked as dirty
+        size_t index = 0;
+        for (auto& instance : this->pool)
         {
-            instance->GetUnchecked()->LocalTransform.GetMatrix(instanceData->Model);
-            instance->GetUnchecked()->LocalTransform.GetNormalMatrix(instanceData->Model, instanceData->Normal);
-            instanceData->Color = instance->GetUnchecked()->GetComponent<Instance>()->GetColor();
+            // instance matrices are relative to parent object. Transform caches them, so they are recomputed only for moved instances
+            auto& object = *instance.GetUnchecked();
+            const auto& transform = object.LocalTransform;
+            const auto& color = object.GetComponent<Instance>()->GetColor();
+
+            auto& instanceData = this->instances[index];
+            if (instanceData.Model != transform.GetMatrix() || instanceData.Color != color)
+            {
+                instanceData.Model = transform.GetMatrix();
+                instanceData.Normal = transform.GetNormalMatrix();
+                instanceData.Color = color;
+                this->MarkDirty(index, index + 1);
+            }
+            index++;
         }
     }
 
@@ -75,46 +231,12 @@ namespace MxEngine
         this->pool.Clear();
     }
 
-    void InstanceFactory::FreeInstanceAllocation()
-    {
-        if (this->instanceAllocation.Size != 0)
-        {
-            BufferAllocator::DeallocateInInstanceVBO({ this->instanceAllocation.Offset * InstanceDataSize, this->instanceAllocation.Size * InstanceDataSize });
-        }
-    }
-
     InstanceFactory::~InstanceFactory()
     {
         this->FreeInstancePool();
         this->FreeInstanceAllocation();
     }
 
-    void InstanceFactory::SendInstancesToGPU()
-    {
-        auto& object = MxObject::GetByComponent(*this);
-        auto meshSource = object.GetComponent<MeshSource>();
-        if (meshSource.IsValid() && meshSource->Mesh.IsValid())
-        {
-            this->UpdateInstanceCache();
-            BufferAllocator::GetInstanceVBO()->BufferSubData(
-                (float*)this->instances.data(),
-                this->instances.size() * InstanceDataSize,
-                this->instanceAllocation.Offset * InstanceDataSize
-            );
-        }
-    }
-
-    void InstanceFactory::ReserveInstanceAllocation(size_t count)
-    {
-        if (count <= this->instanceAllocation.Size) return;
-
-        this->FreeInstanceAllocation();
-
-        auto allocation = BufferAllocator::AllocateInInstanceVBO(count * InstanceDataSize);
-        this->instanceAllocation.Offset = allocation.Offset / InstanceDataSize;
-        this->instanceAllocation.Size = allocation.Size / InstanceDataSize;
-    }
-
     bool IsInstanced(const MxObject& object)
     {
         return object.HasComponent<InstanceFactory>();
@@ -159,7 +281,9 @@ namespace MxEngine
 
     Transform GetGlobalTransform(const MxObject& object)
     {
-        return IsInstance(object) ? LocalToWorld(GetGlobalTransform(GetInstanceParent(object)), object.LocalTransform) : object.LocalTransform;
+        // instances are not tracked by TransformHierarchy relative to their factory, so their world transform is composed on demand
+        auto instanceParent = GetInstanceParent(object);
+        return instanceParent.IsValid() ? LocalToWorld(instanceParent->GetWorldTransform(), object.LocalTransform) : object.GetWorldTransform();
     }
 
     Transform GetGlobalTransform(MxObject::Handle object)
@@ -199,6 +323,10 @@ namespace MxEngine
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::EDITABLE)
             )
+            .property_readonly("data instance count", &InstanceFactory::GetDataInstanceCount)
+            (
+                rttr::metadata(MetaInfo::FLAGS, MetaInfo::EDITABLE)
+            )
             .property_readonly("instances", (GetPoolFunc)&InstanceFactory::GetInstancePool)
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE),
@@ -143,15 +143,31 @@ namespace MxEngine
 
         constexpr static size_t InstanceDataSize = sizeof(InstanceData) / sizeof(float);
         using InstancePool = VectorPool<MxObject::Handle>;
+        /*!
+        number of instances in one range of dirty tracking. Only ranges which were changed are uploaded to GPU
+        */
+        constexpr static size_t DirtyChunkSize = 256;
     private:
         mutable InstancePool pool;
+        /*!
+        CPU copy of instance buffer range. Instances of MxObjects in pool are stored first, followed by data-only instances,
+        so data-only instances are added and removed at the end of buffer and only shifted when number of pooled objects changes
+        */
         MxVector<InstanceData> instances;
+        /*!
+        version of each DirtyChunkSize instances. Chunk which differs from its GPU copy has version instanceVersion + 1
+        */
+        MxVector<uint32_t> chunkVersions;
         MoveOnlyAllocation instanceAllocation;
+        size_t objectInstanceCount = 0;
+        size_t dataInstanceCount = 0;
+        uint32_t instanceVersion = 0;
+        bool hasDirtyChunks = false;
 
         void RemoveDanglingHandles();
-        void SendInstancesToGPU();
-        void ReserveInstanceAllocation(size_t count);
         void UpdateInstanceCache();
+        void ReserveInstanceAllocation(size_t count);
+        void MarkDirty(size_t begin, size_t end);
 
         void FreeInstancePool();
         void FreeInstanceAllocation();
@@ -163,14 +179,51 @@ namespace MxEngine
 
         const InstancePool& GetInstancePool() const { return this->pool; }
         InstancePool& GetInstancePool() { return this->pool; };
-        size_t GetInstanceCount() const { return this->GetInstancePool().Allocated(); }
-        size_t GetInstanceBufferSize() const { return this->instanceAllocation.Size; }
-        size_t GetInstanceBufferOffset() const { return this->instanceAllocation.Offset; }
+        size_t GetInstanceCount() const { return this->GetInstancePool().Allocated() + this->dataInstanceCount; }
         auto GetInstances() const { return InstanceView{ this->pool }; }
 
         void OnUpdate(float timeDelta);
+
+        constexpr static ComponentUpdateInfo UpdateInfo{ UpdateAccess::TRANSFORM | UpdateAccess::OBJECTS, UpdateAccess::RENDERING, false, true };
         MxObject::Handle Instanciate();
         void SubmitInstances();
         void DestroyInstances();
+
+        /*!
+        creates data-only instance, which is not backed by MxObject. Such instances are much cheaper to create and update,
+        but they have no components and are not serialized with the scene
+        \param transform instance transform, relative to factory object
+        \param color instance color
+        \returns index of instance, which is valid until instance with greater index is removed
+        */
+        size_t AddDataInstance(const Transform& transform, const Vector3& color = MakeVector3(1.0f));
+        void SetDataInstance(size_t index, const Transform& transform);
+        void SetDataInstanceColor(size_t index, const Vector3& color);
+        const InstanceData& GetDataInstance(size_t index) const;
+        /*!
+        removes data-only instance. Last data-only instance is moved to its index
+        */
+        void RemoveDataInstance(size_t index);
+        void ClearDataInstances();
+        size_t GetDataInstanceCount() const { return this->dataInstanceCount; }
+
+        /*!
+        uploads chunks of instances which were changed since last call to instance buffer. Called by renderer before instances are culled
+        */
+        void UploadDirtyInstances();
+        /*!
+        gets CPU copy of instance data, which is read by renderer to compute instance bounds
+        */
+        const MxVector<InstanceData>& GetInstanceCache() const { return this->instances; }
+        /*!
+        gets version of instances in instance buffer, which is increased by each UploadDirtyInstances() call which uploaded some data
+        */
+        uint32_t GetInstanceVersion() const { return this->instanceVersion; }
+        /*!
+        gets versions of instance chunks. Chunk was uploaded by last UploadDirtyInstances() call if its version equals GetInstanceVersion()
+        */
+        const MxVector<uint32_t>& GetChunkVersions() const { return this->chunkVersions; }
+        size_t GetInstanceBufferSize() const { return this->instanceAllocation.Size; }
+        size_t GetInstanceBufferOffset() const { return this->instanceAllocation.Offset; }
     };
 }
\ No newline at end of file
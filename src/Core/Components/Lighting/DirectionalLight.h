@@ -44,6 +44,8 @@ namespace MxEngine
 
         void OnUpdate(float dt);
 
+        constexpr static ComponentUpdateInfo UpdateInfo{ UpdateAccess::TRANSFORM | UpdateAccess::CAMERA, UpdateAccess::TRANSFORM, false, false };
+
         DirectionalLight();
 
         Vector3 Direction = MakeVector3(0.0f, 1.0f, 0.0f);
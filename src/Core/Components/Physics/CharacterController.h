@@ -49,6 +49,8 @@ namespace MxEngine
 
         void OnUpdate(float dt);
 
+        constexpr static ComponentUpdateInfo UpdateInfo{ UpdateAccess::TRANSFORM | UpdateAccess::CAMERA | UpdateAccess::PHYSICS, UpdateAccess::PHYSICS, false, false };
+
         bool IsGrounded() const;
         Vector3 GetCurrentMotion() const;
 
@@ -43,18 +43,18 @@ namespace MxEngine
     bool ColliderBase::ShouldUpdateCollider(MxObject& self)
     {
         auto meshSource = GetCurrentlyUsedMesh(self);
-        if (meshSource.IsValid() && meshSource->Mesh.IsValid())
+        if (meshSource.IsValid() && meshSource->GetMesh().IsValid())
         {
-            auto uuid = meshSource->Mesh.GetUUID();
+            auto uuid = meshSource->GetMesh().GetUUID();
             if (this->savedMeshState != uuid)
             {
                 this->savedMeshState = uuid;
                 return true; // ask to update collider to new meshAABB
             }
         }
-        else if(this->savedMeshState != UUIDGenerator::GetNull())
+        else if(this->savedMeshState != ResourceIdGenerator::GetNull())
         {
-            this->savedMeshState = UUIDGenerator::GetNull();
+            this->savedMeshState = ResourceIdGenerator::GetNull();
             return true; // ask to update collider to empty AABB
         }
 
@@ -64,13 +64,13 @@ namespace MxEngine
     const AABB& ColliderBase::GetAABB(MxObject& self)
     {
         auto meshSource = GetCurrentlyUsedMesh(self); 
-        return meshSource->Mesh->MeshAABB;
+        return meshSource->GetMesh()->MeshAABB;
     }
 
     const BoundingSphere& ColliderBase::GetBoundingSphere(MxObject& self)
     {
         auto meshSource = GetCurrentlyUsedMesh(self);
-        return meshSource->Mesh->MeshBoundingSphere;
+        return meshSource->GetMesh()->MeshBoundingSphere;
     }
 
     void ColliderBase::SetColliderChangedFlag(bool value)
@@ -28,7 +28,7 @@
 
 #pragma once
 
-#include "Utilities/UUID/UUID.h"
+#include "Utilities/Factory/Factory.h"
 
 namespace MxEngine
 {
@@ -38,7 +38,7 @@ namespace MxEngine
 
     class ColliderBase
     {
-        UUID savedMeshState = UUIDGenerator::GetNull();
+        ResourceId savedMeshState = ResourceIdGenerator::GetNull();
         bool colliderChangedFlag = true;
     protected:
         bool ShouldUpdateCollider(MxObject& self);
@@ -44,18 +44,30 @@ namespace MxEngine
     {
         auto& self = MxObject::GetByComponent(*this);
         auto& selfScale = self.LocalTransform.GetScale();
+        // physics engine works in world space, so transforms of attached objects are converted using cached world transform of their parent
+        auto parent = self.GetParent();
 
         if (this->IsKinematic())
         {
             // if body is kinematic, MxObject's Transform component controls its position
             btTransform tr;
-            ToBulletTransform(tr, self.LocalTransform);
+            ToBulletTransform(tr, parent.IsValid() ? LocalToWorld(parent->GetWorldTransform(), self.LocalTransform) : self.LocalTransform);
             this->rigidBody->GetNativeHandle()->getMotionState()->setWorldTransform(tr);
         }
         else if (this->rigidBody->HasTransformUpdate())
         {
             // if body is not kinematic, transform is controlled by physics engine
-            FromBulletTransform(self.LocalTransform, this->rigidBody->GetNativeHandle()->getWorldTransform());
+            if (parent.IsValid())
+            {
+                auto parentTransform = parent->GetWorldTransform();
+                auto worldTransform = LocalToWorld(parentTransform, self.LocalTransform);
+                FromBulletTransform(worldTransform, this->rigidBody->GetNativeHandle()->getWorldTransform());
+                self.LocalTransform = WorldToLocal(parentTransform, worldTransform);
+            }
+            else
+            {
+                FromBulletTransform(self.LocalTransform, this->rigidBody->GetNativeHandle()->getWorldTransform());
+            }
             this->rigidBody->SetTransformUpdateFlag(false);
         }
 
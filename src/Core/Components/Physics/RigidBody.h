@@ -65,6 +65,7 @@ namespace MxEngine
         RigidBody() = default;
         void Init();
         void OnUpdate(float dt);
+        constexpr static ComponentUpdateInfo UpdateInfo{ UpdateAccess::TRANSFORM, UpdateAccess::TRANSFORM | UpdateAccess::PHYSICS, false, false };
         void UpdateTransform();
         void UpdateCollider();
 
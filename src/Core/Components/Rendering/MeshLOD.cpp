@@ -43,27 +43,35 @@ namespace MxEngine
             return;
         }
 
-        auto box = meshSource->Mesh->MeshAABB * object.LocalTransform.GetMatrix();
+        auto box = meshSource->GetMesh()->MeshAABB * object.GetWorldMatrix();
+        this->SetCurrentLOD(Min(MeshLOD::SelectLOD(box, viewportPosition, viewportZoom), this->LODs.size()));
+    }
 
+    size_t MeshLOD::SelectLOD(const AABB& box, const Vector3& viewportPosition, float viewportZoom)
+    {
         float distance = Length(box.GetCenter() - viewportPosition);
         Vector3 length = box.Length();
         float maxLength = ComponentMax(length);
         float scaledDistance = maxLength / (distance * viewportZoom);
 
         // magic numbers which were measured in game to find best distance for each LOD peek
-        constexpr static std::array lodDistance = {
+        constexpr static std::array<float, MaxLODLevel> lodDistance = {
             0.21f, 0.15f, 0.10f, 0.06f, 0.03f, 0.01f
         };
-        this->SetCurrentLOD(0);
-        while (this->currentLOD < lodDistance.size() && scaledDistance < lodDistance[this->currentLOD])
-            this->currentLOD++;
-
-        this->SetCurrentLOD(Min(this->currentLOD, this->LODs.size()));
+        size_t lod = 0;
+        while (lod < lodDistance.size() && scaledDistance < lodDistance[lod])
+            lod++;
+        return lod;
     }
 
     void MeshLOD::SetCurrentLOD(size_t lod)
     {
-        this->currentLOD = (uint8_t)Min(lod, (size_t)Max((int)this->LODs.size() - 1, 0));
+        this->currentLOD = (uint8_t)this->ClampLOD(lod);
+    }
+
+    size_t MeshLOD::ClampLOD(size_t lod) const
+    {
+        return Min(lod, (size_t)Max((int)this->LODs.size() - 1, 0));
     }
 
     size_t MeshLOD::GetCurrentLOD() const
@@ -71,12 +79,17 @@ namespace MxEngine
         return (size_t)this->currentLOD;
     }
 
-    MeshHandle MeshLOD::GetMeshLOD() const
+    const MeshHandle& MeshLOD::GetMeshLOD() const
+    {
+        return this->GetMeshLOD(this->currentLOD);
+    }
+
+    const MeshHandle& MeshLOD::GetMeshLOD(size_t lod) const
     {
-        if (this->currentLOD == 0 || this->currentLOD >= this->LODs.size())
-            return MxObject::GetByComponent(*this).GetComponent<MeshSource>()->Mesh;
+        if (lod == 0 || lod >= this->LODs.size())
+            return MxObject::GetByComponent(*this).GetComponent<MeshSource>()->GetMesh();
         else
-            return this->LODs[this->currentLOD - 1];
+            return this->LODs[lod - 1];
     }
 
     MXENGINE_REFLECT_TYPE
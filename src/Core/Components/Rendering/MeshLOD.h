@@ -49,6 +49,18 @@ namespace MxEngine
         void FixBestLOD(const Vector3& viewportPosition, float viewportZoom = 1.0f);
         void SetCurrentLOD(size_t lod);
         size_t GetCurrentLOD() const;
-        MeshHandle GetMeshLOD() const;
+        size_t ClampLOD(size_t lod) const;
+        const MeshHandle& GetMeshLOD() const;
+        const MeshHandle& GetMeshLOD(size_t lod) const;
+
+        /*!
+        selects LOD level for object with given world bounds, not limited by count of LODs
+        \param box world-space bounding box of object
+        \param viewportPosition position of camera
+        \param viewportZoom zoom of camera
+        \returns LOD level from 0 to MaxLODLevel
+        */
+        static size_t SelectLOD(const AABB& box, const Vector3& viewportPosition, float viewportZoom = 1.0f);
+        constexpr static size_t MaxLODLevel = 6;
     };
 }
\ No newline at end of file
@@ -73,30 +73,44 @@ namespace MxEngine
     }
 
     MeshRenderer::MeshRenderer()
-        : Materials(1, Factory<Material>::Create()) { }
+        : materials(1, Factory<Material>::Create()) { }
 
     MeshRenderer::MeshRenderer(MaterialRef material)
-        : Materials(1, std::move(material)) { }
+        : materials(1, std::move(material)) { }
 
     MeshRenderer::MeshRenderer(MaterialArray materials)
-        : Materials(std::move(materials)) { }
+        : materials(std::move(materials)) { }
 
     MeshRenderer& MeshRenderer::operator=(MaterialRef material)
     {
-        this->Materials = MaterialArray{ 1, material };
+        this->materials = MaterialArray{ 1, material };
+        ComponentFactory::MarkChanged(*this);
         return *this;
     }
 
     MeshRenderer& MeshRenderer::operator=(MaterialArray materials)
     {
-        this->Materials = std::move(materials);
+        this->materials = std::move(materials);
+        ComponentFactory::MarkChanged(*this);
         return *this;
     }
 
     MeshRenderer::MaterialRef MeshRenderer::GetMaterial() const
     {
-        MX_ASSERT(!Materials.empty()); 
-        return this->Materials[0];
+        MX_ASSERT(!materials.empty()); 
+        return this->materials[0];
+    }
+
+    const MeshRenderer::MaterialArray& MeshRenderer::GetMaterials() const
+    {
+        return this->materials;
+    }
+
+    void MeshRenderer::SetMaterials(const MaterialArray& materials)
+    {
+        // renderer keeps units between frames, so it is notified through component journal that materials were replaced
+        this->materials = materials;
+        ComponentFactory::MarkChanged(*this);
     }
 
     MeshRenderer::MaterialArray MeshRenderer::LoadMaterials(const FilePath& path)
@@ -137,7 +151,7 @@ namespace MxEngine
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::EDITABLE),
                 rttr::metadata(EditorInfo::CUSTOM_VIEW, GUI::EditorExtra<MeshRenderer>)
             )
-            .property("materials", &MeshRenderer::Materials)
+            .property("materials", &MeshRenderer::GetMaterials, &MeshRenderer::SetMaterials)
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE)
             );
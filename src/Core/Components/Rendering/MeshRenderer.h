@@ -39,8 +39,9 @@ namespace MxEngine
     public:
         using MaterialRef = MaterialHandle;
         using MaterialArray = MxVector<MaterialRef>;
-
-        MaterialArray Materials;
+    private:
+        MaterialArray materials;
+    public:
 
         MeshRenderer();
         MeshRenderer(MaterialRef material);
@@ -49,6 +50,8 @@ namespace MxEngine
         MeshRenderer& operator=(MaterialArray materials);
 
         MaterialRef GetMaterial() const;
+        const MaterialArray& GetMaterials() const;
+        void SetMaterials(const MaterialArray& materials);
 
         static MaterialArray LoadMaterials(const FilePath& objectFilepath);
         static const FilePath& GetMaterialFileExtenstion();
@@ -12,7 +12,7 @@ namespace MxEngine
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::CLONE_COPY)
             )
             .constructor<>()
-            .property("is drawn", &MeshSource::IsDrawn)
+            .property("is drawn", &MeshSource::IsDrawn, &MeshSource::SetDrawn)
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE)
             )
@@ -20,11 +20,11 @@ namespace MxEngine
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE)
             )
-            .property("casts shadow", &MeshSource::CastsShadow)
+            .property("casts shadow", &MeshSource::CastsShadow, &MeshSource::SetCastsShadow)
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE)
             )
-            .property("mesh", &MeshSource::Mesh)
+            .property("mesh", &MeshSource::GetMesh, &MeshSource::SetMesh)
             (
                 rttr::metadata(MetaInfo::FLAGS, MetaInfo::SERIALIZABLE | MetaInfo::EDITABLE)
             );
@@ -36,15 +36,24 @@ namespace MxEngine
     class MeshSource
     {
         MAKE_COMPONENT(MeshSource);
+
+        MeshHandle mesh;
+        bool isDrawn = true;
+        bool castsShadow = true;
     public:
-        MeshHandle Mesh;
-        bool IsDrawn = true;
-        bool CastsShadow = true;
         bool IsStatic = false;
 
-        MeshSource() : Mesh(Factory<MxEngine::Mesh>::Create()) { }
-        MeshSource(const MeshHandle& mesh) : Mesh(mesh) { }
-        MeshSource& operator=(const MeshHandle& mesh) { this->Mesh = mesh; return *this; }
+        MeshSource() : mesh(Factory<MxEngine::Mesh>::Create()) { }
+        MeshSource(const MeshHandle& mesh) : mesh(mesh) { }
+        MeshSource& operator=(const MeshHandle& mesh) { this->SetMesh(mesh); return *this; }
+
+        // renderer keeps units of mesh between frames, so setters notify it through component journal
+        const MeshHandle& GetMesh() const { return this->mesh; }
+        void SetMesh(const MeshHandle& mesh) { this->mesh = mesh; ComponentFactory::MarkChanged(*this); }
+        bool IsDrawn() const { return this->isDrawn; }
+        void SetDrawn(bool value) { this->isDrawn = value; ComponentFactory::MarkChanged(*this); }
+        bool CastsShadow() const { return this->castsShadow; }
+        void SetCastsShadow(bool value) { this->castsShadow = value; ComponentFactory::MarkChanged(*this); }
     };
 }
 
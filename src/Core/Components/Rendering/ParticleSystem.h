@@ -81,6 +81,8 @@ namespace MxEngine
         ~ParticleSystem();
 
         void OnUpdate(float dt);
+
+        constexpr static ComponentUpdateInfo UpdateInfo{ UpdateAccess::NONE, UpdateAccess::RENDERING, false, true };
         void Invalidate();
 
         size_t GetParticleAllocationOffset() const;
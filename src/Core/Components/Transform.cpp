@@ -28,12 +28,66 @@
 
 #include "Transform.h"
 #include "Core/Runtime/Reflection.h"
+#include "Core/MxObject/TransformHierarchy.h"
 
 namespace MxEngine
 {
+    Matrix4x4 ComposeTRS(const Vector3& position, const Quaternion& rotation, const Vector3& scale)
+    {
+        float xx = rotation.x * rotation.x, yy = rotation.y * rotation.y, zz = rotation.z * rotation.z;
+        float xy = rotation.x * rotation.y, xz = rotation.x * rotation.z, yz = rotation.y * rotation.z;
+        float wx = rotation.w * rotation.x, wy = rotation.w * rotation.y, wz = rotation.w * rotation.z;
+
+        Matrix4x4 result;
+        result[0] = Vector4((1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy + wz) * scale.x, 2.0f * (xz - wy) * scale.x, 0.0f);
+        result[1] = Vector4(2.0f * (xy - wz) * scale.y, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz + wx) * scale.y, 0.0f);
+        result[2] = Vector4(2.0f * (xz + wy) * scale.z, 2.0f * (yz - wx) * scale.z, (1.0f - 2.0f * (xx + yy)) * scale.z, 0.0f);
+        result[3] = Vector4(position, 1.0f);
+        return result;
+    }
+
+    void Transform::MarkChanged()
+    {
+        this->needTransformUpdate = true;
+        if (this->hierarchyObject != TransformHierarchy::InvalidHandle)
+            TransformHierarchy::MarkDirty(this->hierarchyObject);
+    }
+
+    Transform::Transform(const Transform& other)
+        : position(other.position), rotation(other.rotation), orientation(other.orientation), scale(other.scale),
+          transform(other.transform), normalMatrix(other.normalMatrix), needTransformUpdate(other.needTransformUpdate)
+    {
+    }
+
+    Transform::Transform(Transform&& other) noexcept
+        : Transform(other)
+    {
+        // moved transform stays attached to the same object, as objects are moved together with their transform
+        this->hierarchyObject = other.hierarchyObject;
+    }
+
+    Transform& Transform::operator=(const Transform& other)
+    {
+        this->position = other.position;
+        this->rotation = other.rotation;
+        this->orientation = other.orientation;
+        this->scale = other.scale;
+        this->transform = other.transform;
+        this->normalMatrix = other.normalMatrix;
+        this->needTransformUpdate = other.needTransformUpdate;
+        if (this->hierarchyObject != TransformHierarchy::InvalidHandle)
+            TransformHierarchy::MarkDirty(this->hierarchyObject);
+        return *this;
+    }
+
+    Transform& Transform::operator=(Transform&& other) noexcept
+    {
+        return *this = other;
+    }
+
     bool Transform::operator==(const Transform& other) const
     {
-        return this->position == other.position && this->rotation == other.rotation && this->scale == other.scale;
+        return this->position == other.position && this->orientation == other.orientation && this->scale == other.scale;
     }
 
     bool Transform::operator!=(const Transform& other) const
@@ -46,7 +100,7 @@ namespace MxEngine
         Transform result;
         result.scale = this->scale * other.scale;
         result.position = this->position + other.position;
-        result.rotation = this->rotation + other.rotation;
+        result.SetRotation(this->rotation + other.rotation);
         return result;
     }
 
@@ -69,10 +123,7 @@ namespace MxEngine
 
     void Transform::GetMatrix(Matrix4x4& inPlaceMatrix) const
     {
-        Matrix4x4 Translation = MxEngine::Translate(Matrix4x4(1.0f), this->position);
-        Matrix4x4 Rotation = MakeRotationMatrix(RadiansVec(this->rotation));
-        Matrix4x4 Scale = MxEngine::Scale(Matrix4x4(1.0f), this->scale);
-        inPlaceMatrix = Translation * Rotation * Scale;
+        inPlaceMatrix = ComposeTRS(this->position, this->orientation, this->scale);
     }
 
     void Transform::GetNormalMatrix(const Matrix4x4& model, Matrix3x3& inPlaceMatrix) const
@@ -93,9 +144,9 @@ namespace MxEngine
         return this->scale;
     }
 
-    Quaternion Transform::GetRotationQuaternion() const
+    const Quaternion& Transform::GetRotationQuaternion() const
     {
-        return MakeQuaternion(MakeRotationMatrix(RadiansVec(this->rotation)));
+        return this->orientation;
     }
 
     const Vector3& Transform::GetPosition() const
@@ -105,7 +156,13 @@ namespace MxEngine
 
     Transform& Transform::SetRotation(const Quaternion& q)
     {
-        return this->SetRotation(DegreesVec(MakeEulerAngles(q)));
+        this->orientation = Normalize(q);
+        this->rotation = DegreesVec(MakeRotationAngles(this->orientation));
+        this->rotation.x = std::fmod(this->rotation.x + 360.0f, 360.0f);
+        this->rotation.y = std::fmod(this->rotation.y + 360.0f, 360.0f);
+        this->rotation.z = std::fmod(this->rotation.z + 360.0f, 360.0f);
+        this->MarkChanged();
+        return *this;
     }
 
     Transform& Transform::SetRotation(const Vector3& angles)
@@ -118,7 +175,7 @@ namespace MxEngine
     Transform& Transform::SetScale(const Vector3& scale)
     {
         this->scale = scale;
-        this->needTransformUpdate = true;
+        this->MarkChanged();
         return *this;
     }
 
@@ -130,7 +187,7 @@ namespace MxEngine
     Transform& Transform::SetPosition(const Vector3& position)
     {
         this->position = position;
-        this->needTransformUpdate = true;
+        this->MarkChanged();
         return *this;
     }
 
@@ -142,7 +199,7 @@ namespace MxEngine
     Transform& Transform::Scale(const Vector3& scale)
     {
         this->scale *= scale;
-        this->needTransformUpdate = true;
+        this->MarkChanged();
         return *this;
     }
 
@@ -163,7 +220,7 @@ namespace MxEngine
 
     Transform& Transform::Rotate(const Quaternion& q)
     {
-        return this->Rotate(MakeEulerAngles(q));
+        return this->SetRotation(q * this->orientation);
     }
 
     Transform& Transform::Rotate(const Vector3& angles)
@@ -172,7 +229,8 @@ namespace MxEngine
         this->rotation.x = std::fmod(this->rotation.x + 360.0f, 360.0f);
         this->rotation.y = std::fmod(this->rotation.y + 360.0f, 360.0f);
         this->rotation.z = std::fmod(this->rotation.z + 360.0f, 360.0f);
-        this->needTransformUpdate = true;
+        this->orientation = MakeQuaternion(MakeRotationMatrix(RadiansVec(this->rotation)));
+        this->MarkChanged();
         return *this;
     }
 
@@ -194,7 +252,7 @@ namespace MxEngine
     Transform& Transform::Translate(const Vector3& dist)
     {
         this->position += dist;
-        this->needTransformUpdate = true;
+        this->MarkChanged();
         return *this;
     }
 
@@ -246,19 +304,21 @@ namespace MxEngine
 
     Transform LocalToWorld(const Transform& parent, const Transform& child)
     {
+        const auto& parentRotation = parent.GetRotationQuaternion();
         Transform result;
         result.SetScale(parent.GetScale() * child.GetScale());
-        result.SetRotation(parent.GetRotation() + child.GetRotation());
-        result.SetPosition(parent.GetPosition() + parent.GetScale() * child.GetPosition());
+        result.SetRotation(parentRotation * child.GetRotationQuaternion());
+        result.SetPosition(parent.GetPosition() + parentRotation * (parent.GetScale() * child.GetPosition()));
         return result;
     }
 
     Transform WorldToLocal(const Transform& parent, const Transform& world)
     {
+        auto inverseRotation = Inverse(parent.GetRotationQuaternion());
         Transform result;
         result.SetScale(world.GetScale() / parent.GetScale());
-        result.SetRotation(world.GetRotation() - parent.GetRotation());
-        result.SetPosition((world.GetPosition() - parent.GetPosition()) / parent.GetScale());
+        result.SetRotation(inverseRotation * world.GetRotationQuaternion());
+        result.SetPosition(inverseRotation * (world.GetPosition() - parent.GetPosition()) / parent.GetScale());
         return result;
     }
 
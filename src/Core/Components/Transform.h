@@ -30,17 +30,38 @@
 
 #include "Utilities/Math/Math.h"
 
+#include <limits>
+
 namespace MxEngine
 {
     class Transform
     {
         Vector3 position = MakeVector3(0.0f);
+        /*!
+        euler angles in degrees. Kept in sync with orientation, used by editor and serialization
+        */
         Vector3 rotation = MakeVector3(0.0f);
+        Quaternion orientation{ 1.0f, 0.0f, 0.0f, 0.0f };
         Vector3 scale = MakeVector3(1.0f);
         mutable Matrix4x4 transform{ 0.0f };
         mutable Matrix3x3 normalMatrix{ 0.0f };
         mutable bool needTransformUpdate = true;
+        /*!
+        object which local transform is stored here. Setters report changes to TransformHierarchy, so it does not need to scan all objects
+        */
+        size_t hierarchyObject = std::numeric_limits<size_t>::max();
+
+        void MarkChanged();
+
+        friend class TransformHierarchy;
     public:
+        Transform() = default;
+        // copies are not attached to hierarchy, assignment keeps object of target transform
+        Transform(const Transform& other);
+        Transform(Transform&& other) noexcept;
+        Transform& operator=(const Transform& other);
+        Transform& operator=(Transform&& other) noexcept;
+
         bool operator==(const Transform& other) const;
         bool operator!=(const Transform& other) const;
         Transform operator*(const Transform& other) const;
@@ -54,7 +75,7 @@ namespace MxEngine
         const Vector3& GetRotation() const;
         const Vector3& GetScale() const;
 
-        Quaternion GetRotationQuaternion() const;
+        const Quaternion& GetRotationQuaternion() const;
 
         Transform& SetRotation(const Quaternion& q);
         Transform& SetRotation(const Vector3& angles);
@@ -85,6 +106,15 @@ namespace MxEngine
         Transform& LookAtYZ(const Vector3& point);
     };
 
+    /*!
+    composes transformation matrix from translation, rotation and scale without multiplying intermediate matrices
+    \param position translation part
+    \param rotation normalized rotation quaternion
+    \param scale scale part
+    \returns matrix equal to Translate * Rotate * Scale
+    */
+    Matrix4x4 ComposeTRS(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
     Transform LocalToWorld(const Transform& parent, const Transform& child);
     Transform WorldToLocal(const Transform& parent, const Transform& world);
 }
\ No newline at end of file
@@ -28,12 +28,17 @@
 
 #include "MxObject.h"
 
+#include <algorithm>
+
 namespace MxEngine
 {
     MxObject::Handle MxObject::Create()
     {
         auto object = Factory<MxObject>::Create();
         object->handle = object.GetHandle();
+        object->components.SetOwner(object->handle);
+        object->Name.SetOwner(object->handle);
+        TransformHierarchy::AddObject(object->handle);
         object.MakeStatic();
         return object;
     }
@@ -54,15 +59,41 @@ namespace MxEngine
         return ComponentView<MxObject>{ Factory<MxObject>::GetPool() };
     }
 
+    static MxVector<MxObject::Handle> ToObjectHandles(const MxVector<MxObject::EngineHandle>& handles)
+    {
+        MxVector<MxObject::Handle> result;
+        result.reserve(handles.size());
+        for (auto handle : handles)
+            result.push_back(MxObject::GetByHandle(handle));
+        return result;
+    }
+
     MxObject::Handle MxObject::GetByName(const MxString& name)
     {
-        auto& factory = Factory<MxObject>::GetPool();
-        for (auto& resource : factory)
-        {
-            if (resource.value.Name == name)
-                return MxObject::Handle{ resource.uuid, factory.IndexOf(resource) };
-        }
-        return MxObject::Handle{ };
+        const auto& handles = ObjectNameRegistry::FindByName(name);
+        if (handles.empty()) return MxObject::Handle{ };
+        // registry does not keep objects ordered, so object with lowest handle is returned, as it goes first in Factory<MxObject> pool
+        return MxObject::GetByHandle(*std::min_element(handles.begin(), handles.end()));
+    }
+
+    MxVector<MxObject::Handle> MxObject::GetAllByName(const MxString& name)
+    {
+        return ToObjectHandles(ObjectNameRegistry::FindByName(name));
+    }
+
+    size_t MxObject::CountByName(const MxString& name)
+    {
+        return ObjectNameRegistry::FindByName(name).size();
+    }
+
+    MxVector<MxObject::Handle> MxObject::GetByNamePrefix(const MxString& prefix)
+    {
+        return ToObjectHandles(ObjectNameRegistry::FindByNamePrefix(prefix));
+    }
+
+    MxVector<MxObject::Handle> MxObject::GetByTag(const MxString& tag)
+    {
+        return ToObjectHandles(ObjectNameRegistry::FindByTag(tag));
     }
 
     MxObject::Handle MxObject::GetHandle(const MxObject& object)
@@ -74,8 +105,8 @@ namespace MxEngine
     {
         MX_ASSERT(handle != InvalidHandle);
         auto& managedObject = Factory<MxObject>::GetPool()[handle];
-        MX_ASSERT(managedObject.refCount > 0 && managedObject.uuid != UUIDGenerator::GetNull());
-        return MxObject::Handle(managedObject.uuid, handle);
+        MX_ASSERT(managedObject.refCount > 0 && managedObject.id != ResourceIdGenerator::GetNull());
+        return MxObject::Handle(managedObject.id, handle);
     }
 
     MxObject::EngineHandle MxObject::GetNativeHandle() const
@@ -83,8 +114,73 @@ namespace MxEngine
         return this->handle;
     }
 
+    bool MxObject::SetParent(const Handle& parent)
+    {
+        MX_ASSERT(this->handle != InvalidHandle);
+        return TransformHierarchy::SetParent(this->handle, parent.IsValid() ? parent->handle : InvalidHandle);
+    }
+
+    MxObject::Handle MxObject::GetParent() const
+    {
+        auto parent = TransformHierarchy::GetParent(this->handle);
+        return parent != InvalidHandle ? MxObject::GetByHandle(parent) : MxObject::Handle{ };
+    }
+
+    MxVector<MxObject::Handle> MxObject::GetChildren() const
+    {
+        return ToObjectHandles(TransformHierarchy::GetChildren(this->handle));
+    }
+
+    const Matrix4x4& MxObject::GetWorldMatrix() const
+    {
+        return TransformHierarchy::GetWorldMatrix(this->handle);
+    }
+
+    const Matrix3x3& MxObject::GetWorldNormalMatrix() const
+    {
+        return TransformHierarchy::GetWorldNormalMatrix(this->handle);
+    }
+
+    Transform MxObject::GetWorldTransform() const
+    {
+        return TransformHierarchy::GetWorldTransform(this->handle);
+    }
+
+    void MxObject::AddTag(const MxString& tag)
+    {
+        if (this->HasTag(tag)) return;
+        this->tags.push_back(tag);
+        if (this->handle != InvalidHandle)
+            ObjectNameRegistry::AddTag(tag, this->handle);
+    }
+
+    void MxObject::RemoveTag(const MxString& tag)
+    {
+        auto it = std::find(this->tags.begin(), this->tags.end(), tag);
+        if (it == this->tags.end()) return;
+        this->tags.erase(it);
+        if (this->handle != InvalidHandle)
+            ObjectNameRegistry::RemoveTag(tag, this->handle);
+    }
+
+    bool MxObject::HasTag(const MxString& tag) const
+    {
+        return std::find(this->tags.begin(), this->tags.end(), tag) != this->tags.end();
+    }
+
+    const MxVector<MxString>& MxObject::GetTags() const
+    {
+        return this->tags;
+    }
+
     MxObject::~MxObject()
     {
+        if (this->handle != InvalidHandle)
+        {
+            for (const auto& tag : this->tags)
+                ObjectNameRegistry::RemoveTag(tag, this->handle);
+            TransformHierarchy::RemoveObject(this->handle);
+        }
         this->components.RemoveAllComponents();
     }
 }
\ No newline at end of file
@@ -30,6 +30,8 @@
 
 #include "Core/Components/Transform.h"
 #include "Utilities/ECS/Component.h"
+#include "Core/MxObject/ObjectNameRegistry.h"
+#include "Core/MxObject/TransformHierarchy.h"
 
 GENERATE_METHOD_CHECK(Init, Init())
 
@@ -50,9 +52,14 @@ namespace MxEngine
     public:
         bool IsSerialized = true;
         bool IsDisplayedInEditor = true;
-        MxString Name = UUIDGenerator::Get();
+        #if defined(MXENGINE_COMPACT_HANDLES)
+        ObjectName Name; // unique name is generated only when object is serialized
+        #else
+        ObjectName Name{ UUIDGenerator::Get() };
+        #endif
         Transform LocalTransform;
     private:
+        MxVector<MxString> tags;
         // placed here to be destroyed before other members
         ComponentManager components;
     public:
@@ -68,12 +75,41 @@ namespace MxEngine
         static void Destroy(MxObject& object);
 
         static ComponentView<MxObject> GetObjects();
+        /*!
+        gets first object with specified name. Lookup is performed using ObjectNameRegistry
+        \param name object name
+        \returns handle to object or invalid handle if there is no such object
+        */
         static Handle GetByName(const MxString& name);
+        static MxVector<Handle> GetAllByName(const MxString& name);
+        static size_t CountByName(const MxString& name);
+        static MxVector<Handle> GetByNamePrefix(const MxString& prefix);
+        static MxVector<Handle> GetByTag(const MxString& tag);
         static Handle GetHandle(const MxObject& object);
         static Handle GetByHandle(EngineHandle handle);
 
         EngineHandle GetNativeHandle() const;
 
+        /*!
+        attaches object to parent object, so its LocalTransform is treated relative to parent
+        \param parent parent object or invalid handle to detach object from its current parent
+        \returns true if parent was changed, false if parent is a descendant of this object
+        */
+        bool SetParent(const Handle& parent);
+        Handle GetParent() const;
+        MxVector<Handle> GetChildren() const;
+        /*!
+        world matrices are cached by TransformHierarchy and updated once per frame before rendering
+        */
+        const Matrix4x4& GetWorldMatrix() const;
+        const Matrix3x3& GetWorldNormalMatrix() const;
+        Transform GetWorldTransform() const;
+
+        void AddTag(const MxString& tag);
+        void RemoveTag(const MxString& tag);
+        bool HasTag(const MxString& tag) const;
+        const MxVector<MxString>& GetTags() const;
+
         template<typename T>
         static MxObject& GetByComponent(T& component)
         {
@@ -134,7 +170,7 @@ namespace MxEngine
         }
 
         template<typename T>
-        static UUID GetComponentUUID(const T& component)
+        static ResourceId GetComponentUUID(const T& component)
         {
             return MxObject::GetComponentHandle(component).GetUUID();
         }
@@ -0,0 +1,200 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "ObjectNameRegistry.h"
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/STL/MxSet.h"
+
+namespace MxEngine
+{
+    /*!
+    handles of objects which share name or tag. Handles are not ordered, position of each handle is stored,
+    so objects are added and removed in constant time regardless of how many objects share the key
+    */
+    struct ObjectHandleList
+    {
+        MxVector<ObjectNameRegistry::EngineHandle> Handles;
+        MxHashMap<ObjectNameRegistry::EngineHandle, size_t> Positions;
+    };
+
+    struct ObjectNameRegistryImpl
+    {
+        MxHashMap<MxString, ObjectHandleList> Names;
+        MxHashMap<MxString, ObjectHandleList> Tags;
+        /*!
+        names in lexicographical order, used for prefix queries. Updated when name is first used or last object with it is removed
+        */
+        MxSet<MxString> SortedNames;
+        const MxVector<ObjectNameRegistry::EngineHandle> EmptyList;
+    };
+
+    static void InsertHandle(ObjectHandleList& list, ObjectNameRegistry::EngineHandle object)
+    {
+        auto [position, inserted] = list.Positions.insert(object);
+        if (!inserted) return;
+
+        position->second = list.Handles.size();
+        list.Handles.push_back(object);
+    }
+
+    template<typename Map>
+    static bool EraseHandle(Map& map, const MxString& key, ObjectNameRegistry::EngineHandle object)
+    {
+        auto entry = map.find(key);
+        if (entry == map.end()) return false;
+
+        auto& list = entry->second;
+        auto position = list.Positions.find(object);
+        if (position != list.Positions.end())
+        {
+            // last handle is moved to the place of removed one
+            size_t index = position->second;
+            auto last = list.Handles.back();
+            list.Handles[index] = last;
+            list.Positions[last] = index;
+            list.Handles.pop_back();
+            list.Positions.erase(object);
+        }
+
+        if (!list.Handles.empty()) return false;
+        map.erase(entry);
+        return true;
+    }
+
+    void ObjectNameRegistry::Init()
+    {
+        impl = Alloc<ObjectNameRegistryImpl>();
+    }
+
+    void ObjectNameRegistry::Destroy()
+    {
+        Free(impl);
+        impl = nullptr;
+    }
+
+    ObjectNameRegistryImpl* ObjectNameRegistry::GetImpl()
+    {
+        return impl;
+    }
+
+    void ObjectNameRegistry::Clone(ObjectNameRegistryImpl* other)
+    {
+        impl = other;
+    }
+
+    void ObjectNameRegistry::AddName(const MxString& name, EngineHandle object)
+    {
+        if (impl == nullptr || name.empty()) return;
+
+        auto [entry, inserted] = impl->Names.insert(name);
+        InsertHandle(entry->second, object);
+        if (inserted) impl->SortedNames.insert(name);
+    }
+
+    void ObjectNameRegistry::RemoveName(const MxString& name, EngineHandle object)
+    {
+        if (impl == nullptr || name.empty()) return;
+
+        if (EraseHandle(impl->Names, name, object))
+            impl->SortedNames.erase(name);
+    }
+
+    void ObjectNameRegistry::AddTag(const MxString& tag, EngineHandle object)
+    {
+        if (impl == nullptr) return;
+
+        InsertHandle(impl->Tags[tag], object);
+    }
+
+    void ObjectNameRegistry::RemoveTag(const MxString& tag, EngineHandle object)
+    {
+        if (impl == nullptr) return;
+
+        EraseHandle(impl->Tags, tag, object);
+    }
+
+    const MxVector<ObjectNameRegistry::EngineHandle>& ObjectNameRegistry::FindByName(const MxString& name)
+    {
+        auto it = impl->Names.find(name);
+        return it != impl->Names.end() ? it->second.Handles : impl->EmptyList;
+    }
+
+    MxVector<ObjectNameRegistry::EngineHandle> ObjectNameRegistry::FindByNamePrefix(const MxString& prefix)
+    {
+        MxVector<EngineHandle> result;
+        for (auto it = impl->SortedNames.lower_bound(prefix); it != impl->SortedNames.end() && it->compare(0, prefix.size(), prefix) == 0; it++)
+        {
+            const auto& handles = impl->Names[*it].Handles;
+            result.insert(result.end(), handles.begin(), handles.end());
+        }
+        return result;
+    }
+
+    const MxVector<ObjectNameRegistry::EngineHandle>& ObjectNameRegistry::FindByTag(const MxString& tag)
+    {
+        auto it = impl->Tags.find(tag);
+        return it != impl->Tags.end() ? it->second.Handles : impl->EmptyList;
+    }
+
+    void ObjectName::SetOwner(size_t owner)
+    {
+        ObjectNameRegistry::RemoveName(this->name, this->owner);
+        this->owner = owner;
+        ObjectNameRegistry::AddName(this->name, this->owner);
+    }
+
+    ObjectName::ObjectName(ObjectName&& other) noexcept
+        : name(std::move(other.name)), owner(other.owner)
+    {
+        other.owner = InvalidOwner;
+    }
+
+    ObjectName& ObjectName::operator=(ObjectName&& other) noexcept
+    {
+        *this = other.name;
+        return *this;
+    }
+
+    ObjectName::~ObjectName()
+    {
+        if (this->owner != InvalidOwner)
+            ObjectNameRegistry::RemoveName(this->name, this->owner);
+    }
+
+    ObjectName& ObjectName::operator=(const MxString& name)
+    {
+        if (this->owner != InvalidOwner)
+        {
+            ObjectNameRegistry::RemoveName(this->name, this->owner);
+            ObjectNameRegistry::AddName(name, this->owner);
+        }
+        this->name = name;
+        return *this;
+    }
+}
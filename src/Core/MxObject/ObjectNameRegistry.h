@@ -0,0 +1,131 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include "Utilities/STL/MxString.h"
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/STL/MxHashMap.h"
+
+#include <limits>
+
+namespace MxEngine
+{
+    struct ObjectNameRegistryImpl;
+
+    /*!
+    object name registry indexes MxObject handles by name and by tags, so lookups do not scan all objects
+    objects which share name or tag are stored in no particular order, so renaming and tagging cost does not depend on scene size
+    */
+    class ObjectNameRegistry
+    {
+        inline static ObjectNameRegistryImpl* impl = nullptr;
+    public:
+        using EngineHandle = size_t;
+
+        static void Init();
+        static void Destroy();
+        static ObjectNameRegistryImpl* GetImpl();
+        static void Clone(ObjectNameRegistryImpl* other);
+
+        static void AddName(const MxString& name, EngineHandle object);
+        static void RemoveName(const MxString& name, EngineHandle object);
+        static void AddTag(const MxString& tag, EngineHandle object);
+        static void RemoveTag(const MxString& tag, EngineHandle object);
+
+        /*!
+        gets all objects with specified name
+        \param name object name
+        \returns handles of objects in unspecified order (empty if there are no such objects)
+        */
+        static const MxVector<EngineHandle>& FindByName(const MxString& name);
+        /*!
+        gets all objects which name starts with prefix
+        \param prefix name prefix
+        \returns handles of objects, grouped by name in lexicographical order
+        */
+        static MxVector<EngineHandle> FindByNamePrefix(const MxString& prefix);
+        /*!
+        gets all objects marked with tag
+        \param tag object tag
+        \returns handles of objects in unspecified order (empty if there are no such objects)
+        */
+        static const MxVector<EngineHandle>& FindByTag(const MxString& tag);
+    };
+
+    /*!
+    object name is a wrapper around MxString, which keeps ObjectNameRegistry in sync when object is renamed
+    it can be used as a regular string in most places, as it converts to const MxString& implicitly
+    */
+    class ObjectName
+    {
+        constexpr static size_t InvalidOwner = std::numeric_limits<size_t>::max();
+
+        MxString name;
+        /*!
+        handle of object which owns this name, set when object is created by MxObject::Create()
+        */
+        size_t owner = InvalidOwner;
+
+        friend class MxObject;
+
+        void SetOwner(size_t owner);
+    public:
+        constexpr static size_t npos = MxString::npos;
+
+        ObjectName() = default;
+        ObjectName(const MxString& name) : name(name) { }
+        ObjectName(const char* name) : name(name) { }
+        ObjectName(ObjectName&& other) noexcept;
+        ObjectName& operator=(ObjectName&& other) noexcept;
+        ObjectName(const ObjectName&) = delete;
+        ~ObjectName();
+
+        ObjectName& operator=(const ObjectName& other) { return *this = other.name; }
+        ObjectName& operator=(const char* name) { return *this = MxString(name); }
+        ObjectName& operator=(const MxString& name);
+
+        operator const MxString&() const { return this->name; }
+        const MxString& Get() const { return this->name; }
+        const char* c_str() const { return this->name.c_str(); }
+        bool empty() const { return this->name.empty(); }
+        size_t size() const { return this->name.size(); }
+        size_t find(const char* str, size_t position = 0) const { return this->name.find(str, position); }
+        size_t find(const MxString& str, size_t position = 0) const { return this->name.find(str, position); }
+
+        friend MxString operator+(const ObjectName& name, const char* str) { return name.name + str; }
+        friend MxString operator+(const char* str, const ObjectName& name) { return str + name.name; }
+        friend MxString operator+(const ObjectName& name, const MxString& str) { return name.name + str; }
+        friend MxString operator+(const MxString& str, const ObjectName& name) { return str + name.name; }
+        friend bool operator==(const ObjectName& name, const char* str) { return name.name == str; }
+        friend bool operator==(const ObjectName& name, const MxString& str) { return name.name == str; }
+        friend bool operator!=(const ObjectName& name, const char* str) { return name.name != str; }
+        friend bool operator!=(const ObjectName& name, const MxString& str) { return name.name != str; }
+    };
+}
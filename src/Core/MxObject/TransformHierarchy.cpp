@@ -0,0 +1,458 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "TransformHierarchy.h"
+#include "Core/MxObject/MxObject.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/Memory/FrameArena.h"
+
+#include <algorithm>
+
+namespace MxEngine
+{
+    struct TransformHierarchyImpl
+    {
+        using EngineHandle = TransformHierarchy::EngineHandle;
+        constexpr static size_t InvalidNode = std::numeric_limits<size_t>::max();
+
+        enum NodeFlags : uint8_t
+        {
+            UNIFORM_SCALE = 1 << 0,
+            QUEUED = 1 << 1,
+        };
+
+        /*!
+        minimal number of removed nodes before node arrays are compacted. Compaction also requires at least half of nodes to be removed
+        */
+        constexpr static size_t MinCompactedNodes = 256;
+
+        // node attributes. Parent node index is always less than child node index, so nodes can be updated in index order
+        // removed objects leave holes (nodes with invalid object handle), which are compacted once there are too many of them
+        MxVector<EngineHandle> Objects;
+        MxVector<size_t> Parents;
+        MxVector<Vector3> WorldPositions;
+        MxVector<Quaternion> WorldRotations;
+        MxVector<Vector3> WorldScales;
+        MxVector<Matrix4x4> WorldMatrices;
+        MxVector<Matrix3x3> WorldNormalMatrices;
+        MxVector<uint32_t> WorldVersions;
+        MxVector<uint8_t> Flags;
+
+        // object relations, indexed by object handle
+        MxVector<size_t> ObjectNodes;
+        MxVector<EngineHandle> ObjectParents;
+        MxVector<MxVector<EngineHandle>> ObjectChildren;
+        /*!
+        objects which local transform or parent changed since last TransformHierarchy::Update() call, flag is indexed by object handle
+        */
+        MxVector<uint8_t> IsObjectDirty;
+        MxVector<EngineHandle> DirtyObjects;
+        /*!
+        objects which world matrix was recomputed since last TransformHierarchy::ConsumeChangedObjects() call, flag is indexed by object handle
+        */
+        MxVector<uint8_t> IsObjectChanged;
+        MxVector<EngineHandle> ChangedObjects;
+        // nodes of dirty subtrees, reused between updates
+        MxVector<size_t> UpdateQueue;
+
+        const MxVector<EngineHandle> EmptyList;
+        size_t UpdatedCount = 0;
+        size_t RemovedNodeCount = 0;
+    };
+
+    using Impl = TransformHierarchyImpl;
+
+    template<typename T>
+    static void AppendCopy(MxVector<T>& values, size_t index)
+    {
+        T value = values[index]; // copied first, as push_back may reallocate storage
+        values.push_back(value);
+    }
+
+    template<typename T>
+    static void Compact(MxVector<T>& values, const FrameVector<size_t>& newNodes, size_t nodeCount)
+    {
+        // new index of node never exceeds the old one, so values can be moved in place
+        for (size_t node = 0; node < newNodes.size(); node++)
+        {
+            if (newNodes[node] != TransformHierarchyImpl::InvalidNode)
+                values[newNodes[node]] = values[node];
+        }
+        values.resize(nodeCount);
+    }
+
+    static bool IsRegistered(TransformHierarchy::EngineHandle object, TransformHierarchyImpl* impl)
+    {
+        return object < impl->ObjectNodes.size() && impl->ObjectNodes[object] != Impl::InvalidNode;
+    }
+
+    static size_t GetNode(TransformHierarchy::EngineHandle object, TransformHierarchyImpl* impl)
+    {
+        MX_ASSERT(IsRegistered(object, impl));
+        return impl->ObjectNodes[object];
+    }
+
+    static void CompactNodes(TransformHierarchyImpl* impl)
+    {
+        MAKE_SCOPE_PROFILER("TransformHierarchy::CompactNodes()");
+
+        // relative order of nodes is kept, so parents still precede their children
+        FrameVector<size_t> newNodes(impl->Objects.size(), Impl::InvalidNode);
+        size_t nodeCount = 0;
+        for (size_t node = 0; node < impl->Objects.size(); node++)
+        {
+            if (impl->Objects[node] != TransformHierarchy::InvalidHandle)
+                newNodes[node] = nodeCount++;
+        }
+
+        Compact(impl->Objects, newNodes, nodeCount);
+        Compact(impl->Parents, newNodes, nodeCount);
+        Compact(impl->WorldPositions, newNodes, nodeCount);
+        Compact(impl->WorldRotations, newNodes, nodeCount);
+        Compact(impl->WorldScales, newNodes, nodeCount);
+        Compact(impl->WorldMatrices, newNodes, nodeCount);
+        Compact(impl->WorldNormalMatrices, newNodes, nodeCount);
+        Compact(impl->WorldVersions, newNodes, nodeCount);
+        Compact(impl->Flags, newNodes, nodeCount);
+
+        for (size_t node = 0; node < nodeCount; node++)
+        {
+            impl->ObjectNodes[impl->Objects[node]] = node;
+            auto& parent = impl->Parents[node];
+            if (parent != Impl::InvalidNode) parent = newNodes[parent];
+        }
+        impl->RemovedNodeCount = 0;
+    }
+
+    static void MoveSubtreeToBack(TransformHierarchy::EngineHandle root, TransformHierarchyImpl* impl)
+    {
+        // subtree is appended in breadth-first order, so moved parents still precede their children. Old nodes become holes
+        FrameVector<TransformHierarchy::EngineHandle> subtree;
+        subtree.push_back(root);
+        for (size_t i = 0; i < subtree.size(); i++)
+        {
+            for (auto child : impl->ObjectChildren[subtree[i]])
+                subtree.push_back(child);
+        }
+
+        for (auto object : subtree)
+        {
+            size_t oldNode = impl->ObjectNodes[object];
+            size_t newNode = impl->Objects.size();
+
+            AppendCopy(impl->Objects, oldNode);
+            AppendCopy(impl->Parents, oldNode);
+            AppendCopy(impl->WorldPositions, oldNode);
+            AppendCopy(impl->WorldRotations, oldNode);
+            AppendCopy(impl->WorldScales, oldNode);
+            AppendCopy(impl->WorldMatrices, oldNode);
+            AppendCopy(impl->WorldNormalMatrices, oldNode);
+            AppendCopy(impl->WorldVersions, oldNode);
+            AppendCopy(impl->Flags, oldNode);
+
+            impl->Objects[oldNode] = TransformHierarchy::InvalidHandle;
+            impl->ObjectNodes[object] = newNode;
+            auto parent = impl->ObjectParents[object];
+            impl->Parents[newNode] = parent != TransformHierarchy::InvalidHandle ? impl->ObjectNodes[parent] : Impl::InvalidNode;
+        }
+        impl->RemovedNodeCount += subtree.size();
+    }
+
+    void TransformHierarchy::Init()
+    {
+        impl = Alloc<TransformHierarchyImpl>();
+    }
+
+    void TransformHierarchy::Destroy()
+    {
+        Free(impl);
+        impl = nullptr;
+    }
+
+    TransformHierarchyImpl* TransformHierarchy::GetImpl()
+    {
+        return impl;
+    }
+
+    void TransformHierarchy::Clone(TransformHierarchyImpl* other)
+    {
+        impl = other;
+    }
+
+    void TransformHierarchy::AddObject(EngineHandle object)
+    {
+        if (object >= impl->ObjectNodes.size())
+        {
+            impl->ObjectNodes.resize(object + 1, Impl::InvalidNode);
+            impl->ObjectParents.resize(object + 1, InvalidHandle);
+            impl->ObjectChildren.resize(object + 1);
+            impl->IsObjectDirty.resize(object + 1, 0);
+            impl->IsObjectChanged.resize(object + 1, 0);
+        }
+        MX_ASSERT(impl->ObjectNodes[object] == Impl::InvalidNode);
+
+        // new objects are roots, so they can be appended without breaking node order
+        impl->ObjectNodes[object] = impl->Objects.size();
+        impl->ObjectParents[object] = InvalidHandle;
+        impl->ObjectChildren[object].clear();
+
+        impl->Objects.push_back(object);
+        impl->Parents.push_back(Impl::InvalidNode);
+        impl->WorldPositions.push_back(MakeVector3(0.0f));
+        impl->WorldRotations.push_back(Quaternion{ 1.0f, 0.0f, 0.0f, 0.0f });
+        impl->WorldScales.push_back(MakeVector3(1.0f));
+        impl->WorldMatrices.push_back(Matrix4x4(1.0f));
+        impl->WorldNormalMatrices.push_back(Matrix3x3(1.0f));
+        impl->WorldVersions.push_back(0);
+        impl->Flags.push_back(uint8_t(Impl::UNIFORM_SCALE));
+
+        Factory<MxObject>::GetPool()[object].value.LocalTransform.hierarchyObject = object;
+        TransformHierarchy::MarkDirty(object);
+    }
+
+    void TransformHierarchy::MarkDirty(EngineHandle object)
+    {
+        if (impl->IsObjectDirty[object] != 0) return;
+        impl->IsObjectDirty[object] = 1;
+        impl->DirtyObjects.push_back(object);
+    }
+
+    void TransformHierarchy::RemoveObject(EngineHandle object)
+    {
+        if (!IsRegistered(object, impl)) return;
+        size_t node = impl->ObjectNodes[object];
+
+        auto parent = impl->ObjectParents[object];
+        if (parent != InvalidHandle)
+        {
+            auto& siblings = impl->ObjectChildren[parent];
+            siblings.erase(std::find(siblings.begin(), siblings.end(), object));
+        }
+
+        // children become roots, keeping their world transform from the last update
+        for (auto child : impl->ObjectChildren[object])
+        {
+            size_t childNode = impl->ObjectNodes[child];
+            auto& childTransform = Factory<MxObject>::GetPool()[child].value.LocalTransform;
+            childTransform.SetPosition(impl->WorldPositions[childNode]);
+            childTransform.SetRotation(impl->WorldRotations[childNode]);
+            childTransform.SetScale(impl->WorldScales[childNode]);
+            impl->ObjectParents[child] = InvalidHandle;
+            impl->Parents[childNode] = Impl::InvalidNode;
+            TransformHierarchy::MarkDirty(child);
+        }
+        impl->ObjectChildren[object].clear();
+
+        Factory<MxObject>::GetPool()[object].value.LocalTransform.hierarchyObject = InvalidHandle;
+
+        impl->ObjectParents[object] = InvalidHandle;
+        impl->ObjectNodes[object] = Impl::InvalidNode;
+        impl->Objects[node] = InvalidHandle;
+        impl->RemovedNodeCount++;
+    }
+
+    bool TransformHierarchy::SetParent(EngineHandle object, EngineHandle parent)
+    {
+        MX_ASSERT(IsRegistered(object, impl));
+        MX_ASSERT(parent == InvalidHandle || IsRegistered(parent, impl));
+
+        auto& currentParent = impl->ObjectParents[object];
+        if (currentParent == parent) return true;
+
+        for (auto ancestor = parent; ancestor != InvalidHandle; ancestor = impl->ObjectParents[ancestor])
+        {
+            if (ancestor == object) return false;
+        }
+
+        if (currentParent != InvalidHandle)
+        {
+            auto& siblings = impl->ObjectChildren[currentParent];
+            siblings.erase(std::find(siblings.begin(), siblings.end(), object));
+        }
+        if (parent != InvalidHandle)
+        {
+            impl->ObjectChildren[parent].push_back(object);
+        }
+
+        currentParent = parent;
+        TransformHierarchy::MarkDirty(object);
+
+        // node order is only changed if new parent goes after object, in this case whole subtree is moved after parent
+        size_t node = impl->ObjectNodes[object];
+        size_t parentNode = parent != InvalidHandle ? impl->ObjectNodes[parent] : Impl::InvalidNode;
+        if (parentNode != Impl::InvalidNode && parentNode > node)
+            MoveSubtreeToBack(object, impl);
+        else
+            impl->Parents[node] = parentNode;
+        return true;
+    }
+
+    TransformHierarchy::EngineHandle TransformHierarchy::GetParent(EngineHandle object)
+    {
+        return IsRegistered(object, impl) ? impl->ObjectParents[object] : InvalidHandle;
+    }
+
+    const MxVector<TransformHierarchy::EngineHandle>& TransformHierarchy::GetChildren(EngineHandle object)
+    {
+        return IsRegistered(object, impl) ? impl->ObjectChildren[object] : impl->EmptyList;
+    }
+
+    static void QueueSubtree(size_t root, TransformHierarchyImpl* impl)
+    {
+        // subtree is skipped if its root was already queued as part of another dirty subtree
+        if ((impl->Flags[root] & Impl::QUEUED) != 0) return;
+
+        auto& queue = impl->UpdateQueue;
+        size_t first = queue.size();
+        impl->Flags[root] |= Impl::QUEUED;
+        queue.push_back(root);
+        for (size_t i = first; i < queue.size(); i++)
+        {
+            for (auto child : impl->ObjectChildren[impl->Objects[queue[i]]])
+            {
+                size_t childNode = impl->ObjectNodes[child];
+                if ((impl->Flags[childNode] & Impl::QUEUED) != 0) continue;
+                impl->Flags[childNode] |= Impl::QUEUED;
+                queue.push_back(childNode);
+            }
+        }
+    }
+
+    void TransformHierarchy::Update()
+    {
+        MAKE_SCOPE_PROFILER("TransformHierarchy::Update()");
+
+        if (impl->RemovedNodeCount >= Impl::MinCompactedNodes && impl->RemovedNodeCount * 2 >= impl->Objects.size())
+            CompactNodes(impl);
+
+        auto& queue = impl->UpdateQueue;
+        queue.clear();
+        for (auto object : impl->DirtyObjects)
+        {
+            impl->IsObjectDirty[object] = 0;
+            if (IsRegistered(object, impl)) QueueSubtree(impl->ObjectNodes[object], impl);
+        }
+        impl->DirtyObjects.clear();
+        // parent node index is always less than child node index, so sorting by node index puts parents before their children
+        std::sort(queue.begin(), queue.end());
+
+        auto& objects = Factory<MxObject>::GetPool();
+        for (size_t node : queue)
+        {
+            auto object = impl->Objects[node];
+            const auto& local = objects[object].value.LocalTransform;
+            size_t parent = impl->Parents[node];
+
+            const auto& localScale = local.GetScale();
+            bool isUniformScale = localScale.x == localScale.y && localScale.y == localScale.z;
+            auto& worldMatrix = impl->WorldMatrices[node];
+            if (parent == Impl::InvalidNode)
+            {
+                worldMatrix = local.GetMatrix();
+                impl->WorldPositions[node] = local.GetPosition();
+                impl->WorldRotations[node] = local.GetRotationQuaternion();
+                impl->WorldScales[node] = localScale;
+            }
+            else
+            {
+                worldMatrix = impl->WorldMatrices[parent] * local.GetMatrix();
+                impl->WorldPositions[node] = Vector3(worldMatrix[3]);
+                impl->WorldRotations[node] = impl->WorldRotations[parent] * local.GetRotationQuaternion();
+                impl->WorldScales[node] = impl->WorldScales[parent] * localScale;
+                isUniformScale = isUniformScale && (impl->Flags[parent] & Impl::UNIFORM_SCALE) != 0;
+            }
+
+            // normal matrix only differs from model matrix if object is scaled non-uniformly
+            impl->WorldNormalMatrices[node] = isUniformScale ? Matrix3x3(worldMatrix) : Transpose(Inverse(Matrix3x3(worldMatrix)));
+            impl->WorldVersions[node]++;
+
+            if (impl->IsObjectChanged[object] == 0)
+            {
+                impl->IsObjectChanged[object] = 1;
+                impl->ChangedObjects.push_back(object);
+            }
+            impl->Flags[node] = isUniformScale ? Impl::UNIFORM_SCALE : 0;
+        }
+        impl->UpdatedCount = queue.size();
+    }
+
+    const Matrix4x4& TransformHierarchy::GetWorldMatrix(EngineHandle object)
+    {
+        return impl->WorldMatrices[GetNode(object, impl)];
+    }
+
+    const Matrix3x3& TransformHierarchy::GetWorldNormalMatrix(EngineHandle object)
+    {
+        return impl->WorldNormalMatrices[GetNode(object, impl)];
+    }
+
+    const Vector3& TransformHierarchy::GetWorldPosition(EngineHandle object)
+    {
+        return impl->WorldPositions[GetNode(object, impl)];
+    }
+
+    const Quaternion& TransformHierarchy::GetWorldRotation(EngineHandle object)
+    {
+        return impl->WorldRotations[GetNode(object, impl)];
+    }
+
+    const Vector3& TransformHierarchy::GetWorldScale(EngineHandle object)
+    {
+        return impl->WorldScales[GetNode(object, impl)];
+    }
+
+    Transform TransformHierarchy::GetWorldTransform(EngineHandle object)
+    {
+        size_t node = GetNode(object, impl);
+        Transform result;
+        result.SetPosition(impl->WorldPositions[node]);
+        result.SetRotation(impl->WorldRotations[node]);
+        result.SetScale(impl->WorldScales[node]);
+        return result;
+    }
+
+    uint32_t TransformHierarchy::GetWorldVersion(EngineHandle object)
+    {
+        return impl->WorldVersions[GetNode(object, impl)];
+    }
+
+    size_t TransformHierarchy::GetUpdatedCount()
+    {
+        return impl->UpdatedCount;
+    }
+
+    void TransformHierarchy::ConsumeChangedObjects(MxVector<EngineHandle>& result)
+    {
+        result.clear();
+        std::swap(result, impl->ChangedObjects);
+        for (auto object : result)
+            impl->IsObjectChanged[object] = 0;
+    }
+}
@@ -0,0 +1,109 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include "Core/Components/Transform.h"
+#include "Utilities/STL/MxVector.h"
+
+#include <limits>
+
+namespace MxEngine
+{
+    struct TransformHierarchyImpl;
+
+    /*!
+    transform hierarchy stores parent-child relations between MxObjects and caches their world matrices
+    cached data is kept in contiguous arrays (one array per attribute) where each parent is placed before its children, so parents are always processed first
+    reparenting moves only the affected subtree, removed objects leave holes in arrays, which are compacted when they make up at least half of all nodes
+    world matrices are recomputed in TransformHierarchy::Update() only for objects which local transform changed and for their subtrees
+    changed objects are reported by Transform setters, so update cost does not depend on number of unchanged objects
+    */
+    class TransformHierarchy
+    {
+        inline static TransformHierarchyImpl* impl = nullptr;
+    public:
+        using EngineHandle = size_t;
+        constexpr static EngineHandle InvalidHandle = std::numeric_limits<EngineHandle>::max();
+
+        static void Init();
+        static void Destroy();
+        static TransformHierarchyImpl* GetImpl();
+        static void Clone(TransformHierarchyImpl* other);
+
+        static void AddObject(EngineHandle object);
+        static void RemoveObject(EngineHandle object);
+
+        /*!
+        attaches object to parent. Local transform of object is not changed, so it is now treated relative to parent
+        \param object object to attach
+        \param parent new parent object or InvalidHandle to make object a root
+        \returns true if parent was changed, false if it would create a cycle
+        */
+        static bool SetParent(EngineHandle object, EngineHandle parent);
+        static EngineHandle GetParent(EngineHandle object);
+        /*!
+        queues object for world matrix update. Called by setters of object LocalTransform, so it rarely needs to be called directly
+        */
+        static void MarkDirty(EngineHandle object);
+        static const MxVector<EngineHandle>& GetChildren(EngineHandle object);
+
+        /*!
+        propagates changed local transforms to world matrices. Called once per frame before rendering
+        */
+        static void Update();
+
+        /*!
+        world matrices are cached, so they reflect local transforms at the moment of last TransformHierarchy::Update() call
+        */
+        static const Matrix4x4& GetWorldMatrix(EngineHandle object);
+        static const Matrix3x3& GetWorldNormalMatrix(EngineHandle object);
+        static const Vector3& GetWorldPosition(EngineHandle object);
+        static const Quaternion& GetWorldRotation(EngineHandle object);
+        static const Vector3& GetWorldScale(EngineHandle object);
+        /*!
+        gets world transform decomposed into position, rotation and scale. Result is approximate if hierarchy contains non-uniform scale
+        */
+        static Transform GetWorldTransform(EngineHandle object);
+        /*!
+        gets counter which is incremented each time world matrix of object is recomputed
+        */
+        static uint32_t GetWorldVersion(EngineHandle object);
+        /*!
+        gets number of world matrices recomputed by last TransformHierarchy::Update() call
+        */
+        static size_t GetUpdatedCount();
+        /*!
+        moves objects which world matrices were recomputed since last call to result. Each object is reported once,
+        objects which were removed after their update are reported too, so caller must validate them
+        \param result vector where changed object handles are stored. It is cleared before objects are added
+        */
+        static void ConsumeChangedObjects(MxVector<EngineHandle>& result);
+    };
+}
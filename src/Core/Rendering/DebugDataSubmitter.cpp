@@ -40,19 +40,19 @@ namespace MxEngine
         {
             if (debugDraw.RenderBoundingBox)
             {
-                for (const auto& submesh : meshSource->Mesh->GetSubMeshes())
+                for (const auto& submesh : meshSource->GetMesh()->GetSubMeshes())
                 {
-                    auto box = submesh.GetAABB() * (object.LocalTransform.GetMatrix() * submesh.GetTransform().GetMatrix());
+                    auto box = submesh.GetAABB() * (object.GetWorldMatrix() * submesh.GetTransform().GetMatrix());
                     buffer.Submit(box, debugDraw.BoundingBoxColor);
                 }
             }
             if (debugDraw.RenderBoundingSphere)
             {
-                for (const auto& submesh : meshSource->Mesh->GetSubMeshes())
+                for (const auto& submesh : meshSource->GetMesh()->GetSubMeshes())
                 {
                     auto sphere = submesh.GetBoundingSphere();
-                    sphere.Center += object.LocalTransform.GetPosition() + submesh.GetTransform().GetPosition();
-                    sphere.Radius *= ComponentMax(object.LocalTransform.GetScale() * submesh.GetTransform().GetScale());
+                    sphere.Center += TransformHierarchy::GetWorldPosition(object.GetNativeHandle()) + submesh.GetTransform().GetPosition();
+                    sphere.Radius *= ComponentMax(TransformHierarchy::GetWorldScale(object.GetNativeHandle()) * submesh.GetTransform().GetScale());
                     buffer.Submit(sphere, debugDraw.BoundingSphereColor);
                 }
             }
@@ -63,7 +63,7 @@ namespace MxEngine
     {
         if (debugDraw.RenderLightingBounds && pointLight.IsValid())
         {
-            BoundingSphere sphere(object.LocalTransform.GetPosition(), pointLight->GetRadius());
+            BoundingSphere sphere(TransformHierarchy::GetWorldPosition(object.GetNativeHandle()), pointLight->GetRadius());
             buffer.Submit(sphere, debugDraw.LightSourceColor);
         }
     }
@@ -72,7 +72,7 @@ namespace MxEngine
     {
         if (debugDraw.RenderLightingBounds && spotLight.IsValid())
         {
-            Cone cone(object.LocalTransform.GetPosition(), spotLight->Direction, 3.0f, spotLight->GetOuterAngle());
+            Cone cone(TransformHierarchy::GetWorldPosition(object.GetNativeHandle()), spotLight->Direction, 3.0f, spotLight->GetOuterAngle());
             buffer.Submit(cone, debugDraw.LightSourceColor);
         }
     }
@@ -85,12 +85,12 @@ namespace MxEngine
             {
                 if (audioSource->IsOmnidirectional())
                 {
-                    BoundingSphere sphere(object.LocalTransform.GetPosition(), 3.0f);
+                    BoundingSphere sphere(TransformHierarchy::GetWorldPosition(object.GetNativeHandle()), 3.0f);
                     buffer.Submit(sphere, debugDraw.SoundSourceColor);
                 }
                 else
                 {
-                    Cone cone(object.LocalTransform.GetPosition(), audioSource->GetDirection(), 3.0f, audioSource->GetOuterAngle());
+                    Cone cone(TransformHierarchy::GetWorldPosition(object.GetNativeHandle()), audioSource->GetDirection(), 3.0f, audioSource->GetOuterAngle());
                     buffer.Submit(cone, debugDraw.SoundSourceColor);
                 }
             }
@@ -105,7 +105,7 @@ namespace MxEngine
             auto up = cameraController->GetDirectionUp();
             auto aspect = cameraController->Camera.GetAspectRatio();
             auto zoom = cameraController->Camera.GetZoom() * 65.0f;
-            Frustrum frustrum(object.LocalTransform.GetPosition() + Normalize(direction), direction, up, zoom, aspect);
+            Frustrum frustrum(TransformHierarchy::GetWorldPosition(object.GetNativeHandle()) + Normalize(direction), direction, up, zoom, aspect);
             buffer.Submit(frustrum, debugDraw.FrustrumColor);
         }
     }
@@ -131,13 +131,14 @@ namespace MxEngine
 
             if (compoundCollider.IsValid())
             {
+                auto worldTransform = object.GetWorldTransform();
                 for (size_t i = 0; i < compoundCollider->GetShapeCount(); i++)
                 {
                     auto& child = compoundCollider->GetShapeByIndex(i);
                     auto childTransform = compoundCollider->GetShapeTransformByIndex(i);
-                    childTransform.SetPosition(childTransform.GetPosition() * object.LocalTransform.GetScale());
+                    childTransform.SetPosition(childTransform.GetPosition() * worldTransform.GetScale());
 
-                    std::visit([&buffer, &debugDraw, transform = childTransform * object.LocalTransform](auto&& shape) mutable
+                    std::visit([&buffer, &debugDraw, transform = childTransform * worldTransform](auto&& shape) mutable
                     {
                         buffer.Submit(shape->GetNativeBoundingTransformed(transform), debugDraw.BoundingBoxColor);
                     }, child);
@@ -49,7 +49,10 @@
 #include "Core/Components/Instancing/InstanceFactory.h"
 #include "Core/Rendering/DebugDataSubmitter.h"
 #include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Concurrency/ThreadPool.h"
+#include "Utilities/Memory/FrameArena.h"
 #include "Utilities/FileSystem/FileManager.h"
+#include "Platform/OpenGL/UniformBlocks.h"
 
 namespace MxEngine
 {
@@ -60,9 +63,29 @@ namespace MxEngine
 
         this->SetRenderToDefaultFrameBuffer();
 
+        // render units are rebuilt only for objects which mesh components were added, removed or changed
+        ComponentFactory::GetOwnerSet<MeshSource>().EnableJournal();
+        ComponentFactory::GetOwnerSet<MeshRenderer>().EnableJournal();
+        ComponentFactory::GetOwnerSet<MeshLOD>().EnableJournal();
+        ComponentFactory::GetOwnerSet<InstanceFactory>().EnableJournal();
+        for (size_t owner : ComponentFactory::GetOwnerSet<MeshSource>().GetOwners())
+            this->QueueRebuild(owner);
+
         environment.RenderVAO = BufferAllocator::GetVAO();
         environment.RenderSSBO = BufferAllocator::GetSSBO();
 
+        // uniform blocks shared by all shaders, see Platform/OpenGL/UniformBlocks.h
+        environment.CameraUniformBuffer = Factory<UniformBuffer>::Create((CameraUniformBlock*)nullptr, 1, UsageType::DYNAMIC_DRAW);
+        environment.EnvironmentUniformBuffer = Factory<UniformBuffer>::Create((EnvironmentUniformBlock*)nullptr, 1, UsageType::DYNAMIC_DRAW);
+        environment.LightingUniformBuffer = Factory<UniformBuffer>::Create((LightingUniformBlock*)nullptr, 1, UsageType::DYNAMIC_DRAW);
+
+        // multi-draw indirect buffers. gl_DrawID is core only since OpenGL 4.6, older contexts use per-unit draws
+        auto& indirectDraw = this->Renderer.GetIndirectDrawInformation();
+        indirectDraw.UnitDataBuffer = Factory<ShaderStorageBuffer>::Create((RenderUnitGPUData*)nullptr, 0, UsageType::DYNAMIC_DRAW);
+        indirectDraw.DrawUnitIndexBuffer = Factory<ShaderStorageBuffer>::Create((uint32_t*)nullptr, 0, UsageType::DYNAMIC_DRAW);
+        indirectDraw.CommandBuffer = Factory<DrawIndirectBuffer>::Create(nullptr, 0, UsageType::DYNAMIC_DRAW);
+        this->SetIndirectDrawing(GlobalConfig::GetGraphicAPIMajorVersion() * 10 + GlobalConfig::GetGraphicAPIMinorVersion() >= 46);
+
         // helper objects
         environment.RectangularObject.Init(1.0f);
         environment.SkyboxCubeObject.Init();
@@ -141,6 +164,29 @@ namespace MxEngine
             shaderFolder / "gbuffer_mask_fragment.glsl"
         );
 
+        if (this->IsIndirectDrawingEnabled())
+        {
+            environment.Shaders["GBufferIndirect"_id] = AssetManager::LoadShader(
+                shaderFolder / "gbuffer_indirect_vertex.glsl",
+                shaderFolder / "gbuffer_fragment.glsl"
+            );
+
+            environment.Shaders["GBufferMaskIndirect"_id] = AssetManager::LoadShader(
+                shaderFolder / "gbuffer_indirect_vertex.glsl",
+                shaderFolder / "gbuffer_mask_fragment.glsl"
+            );
+
+            environment.Shaders["DepthMapIndirect"_id] = AssetManager::LoadShader(
+                shaderFolder / "depthtexture_indirect_vertex.glsl",
+                shaderFolder / "depthtexture_fragment.glsl"
+            );
+
+            environment.Shaders["MaskDepthMapIndirect"_id] = AssetManager::LoadShader(
+                shaderFolder / "depthtexture_indirect_vertex.glsl",
+                shaderFolder / "depthtexture_mask_fragment.glsl"
+            );
+        }
+
         environment.Shaders["Transparent"_id] = AssetManager::LoadShader(
             shaderFolder / "gbuffer_vertex.glsl", 
             shaderFolder / "transparent_fragment.glsl"
@@ -312,6 +358,10 @@ namespace MxEngine
         environment.ComputeShaders["Particle"_id] = AssetManager::LoadComputeShader(
             shaderFolder / "particle_compute.glsl"
         );
+        environment.ComputeShaders["InstanceGather"_id] = AssetManager::LoadComputeShader(
+            shaderFolder / "instance_gather_compute.glsl"
+        );
+        this->Renderer.GetInstanceCuller().Init(environment.ComputeShaders["InstanceGather"_id]);
 
         // framebuffers
         environment.DepthFrameBuffer = Factory<FrameBuffer>::Create();
@@ -337,7 +387,7 @@ namespace MxEngine
         float viewportZoom = 0.0f;
         if (this->Viewport.IsValid())
         {
-            viewportPosition = MxObject::GetByComponent(*this->Viewport).LocalTransform.GetPosition();
+            viewportPosition = TransformHierarchy::GetWorldPosition(MxObject::GetByComponent(*this->Viewport).GetNativeHandle());
             viewportZoom = this->Viewport->Camera.GetZoom();
         }
 
@@ -360,7 +410,7 @@ namespace MxEngine
             for (const auto& camera : cameraView)
             {
                 auto& object = MxObject::GetByComponent(camera);
-                auto& transform = object.LocalTransform;
+                auto transform = object.GetWorldTransform();
 
                 auto skyboxComponent = object.GetComponent<Skybox>();
                 auto effectsComponent = object.GetComponent<CameraEffects>();
@@ -381,47 +431,9 @@ namespace MxEngine
         }
 
         // submit render units
-        auto meshSourceView = ComponentFactory::GetView<MeshSource>();
         {
             MAKE_SCOPE_PROFILER("RenderAdaptor::SubmitMeshPrimitives()");
-            for (const auto& meshSource : meshSourceView)
-            {
-                auto& object = MxObject::GetByComponent(meshSource);
-                auto& transform = object.LocalTransform;
-                auto meshRenderer = object.GetComponent<MeshRenderer>();
-                auto meshLOD = object.GetComponent<MeshLOD>();
-                auto instances = object.GetComponent<InstanceFactory>();
-
-                size_t instanceCount = 0, instanceOffset = 0;
-                if (instances.IsValid())
-                {
-                    instanceCount = instances->GetInstanceCount();
-                    instanceOffset = instances->GetInstanceBufferOffset();
-                    if (instanceCount == 0) continue; // skip objects without instances
-                }
-
-                auto mesh = meshSource.Mesh;
-                bool castsShadow = meshSource.CastsShadow;
-
-                if (!meshSource.IsDrawn || !meshRenderer.IsValid() || !mesh.IsValid()) continue;
-
-                // we do not try to use LODs for instanced objects, as its quite hard and time consuming. TODO: fix this
-                if (meshLOD.IsValid() && instanceCount == 0)
-                {
-                    meshLOD->FixBestLOD(viewportPosition, viewportZoom);
-                    mesh = meshLOD->GetMeshLOD();
-                }
-
-                size_t renderGroupIndex = this->Renderer.SubmitRenderGroup(*mesh, instanceOffset, instanceCount);
-                for (const auto& submesh : mesh->GetSubMeshes())
-                {
-                    auto materialId = submesh.GetMaterialId();
-                    if (materialId >= meshRenderer->Materials.size()) continue;
-                    auto material = meshRenderer->Materials[materialId];
-
-                    this->Renderer.SubmitRenderUnit(renderGroupIndex, submesh, *material, transform, castsShadow, object.Name.c_str());
-                }
-            }
+            this->SubmitMeshSources(viewportPosition, viewportZoom);
         }
 
         {
@@ -431,10 +443,10 @@ namespace MxEngine
             {
                 auto& object = MxObject::GetByComponent(particleSystem);
                 auto meshRenderer = (IsInstance(object) ? *GetInstanceParent(object) : object).GetComponent<MeshRenderer>();
-                if (!meshRenderer.IsValid() || meshRenderer->Materials.empty())
+                if (!meshRenderer.IsValid() || meshRenderer->GetMaterials().empty())
                     continue;
 
-                auto& transform = MxObject::GetByComponent(particleSystem).LocalTransform;
+                auto transform = object.GetWorldTransform();
                 this->Renderer.SubmitParticleSystem(particleSystem, *meshRenderer->GetMaterial(), transform);
             }
         }
@@ -444,21 +456,21 @@ namespace MxEngine
             auto dirLightView = ComponentFactory::GetView<DirectionalLight>();
             for (const auto& dirLight : dirLightView)
             {
-                auto& transform = MxObject::GetByComponent(dirLight).LocalTransform;
+                auto transform = MxObject::GetByComponent(dirLight).GetWorldTransform();
                 this->Renderer.SubmitLightSource(dirLight, transform);
             }
 
             auto spotLightView = ComponentFactory::GetView<SpotLight>();
             for (const auto& spotLight : spotLightView)
             {
-                auto& transform = MxObject::GetByComponent(spotLight).LocalTransform;
+                auto transform = MxObject::GetByComponent(spotLight).GetWorldTransform();
                 this->Renderer.SubmitLightSource(spotLight, transform);
             }
 
             auto pointLightView = ComponentFactory::GetView<PointLight>();
             for (const auto& pointLight : pointLightView)
             {
-                auto& transform = MxObject::GetByComponent(pointLight).LocalTransform;
+                auto transform = MxObject::GetByComponent(pointLight).GetWorldTransform();
                 this->Renderer.SubmitLightSource(pointLight, transform);
             }
         }
@@ -484,9 +496,453 @@ namespace MxEngine
         }
 
         this->Renderer.GetRenderStatistics().ResetAll();
+        size_t unitCount = this->Renderer.GetRenderUnitCount();
+        this->Renderer.GetRenderStatistics().AddEntry("submitted objects", this->submittedObjectCount);
+        this->Renderer.GetRenderStatistics().AddEntry("reused render units", unitCount - Min(unitCount, this->rebuiltUnitCount + this->movedUnitCount));
+        this->Renderer.GetRenderStatistics().AddEntry("rebuilt render units", this->rebuiltUnitCount);
+        this->Renderer.GetRenderStatistics().AddEntry("moved render units", this->movedUnitCount);
+        this->Renderer.GetRenderStatistics().AddEntry("frame arena bytes", FrameArena::GetGlobal().GetLastFrameUsedBytes());
+        this->Renderer.GetRenderStatistics().AddEntry("frame arena block allocations", FrameArena::GetGlobal().GetLastFrameBlockAllocations());
         this->Renderer.StartPipeline();
     }
 
+    // submesh state which render units of mesh were built from. If it differs from mesh, units of all objects using the mesh are rebuilt
+    static void CaptureMeshState(RenderMeshRecord& record)
+    {
+        const auto& submeshes = record.Mesh->GetSubMeshes();
+        record.SubMeshes.resize(submeshes.size());
+        for (size_t i = 0; i < submeshes.size(); i++)
+        {
+            const auto& submesh = submeshes[i];
+            auto& state = record.SubMeshes[i];
+            state.SubMeshTransform = submesh.GetTransform();
+            state.SubMeshAABB = submesh.Data.GetAABB();
+            state.MaterialId = submesh.GetMaterialId();
+            state.VertexOffset = submesh.Data.GetVerteciesOffset();
+            state.VertexCount = submesh.Data.GetVerteciesCount();
+            state.IndexOffset = submesh.Data.GetIndiciesOffset();
+            state.IndexCount = submesh.Data.GetIndiciesCount();
+        }
+    }
+
+    static bool IsMeshStateValid(const RenderMeshRecord& record)
+    {
+        if (!record.Mesh.IsValid()) return false;
+
+        const auto& submeshes = record.Mesh->GetSubMeshes();
+        if (submeshes.size() != record.SubMeshes.size()) return false;
+
+        for (size_t i = 0; i < submeshes.size(); i++)
+        {
+            const auto& submesh = submeshes[i];
+            const auto& state = record.SubMeshes[i];
+            bool isSame =
+                state.SubMeshTransform == submesh.GetTransform()          &&
+                state.SubMeshAABB      == submesh.Data.GetAABB()          &&
+                state.MaterialId       == submesh.GetMaterialId()         &&
+                state.VertexOffset     == submesh.Data.GetVerteciesOffset() &&
+                state.VertexCount      == submesh.Data.GetVerteciesCount()  &&
+                state.IndexOffset      == submesh.Data.GetIndiciesOffset()  &&
+                state.IndexCount       == submesh.Data.GetIndiciesCount();
+            if (!isSame) return false;
+        }
+        return true;
+    }
+
+    static size_t GetLODCount(const MeshLOD* meshLOD)
+    {
+        return meshLOD != nullptr ? meshLOD->ClampLOD(MeshLOD::MaxLODLevel) + 1 : 1;
+    }
+
+    static const MeshHandle& GetLODMesh(const MeshLOD* meshLOD, const MeshHandle& mesh, size_t lod)
+    {
+        if (meshLOD == nullptr) return mesh;
+        const auto& lodMesh = meshLOD->GetMeshLOD(lod);
+        return lodMesh.IsValid() ? lodMesh : mesh;
+    }
+
+    void RenderAdaptor::QueueRebuild(size_t object)
+    {
+        if (object >= this->renderObjects.size())
+            this->renderObjects.resize(object + 1);
+
+        auto& record = this->renderObjects[object];
+        if (record.IsRebuildQueued) return;
+        record.IsRebuildQueued = true;
+        this->rebuildQueue.push_back(object);
+    }
+
+    void RenderAdaptor::QueueGeometryUpdate(size_t object)
+    {
+        auto& record = this->renderObjects[object];
+        if (record.IsGeometryQueued) return;
+        record.IsGeometryQueued = true;
+        this->geometryQueue.push_back(object);
+    }
+
+    void RenderAdaptor::ValidateRenderMeshes()
+    {
+        // meshes may be loaded asynchronously or edited, so their submeshes are compared once per frame for each distinct mesh
+        for (auto& [meshKey, meshRecord] : this->renderMeshes)
+        {
+            if (IsMeshStateValid(meshRecord)) continue;
+
+            for (const auto& dependent : meshRecord.Dependents)
+                this->QueueRebuild(dependent.Object);
+            if (meshRecord.Mesh.IsValid()) CaptureMeshState(meshRecord);
+        }
+    }
+
+    void RenderAdaptor::ValidateMeshLODs(const Vector3& viewportPosition, float viewportZoom)
+    {
+        // LOD of regular object depends on viewport, so it is selected every frame, but units are rebuilt only if selected mesh changed
+        auto meshLODView = ComponentFactory::GetView<MeshLOD>();
+        for (auto& meshLOD : meshLODView)
+        {
+            size_t object = MxObject::GetByComponent(meshLOD).GetNativeHandle();
+            if (object >= this->renderObjects.size()) continue;
+
+            const auto& record = this->renderObjects[object];
+            if (record.IsRebuildQueued || record.Meshes.empty() || record.InstancedSlot != InvalidRenderObject) continue;
+
+            meshLOD.FixBestLOD(viewportPosition, viewportZoom);
+            const auto& mesh = GetLODMesh(&meshLOD, meshLOD.GetMeshLOD(0), meshLOD.GetCurrentLOD());
+            const auto& objectMesh = record.Meshes.front();
+            if (mesh.GetHandle() != objectMesh.MeshKey || mesh.GetUUID() != objectMesh.MeshId)
+                this->QueueRebuild(object);
+        }
+
+        // instanced objects draw all LODs at once, so only set of LOD meshes is checked
+        for (const auto& instanced : this->instancedObjects)
+        {
+            if (instanced.Object == InvalidRenderObject) continue;
+
+            // object may be already destroyed if it was queued for rebuild
+            const auto& record = this->renderObjects[instanced.Object];
+            if (record.IsRebuildQueued) continue;
+
+            auto& object = Factory<MxObject>::GetPool()[instanced.Object].value;
+            auto meshSource = object.GetComponent<MeshSource>();
+            auto meshLOD = object.GetComponent<MeshLOD>();
+            const MeshLOD* instanceLOD = meshLOD.IsValid() ? meshLOD.GetUnchecked() : nullptr;
+
+            size_t lodCount = GetLODCount(instanceLOD);
+            bool isSame = lodCount == record.Meshes.size();
+            for (size_t lod = 0; isSame && lod < lodCount; lod++)
+            {
+                const auto& mesh = GetLODMesh(instanceLOD, meshSource->GetMesh(), lod);
+                isSame = mesh.GetHandle() == record.Meshes[lod].MeshKey && mesh.GetUUID() == record.Meshes[lod].MeshId;
+            }
+            if (!isSame) this->QueueRebuild(instanced.Object);
+        }
+    }
+
+    void RenderAdaptor::AddRenderObjectMesh(size_t object, const MeshHandle& mesh, const MeshRenderer& meshRenderer, bool castsShadow, size_t instanceBucket)
+    {
+        auto& record = this->renderObjects[object];
+        size_t meshKey = mesh.GetHandle();
+        auto it = this->renderMeshes.find(meshKey);
+        if (it == this->renderMeshes.end())
+        {
+            it = this->renderMeshes.insert({ meshKey, RenderMeshRecord{ } }).first;
+            it->second.Mesh = mesh;
+            CaptureMeshState(it->second);
+        }
+
+        auto& meshRecord = it->second;
+        auto& objectMesh = record.Meshes.emplace_back();
+        objectMesh.MeshKey = meshKey;
+        objectMesh.MeshId = mesh.GetUUID();
+        objectMesh.DependentIndex = meshRecord.Dependents.size();
+        meshRecord.Dependents.push_back(RenderMeshDependent{ object, record.Meshes.size() - 1 });
+
+        const auto& submeshes = mesh->GetSubMeshes();
+        const auto& materials = meshRenderer.GetMaterials();
+        objectMesh.Units.resize(submeshes.size(), RenderController::InvalidRenderUnit);
+        for (size_t i = 0; i < submeshes.size(); i++)
+        {
+            auto materialId = submeshes[i].GetMaterialId();
+            if (materialId >= materials.size() || !materials[materialId].IsValid()) continue;
+
+            objectMesh.Units[i] = this->Renderer.AddRenderUnit(submeshes[i], materials[materialId], castsShadow, instanceBucket);
+            this->rebuiltUnitCount++;
+        }
+    }
+
+    void RenderAdaptor::AddRenderObject(size_t object, const Vector3& viewportPosition, float viewportZoom)
+    {
+        // object could be destroyed or lose its MeshSource since it was queued
+        if (!ComponentFactory::GetOwnerSet<MeshSource>().Contains(object)) return;
+
+        auto& mxObject = Factory<MxObject>::GetPool()[object].value;
+        auto meshSource = mxObject.GetComponent<MeshSource>();
+        auto meshRenderer = mxObject.GetComponent<MeshRenderer>();
+        auto meshLOD = mxObject.GetComponent<MeshLOD>();
+        auto instances = mxObject.GetComponent<InstanceFactory>();
+
+        const auto& mesh = meshSource->GetMesh();
+        if (!meshSource->IsDrawn() || !meshRenderer.IsValid() || !mesh.IsValid()) return;
+        bool castsShadow = meshSource->CastsShadow();
+
+        auto& record = this->renderObjects[object];
+        if (!instances.IsValid())
+        {
+            const MeshHandle* lodMesh = &mesh;
+            if (meshLOD.IsValid())
+            {
+                meshLOD->FixBestLOD(viewportPosition, viewportZoom);
+                lodMesh = &GetLODMesh(meshLOD.GetUnchecked(), mesh, meshLOD->GetCurrentLOD());
+            }
+            this->AddRenderObjectMesh(object, *lodMesh, *meshRenderer, castsShadow, InstanceCuller::InvalidBucket);
+        }
+        else
+        {
+            // slot of instanced object is also its index in InstanceCuller, so it is kept even if object has no instances
+            size_t slot = this->instancedObjects.size();
+            if (!this->freeInstancedSlots.empty())
+            {
+                slot = this->freeInstancedSlots.back();
+                this->freeInstancedSlots.pop_back();
+            }
+            else
+            {
+                this->instancedObjects.emplace_back();
+            }
+            this->instancedObjects[slot].Object = object;
+            record.InstancedSlot = slot;
+
+            // instances are culled and bucketed by LOD before each pass, so every LOD of object is drawn from its own bucket
+            const MeshLOD* instanceLOD = meshLOD.IsValid() ? meshLOD.GetUnchecked() : nullptr;
+            size_t lodCount = GetLODCount(instanceLOD);
+            for (size_t lod = 0; lod < lodCount; lod++)
+            {
+                size_t instanceBucket = slot * InstanceCuller::MaxLODCount + lod;
+                this->AddRenderObjectMesh(object, GetLODMesh(instanceLOD, mesh, lod), *meshRenderer, castsShadow, instanceBucket);
+            }
+        }
+
+        this->submittedObjectCount++;
+        this->QueueGeometryUpdate(object);
+    }
+
+    void RenderAdaptor::RemoveRenderObject(size_t object)
+    {
+        auto& record = this->renderObjects[object];
+        if (!record.Meshes.empty()) this->submittedObjectCount--;
+
+        for (const auto& objectMesh : record.Meshes)
+        {
+            for (size_t unit : objectMesh.Units)
+            {
+                if (unit != RenderController::InvalidRenderUnit)
+                    this->Renderer.RemoveRenderUnit(unit);
+            }
+
+            // dependent is removed by moving last one to its place, so moved dependent has to know its new index
+            auto it = this->renderMeshes.find(objectMesh.MeshKey);
+            auto& dependents = it->second.Dependents;
+            dependents[objectMesh.DependentIndex] = dependents.back();
+            const auto& moved = dependents[objectMesh.DependentIndex];
+            this->renderObjects[moved.Object].Meshes[moved.MeshIndex].DependentIndex = objectMesh.DependentIndex;
+            dependents.pop_back();
+
+            if (dependents.empty()) this->renderMeshes.erase(it);
+        }
+        record.Meshes.clear();
+
+        if (record.InstancedSlot != InvalidRenderObject)
+        {
+            this->instancedObjects[record.InstancedSlot] = RenderInstancedRecord{ };
+            this->freeInstancedSlots.push_back(record.InstancedSlot);
+            record.InstancedSlot = InvalidRenderObject;
+        }
+    }
+
+    void RenderAdaptor::UpdateRenderGeometry()
+    {
+        // each chunk is processed by one thread into its own batch, batches are applied in order, so result does not depend on thread count
+        size_t chunkCount = ThreadPool::GetChunkCount(this->geometryQueue.size(), RenderAdaptor::SubmitChunkSize);
+        if (this->geometryBatches.size() < chunkCount)
+            this->geometryBatches.resize(chunkCount);
+
+        ThreadPool::GetGlobal().ParallelFor(chunkCount, [this](size_t chunk)
+        {
+            // this function is called from worker threads, so meshes are only accessed by reference, as copying handles modifies reference counters
+            auto& batch = this->geometryBatches[chunk];
+            batch.Units.clear();
+            batch.Geometry.clear();
+
+            size_t begin = chunk * RenderAdaptor::SubmitChunkSize;
+            size_t end = Min(begin + RenderAdaptor::SubmitChunkSize, this->geometryQueue.size());
+            for (size_t i = begin; i < end; i++)
+            {
+                size_t object = this->geometryQueue[i];
+                const auto& record = this->renderObjects[object];
+                if (record.Meshes.empty()) continue;
+
+                const auto& worldMatrix = TransformHierarchy::GetWorldMatrix(object);
+                const auto& worldNormalMatrix = TransformHierarchy::GetWorldNormalMatrix(object);
+                for (const auto& objectMesh : record.Meshes)
+                {
+                    const auto& submeshes = this->renderMeshes.find(objectMesh.MeshKey)->second.Mesh->GetSubMeshes();
+                    for (size_t j = 0; j < objectMesh.Units.size(); j++)
+                    {
+                        if (objectMesh.Units[j] == RenderController::InvalidRenderUnit) continue;
+
+                        batch.Units.push_back(objectMesh.Units[j]);
+                        RenderController::ComputeRenderUnitGeometry(submeshes[j], worldMatrix, worldNormalMatrix, batch.Geometry.emplace_back());
+                    }
+                }
+            }
+        }, this->submitThreadCount);
+
+        for (size_t chunk = 0; chunk < chunkCount; chunk++)
+        {
+            const auto& batch = this->geometryBatches[chunk];
+            for (size_t i = 0; i < batch.Units.size(); i++)
+                this->Renderer.UpdateRenderUnit(batch.Units[i], batch.Geometry[i]);
+            this->movedUnitCount += batch.Units.size();
+        }
+
+        for (size_t object : this->geometryQueue)
+            this->renderObjects[object].IsGeometryQueued = false;
+        this->geometryQueue.clear();
+    }
+
+    void RenderAdaptor::UpdateInstancedObjects(const Vector3& viewportPosition, float viewportZoom)
+    {
+        this->instancedUnits.resize(this->instancedObjects.size());
+
+        // instance buffer is updated only by main thread, so changed instance chunks are uploaded before workers compute bounds
+        for (const auto& instanced : this->instancedObjects)
+        {
+            if (instanced.Object == InvalidRenderObject) continue;
+            auto& object = Factory<MxObject>::GetPool()[instanced.Object].value;
+            object.GetComponent<InstanceFactory>()->UploadDirtyInstances();
+        }
+
+        ThreadPool::GetGlobal().ParallelFor(this->instancedObjects.size(), [this, &viewportPosition, viewportZoom](size_t slot)
+        {
+            auto& instanced = this->instancedObjects[slot];
+            auto& unit = this->instancedUnits[slot];
+            unit = InstancedObjectUnit{ 0, &instanced.InstanceAABBs, nullptr, 0 };
+            if (instanced.Object == InvalidRenderObject) return;
+
+            // components of object are owned by exactly one task, so they can be copied
+            auto& object = Factory<MxObject>::GetPool()[instanced.Object].value;
+            auto instances = object.GetComponent<InstanceFactory>();
+            auto meshSource = object.GetComponent<MeshSource>();
+            auto meshLOD = object.GetComponent<MeshLOD>();
+            const auto& instanceData = instances->GetInstanceCache();
+            const auto& mesh = meshSource->GetMesh();
+
+            auto parentVersion = TransformHierarchy::GetWorldVersion(instanced.Object);
+            bool isBoundsValid = instanced.IsBoundsValid &&
+                instanced.ParentVersion == parentVersion &&
+                instanced.MeshId == mesh.GetUUID();
+            bool isInstancesChanged = instanced.InstanceVersion != instances->GetInstanceVersion() ||
+                instanced.InstanceAABBs.Size() != instanceData.size();
+
+            if (!isBoundsValid || isInstancesChanged)
+            {
+                // instance matrix is applied before submesh transforms, so mesh bounds (which already include them) are used for all submeshes
+                const auto& meshAABB = mesh->MeshAABB;
+                const auto& objectMatrix = TransformHierarchy::GetWorldMatrix(instanced.Object);
+                const auto& chunkVersions = instances->GetChunkVersions();
+                instanced.InstanceAABBs.Resize(instanceData.size());
+
+                // if only instances were changed, bounds are recomputed for chunks uploaded after last update
+                for (size_t begin = 0; begin < instanceData.size(); begin += InstanceFactory::DirtyChunkSize)
+                {
+                    size_t chunk = begin / InstanceFactory::DirtyChunkSize;
+                    bool isChunkChanged = chunk >= chunkVersions.size() || chunkVersions[chunk] > instanced.InstanceVersion;
+                    if (isBoundsValid && !isChunkChanged) continue;
+
+                    size_t end = Min(begin + InstanceFactory::DirtyChunkSize, instanceData.size());
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        auto box = meshAABB * (objectMatrix * instanceData[i].Model);
+                        instanced.InstanceAABBs.Set(i, box.Min, box.Max);
+                    }
+                }
+                instanced.ParentVersion = parentVersion;
+                instanced.InstanceVersion = instances->GetInstanceVersion();
+                instanced.MeshId = mesh.GetUUID();
+                instanced.IsBoundsValid = true;
+            }
+
+            // LODs depend on viewport, so they are selected every frame
+            auto& lods = instanced.InstanceLODs;
+            lods.resize(instanceData.size());
+            if (!meshLOD.IsValid())
+            {
+                std::fill(lods.begin(), lods.end(), 0);
+            }
+            else if (!meshLOD->AutoLODSelection)
+            {
+                std::fill(lods.begin(), lods.end(), (uint8_t)meshLOD->GetCurrentLOD());
+            }
+            else
+            {
+                const auto& boxes = instanced.InstanceAABBs;
+                for (size_t i = 0; i < lods.size(); i++)
+                {
+                    AABB box{ Vector3(boxes.MinX[i], boxes.MinY[i], boxes.MinZ[i]), Vector3(boxes.MaxX[i], boxes.MaxY[i], boxes.MaxZ[i]) };
+                    lods[i] = (uint8_t)meshLOD->ClampLOD(MeshLOD::SelectLOD(box, viewportPosition, viewportZoom));
+                }
+            }
+
+            unit.InstanceBufferOffset = instances->GetInstanceBufferOffset();
+            unit.InstanceLODs = lods.data();
+            unit.InstanceCount = instanceData.size();
+        }, this->submitThreadCount);
+
+        // slots are added in order, so slot index is also object index in culler and its buckets match buckets of render units
+        auto& culler = this->Renderer.GetInstanceCuller();
+        culler.Clear();
+        for (const auto& unit : this->instancedUnits)
+            culler.AddObject(unit);
+    }
+
+    void RenderAdaptor::SubmitMeshSources(const Vector3& viewportPosition, float viewportZoom)
+    {
+        this->rebuiltUnitCount = 0;
+        this->movedUnitCount = 0;
+
+        // objects which mesh components were added, removed or changed since last frame
+        for (auto* ownerSet : { &ComponentFactory::GetOwnerSet<MeshSource>(), &ComponentFactory::GetOwnerSet<MeshRenderer>(),
+                                &ComponentFactory::GetOwnerSet<MeshLOD>(), &ComponentFactory::GetOwnerSet<InstanceFactory>() })
+        {
+            ownerSet->ConsumeJournal(this->changedObjects);
+            for (size_t object : this->changedObjects)
+                this->QueueRebuild(object);
+        }
+
+        this->ValidateRenderMeshes();
+        this->ValidateMeshLODs(viewportPosition, viewportZoom);
+        this->Renderer.UpdateRenderUnitMaterials();
+
+        // units of queued objects are removed and added again, other objects keep their units and list entries
+        for (size_t object : this->rebuildQueue)
+        {
+            this->renderObjects[object].IsRebuildQueued = false;
+            this->RemoveRenderObject(object);
+            this->AddRenderObject(object, viewportPosition, viewportZoom);
+        }
+        this->rebuildQueue.clear();
+
+        // objects which world matrices changed, removed objects have no units, so they are skipped
+        TransformHierarchy::ConsumeChangedObjects(this->changedObjects);
+        for (size_t object : this->changedObjects)
+        {
+            if (object < this->renderObjects.size() && !this->renderObjects[object].Meshes.empty())
+                this->QueueGeometryUpdate(object);
+        }
+
+        this->UpdateRenderGeometry();
+        this->UpdateInstancedObjects(viewportPosition, viewportZoom);
+    }
+
     void RenderAdaptor::SubmitRenderedFrame()
     {
         this->Renderer.EndPipeline();
@@ -508,4 +964,24 @@ namespace MxEngine
     {
         return this->Renderer.GetEnvironment().RenderToDefaultFrameBuffer;
     }
+
+    void RenderAdaptor::SetSubmitThreadCount(size_t threadCount)
+    {
+        this->submitThreadCount = threadCount;
+    }
+
+    size_t RenderAdaptor::GetSubmitThreadCount() const
+    {
+        return this->submitThreadCount;
+    }
+
+    void RenderAdaptor::SetIndirectDrawing(bool value)
+    {
+        this->Renderer.GetEnvironment().UseIndirectDrawing = value;
+    }
+
+    bool RenderAdaptor::IsIndirectDrawingEnabled() const
+    {
+        return this->Renderer.GetEnvironment().UseIndirectDrawing;
+    }
 }
\ No newline at end of file
@@ -33,18 +33,57 @@
 
 namespace MxEngine
 {
+    class MeshRenderer;
+
     struct RenderAdaptor
     {
+    private:
+        constexpr static size_t InvalidRenderObject = std::numeric_limits<size_t>::max();
+
+        /*!
+        render units of each object, indexed by object handle. Units are kept in renderer between frames,
+        so only objects which components, mesh or transform were changed are visited each frame
+        */
+        MxVector<RenderObjectRecord> renderObjects;
+        MxHashMap<size_t, RenderMeshRecord> renderMeshes;
+        MxVector<RenderInstancedRecord> instancedObjects;
+        MxVector<InstancedObjectUnit> instancedUnits;
+        MxVector<size_t> freeInstancedSlots;
+        MxVector<size_t> rebuildQueue;
+        MxVector<size_t> geometryQueue;
+        MxVector<size_t> changedObjects;
+        MxVector<RenderGeometryBatch> geometryBatches;
+        size_t submittedObjectCount = 0;
+        size_t rebuiltUnitCount = 0;
+        size_t movedUnitCount = 0;
+        size_t submitThreadCount = 0;
+
+        void SubmitMeshSources(const Vector3& viewportPosition, float viewportZoom);
+        void QueueRebuild(size_t object);
+        void QueueGeometryUpdate(size_t object);
+        void ValidateRenderMeshes();
+        void ValidateMeshLODs(const Vector3& viewportPosition, float viewportZoom);
+        void AddRenderObject(size_t object, const Vector3& viewportPosition, float viewportZoom);
+        void AddRenderObjectMesh(size_t object, const MeshHandle& mesh, const MeshRenderer& meshRenderer, bool castsShadow, size_t instanceBucket);
+        void RemoveRenderObject(size_t object);
+        void UpdateRenderGeometry();
+        void UpdateInstancedObjects(const Vector3& viewportPosition, float viewportZoom);
+    public:
         RenderController Renderer;
         DebugBuffer DebugDrawer;
         CameraController::Handle Viewport;
 
         constexpr static TextureFormat HDRTextureFormat = TextureFormat::RGBA16F;
+        constexpr static size_t SubmitChunkSize = 64;
         void InitRendererEnvironment();
         void RenderFrame();
         void SubmitRenderedFrame();
         void SetWindowSize(const VectorInt2& size);
         void SetRenderToDefaultFrameBuffer(bool value = true);
         bool IsRenderedToDefaultFrameBuffer() const;
+        void SetSubmitThreadCount(size_t threadCount);
+        size_t GetSubmitThreadCount() const;
+        void SetIndirectDrawing(bool value = true);
+        bool IsIndirectDrawingEnabled() const;
     };
 }
\ No newline at end of file
@@ -43,85 +43,74 @@
 #include "Utilities/Profiler/Profiler.h"
 #include "Platform/Compute/Compute.h"
 #include "RenderUtilities/ShadowMapGenerator.h"
+#include "Platform/OpenGL/UniformBlocks.h"
 
 namespace MxEngine
 {
-    constexpr size_t MaxDirLightCount = 4;
+    constexpr size_t MaxDirLightCount = LightingUniformBlock::MaxDirLightCount;
     constexpr size_t ParticleComputeGroupSize = 64;
 
+    // shadow maps are still bound as samplers, so their uniform names are spelled out to compute hashes at compile time
+    constexpr std::array<UniformId, MaxDirLightCount> LightDepthMapUniformIds = {
+        UNIFORM_ID("lightDepthMaps[0]"),
+        UNIFORM_ID("lightDepthMaps[1]"),
+        UNIFORM_ID("lightDepthMaps[2]"),
+        UNIFORM_ID("lightDepthMaps[3]"),
+    };
+
     void RenderController::PrepareShadowMaps()
     {
         MAKE_SCOPE_PROFILER("RenderController::PrepareShadowMaps()");
 
-        ShadowMapGenerator generatorOpaque(this->Pipeline.ShadowCasters, this->Pipeline.RenderUnits, this->Pipeline.MaterialUnits);
-        ShadowMapGenerator generatorMasked(this->Pipeline.MaskedShadowCasters, this->Pipeline.RenderUnits, this->Pipeline.MaterialUnits);
+        bool useIndirectDrawing = this->IsIndirectDrawingActive();
+        ShadowMapGenerator generator(this->Pipeline.ShadowCasters, this->Pipeline.MaskedShadowCasters, this->Pipeline.RenderUnits, this->Pipeline.RenderUnitsAABB, 
+            this->Pipeline.InstancedObjects, this->Pipeline.MaterialUnits, this->Pipeline.DrawCommands, useIndirectDrawing);
+
+        auto& shaders = this->Pipeline.Environment.Shaders;
+        const auto& dirLightShader = *shaders[useIndirectDrawing ? "DepthMapIndirect"_id : "DirLightDepthMap"_id];
+        const auto& dirLightMaskShader = *shaders[useIndirectDrawing ? "MaskDepthMapIndirect"_id : "DirLightMaskDepthMap"_id];
+        const auto& spotLightShader = *shaders[useIndirectDrawing ? "DepthMapIndirect"_id : "SpotLightDepthMap"_id];
+        const auto& spotLightMaskShader = *shaders[useIndirectDrawing ? "MaskDepthMapIndirect"_id : "SpotLightMaskDepthMap"_id];
 
         this->Pipeline.Environment.RenderVAO->Bind();
 
         {
             MAKE_SCOPE_PROFILER("RenderController::PrepareDirectionalLightMaps()");
-            generatorOpaque.GenerateFor(
-                *this->Pipeline.Environment.Shaders["DirLightDepthMap"_id], 
-                this->Pipeline.Lighting.DirectionalLights,
-                ShadowMapGenerator::LoadStoreOptions::CLEAR
-            );
-            generatorMasked.GenerateFor(
-                *this->Pipeline.Environment.Shaders["DirLightMaskDepthMap"_id],
-                this->Pipeline.Lighting.DirectionalLights,
-                ShadowMapGenerator::LoadStoreOptions::LOAD
-            );
+            generator.GenerateFor(dirLightShader, dirLightMaskShader, this->Pipeline.Lighting.DirectionalLights);
         }
 
         {
             MAKE_SCOPE_PROFILER("RenderController::PrepareSpotLightMaps()");
-            generatorOpaque.GenerateFor(
-                *this->Pipeline.Environment.Shaders["SpotLightDepthMap"_id], 
-                this->Pipeline.Lighting.SpotLights,
-                ShadowMapGenerator::LoadStoreOptions::CLEAR
-            );
-            generatorMasked.GenerateFor(
-                *this->Pipeline.Environment.Shaders["SpotLightMaskDepthMap"_id],
-                this->Pipeline.Lighting.SpotLights,
-                ShadowMapGenerator::LoadStoreOptions::LOAD
-            );
+            generator.GenerateFor(spotLightShader, spotLightMaskShader, this->Pipeline.Lighting.SpotLights);
         }
 
         {
             MAKE_SCOPE_PROFILER("RenderController::PreparePointLightMaps()");
-            generatorOpaque.GenerateFor(
-                *this->Pipeline.Environment.Shaders["PointLightDepthMap"_id], 
-                this->Pipeline.Lighting.PointLights,
-                ShadowMapGenerator::LoadStoreOptions::CLEAR
-            );
-            generatorMasked.GenerateFor(
-                *this->Pipeline.Environment.Shaders["PointLightDepthMap"_id],
-                this->Pipeline.Lighting.PointLights,
-                ShadowMapGenerator::LoadStoreOptions::LOAD
-            );
+            generator.GenerateFor(*shaders["PointLightDepthMap"_id], this->Pipeline.Lighting.PointLights);
         }
     }
     
-    void RenderController::ComputeParticles(const MxVector<ParticleSystemUnit>& particleSystems)
+    void RenderController::ComputeParticles(const FrameVector<ParticleSystemUnit>& particleSystems)
     {
         if (particleSystems.empty()) return;
         MAKE_SCOPE_PROFILER("RenderController::ComputeParticles()");
         
         auto& computeShader = this->Pipeline.Environment.ComputeShaders["Particle"_id];
         computeShader->Bind();
-        computeShader->SetUniform("dt", Min(Time::Delta(), 1.0f / 60.0f));
+        computeShader->SetUniform(UNIFORM_ID("dt"), Min(Time::Delta(), 1.0f / 60.0f));
 
         this->Pipeline.Environment.RenderSSBO->BindBase(0);
         for (const auto& particleSystem : particleSystems)
         {
-            computeShader->SetUniform("bufferOffset", (int)particleSystem.ParticleBufferOffset);
-            computeShader->SetUniform("lifetime", particleSystem.ParticleLifetime);
-            computeShader->SetUniform("spawnpoint", particleSystem.IsRelative ? Vector3(0.0f) : Vector3(particleSystem.Transform[3]));
+            computeShader->SetUniform(UNIFORM_ID("bufferOffset"), (int)particleSystem.ParticleBufferOffset);
+            computeShader->SetUniform(UNIFORM_ID("lifetime"), particleSystem.ParticleLifetime);
+            computeShader->SetUniform(UNIFORM_ID("spawnpoint"), particleSystem.IsRelative ? Vector3(0.0f) : Vector3(particleSystem.Transform[3]));
 
             Compute::Dispatch(computeShader, particleSystem.InvocationCount, 1, 1);
         }
     }
 
-    void RenderController::SortParticles(const CameraUnit& camera, MxVector<ParticleSystemUnit>& particleSystems)
+    void RenderController::SortParticles(const CameraUnit& camera, FrameVector<ParticleSystemUnit>& particleSystems)
     {
         std::sort(particleSystems.begin(), particleSystems.end(), 
             [&camera](const ParticleSystemUnit& p1, const ParticleSystemUnit& p2)
@@ -132,42 +121,39 @@ namespace MxEngine
             });
     }
 
-    void RenderController::DrawParticles(const CameraUnit& camera, MxVector<ParticleSystemUnit>& particleSystems, const Shader& shader)
+    void RenderController::DrawParticles(const CameraUnit& camera, FrameVector<ParticleSystemUnit>& particleSystems, const Shader& shader)
     {
         if (particleSystems.empty()) return;
         MAKE_SCOPE_PROFILER("RenderController::DrawParticles()");
         this->SortParticles(camera, particleSystems);
 
         shader.Bind();
-        shader.IgnoreNonExistingUniform("viewportSize");
-        shader.IgnoreNonExistingUniform("depthTex");
-        shader.IgnoreNonExistingUniform("light");
-        shader.IgnoreNonExistingUniform("light");
-        shader.IgnoreNonExistingUniform("fading");
-        shader.IgnoreNonExistingUniform("lifetime");
-        shader.IgnoreNonExistingUniform("environment.skybox");
-        shader.IgnoreNonExistingUniform("environment.irradiance");
-        shader.IgnoreNonExistingUniform("environment.skyboxRotation");
-        shader.IgnoreNonExistingUniform("environment.intensity");
-        shader.IgnoreNonExistingUniform("environment.envBRDFLUT");
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("viewportSize"));
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("depthTex"));
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("light"));
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("light"));
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("fading"));
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("lifetime"));
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("environment.skybox"));
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("environment.irradiance"));
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("environment.envBRDFLUT"));
 
         auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
 
         Texture::TextureBindId textureId = 0;
         this->BindSkyboxInformation(camera, shader, textureId);
         
-        shader.SetUniform("viewportSize", viewportSize);
-        shader.SetUniform("projMatrix", camera.ViewProjectionMatrix);
-        shader.SetUniform("aspectRatio", camera.AspectRatio);
-        shader.SetUniform("gamma", camera.Gamma);
+        shader.SetUniform(UNIFORM_ID("viewportSize"), viewportSize);
+        shader.SetUniform(UNIFORM_ID("projMatrix"), camera.ViewProjectionMatrix);
+        shader.SetUniform(UNIFORM_ID("aspectRatio"), camera.AspectRatio);
 
         auto& particleMesh = this->Pipeline.Environment.RectangularObject;
         auto& VAO = particleMesh.GetVAO();
         VAO.Bind();
 
         camera.DepthTexture->Bind(textureId++);
-        shader.SetUniform("depthTex", camera.DepthTexture->GetBoundId());
-        shader.SetUniform("albedoTex", textureId);
+        shader.SetUniform(UNIFORM_ID("depthTex"), camera.DepthTexture->GetBoundId());
+        shader.SetUniform(UNIFORM_ID("albedoTex"), textureId);
 
         Compute::SetMemoryBarrier(BarrierType::SHADER_STORAGE_BUFFER);
         this->Pipeline.Environment.RenderSSBO->BindBase(0);
@@ -184,89 +170,266 @@ namespace MxEngine
             for (const auto& dirLight : this->Pipeline.Lighting.DirectionalLights)
                 totalLight += (0.5f * Dot(normal, dirLight.Direction) + 0.5f) * dirLight.Color * dirLight.Intensity * (1.0f + dirLight.AmbientIntensity);
 
-            shader.SetUniform("normal", normal);
-            shader.SetUniform("transform", particleSystem.IsRelative ? particleSystem.Transform : Matrix4x4(1.0f));
-            shader.SetUniform("metallness", material.MetallicFactor);
-            shader.SetUniform("roughness", material.RoughnessFactor);
-            shader.SetUniform("color", material.BaseColor);
-            shader.SetUniform("transparency", material.Transparency);
-            shader.SetUniform("emmision", material.Emission);
-            shader.SetUniform("light", totalLight);
-            shader.SetUniform("bufferOffset", (int)particleSystem.ParticleBufferOffset);
-            shader.SetUniform("lifetime", particleSystem.ParticleLifetime);
-            shader.SetUniform("fading", particleSystem.Fading);
+            shader.SetUniform(UNIFORM_ID("normal"), normal);
+            shader.SetUniform(UNIFORM_ID("transform"), particleSystem.IsRelative ? particleSystem.Transform : Matrix4x4(1.0f));
+            shader.SetUniform(UNIFORM_ID("metallness"), material.MetallicFactor);
+            shader.SetUniform(UNIFORM_ID("roughness"), material.RoughnessFactor);
+            shader.SetUniform(UNIFORM_ID("color"), material.BaseColor);
+            shader.SetUniform(UNIFORM_ID("transparency"), material.Transparency);
+            shader.SetUniform(UNIFORM_ID("emmision"), material.Emission);
+            shader.SetUniform(UNIFORM_ID("light"), totalLight);
+            shader.SetUniform(UNIFORM_ID("bufferOffset"), (int)particleSystem.ParticleBufferOffset);
+            shader.SetUniform(UNIFORM_ID("lifetime"), particleSystem.ParticleLifetime);
+            shader.SetUniform(UNIFORM_ID("fading"), particleSystem.Fading);
 
             this->DrawIndices(RenderPrimitive::TRIANGLES, particleMesh.IndexCount, 0, 0, particleSystem.InvocationCount * ParticleComputeGroupSize, 0);
         }
     }
 
-    void RenderController::DrawObjects(const CameraUnit& camera, const Shader& shader, const RenderList& objects)
+    void RenderController::BindObjectsShader(const CameraUnit& camera, const Shader& shader)
+    {
+        shader.Bind();
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("material.transparency"));
+
+
+        // material textures are always bound to the same slots, so samplers are set once for all units
+        Texture::TextureBindId textureBindIndex = 0;
+        shader.SetUniform(UNIFORM_ID("map_albedo"), textureBindIndex++);
+        shader.SetUniform(UNIFORM_ID("map_metallic"), textureBindIndex++);
+        shader.SetUniform(UNIFORM_ID("map_roughness"), textureBindIndex++);
+        shader.SetUniform(UNIFORM_ID("map_emmisive"), textureBindIndex++);
+        shader.SetUniform(UNIFORM_ID("map_normal"), textureBindIndex++);
+        shader.SetUniform(UNIFORM_ID("map_height"), textureBindIndex++);
+        shader.SetUniform(UNIFORM_ID("map_occlusion"), textureBindIndex++);
+    }
+
+    void RenderController::CollectDrawCommands(const CameraUnit& camera, const RenderList& objects)
+    {
+        auto& drawCommands = this->Pipeline.DrawCommands;
+        drawCommands.clear();
+
+        size_t culledUnits = 0;
+        for (const auto& entry : objects.Entries)
+        {
+            const auto& unit = this->Pipeline.RenderUnits[entry.UnitIndex];
+            bool isInstanced = entry.InstanceBucket != InstanceCuller::InvalidBucket;
+
+            // instances are already culled for camera, unit is skipped if none of them are visible in its LOD
+            auto instances = isInstanced ? this->Pipeline.InstancedObjects.GetInstanceRange(entry.InstanceBucket) : InstanceRange{ 0, 0 };
+            if (isInstanced && instances.InstanceCount == 0) continue;
+
+            bool isUnitVisible = isInstanced || FrustrumCuller::IsVisible(camera.Visibility, entry.UnitIndex);
+            if (!isUnitVisible)
+            {
+                culledUnits++;
+                continue;
+            }
+
+            auto& command = drawCommands.emplace_back();
+            command.UnitIndex = entry.UnitIndex;
+            command.MaterialIndex = unit.MaterialIndex;
+            command.VertexOffset = unit.VertexOffset;
+            command.Depth = Length2(0.5f * (unit.MinAABB + unit.MaxAABB) - camera.ViewportPosition);
+            command.InstanceCount = instances.InstanceCount;
+            command.BaseInstance = instances.BaseInstance;
+        }
+        this->Pipeline.Statistics.AddEntry("drawn objects", drawCommands.size());
+        this->Pipeline.Statistics.AddEntry("culled objects", culledUnits);
+    }
+
+    void RenderController::SortDrawCommands()
+    {
+        MAKE_SCOPE_PROFILER("RenderController::SortDrawCommands()");
+        // shader is same for the whole list, so units are ordered by material, then by mesh, then front-to-back
+        auto& drawCommands = this->Pipeline.DrawCommands;
+        std::sort(drawCommands.begin(), drawCommands.end(), [](const DrawCommand& c1, const DrawCommand& c2)
+        {
+            if (c1.MaterialIndex != c2.MaterialIndex) return c1.MaterialIndex < c2.MaterialIndex;
+            if (c1.VertexOffset != c2.VertexOffset) return c1.VertexOffset < c2.VertexOffset;
+            return c1.Depth < c2.Depth;
+        });
+    }
+
+    void RenderController::DrawObjects(const CameraUnit& camera, const Shader& shader, const RenderList& objects, bool sortByState)
     {
         MAKE_SCOPE_PROFILER("RenderController::DrawObjects()");
 
-        if (objects.UnitsIndex.empty()) return;
-        shader.Bind();
-        shader.IgnoreNonExistingUniform("camera.position");
-        shader.IgnoreNonExistingUniform("camera.invViewProjMatrix");
-        shader.IgnoreNonExistingUniform("material.transparency");
+        if (objects.Entries.empty()) return;
+        this->BindObjectsShader(camera, shader);
+        this->CollectDrawCommands(camera, objects);
+        if (sortByState) this->SortDrawCommands();
 
-        this->BindCameraInformation(camera, shader);
-        shader.SetUniform("gamma", camera.Gamma);
+        this->Pipeline.DrawState.Reset();
+        this->Pipeline.Environment.RenderVAO->Bind();
+        for (const auto& command : this->Pipeline.DrawCommands)
+        {
+            const auto& unit = this->Pipeline.RenderUnits[command.UnitIndex];
+            this->DrawObject(unit, command.InstanceCount, command.BaseInstance, shader);
+        }
 
-        size_t currentUnit = 0;
+        this->Pipeline.Statistics.AddEntry("avoided texture binds", this->Pipeline.DrawState.AvoidedTextureBinds);
+        this->Pipeline.Statistics.AddEntry("avoided uniform calls", this->Pipeline.DrawState.AvoidedUniformCalls);
+    }
+
+    void RenderController::DrawObjectsIndirect(const CameraUnit& camera, const Shader& shader, const RenderList& objects)
+    {
+        MAKE_SCOPE_PROFILER("RenderController::DrawObjectsIndirect()");
+
+        if (objects.Entries.empty()) return;
+        this->BindObjectsShader(camera, shader);
+        this->CollectDrawCommands(camera, objects);
+        this->SortDrawCommands();
+
+        const auto& drawCommands = this->Pipeline.DrawCommands;
+        this->Pipeline.DrawState.Reset();
         this->Pipeline.Environment.RenderVAO->Bind();
-        for (const auto& group : objects.Groups)
+        this->SubmitIndirectCommands(this->Pipeline.DrawCommands);
+
+        // per-unit transforms and displacement are read from RenderUnitBuffer, so units sharing material are drawn by one call
+        size_t bucketBegin = 0;
+        while (bucketBegin < drawCommands.size())
         {
-            if (group.UnitCount == 0) continue;
-            bool isInstanced = group.InstanceCount > 0;
+            size_t materialIndex = drawCommands[bucketBegin].MaterialIndex;
+            size_t bucketEnd = bucketBegin + 1;
+            while (bucketEnd < drawCommands.size() && drawCommands[bucketEnd].MaterialIndex == materialIndex)
+                bucketEnd++;
+
+            // displacement scale of each unit is read from RenderUnitBuffer and multiplied by material displacement in shader
+            this->BindMaterial(materialIndex, shader);
+            this->SetDisplacement(this->Pipeline.MaterialUnits[materialIndex].Displacement, shader);
+            this->DrawIndicesIndirect(shader, bucketBegin, bucketEnd - bucketBegin);
+            bucketBegin = bucketEnd;
+        }
 
-            for (size_t i = 0; i < group.UnitCount; i++, currentUnit++)
-            {
-                const auto& unit = this->Pipeline.RenderUnits[objects.UnitsIndex[currentUnit]];
-                bool isUnitVisible = isInstanced || camera.Culler.IsAABBVisible(unit.MinAABB, unit.MaxAABB);
-                this->Pipeline.Statistics.AddEntry(isUnitVisible ? "drawn objects" : "culled objects", 1);
+        this->Pipeline.Statistics.AddEntry("avoided texture binds", this->Pipeline.DrawState.AvoidedTextureBinds);
+        this->Pipeline.Statistics.AddEntry("avoided uniform calls", this->Pipeline.DrawState.AvoidedUniformCalls);
+    }
+
+    void RenderController::SetDisplacement(float displacement, const Shader& shader)
+    {
+        auto& state = this->Pipeline.DrawState;
+        if (state.Displacement != displacement)
+        {
+            shader.SetUniform(UNIFORM_ID("displacement"), displacement);
+            state.Displacement = displacement;
+        }
+        else
+        {
+            state.AvoidedUniformCalls++;
+        }
+    }
 
-                if (isUnitVisible) this->DrawObject(unit, group.InstanceCount, group.BaseInstance, shader);
+    void RenderController::BindMaterial(size_t materialIndex, const Shader& shader)
+    {
+        auto& state = this->Pipeline.DrawState;
+        const auto& material = this->Pipeline.MaterialUnits[materialIndex];
+        state.MaterialIndex = materialIndex;
+
+        std::array materialTextures = {
+            std::cref(material.AlbedoMap),
+            std::cref(material.MetallicMap),
+            std::cref(material.RoughnessMap),
+            std::cref(material.EmissiveMap),
+            std::cref(material.NormalMap),
+            std::cref(material.HeightMap),
+            std::cref(material.AmbientOcclusionMap),
+        };
+
+        Texture::TextureBindId textureBindIndex = 0;
+        for (const auto& texture : materialTextures)
+        {
+            auto nativeHandle = texture.get()->GetNativeHandle();
+            if (state.BoundTextures[textureBindIndex] != nativeHandle)
+            {
+                texture.get()->Bind(textureBindIndex);
+                state.BoundTextures[textureBindIndex] = nativeHandle;
+            }
+            else
+            {
+                state.AvoidedTextureBinds++;
             }
+            textureBindIndex++;
         }
+
+        shader.SetUniform(UNIFORM_ID("material.roughness"), material.RoughnessFactor);
+        shader.SetUniform(UNIFORM_ID("material.metallic"), material.MetallicFactor);
+        shader.SetUniform(UNIFORM_ID("material.emmisive"), material.Emission);
+        shader.SetUniform(UNIFORM_ID("material.transparency"), material.Transparency);
+        shader.SetUniform(UNIFORM_ID("uvMultipliers"), material.UVMultipliers);
+        shader.SetUniform(UNIFORM_ID("parentColor"), material.BaseColor);
     }
 
     void RenderController::DrawObject(const RenderUnit& unit, size_t instanceCount, size_t baseInstance, const Shader& shader)
     {
-        Texture::TextureBindId textureBindIndex = 0;
+        auto& state = this->Pipeline.DrawState;
         const auto& material = this->Pipeline.MaterialUnits[unit.MaterialIndex];
 
-        material.AlbedoMap->Bind(textureBindIndex++);
-        material.MetallicMap->Bind(textureBindIndex++);
-        material.RoughnessMap->Bind(textureBindIndex++);
-        material.EmissiveMap->Bind(textureBindIndex++);
-        material.NormalMap->Bind(textureBindIndex++);
-        material.HeightMap->Bind(textureBindIndex++);
-        material.AmbientOcclusionMap->Bind(textureBindIndex++);
-
-        shader.SetUniform("map_albedo", material.AlbedoMap->GetBoundId());
-        shader.SetUniform("map_metallic", material.MetallicMap->GetBoundId());
-        shader.SetUniform("map_roughness", material.RoughnessMap->GetBoundId());
-        shader.SetUniform("map_emmisive", material.EmissiveMap->GetBoundId());
-        shader.SetUniform("map_normal", material.NormalMap->GetBoundId());
-        shader.SetUniform("map_height", material.HeightMap->GetBoundId());
-        shader.SetUniform("map_occlusion", material.AmbientOcclusionMap->GetBoundId());
-
-        shader.SetUniform("material.roughness", material.RoughnessFactor);
-        shader.SetUniform("material.metallic", material.MetallicFactor);
-        shader.SetUniform("material.emmisive", material.Emission);
-        shader.SetUniform("material.transparency", material.Transparency);
-
-        shader.SetUniform("displacement", material.Displacement);
-        shader.SetUniform("uvMultipliers", material.UVMultipliers);
-
-        shader.SetUniform("parentModel", unit.ModelMatrix); //-V807
-        shader.SetUniform("parentNormal", unit.NormalMatrix);
-        shader.SetUniform("parentColor", material.BaseColor);
+        // units with the same material follow each other after sorting, so most of material state is already set
+        if (state.MaterialIndex != unit.MaterialIndex)
+        {
+            this->BindMaterial(unit.MaterialIndex, shader);
+        }
+        else
+        {
+            state.AvoidedTextureBinds += Material::TextureCount;
+            state.AvoidedUniformCalls += DrawStateTracker::MaterialUniformCount;
+        }
+
+        this->SetDisplacement(material.Displacement * unit.DisplacementScale, shader);
+
+        shader.SetUniform(UNIFORM_ID("parentModel"), unit.ModelMatrix); //-V807
+        shader.SetUniform(UNIFORM_ID("parentNormal"), unit.NormalMatrix);
         
         this->DrawIndices(RenderPrimitive::TRIANGLES, unit.IndexCount, unit.IndexOffset, unit.VertexOffset, instanceCount, baseInstance);
     }
 
+    void RenderController::UploadRenderUnitData()
+    {
+        MAKE_SCOPE_PROFILER("RenderController::UploadRenderUnitData()");
+        auto& indirectDraw = this->Pipeline.IndirectDraw;
+        auto& unitData = indirectDraw.UnitData;
+        auto& changedUnits = indirectDraw.ChangedUnits;
+
+        bool isResized = unitData.size() < this->Pipeline.RenderUnits.size();
+        if (isResized)
+            unitData.resize(Max(this->Pipeline.RenderUnits.size(), unitData.size() * 2));
+
+        for (size_t unitIndex : changedUnits)
+        {
+            const auto& unit = this->Pipeline.RenderUnits[unitIndex];
+            auto& data = unitData[unitIndex];
+            data.Model = unit.ModelMatrix;
+            data.Normal = Matrix4x4(unit.NormalMatrix);
+            data.Params = Vector4(unit.DisplacementScale, 0.0f, 0.0f, 0.0f);
+            indirectDraw.IsUnitChanged[unitIndex] = 0;
+        }
+        this->Pipeline.Statistics.AddEntry("uploaded render units", changedUnits.size());
+
+        if (isResized || indirectDraw.UnitDataBuffer->GetSize<RenderUnitGPUData>() < unitData.size())
+        {
+            indirectDraw.UnitDataBuffer->BufferSubDataWithResize(unitData.data(), unitData.size());
+        }
+        else
+        {
+            // changed units are uploaded in ranges, small gaps between them are uploaded too to avoid many tiny buffer updates
+            constexpr size_t MaxUnitGap = 16;
+            std::sort(changedUnits.begin(), changedUnits.end());
+            size_t rangeBegin = 0;
+            while (rangeBegin < changedUnits.size())
+            {
+                size_t rangeEnd = rangeBegin + 1;
+                while (rangeEnd < changedUnits.size() && changedUnits[rangeEnd] - changedUnits[rangeEnd - 1] <= MaxUnitGap)
+                    rangeEnd++;
+
+                size_t firstUnit = changedUnits[rangeBegin];
+                size_t lastUnit = changedUnits[rangeEnd - 1];
+                indirectDraw.UnitDataBuffer->BufferSubData(unitData.data() + firstUnit, lastUnit - firstUnit + 1, firstUnit);
+                rangeBegin = rangeEnd;
+            }
+        }
+        changedUnits.clear();
+    }
+
     void RenderController::ComputeBloomEffect(CameraUnit& camera, const TextureHandle& output)
     {
         if (camera.Effects == nullptr) return;
@@ -281,8 +444,8 @@ namespace MxEngine
 
         camera.AlbedoTexture->Bind(0);
         splitShader->Bind();
-        splitShader->SetUniform("albedoTex", camera.AlbedoTexture->GetBoundId());
-        splitShader->SetUniform("weight", bloomWeight);
+        splitShader->SetUniform(UNIFORM_ID("albedoTex"), camera.AlbedoTexture->GetBoundId());
+        splitShader->SetUniform(UNIFORM_ID("weight"), bloomWeight);
 
         auto& blurTarget = bloomTextures.front();
         auto& blurTemp = bloomTextures.back();
@@ -306,16 +469,14 @@ namespace MxEngine
 
         auto& ssaoShader = this->Pipeline.Environment.Shaders["AmbientOcclusion"_id];
         ssaoShader->Bind();
-        ssaoShader->IgnoreNonExistingUniform("materialTex");
-        ssaoShader->IgnoreNonExistingUniform("albedoTex");
-        ssaoShader->IgnoreNonExistingUniform("camera.position");
+        ssaoShader->IgnoreNonExistingUniform(UNIFORM_ID("materialTex"));
+        ssaoShader->IgnoreNonExistingUniform(UNIFORM_ID("albedoTex"));
 
         Texture::TextureBindId textureId = 0;
         this->BindGBuffer(camera, *ssaoShader, textureId);
-        this->BindCameraInformation(camera, *ssaoShader);
 
-        ssaoShader->SetUniform("sampleCount", (int)camera.SSAO->GetSampleCount());
-        ssaoShader->SetUniform("radius", camera.SSAO->GetRadius());
+        ssaoShader->SetUniform(UNIFORM_ID("sampleCount"), (int)camera.SSAO->GetSampleCount());
+        ssaoShader->SetUniform(UNIFORM_ID("radius"), camera.SSAO->GetRadius());
 
         auto& blurInputOutput = temporary;
         auto& blurTemporary = output;
@@ -328,9 +489,9 @@ namespace MxEngine
         applyShader->Bind();
         input->Bind(0);
         blurInputOutput->Bind(1);
-        applyShader->SetUniform("inputTex", input->GetBoundId());
-        applyShader->SetUniform("aoTex", blurInputOutput->GetBoundId());
-        applyShader->SetUniform("intensity", camera.SSAO->GetIntensity());
+        applyShader->SetUniform(UNIFORM_ID("inputTex"), input->GetBoundId());
+        applyShader->SetUniform(UNIFORM_ID("aoTex"), blurInputOutput->GetBoundId());
+        applyShader->SetUniform(UNIFORM_ID("intensity"), camera.SSAO->GetIntensity());
 
         this->RenderToTexture(output, applyShader);
         std::swap(input, output);
@@ -351,10 +512,10 @@ namespace MxEngine
         shader->Bind();
         camera.HDRTexture->Bind(0);
         camera.AverageWhiteTexture->Bind(1);
-        shader->SetUniform("curFrameHDR", 0);
-        shader->SetUniform("prevFrameWhite", 1);
-        shader->SetUniform("adaptSpeed", fadingAdaptationSpeed);
-        shader->SetUniform("adaptThreshold", adaptationThreshold);
+        shader->SetUniform(UNIFORM_ID("curFrameHDR"), 0);
+        shader->SetUniform(UNIFORM_ID("prevFrameWhite"), 1);
+        shader->SetUniform(UNIFORM_ID("adaptSpeed"), fadingAdaptationSpeed);
+        shader->SetUniform(UNIFORM_ID("adaptThreshold"), adaptationThreshold);
         this->RenderToTexture(output, shader);
         output->GenerateMipmaps();
         this->CopyTexture(output, camera.AverageWhiteTexture);
@@ -412,43 +573,14 @@ namespace MxEngine
         auto& shader = this->Pipeline.Environment.Shaders["DirLight"_id];
         shader->Bind();
 
-        shader->IgnoreNonExistingUniform("camera.viewProjMatrix");
-        shader->IgnoreNonExistingUniform("camera.position");
-        shader->IgnoreNonExistingUniform("albedoTex");
-        shader->IgnoreNonExistingUniform("materialTex");
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("albedoTex"));
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("materialTex"));
 
         Texture::TextureBindId textureId = 0;
         this->BindGBuffer(camera, *shader, textureId);
-        this->BindCameraInformation(camera, *shader);
 
-        // submit directional light information
-        constexpr size_t MaxDirLightCount = 4;
-        const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
-        size_t lightCount = Min(MaxDirLightCount, dirLights.size());
-
-        shader->SetUniform("lightCount", (int)lightCount);
-
-        for (size_t i = 0; i < lightCount; i++)
-        {
-            auto& dirLight = this->Pipeline.Lighting.DirectionalLights[i];
-
-            Vector4 colorPacked = Vector4(dirLight.Color * dirLight.Intensity, dirLight.AmbientIntensity);
-            dirLight.ShadowMap->Bind(textureId++);
-            shader->SetUniform(MxFormat("lights[{}].color", i), colorPacked);
-            shader->SetUniform(MxFormat("lights[{}].direction", i), dirLight.Direction);
-            shader->SetUniform(MxFormat("lightDepthMaps[{}]", i), dirLight.ShadowMap->GetBoundId());
-
-            for (size_t j = 0; j < dirLight.BiasedProjectionMatrices.size(); j++)
-            {
-                shader->SetUniform(MxFormat("lights[{}].transform[{}]", i, j), dirLight.BiasedProjectionMatrices[j]);
-            }
-        }
-
-        this->Pipeline.Environment.DefaultShadowMap->Bind(textureId);
-        for (size_t i = lightCount; i < MaxDirLightCount; i++)
-        {
-            shader->SetUniform(MxFormat("lightDepthMaps[{}]", i), this->Pipeline.Environment.DefaultShadowMap->GetBoundId());
-        }
+        // directional light parameters are stored in LightingBlock, only shadow maps are bound per shader
+        this->BindDirectionalLightShadowMaps(*shader, textureId);
 
         this->RenderToTextureNoClear(output, shader);
     }
@@ -476,47 +608,20 @@ namespace MxEngine
 
     void RenderController::DrawTransparentObjects(CameraUnit& camera)
     {
-        if (this->Pipeline.TransparentObjects.UnitsIndex.empty()) return;
+        if (this->Pipeline.TransparentObjects.Entries.empty()) return;
         MAKE_SCOPE_PROFILER("RenderController::DrawTransparentObjects()");
 
         auto& shader = this->Pipeline.Environment.Shaders["Transparent"_id];
         shader->Bind();
 
-        shader->SetUniform("viewportPosition", camera.ViewportPosition);
-        shader->SetUniform("gamma", camera.Gamma);
+        shader->SetUniform(UNIFORM_ID("viewportPosition"), camera.ViewportPosition);
 
         Texture::TextureBindId textureId = Material::TextureCount;
         this->BindSkyboxInformation(camera, *shader, textureId);
 
-        // submit directional light information
-        const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
-        size_t lightCount = Min(MaxDirLightCount, dirLights.size());
-
-        shader->SetUniform("lightCount", (int)lightCount);
+        this->BindDirectionalLightShadowMaps(*shader, textureId);
 
-        for (size_t i = 0; i < lightCount; i++)
-        {
-            auto& dirLight = this->Pipeline.Lighting.DirectionalLights[i];
-
-            Vector4 colorPacked = Vector4(dirLight.Color * dirLight.Intensity, dirLight.AmbientIntensity);
-            dirLight.ShadowMap->Bind(textureId++);
-            shader->SetUniform(MxFormat("lights[{}].color", i), colorPacked);
-            shader->SetUniform(MxFormat("lights[{}].direction", i), dirLight.Direction);
-            shader->SetUniform(MxFormat("lightDepthMaps[{}]", i), dirLight.ShadowMap->GetBoundId());
-
-            for (size_t j = 0; j < dirLight.BiasedProjectionMatrices.size(); j++)
-            {
-                shader->SetUniform(MxFormat("lights[{}].transform[{}]", i, j), dirLight.BiasedProjectionMatrices[j]);
-            }
-        }
-
-        this->Pipeline.Environment.DefaultShadowMap->Bind(textureId);
-        for (size_t i = lightCount; i < MaxDirLightCount; i++)
-        {
-            shader->SetUniform(MxFormat("lightDepthMaps[{}]", i), this->Pipeline.Environment.DefaultShadowMap->GetBoundId());
-        }
-
-        this->DrawObjects(camera, *shader, this->Pipeline.TransparentObjects);
+        this->DrawObjects(camera, *shader, this->Pipeline.TransparentObjects, false);
     }
 
     void RenderController::DrawIBL(CameraUnit& camera, TextureHandle& output)
@@ -525,14 +630,11 @@ namespace MxEngine
 
         auto shader = this->Pipeline.Environment.Shaders["IBL"_id];
         shader->Bind();
-        shader->IgnoreNonExistingUniform("camera.viewProjMatrix");
         Texture::TextureBindId textureId = 0;
 
         this->BindGBuffer(camera, *shader, textureId);
-        this->BindCameraInformation(camera, *shader);
         this->BindSkyboxInformation(camera, *shader, textureId);
         
-        shader->SetUniform("gamma", camera.Gamma);
 
         this->RenderToTexture(output, shader);
     }
@@ -546,18 +648,15 @@ namespace MxEngine
 
         auto fogShader = this->Pipeline.Environment.Shaders["Fog"_id];
         fogShader->Bind();
-        fogShader->IgnoreNonExistingUniform("camera.viewProjMatrix");
-        fogShader->IgnoreNonExistingUniform("normalTex");
-        fogShader->IgnoreNonExistingUniform("albedoTex");
-        fogShader->IgnoreNonExistingUniform("materialTex");
+        fogShader->IgnoreNonExistingUniform(UNIFORM_ID("normalTex"));
+        fogShader->IgnoreNonExistingUniform(UNIFORM_ID("albedoTex"));
+        fogShader->IgnoreNonExistingUniform(UNIFORM_ID("materialTex"));
 
         Texture::TextureBindId textureId = 0;
         this->BindGBuffer(camera, *fogShader, textureId);
-        this->BindFogInformation(camera, *fogShader);
-        this->BindCameraInformation(camera, *fogShader);
 
         input->Bind(textureId++);
-        fogShader->SetUniform("cameraOutput", input->GetBoundId());
+        fogShader->SetUniform(UNIFORM_ID("cameraOutput"), input->GetBoundId());
 
         this->RenderToTexture(output, fogShader);
         std::swap(input, output);
@@ -572,8 +671,8 @@ namespace MxEngine
         shader->Bind();
         input->Bind(0);
 
-        shader->SetUniform("tex", input->GetBoundId());
-        shader->SetUniform("chromaticAbberationParams", Vector3{
+        shader->SetUniform(UNIFORM_ID("tex"), input->GetBoundId());
+        shader->SetUniform(UNIFORM_ID("chromaticAbberationParams"), Vector3{
             camera.Effects->GetChromaticAberrationMinDistance(),
             camera.Effects->GetChromaticAberrationIntensity(),
             camera.Effects->GetChromaticAberrationDistortion()
@@ -590,16 +689,15 @@ namespace MxEngine
 
         auto& SSRShader = this->Pipeline.Environment.Shaders["SSR"_id];
         SSRShader->Bind();
-        SSRShader->IgnoreNonExistingUniform("albedoTex");
-        SSRShader->IgnoreNonExistingUniform("materialTex");
+        SSRShader->IgnoreNonExistingUniform(UNIFORM_ID("albedoTex"));
+        SSRShader->IgnoreNonExistingUniform(UNIFORM_ID("materialTex"));
         
         Texture::TextureBindId textureId = 0;
         this->BindGBuffer(camera, *SSRShader, textureId);
-        this->BindCameraInformation(camera, *SSRShader);
 
-        SSRShader->SetUniform("thickness", camera.SSR->GetThickness());
-        SSRShader->SetUniform("startDistance", camera.SSR->GetStartDistance());
-        SSRShader->SetUniform("steps", (int)camera.SSR->GetSteps());
+        SSRShader->SetUniform(UNIFORM_ID("thickness"), camera.SSR->GetThickness());
+        SSRShader->SetUniform(UNIFORM_ID("startDistance"), camera.SSR->GetStartDistance());
+        SSRShader->SetUniform(UNIFORM_ID("steps"), (int)camera.SSR->GetSteps());
 
         this->RenderToTexture(temporary, SSRShader);
         temporary->GenerateMipmaps();
@@ -612,10 +710,10 @@ namespace MxEngine
         camera.AlbedoTexture->Bind(textureId++);
         temporary->Bind(textureId++);
         input->Bind(textureId++);
-        applySSRShader->SetUniform("albedoTex", camera.AlbedoTexture->GetBoundId());
-        applySSRShader->SetUniform("materialTex", camera.MaterialTexture->GetBoundId());
-        applySSRShader->SetUniform("SSRTex", temporary->GetBoundId());
-        applySSRShader->SetUniform("HDRTex", input->GetBoundId());
+        applySSRShader->SetUniform(UNIFORM_ID("albedoTex"), camera.AlbedoTexture->GetBoundId());
+        applySSRShader->SetUniform(UNIFORM_ID("materialTex"), camera.MaterialTexture->GetBoundId());
+        applySSRShader->SetUniform(UNIFORM_ID("SSRTex"), temporary->GetBoundId());
+        applySSRShader->SetUniform(UNIFORM_ID("HDRTex"), input->GetBoundId());
 
         this->RenderToTexture(output, applySSRShader);
         std::swap(input, output);
@@ -630,20 +728,18 @@ namespace MxEngine
 
         auto& SSGIShader = this->Pipeline.Environment.Shaders["SSGI"_id];
         SSGIShader->Bind();
-        SSGIShader->IgnoreNonExistingUniform("albedoTex");
-        SSGIShader->IgnoreNonExistingUniform("normalTex");
-        SSGIShader->IgnoreNonExistingUniform("materialTex");
-        SSGIShader->IgnoreNonExistingUniform("camera.position");
+        SSGIShader->IgnoreNonExistingUniform(UNIFORM_ID("albedoTex"));
+        SSGIShader->IgnoreNonExistingUniform(UNIFORM_ID("normalTex"));
+        SSGIShader->IgnoreNonExistingUniform(UNIFORM_ID("materialTex"));
 
         Texture::TextureBindId textureId = 0;
         this->BindGBuffer(camera, *SSGIShader, textureId);
-        this->BindCameraInformation(camera, *SSGIShader);
 
         input->Bind(textureId++);
-        SSGIShader->SetUniform("inputTex", input->GetBoundId());
-        SSGIShader->SetUniform("raySteps", (int)camera.SSGI->GetRaySteps());
-        SSGIShader->SetUniform("intensity", camera.SSGI->GetIntensity());
-        SSGIShader->SetUniform("distance", camera.SSGI->GetDistance());
+        SSGIShader->SetUniform(UNIFORM_ID("inputTex"), input->GetBoundId());
+        SSGIShader->SetUniform(UNIFORM_ID("raySteps"), (int)camera.SSGI->GetRaySteps());
+        SSGIShader->SetUniform(UNIFORM_ID("intensity"), camera.SSGI->GetIntensity());
+        SSGIShader->SetUniform(UNIFORM_ID("distance"), camera.SSGI->GetDistance());
 
         auto& blurInputOutput = this->Pipeline.Environment.BloomTextures.front();
         auto& blurTemporary = this->Pipeline.Environment.BloomTextures.back();
@@ -654,16 +750,16 @@ namespace MxEngine
 
         auto& applyShader = this->Pipeline.Environment.Shaders["ApplySSGI"_id];
         applyShader->Bind();
-        applyShader->IgnoreNonExistingUniform("depthTex");
-        applyShader->IgnoreNonExistingUniform("normalTex");
+        applyShader->IgnoreNonExistingUniform(UNIFORM_ID("depthTex"));
+        applyShader->IgnoreNonExistingUniform(UNIFORM_ID("normalTex"));
 
         textureId = 0;
         this->BindGBuffer(camera, *applyShader, textureId);
 
         input->Bind(textureId++);
         blurInputOutput->Bind(textureId++);
-        applyShader->SetUniform("inputTex", input->GetBoundId());
-        applyShader->SetUniform("SSGITex", blurInputOutput->GetBoundId());
+        applyShader->SetUniform(UNIFORM_ID("inputTex"), input->GetBoundId());
+        applyShader->SetUniform(UNIFORM_ID("SSGITex"), blurInputOutput->GetBoundId());
 
         this->RenderToTexture(output, applyShader);
 
@@ -682,18 +778,17 @@ namespace MxEngine
         HDRToLDRShader->Bind();
         input->Bind(0);
         averageWhite->Bind(1);
-        HDRToLDRShader->SetUniform("HDRTex", input->GetBoundId());
-        HDRToLDRShader->SetUniform("averageWhiteTex", averageWhite->GetBoundId());
+        HDRToLDRShader->SetUniform(UNIFORM_ID("HDRTex"), input->GetBoundId());
+        HDRToLDRShader->SetUniform(UNIFORM_ID("averageWhiteTex"), averageWhite->GetBoundId());
 
-        HDRToLDRShader->SetUniform("exposure", camera.ToneMapping->GetExposure());
-        HDRToLDRShader->SetUniform("colorMultiplier", camera.ToneMapping->GetColorScale());
-        HDRToLDRShader->SetUniform("whitePoint", camera.ToneMapping->GetWhitePoint());
-        HDRToLDRShader->SetUniform("minLuminance", camera.ToneMapping->GetMinLuminance());
-        HDRToLDRShader->SetUniform("maxLuminance", camera.ToneMapping->GetMaxLuminance());
-        HDRToLDRShader->SetUniform("ABCcoefsACES", Vector3{ aces.A, aces.B, aces.C });
-        HDRToLDRShader->SetUniform("DEFcoefsACES", Vector3{ aces.D, aces.E, aces.F });
+        HDRToLDRShader->SetUniform(UNIFORM_ID("exposure"), camera.ToneMapping->GetExposure());
+        HDRToLDRShader->SetUniform(UNIFORM_ID("colorMultiplier"), camera.ToneMapping->GetColorScale());
+        HDRToLDRShader->SetUniform(UNIFORM_ID("whitePoint"), camera.ToneMapping->GetWhitePoint());
+        HDRToLDRShader->SetUniform(UNIFORM_ID("minLuminance"), camera.ToneMapping->GetMinLuminance());
+        HDRToLDRShader->SetUniform(UNIFORM_ID("maxLuminance"), camera.ToneMapping->GetMaxLuminance());
+        HDRToLDRShader->SetUniform(UNIFORM_ID("ABCcoefsACES"), Vector3{ aces.A, aces.B, aces.C });
+        HDRToLDRShader->SetUniform(UNIFORM_ID("DEFcoefsACES"), Vector3{ aces.D, aces.E, aces.F });
 
-        HDRToLDRShader->SetUniform("gamma", camera.Gamma);
 
         this->RenderToTexture(output, HDRToLDRShader);
         std::swap(input, output);
@@ -709,7 +804,7 @@ namespace MxEngine
         auto& fxaaShader = this->Pipeline.Environment.Shaders["FXAA"_id];
         fxaaShader->Bind();
         input->Bind(0);
-        fxaaShader->SetUniform("tex", input->GetBoundId());
+        fxaaShader->SetUniform(UNIFORM_ID("tex"), input->GetBoundId());
         
         this->RenderToTexture(output, fxaaShader);
         std::swap(input, output);
@@ -723,10 +818,10 @@ namespace MxEngine
         auto& vignetteShader = this->Pipeline.Environment.Shaders["Vignette"_id];
         vignetteShader->Bind();
         input->Bind(0);
-        vignetteShader->SetUniform("tex", input->GetBoundId());
+        vignetteShader->SetUniform(UNIFORM_ID("tex"), input->GetBoundId());
 
-        vignetteShader->SetUniform("radius", camera.Effects->GetVignetteRadius());
-        vignetteShader->SetUniform("intensity", camera.Effects->GetVignetteIntensity());
+        vignetteShader->SetUniform(UNIFORM_ID("radius"), camera.Effects->GetVignetteRadius());
+        vignetteShader->SetUniform(UNIFORM_ID("intensity"), camera.Effects->GetVignetteIntensity());
 
         this->RenderToTexture(output, vignetteShader);
         std::swap(input, output);
@@ -740,12 +835,12 @@ namespace MxEngine
         auto& colorGradingShader = this->Pipeline.Environment.Shaders["ColorGrading"_id];
         colorGradingShader->Bind();
         input->Bind(0);
-        colorGradingShader->SetUniform("tex", input->GetBoundId());
+        colorGradingShader->SetUniform(UNIFORM_ID("tex"), input->GetBoundId());
 
         auto& colorGrading = camera.ToneMapping->GetColorGrading();
-        colorGradingShader->SetUniform("channelR", colorGrading.R);
-        colorGradingShader->SetUniform("channelG", colorGrading.G);
-        colorGradingShader->SetUniform("channelB", colorGrading.B);
+        colorGradingShader->SetUniform(UNIFORM_ID("channelR"), colorGrading.R);
+        colorGradingShader->SetUniform(UNIFORM_ID("channelG"), colorGrading.G);
+        colorGradingShader->SetUniform(UNIFORM_ID("channelB"), colorGrading.B);
 
         this->RenderToTexture(output, colorGradingShader);
         std::swap(input, output);
@@ -759,21 +854,19 @@ namespace MxEngine
 
         auto shader = this->Pipeline.Environment.Shaders["SpotLightShadow"_id];
         shader->Bind();
-        shader->IgnoreNonExistingUniform("camera.position");
-        shader->IgnoreNonExistingUniform("albedoTex");
-        shader->IgnoreNonExistingUniform("materialTex");
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("albedoTex"));
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("materialTex"));
 
         auto& pyramid = this->Pipeline.Lighting.SpotLight;
         auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
 
-        shader->SetUniform("viewportSize", viewportSize);
-        shader->SetUniform("castsShadows", true);
+        shader->SetUniform(UNIFORM_ID("viewportSize"), viewportSize);
+        shader->SetUniform(UNIFORM_ID("castsShadows"), true);
 
         Texture::TextureBindId textureId = 0;
         this->BindGBuffer(camera, *shader, textureId);
-        this->BindCameraInformation(camera, *shader);
         
-        shader->SetUniform("lightDepthMap", textureId);
+        shader->SetUniform(UNIFORM_ID("lightDepthMap"), textureId);
 
         pyramid.GetVAO()->Bind();
 
@@ -783,12 +876,12 @@ namespace MxEngine
 
             spotLight.ShadowMap->Bind(textureId);
 
-            shader->SetUniform("worldToLightTransform", spotLight.BiasedProjectionMatrix);
+            shader->SetUniform(UNIFORM_ID("worldToLightTransform"), spotLight.BiasedProjectionMatrix);
 
-            shader->SetUniform("transform", spotLight.Transform);
-            shader->SetUniform("lightPosition", Vector4(spotLight.Position, spotLight.InnerAngle));
-            shader->SetUniform("lightDirection", Vector4(spotLight.Direction, spotLight.OuterAngle));
-            shader->SetUniform("colorParameters", Vector4(spotLight.Color, spotLight.AmbientIntensity));
+            shader->SetUniform(UNIFORM_ID("transform"), spotLight.Transform);
+            shader->SetUniform(UNIFORM_ID("lightPosition"), Vector4(spotLight.Position, spotLight.InnerAngle));
+            shader->SetUniform(UNIFORM_ID("lightDirection"), Vector4(spotLight.Direction, spotLight.OuterAngle));
+            shader->SetUniform(UNIFORM_ID("colorParameters"), Vector4(spotLight.Color, spotLight.AmbientIntensity));
 
             this->DrawIndices(RenderPrimitive::TRIANGLES, pyramid.GetIndexCount(), pyramid.GetIndexOffset(), pyramid.GetVertexOffset(), 0, 0);
         }
@@ -802,21 +895,19 @@ namespace MxEngine
 
         auto shader = this->Pipeline.Environment.Shaders["PointLightShadow"_id];
         shader->Bind();
-        shader->IgnoreNonExistingUniform("camera.position");
-        shader->IgnoreNonExistingUniform("albedoTex");
-        shader->IgnoreNonExistingUniform("materialTex");
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("albedoTex"));
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("materialTex"));
 
         auto& sphere = this->Pipeline.Lighting.PointLight;
         auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
 
-        shader->SetUniform("viewportSize", viewportSize);
-        shader->SetUniform("castsShadows", true);
+        shader->SetUniform(UNIFORM_ID("viewportSize"), viewportSize);
+        shader->SetUniform(UNIFORM_ID("castsShadows"), true);
 
         Texture::TextureBindId textureId = 0;
         this->BindGBuffer(camera, *shader, textureId);
-        this->BindCameraInformation(camera, *shader);
 
-        shader->SetUniform("lightDepthMap", textureId);
+        shader->SetUniform(UNIFORM_ID("lightDepthMap"), textureId);
 
         sphere.GetVAO()->Bind();
 
@@ -826,9 +917,9 @@ namespace MxEngine
 
             pointLight.ShadowMap->Bind(textureId);
 
-            shader->SetUniform("transform", pointLight.Transform);
-            shader->SetUniform("sphereParameters", Vector4(pointLight.Position, pointLight.Radius));
-            shader->SetUniform("colorParameters", Vector4(pointLight.Color, pointLight.AmbientIntensity));
+            shader->SetUniform(UNIFORM_ID("transform"), pointLight.Transform);
+            shader->SetUniform(UNIFORM_ID("sphereParameters"), Vector4(pointLight.Position, pointLight.Radius));
+            shader->SetUniform(UNIFORM_ID("colorParameters"), Vector4(pointLight.Color, pointLight.AmbientIntensity));
 
             this->DrawIndices(RenderPrimitive::TRIANGLES, sphere.GetIndexCount(), sphere.GetIndexOffset(), sphere.GetVertexOffset(), 0, 0);
         }
@@ -842,20 +933,18 @@ namespace MxEngine
 
         auto shader = this->Pipeline.Environment.Shaders["PointLightNonShadow"_id];
         shader->Bind();
-        shader->IgnoreNonExistingUniform("camera.position");
-        shader->IgnoreNonExistingUniform("albedoTex");
-        shader->IgnoreNonExistingUniform("materialTex");
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("albedoTex"));
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("materialTex"));
         auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
 
         Texture::TextureBindId textureId = 0;
         this->BindGBuffer(camera, *shader, textureId);
-        this->BindCameraInformation(camera, *shader);
 
         this->Pipeline.Environment.DefaultShadowCubeMap->Bind(textureId++);
 
-        shader->SetUniform("lightDepthMap", this->Pipeline.Environment.DefaultShadowCubeMap->GetBoundId());
-        shader->SetUniform("viewportSize", viewportSize);
-        shader->SetUniform("castsShadows", false);
+        shader->SetUniform(UNIFORM_ID("lightDepthMap"), this->Pipeline.Environment.DefaultShadowCubeMap->GetBoundId());
+        shader->SetUniform(UNIFORM_ID("viewportSize"), viewportSize);
+        shader->SetUniform(UNIFORM_ID("castsShadows"), false);
 
         instancedPointLights.GetVAO()->Bind();
 
@@ -873,20 +962,18 @@ namespace MxEngine
 
         auto shader = this->Pipeline.Environment.Shaders["SpotLightNonShadow"_id];
         shader->Bind();
-        shader->IgnoreNonExistingUniform("camera.position");
-        shader->IgnoreNonExistingUniform("albedoTex");
-        shader->IgnoreNonExistingUniform("materialTex");
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("albedoTex"));
+        shader->IgnoreNonExistingUniform(UNIFORM_ID("materialTex"));
         auto viewportSize = MakeVector2((float)camera.OutputTexture->GetWidth(), (float)camera.OutputTexture->GetHeight());
 
         Texture::TextureBindId textureId = 0;
         this->BindGBuffer(camera, *shader, textureId);
-        this->BindCameraInformation(camera, *shader);
 
         this->Pipeline.Environment.DefaultShadowCubeMap->Bind(textureId++);
 
-        shader->SetUniform("lightDepthMap", this->Pipeline.Environment.DefaultShadowCubeMap->GetBoundId());
-        shader->SetUniform("viewportSize", viewportSize);
-        shader->SetUniform("castsShadows", false);
+        shader->SetUniform(UNIFORM_ID("lightDepthMap"), this->Pipeline.Environment.DefaultShadowCubeMap->GetBoundId());
+        shader->SetUniform(UNIFORM_ID("viewportSize"), viewportSize);
+        shader->SetUniform(UNIFORM_ID("castsShadows"), false);
 
         instancedSpotLights.GetVAO()->Bind();
 
@@ -902,14 +989,6 @@ namespace MxEngine
         this->Pipeline.Lighting.SpotLightsInstanced.SubmitToVBO();
     }
 
-    void RenderController::BindFogInformation(const CameraUnit& camera, const Shader& shader)
-    {
-        MX_ASSERT(camera.Effects != nullptr);
-        shader.SetUniform("fog.distance", camera.Effects->GetFogDistance());
-        shader.SetUniform("fog.density", camera.Effects->GetFogDensity());
-        shader.SetUniform("fog.color", camera.Effects->GetFogColor());
-    }
-
     void RenderController::AttachDefaultVAO()
     {
         // simular to default framebuffer, we simply unbind any VAO to set it
@@ -922,18 +1001,73 @@ namespace MxEngine
         camera.SkyboxTexture->Bind(startId++);
         camera.IrradianceTexture->Bind(startId++);
         this->Pipeline.Environment.EnvironmentBRDFLUT->Bind(startId++);
-        shader.SetUniform("environment.skybox", camera.SkyboxTexture->GetBoundId());
-        shader.SetUniform("environment.irradiance", camera.IrradianceTexture->GetBoundId());
-        shader.SetUniform("environment.envBRDFLUT", this->Pipeline.Environment.EnvironmentBRDFLUT->GetBoundId());
-        shader.SetUniform("environment.skyboxRotation", camera.InversedSkyboxRotation);
-        shader.SetUniform("environment.intensity", camera.SkyboxIntensity);
+        shader.SetUniform(UNIFORM_ID("environment.skybox"), camera.SkyboxTexture->GetBoundId());
+        shader.SetUniform(UNIFORM_ID("environment.irradiance"), camera.IrradianceTexture->GetBoundId());
+        shader.SetUniform(UNIFORM_ID("environment.envBRDFLUT"), this->Pipeline.Environment.EnvironmentBRDFLUT->GetBoundId());
+    }
+
+    void RenderController::BindDirectionalLightShadowMaps(const Shader& shader, Texture::TextureBindId& startId)
+    {
+        const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
+        size_t lightCount = Min(MaxDirLightCount, dirLights.size());
+
+        for (size_t i = 0; i < lightCount; i++)
+        {
+            dirLights[i].ShadowMap->Bind(startId++);
+            shader.SetUniform(LightDepthMapUniformIds[i], dirLights[i].ShadowMap->GetBoundId());
+        }
+
+        this->Pipeline.Environment.DefaultShadowMap->Bind(startId);
+        for (size_t i = lightCount; i < MaxDirLightCount; i++)
+        {
+            shader.SetUniform(LightDepthMapUniformIds[i], this->Pipeline.Environment.DefaultShadowMap->GetBoundId());
+        }
+    }
+
+    void RenderController::UpdateCameraUniformBlocks(const CameraUnit& camera)
+    {
+        auto& environment = this->Pipeline.Environment;
+
+        CameraUniformBlock cameraBlock;
+        cameraBlock.Position = camera.ViewportPosition;
+        cameraBlock.Gamma = camera.Gamma;
+        cameraBlock.ViewProjMatrix = camera.ViewProjectionMatrix;
+        cameraBlock.InvViewProjMatrix = camera.InverseViewProjMatrix;
+
+        EnvironmentUniformBlock environmentBlock;
+        for (size_t i = 0; i < std::size(environmentBlock.SkyboxRotation); i++)
+            environmentBlock.SkyboxRotation[i] = Vector4(camera.InversedSkyboxRotation[(int)i], 0.0f);
+        environmentBlock.SkyboxIntensity = camera.SkyboxIntensity;
+        environmentBlock.FogDistance = camera.Effects != nullptr ? camera.Effects->GetFogDistance() : 0.0f;
+        environmentBlock.FogDensity = camera.Effects != nullptr ? camera.Effects->GetFogDensity() : 0.0f;
+        environmentBlock.FogColor = camera.Effects != nullptr ? camera.Effects->GetFogColor() : MakeVector3(0.0f);
+
+        environment.CameraUniformBuffer->BufferSubData(&cameraBlock, 1);
+        environment.EnvironmentUniformBuffer->BufferSubData(&environmentBlock, 1);
+        environment.CameraUniformBuffer->BindBase((size_t)UniformBlockBinding::CAMERA);
+        environment.EnvironmentUniformBuffer->BindBase((size_t)UniformBlockBinding::ENVIRONMENT);
     }
 
-    void RenderController::BindCameraInformation(const CameraUnit& camera, const Shader& shader)
+    void RenderController::UpdateLightingUniformBlock()
     {
-        shader.SetUniform("camera.position", camera.ViewportPosition);
-        shader.SetUniform("camera.viewProjMatrix", camera.ViewProjectionMatrix);
-        shader.SetUniform("camera.invViewProjMatrix", camera.InverseViewProjMatrix);
+        const auto& dirLights = this->Pipeline.Lighting.DirectionalLights;
+        size_t lightCount = Min(MaxDirLightCount, dirLights.size());
+
+        LightingUniformBlock lightingBlock;
+        lightingBlock.LightCount = (int)lightCount;
+        for (size_t i = 0; i < lightCount; i++)
+        {
+            const auto& dirLight = dirLights[i];
+            auto& lightData = lightingBlock.Lights[i];
+            for (size_t j = 0; j < dirLight.BiasedProjectionMatrices.size(); j++)
+                lightData.Transform[j] = dirLight.BiasedProjectionMatrices[j];
+            lightData.Color = Vector4(dirLight.Color * dirLight.Intensity, dirLight.AmbientIntensity);
+            lightData.Direction = dirLight.Direction;
+        }
+
+        auto& lightingBuffer = this->Pipeline.Environment.LightingUniformBuffer;
+        lightingBuffer->BufferSubData(&lightingBlock, 1);
+        lightingBuffer->BindBase((size_t)UniformBlockBinding::LIGHTING);
     }
 
     void RenderController::BindGBuffer(const CameraUnit& camera, const Shader& shader, Texture::TextureBindId& startId)
@@ -943,10 +1077,10 @@ namespace MxEngine
         camera.MaterialTexture->Bind(startId++);
         camera.DepthTexture->Bind(startId++);
 
-        shader.SetUniform("albedoTex", camera.AlbedoTexture->GetBoundId());
-        shader.SetUniform("normalTex", camera.NormalTexture->GetBoundId());
-        shader.SetUniform("materialTex", camera.MaterialTexture->GetBoundId());
-        shader.SetUniform("depthTex", camera.DepthTexture->GetBoundId());
+        shader.SetUniform(UNIFORM_ID("albedoTex"), camera.AlbedoTexture->GetBoundId());
+        shader.SetUniform(UNIFORM_ID("normalTex"), camera.NormalTexture->GetBoundId());
+        shader.SetUniform(UNIFORM_ID("materialTex"), camera.MaterialTexture->GetBoundId());
+        shader.SetUniform(UNIFORM_ID("depthTex"), camera.DepthTexture->GetBoundId());
     }
 
     const Renderer& RenderController::GetRenderEngine() const
@@ -1065,8 +1199,8 @@ namespace MxEngine
         if (iterations == 0) return;
         auto& shader = this->Pipeline.Environment.Shaders["GaussianBlur"_id];
         shader->Bind();
-        shader->SetUniform("inputTex", 0);
-        shader->SetUniform("lod", (int)lod);
+        shader->SetUniform(UNIFORM_ID("inputTex"), 0);
+        shader->SetUniform(UNIFORM_ID("lod"), (int)lod);
 
         auto& framebuffer = this->Pipeline.Environment.BloomFrameBuffer;
 
@@ -1075,7 +1209,7 @@ namespace MxEngine
             bool horizontalBlur = (i % 2 == 0);
             auto& source = horizontalBlur ? inputOutput : temporary;
             auto& target = horizontalBlur ? temporary : inputOutput;
-            shader->SetUniform("horizontalBlur", horizontalBlur);
+            shader->SetUniform(UNIFORM_ID("horizontalBlur"), horizontalBlur);
 
             if (lod != 0) source->GenerateMipmaps();
             source->Bind(0);
@@ -1113,6 +1247,59 @@ namespace MxEngine
         }
     }
 
+    void RenderController::SubmitIndirectCommands(ArrayView<DrawCommand> commands)
+    {
+        auto& indirectDraw = this->Pipeline.IndirectDraw;
+        indirectDraw.Commands.resize(commands.size());
+        indirectDraw.DrawUnitIndices.resize(commands.size());
+
+        for (size_t i = 0; i < commands.size(); i++)
+        {
+            const auto& command = commands[i];
+            const auto& unit = this->Pipeline.RenderUnits[command.UnitIndex];
+            auto& indirectCommand = indirectDraw.Commands[i];
+
+            // non-instanced units are drawn as single instance reading first instance attribute, same as glDrawElementsBaseVertex
+            bool isInstanced = command.InstanceCount > 0;
+            indirectCommand.IndexCount = (uint32_t)unit.IndexCount;
+            indirectCommand.InstanceCount = isInstanced ? (uint32_t)command.InstanceCount : 1;
+            indirectCommand.FirstIndex = (uint32_t)unit.IndexOffset;
+            indirectCommand.BaseVertex = (int32_t)unit.VertexOffset;
+            indirectCommand.BaseInstance = isInstanced ? (uint32_t)command.BaseInstance : 0;
+            indirectDraw.DrawUnitIndices[i] = (uint32_t)command.UnitIndex;
+        }
+
+        indirectDraw.CommandBuffer->BufferSubDataWithResize(indirectDraw.Commands.data(), indirectDraw.Commands.size());
+        indirectDraw.DrawUnitIndexBuffer->BufferSubDataWithResize(indirectDraw.DrawUnitIndices.data(), indirectDraw.DrawUnitIndices.size());
+        indirectDraw.CommandBuffer->Bind();
+        indirectDraw.UnitDataBuffer->BindBase(1);
+        indirectDraw.DrawUnitIndexBuffer->BindBase(2);
+    }
+
+    void RenderController::DrawIndicesIndirect(const Shader& shader, size_t commandOffset, size_t commandCount)
+    {
+        const auto& commands = this->Pipeline.IndirectDraw.Commands;
+        MX_ASSERT(commandOffset + commandCount <= commands.size());
+
+        size_t drawnVertecies = 0;
+        for (size_t i = commandOffset; i < commandOffset + commandCount; i++)
+            drawnVertecies += (size_t)commands[i].IndexCount * commands[i].InstanceCount;
+
+        this->Pipeline.Statistics.AddEntry("draw calls", 1);
+        this->Pipeline.Statistics.AddEntry("indirect draws", commandCount);
+        this->Pipeline.Statistics.AddEntry("drawn vertecies", drawnVertecies);
+
+        shader.SetUniform(UNIFORM_ID("drawOffset"), (int)commandOffset);
+        this->GetRenderEngine().DrawIndicesMultiIndirect(RenderPrimitive::TRIANGLES, commandOffset, commandCount);
+    }
+
+    bool RenderController::IsIndirectDrawingActive() const
+    {
+        // indirect shaders are loaded only if context supports them
+        const auto& environment = this->Pipeline.Environment;
+        return environment.UseIndirectDrawing && environment.Shaders.find("GBufferIndirect"_id) != environment.Shaders.end();
+    }
+
     void RenderController::ToggleDepthOnlyMode(bool value)
     {
         bool useColor = !value;
@@ -1154,12 +1341,11 @@ namespace MxEngine
         }
 
         shader.Bind();
-        shader.SetUniform("StaticViewProjection", camera.StaticViewProjectionMatrix);
-        shader.SetUniform("Rotation", Transpose(camera.InversedSkyboxRotation));
-        shader.SetUniform("gamma", camera.Gamma);
-        shader.SetUniform("luminance", skyLuminance);
+        shader.SetUniform(UNIFORM_ID("StaticViewProjection"), camera.StaticViewProjectionMatrix);
+        shader.SetUniform(UNIFORM_ID("Rotation"), Transpose(camera.InversedSkyboxRotation));
+        shader.SetUniform(UNIFORM_ID("luminance"), skyLuminance);
         camera.SkyboxTexture->Bind(0);
-        shader.SetUniform("skybox", camera.SkyboxTexture->GetBoundId());
+        shader.SetUniform(UNIFORM_ID("skybox"), camera.SkyboxTexture->GetBoundId());
 
         skybox.GetVAO().Bind();
 
@@ -1173,7 +1359,7 @@ namespace MxEngine
 
         auto& shader = *this->Pipeline.Environment.Shaders["DebugDraw"_id];
         shader.Bind();
-        shader.SetUniform("ViewProjMatrix", camera.ViewProjectionMatrix);
+        shader.SetUniform(UNIFORM_ID("ViewProjMatrix"), camera.ViewProjectionMatrix);
 
         // TODO: refactor
         auto& VAO = *this->Pipeline.Environment.DebugBufferObject.VAO;
@@ -1202,6 +1388,26 @@ namespace MxEngine
         return this->Pipeline.Lighting;
     }
 
+    IndirectDrawUnit& RenderController::GetIndirectDrawInformation()
+    {
+        return this->Pipeline.IndirectDraw;
+    }
+
+    const IndirectDrawUnit& RenderController::GetIndirectDrawInformation() const
+    {
+        return this->Pipeline.IndirectDraw;
+    }
+
+    InstanceCuller& RenderController::GetInstanceCuller()
+    {
+        return this->Pipeline.InstancedObjects;
+    }
+
+    const InstanceCuller& RenderController::GetInstanceCuller() const
+    {
+        return this->Pipeline.InstancedObjects;
+    }
+
     const RenderStatistics& RenderController::GetRenderStatistics() const
     {
         return this->Pipeline.Statistics;
@@ -1215,26 +1421,18 @@ namespace MxEngine
 
     void RenderController::ResetPipeline()
     {
-        this->Pipeline.Lighting.DirectionalLights.clear();
+        // frame arena lists are replaced instead of cleared, as their memory is reused by arena two frames later
+        this->Pipeline.Lighting.DirectionalLights = FrameVector<DirectionalLightUnit>();
         this->Pipeline.Lighting.PointLightsInstanced.Instances.clear();
         this->Pipeline.Lighting.SpotLightsInstanced.Instances.clear();
-        this->Pipeline.Lighting.PointLights.clear();
-        this->Pipeline.Lighting.SpotLights.clear();
-        this->Pipeline.ShadowCasters.Groups.clear();
-        this->Pipeline.ShadowCasters.UnitsIndex.clear();
-        this->Pipeline.MaskedShadowCasters.Groups.clear();
-        this->Pipeline.MaskedShadowCasters.UnitsIndex.clear();
-        this->Pipeline.TransparentObjects.Groups.clear();
-        this->Pipeline.TransparentObjects.UnitsIndex.clear();
-        this->Pipeline.MaskedObjects.Groups.clear();
-        this->Pipeline.MaskedObjects.UnitsIndex.clear();
-        this->Pipeline.OpaqueObjects.Groups.clear();
-        this->Pipeline.OpaqueObjects.UnitsIndex.clear();
-        this->Pipeline.RenderUnits.clear();
-        this->Pipeline.OpaqueParticleSystems.clear();
-        this->Pipeline.TransparentParticleSystems.clear();
-        this->Pipeline.MaterialUnits.clear();
-        this->Pipeline.Cameras.clear();
+        this->Pipeline.Lighting.PointLights = FrameVector<PointLightUnit>();
+        this->Pipeline.Lighting.SpotLights = FrameVector<SpotLightUnit>();
+        // render units and render lists are kept between frames and updated by RenderAdaptor only for changed objects
+        this->Pipeline.InstancedObjects.Clear();
+        this->Pipeline.OpaqueParticleSystems = FrameVector<ParticleSystemUnit>();
+        this->Pipeline.TransparentParticleSystems = FrameVector<ParticleSystemUnit>();
+        this->Pipeline.Cameras = FrameVector<CameraUnit>();
+        this->ReleaseUnusedMaterials();
     }
 
     void RenderController::SubmitParticleSystem(const ParticleSystem& system, const Material& material, const Transform& parentTransform)
@@ -1248,12 +1446,9 @@ namespace MxEngine
         particleSystem.Fading = system.GetFading();
         particleSystem.IsRelative = system.IsRelative();
         particleSystem.InvocationCount = system.GetMaxParticleCount() / ParticleComputeGroupSize;
-        particleSystem.MaterialIndex = this->Pipeline.MaterialUnits.size();
+        particleSystem.MaterialIndex = this->SubmitMaterial(material);
 
         parentTransform.GetMatrix(particleSystem.Transform);
-        
-        auto& materialCopy = this->Pipeline.MaterialUnits.emplace_back(material);
-        if (!materialCopy.AlbedoMap.IsValid()) materialCopy.AlbedoMap = this->Pipeline.Environment.DefaultMaterialMap;
     }
 
     void RenderController::SubmitLightSource(const DirectionalLight& light, const Transform& parentTransform)
@@ -1377,98 +1572,358 @@ namespace MxEngine
         camera.SSAO                       = ssao;
     }
 
-    size_t RenderController::SubmitRenderGroup(const Mesh& mesh, size_t instanceOffset, size_t instanceCount)
+    static RenderUnitClass GetRenderUnitClass(const Material& material)
     {
-        size_t renderGroupIndex = this->Pipeline.OpaqueObjects.Groups.size();
+        if (material.Transparency == 0.0f) return RenderUnitClass::INVISIBLE;
+        if (material.AlphaMode == AlphaModeGroup::TRANSPARENT) return RenderUnitClass::TRANSPARENT;
+        if (material.AlphaMode == AlphaModeGroup::MASKED && material.Transparency < 1.0f) return RenderUnitClass::MASKED;
+        return RenderUnitClass::OPAQUE;
+    }
 
-        std::array groupSubTypes = {
-            std::ref(this->Pipeline.OpaqueObjects.Groups.emplace_back()),
-            std::ref(this->Pipeline.MaskedObjects.Groups.emplace_back()),
-            std::ref(this->Pipeline.TransparentObjects.Groups.emplace_back()),
-            std::ref(this->Pipeline.ShadowCasters.Groups.emplace_back()),
-            std::ref(this->Pipeline.MaskedShadowCasters.Groups.emplace_back()),
-        };
+    static void AddToRenderList(RenderList& list, size_t unitIndex, size_t instanceBucket, size_t& listIndex)
+    {
+        listIndex = list.Entries.size();
+        list.Entries.push_back(RenderListEntry{ unitIndex, instanceBucket });
+    }
 
-        for (auto subType : groupSubTypes)
+    void RenderController::PlaceRenderUnit(size_t unitIndex, RenderUnitClass unitClass)
+    {
+        auto& placement = this->Pipeline.RenderUnitPlacements[unitIndex];
+        placement.DrawList = nullptr;
+        placement.ShadowList = nullptr;
+        if (unitClass == RenderUnitClass::INVISIBLE) return;
+
+        if (placement.CastsShadow)
+        {
+            placement.ShadowList = unitClass == RenderUnitClass::MASKED ? &this->Pipeline.MaskedShadowCasters : &this->Pipeline.ShadowCasters;
+            AddToRenderList(*placement.ShadowList, unitIndex, placement.InstanceBucket, placement.ShadowListIndex);
+        }
+
+        switch (unitClass)
         {
-            subType.get().BaseInstance = instanceOffset;
-            subType.get().InstanceCount = instanceCount;
-            subType.get().UnitCount = 0;
+        case RenderUnitClass::TRANSPARENT:
+            placement.DrawList = &this->Pipeline.TransparentObjects;
+            break;
+        case RenderUnitClass::MASKED:
+            placement.DrawList = &this->Pipeline.MaskedObjects;
+            break;
+        default:
+            placement.DrawList = &this->Pipeline.OpaqueObjects;
+            break;
         }
+        AddToRenderList(*placement.DrawList, unitIndex, placement.InstanceBucket, placement.DrawListIndex);
+    }
+
+    void RenderController::UnplaceRenderUnit(size_t unitIndex)
+    {
+        auto& placements = this->Pipeline.RenderUnitPlacements;
+        auto RemoveFromList = [&placements](RenderList* list, size_t listIndex)
+        {
+            if (list == nullptr) return;
+            auto& entries = list->Entries;
+            entries[listIndex] = entries.back();
+            entries.pop_back();
+            if (listIndex == entries.size()) return;
+
+            // moved unit may be in this list either as drawn unit or as shadow caster
+            auto& moved = placements[entries[listIndex].UnitIndex];
+            if (moved.DrawList == list) moved.DrawListIndex = listIndex;
+            else moved.ShadowListIndex = listIndex;
+        };
 
-        return renderGroupIndex;
+        auto& placement = placements[unitIndex];
+        RemoveFromList(placement.DrawList, placement.DrawListIndex);
+        RemoveFromList(placement.ShadowList, placement.ShadowListIndex);
+        placement.DrawList = nullptr;
+        placement.ShadowList = nullptr;
     }
 
-    void RenderController::SubmitRenderUnit(size_t renderGroupIndex, const SubMesh& submesh, const Material& material, const Transform& parentTransform, bool castsShadow, const char* debugName)
+    void RenderController::MarkRenderUnitChanged(size_t unitIndex)
     {
-        bool isInvisible = material.Transparency == 0.0f;
-        bool isTransparent = material.AlphaMode == AlphaModeGroup::TRANSPARENT;
-        bool isMasked = material.AlphaMode == AlphaModeGroup::MASKED && material.Transparency < 1.0f;
-        if (isInvisible) return;
+        auto& indirectDraw = this->Pipeline.IndirectDraw;
+        if (indirectDraw.IsUnitChanged.size() <= unitIndex)
+            indirectDraw.IsUnitChanged.resize(this->Pipeline.RenderUnits.size(), 0);
+
+        if (indirectDraw.IsUnitChanged[unitIndex] == 0)
+        {
+            indirectDraw.IsUnitChanged[unitIndex] = 1;
+            indirectDraw.ChangedUnits.push_back(unitIndex);
+        }
+    }
 
+    size_t RenderController::AddRenderUnit(const SubMesh& submesh, const MaterialHandle& material, bool castsShadow, size_t instanceBucket)
+    {
+        MX_ASSERT(material.IsValid());
         size_t unitIndex = this->Pipeline.RenderUnits.size();
-        auto& renderUnit = this->Pipeline.RenderUnits.emplace_back();
+        if (!this->Pipeline.FreeRenderUnits.empty())
+        {
+            unitIndex = this->Pipeline.FreeRenderUnits.back();
+            this->Pipeline.FreeRenderUnits.pop_back();
+        }
+        else
+        {
+            this->Pipeline.RenderUnits.emplace_back();
+            this->Pipeline.RenderUnitPlacements.emplace_back();
+            this->Pipeline.RenderUnitsAABB.Add(MakeVector3(0.0f), MakeVector3(0.0f));
+        }
+
+        // units sharing material are tracked by its table entry, so material changes are detected once per material, not per unit
+        auto& table = this->Pipeline.Materials;
+        size_t materialKey = material.GetHandle();
+        auto it = table.RenderUnitMaterials.find(materialKey);
+        if (it == table.RenderUnitMaterials.end())
+        {
+            size_t materialIndex = this->Pipeline.MaterialUnits.size();
+            if (!table.FreeIndices.empty())
+            {
+                materialIndex = table.FreeIndices.back();
+                table.FreeIndices.pop_back();
+            }
+            else
+            {
+                this->Pipeline.MaterialUnits.emplace_back();
+            }
 
-        renderUnit.MaterialIndex = this->Pipeline.MaterialUnits.size();
+            it = table.RenderUnitMaterials.insert({ materialKey, RenderUnitMaterialEntry{ } }).first;
+            auto& entry = it->second;
+            entry.SourceHandle = material;
+            entry.Source = *material;
+            entry.MaterialIndex = materialIndex;
+            entry.Class = GetRenderUnitClass(entry.Source);
+
+            auto& renderMaterial = this->Pipeline.MaterialUnits[materialIndex];
+            renderMaterial = entry.Source;
+            this->ResolveMaterial(renderMaterial, false);
+            table.ResolvedCount++;
+        }
+        auto& materialEntry = it->second;
+
+        auto& renderUnit = this->Pipeline.RenderUnits[unitIndex];
+        renderUnit.MaterialIndex = materialEntry.MaterialIndex;
         renderUnit.IndexCount = submesh.Data.GetIndiciesCount();
         renderUnit.IndexOffset = submesh.Data.GetIndiciesOffset();
         renderUnit.VertexCount = submesh.Data.GetVerteciesCount();
         renderUnit.VertexOffset = submesh.Data.GetVerteciesOffset();
-        renderUnit.ModelMatrix = parentTransform.GetMatrix() * submesh.GetTransform().GetMatrix(); //-V807
-        renderUnit.NormalMatrix = parentTransform.GetNormalMatrix() * submesh.GetTransform().GetNormalMatrix();
 
-        #if defined(MXENGINE_DEBUG)
-        renderUnit.DebugName = debugName;
-        #endif
+        auto& placement = this->Pipeline.RenderUnitPlacements[unitIndex];
+        placement.MaterialKey = materialKey;
+        placement.MaterialUnitIndex = materialEntry.Units.size();
+        placement.InstanceBucket = instanceBucket;
+        placement.CastsShadow = castsShadow;
+        placement.IsAllocated = true;
+        materialEntry.Units.push_back(unitIndex);
+
+        this->PlaceRenderUnit(unitIndex, materialEntry.Class);
+        return unitIndex;
+    }
+
+    void RenderController::UpdateRenderUnit(size_t unitIndex, const RenderUnitGeometry& geometry)
+    {
+        MX_ASSERT(this->Pipeline.RenderUnitPlacements[unitIndex].IsAllocated);
+        auto& renderUnit = this->Pipeline.RenderUnits[unitIndex];
+        renderUnit.ModelMatrix = geometry.ModelMatrix;
+        renderUnit.NormalMatrix = geometry.NormalMatrix;
+        renderUnit.MinAABB = geometry.MinAABB;
+        renderUnit.MaxAABB = geometry.MaxAABB;
+        renderUnit.DisplacementScale = geometry.DisplacementScale;
+        this->Pipeline.RenderUnitsAABB.Set(unitIndex, geometry.MinAABB, geometry.MaxAABB);
+        this->MarkRenderUnitChanged(unitIndex);
+    }
+
+    void RenderController::RemoveRenderUnit(size_t unitIndex)
+    {
+        auto& placement = this->Pipeline.RenderUnitPlacements[unitIndex];
+        MX_ASSERT(placement.IsAllocated);
+        this->UnplaceRenderUnit(unitIndex);
+
+        auto& table = this->Pipeline.Materials;
+        auto it = table.RenderUnitMaterials.find(placement.MaterialKey);
+        MX_ASSERT(it != table.RenderUnitMaterials.end());
+        auto& entry = it->second;
+        entry.Units[placement.MaterialUnitIndex] = entry.Units.back();
+        this->Pipeline.RenderUnitPlacements[entry.Units[placement.MaterialUnitIndex]].MaterialUnitIndex = placement.MaterialUnitIndex;
+        entry.Units.pop_back();
+
+        if (entry.Units.empty())
+        {
+            // release texture references held by material which is not used anymore
+            this->Pipeline.MaterialUnits[entry.MaterialIndex] = Material{ };
+            table.FreeIndices.push_back(entry.MaterialIndex);
+            table.RenderUnitMaterials.erase(it);
+        }
+
+        placement.IsAllocated = false;
+        this->Pipeline.RenderUnitsAABB.Set(unitIndex, MakeVector3(0.0f), MakeVector3(0.0f));
+        this->Pipeline.FreeRenderUnits.push_back(unitIndex);
+    }
+
+    size_t RenderController::GetRenderUnitCount() const
+    {
+        return this->Pipeline.RenderUnits.size() - this->Pipeline.FreeRenderUnits.size();
+    }
+
+    void RenderController::ComputeRenderUnitGeometry(const SubMesh& submesh, const Matrix4x4& parentMatrix, const Matrix3x3& parentNormalMatrix, RenderUnitGeometry& geometry)
+    {
+        // submesh transform is shared by all objects using the mesh, so its cached matrices must not be updated from worker threads
+        Matrix4x4 submeshMatrix;
+        Matrix3x3 submeshNormalMatrix;
+        submesh.GetTransform().GetMatrix(submeshMatrix);
+        submesh.GetTransform().GetNormalMatrix(submeshMatrix, submeshNormalMatrix);
+
+        geometry.ModelMatrix = parentMatrix * submeshMatrix;
+        geometry.NormalMatrix = parentNormalMatrix * submeshNormalMatrix;
 
         // compute aabb of primitive object for later frustrum culling
-        auto aabb = submesh.Data.GetAABB() * renderUnit.ModelMatrix;
-        renderUnit.MinAABB = aabb.Min;
-        renderUnit.MaxAABB = aabb.Max;
+        auto aabb = submesh.Data.GetAABB() * geometry.ModelMatrix;
+        geometry.MinAABB = aabb.Min;
+        geometry.MaxAABB = aabb.Max;
 
-        if (castsShadow)
+        // we need to change displacement to account object scale, so we take average of object scale components as multiplier
+        Vector3 parentScale{ Length(Vector3(parentMatrix[0])), Length(Vector3(parentMatrix[1])), Length(Vector3(parentMatrix[2])) };
+        geometry.DisplacementScale = Dot(parentScale * submesh.GetTransform().GetScale(), MakeVector3(1.0f / 3.0f));
+    }
+
+    static bool IsSameMaterial(const Material& m1, const Material& m2)
+    {
+        return
+            m1.AlbedoMap           == m2.AlbedoMap           &&
+            m1.EmissiveMap         == m2.EmissiveMap         &&
+            m1.NormalMap           == m2.NormalMap           &&
+            m1.HeightMap           == m2.HeightMap           &&
+            m1.AmbientOcclusionMap == m2.AmbientOcclusionMap &&
+            m1.MetallicMap         == m2.MetallicMap         &&
+            m1.RoughnessMap        == m2.RoughnessMap        &&
+            m1.Transparency        == m2.Transparency        &&
+            m1.Emission            == m2.Emission            &&
+            m1.Displacement        == m2.Displacement        &&
+            m1.RoughnessFactor     == m2.RoughnessFactor     &&
+            m1.MetallicFactor      == m2.MetallicFactor      &&
+            m1.BaseColor           == m2.BaseColor           &&
+            m1.UVMultipliers       == m2.UVMultipliers       &&
+            m1.AlphaMode           == m2.AlphaMode;
+    }
+
+    void RenderController::ResolveMaterial(Material& renderMaterial, bool isParticleMaterial) const
+    {
+        const auto& environment = this->Pipeline.Environment;
+        if (isParticleMaterial)
         {
-            auto& groupList = isMasked ? this->Pipeline.MaskedShadowCasters : this->Pipeline.ShadowCasters;
-            groupList.Groups[renderGroupIndex].UnitCount++;
-            groupList.UnitsIndex.push_back(unitIndex);
+            if (!renderMaterial.AlbedoMap.IsValid()) renderMaterial.AlbedoMap = environment.DefaultMaterialMap;
+            return;
         }
 
-        if (isTransparent)
+        if (renderMaterial.RoughnessMap.IsValid())         renderMaterial.RoughnessFactor = 1.0f;
+        if (renderMaterial.MetallicMap.IsValid())          renderMaterial.MetallicFactor = 1.0f;
+
+        // set default textures if they are not exist
+        if (!renderMaterial.AlbedoMap.IsValid())           renderMaterial.AlbedoMap = environment.DefaultMaterialMap;
+        if (!renderMaterial.RoughnessMap.IsValid())        renderMaterial.RoughnessMap = environment.DefaultMaterialMap;
+        if (!renderMaterial.MetallicMap.IsValid())         renderMaterial.MetallicMap = environment.DefaultMaterialMap;
+        if (!renderMaterial.EmissiveMap.IsValid())         renderMaterial.EmissiveMap = environment.DefaultMaterialMap;
+        if (!renderMaterial.AmbientOcclusionMap.IsValid()) renderMaterial.AmbientOcclusionMap = environment.DefaultMaterialMap;
+        if (!renderMaterial.NormalMap.IsValid())           renderMaterial.NormalMap = environment.DefaultNormalMap;
+        if (!renderMaterial.HeightMap.IsValid())           renderMaterial.HeightMap = environment.DefaultBlackMap;
+    }
+
+    void RenderController::UpdateRenderUnitMaterials()
+    {
+        MAKE_SCOPE_PROFILER("RenderController::UpdateRenderUnitMaterials()");
+        auto& table = this->Pipeline.Materials;
+        for (auto& [materialKey, entry] : table.RenderUnitMaterials)
         {
-            auto& transparentObjects = this->Pipeline.TransparentObjects;
-            transparentObjects.Groups[renderGroupIndex].UnitCount++;
-            transparentObjects.UnitsIndex.push_back(unitIndex);
+            const auto& material = *entry.SourceHandle;
+            if (IsSameMaterial(entry.Source, material))
+            {
+                table.ReusedCount++;
+                continue;
+            }
+
+            entry.Source = material;
+            auto& renderMaterial = this->Pipeline.MaterialUnits[entry.MaterialIndex];
+            renderMaterial = material;
+            this->ResolveMaterial(renderMaterial, false);
+            table.ResolvedCount++;
+
+            // units keep material index, they only have to be moved if material now belongs to other render list
+            auto unitClass = GetRenderUnitClass(material);
+            if (unitClass == entry.Class) continue;
+
+            entry.Class = unitClass;
+            for (size_t unitIndex : entry.Units)
+            {
+                this->UnplaceRenderUnit(unitIndex);
+                this->PlaceRenderUnit(unitIndex, unitClass);
+            }
         }
-        else if (isMasked)
+    }
+
+    size_t RenderController::SubmitMaterial(const Material& material)
+    {
+        auto& table = this->Pipeline.Materials;
+        auto& entries = table.ParticleMaterials;
+
+        auto it = entries.find(&material);
+        if (it != entries.end())
         {
-            auto& maskedObjects = this->Pipeline.MaskedObjects;
-            maskedObjects.Groups[renderGroupIndex].UnitCount++;
-            maskedObjects.UnitsIndex.push_back(unitIndex);
+            auto& entry = it->second;
+            // material is checked for changes once per frame, all other units just share its index
+            if (entry.LastUsedFrame == table.CurrentFrame || IsSameMaterial(entry.Source, material))
+            {
+                entry.LastUsedFrame = table.CurrentFrame;
+                table.ReusedCount++;
+                return entry.MaterialIndex;
+            }
         }
         else
         {
-            auto& opaqueObjects = this->Pipeline.OpaqueObjects;
-            opaqueObjects.Groups[renderGroupIndex].UnitCount++;
-            opaqueObjects.UnitsIndex.push_back(unitIndex);
+            size_t materialIndex = this->Pipeline.MaterialUnits.size();
+            if (!table.FreeIndices.empty())
+            {
+                materialIndex = table.FreeIndices.back();
+                table.FreeIndices.pop_back();
+            }
+            else
+            {
+                this->Pipeline.MaterialUnits.emplace_back();
+            }
+            it = entries.insert({ &material, MaterialTableEntry{ Material{ }, materialIndex, table.CurrentFrame } }).first;
         }
 
-        // submit render material
-        auto& renderMaterial = this->Pipeline.MaterialUnits.emplace_back(material); // create a copy of material for future work
+        // new or changed material: store source for later comparison and resolve render copy
+        auto& entry = it->second;
+        entry.Source = material;
+        entry.LastUsedFrame = table.CurrentFrame;
 
-        // we need to change displacement to account object scale, so we take average of object scale components as multiplier
-        renderMaterial.Displacement *= Dot(parentTransform.GetScale() * submesh.GetTransform().GetScale(), MakeVector3(1.0f / 3.0f));
+        auto& renderMaterial = this->Pipeline.MaterialUnits[entry.MaterialIndex];
+        renderMaterial = material;
+        this->ResolveMaterial(renderMaterial, true);
 
-        if (renderMaterial.RoughnessMap.IsValid())         renderMaterial.RoughnessFactor = 1.0f;
-        if (renderMaterial.MetallicMap.IsValid())          renderMaterial.MetallicFactor = 1.0f;
+        table.ResolvedCount++;
+        return entry.MaterialIndex;
+    }
 
-        // set default textures if they are not exist
-        if (!renderMaterial.AlbedoMap.IsValid())           renderMaterial.AlbedoMap = this->Pipeline.Environment.DefaultMaterialMap;
-        if (!renderMaterial.RoughnessMap.IsValid())        renderMaterial.RoughnessMap = this->Pipeline.Environment.DefaultMaterialMap;
-        if (!renderMaterial.MetallicMap.IsValid())         renderMaterial.MetallicMap = this->Pipeline.Environment.DefaultMaterialMap;
-        if (!renderMaterial.EmissiveMap.IsValid())         renderMaterial.EmissiveMap = this->Pipeline.Environment.DefaultMaterialMap;
-        if (!renderMaterial.AmbientOcclusionMap.IsValid()) renderMaterial.AmbientOcclusionMap = this->Pipeline.Environment.DefaultMaterialMap;
-        if (!renderMaterial.NormalMap.IsValid())           renderMaterial.NormalMap = this->Pipeline.Environment.DefaultNormalMap;
-        if (!renderMaterial.HeightMap.IsValid())           renderMaterial.HeightMap = this->Pipeline.Environment.DefaultBlackMap;
+    void RenderController::ReleaseUnusedMaterials()
+    {
+        // render unit materials are released when their last unit is removed, so only particle materials are checked here
+        auto& table = this->Pipeline.Materials;
+        auto& entries = table.ParticleMaterials;
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            if (it->second.LastUsedFrame != table.CurrentFrame)
+            {
+                // release texture references held by unused material
+                this->Pipeline.MaterialUnits[it->second.MaterialIndex] = Material{ };
+                table.FreeIndices.push_back(it->second.MaterialIndex);
+                it = entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        table.CurrentFrame++;
+        table.ResolvedCount = 0;
+        table.ReusedCount = 0;
     }
 
     void RenderController::SubmitImage(const TextureHandle& texture)
@@ -1477,7 +1932,7 @@ namespace MxEngine
         auto& rectangle = this->Pipeline.Environment.RectangularObject;
 
         finalShader.Bind();
-        finalShader.SetUniform("tex", 0);
+        finalShader.SetUniform(UNIFORM_ID("tex"), 0);
         texture->Bind(0);
 
         rectangle.GetVAO().Bind();
@@ -1495,10 +1950,17 @@ namespace MxEngine
             return;
         }
 
+        this->Pipeline.Statistics.AddEntry("resolved materials", this->Pipeline.Materials.ResolvedCount);
+        this->Pipeline.Statistics.AddEntry("shared materials", this->Pipeline.Materials.ReusedCount);
+
         this->SubmitInstancedLights();
+        this->UpdateLightingUniformBlock();
         this->ComputeParticles(this->Pipeline.OpaqueParticleSystems);
         this->ComputeParticles(this->Pipeline.TransparentParticleSystems);
 
+        bool useIndirectDrawing = this->IsIndirectDrawingActive();
+        if (useIndirectDrawing) this->UploadRenderUnitData();
+
         this->PrepareShadowMaps();
 
         for (auto& camera : this->Pipeline.Cameras)
@@ -1509,8 +1971,24 @@ namespace MxEngine
             this->ToggleReversedDepth(camera.IsPerspective);
             this->AttachFrameBuffer(camera.GBuffer);
 
-            this->DrawObjects(camera, *this->Pipeline.Environment.Shaders["GBuffer"_id], this->Pipeline.OpaqueObjects);
-            this->DrawObjects(camera, *this->Pipeline.Environment.Shaders["GBufferMask"_id], this->Pipeline.MaskedObjects);
+            this->UpdateCameraUniformBlocks(camera);
+
+            {
+                MAKE_SCOPE_PROFILER("RenderController::CullRenderUnits()");
+                camera.Culler.CullAABBs(this->Pipeline.RenderUnitsAABB, camera.Visibility);
+                this->Pipeline.InstancedObjects.Cull(camera.Culler, this->Pipeline.Statistics);
+            }
+
+            if (useIndirectDrawing)
+            {
+                this->DrawObjectsIndirect(camera, *this->Pipeline.Environment.Shaders["GBufferIndirect"_id], this->Pipeline.OpaqueObjects);
+                this->DrawObjectsIndirect(camera, *this->Pipeline.Environment.Shaders["GBufferMaskIndirect"_id], this->Pipeline.MaskedObjects);
+            }
+            else
+            {
+                this->DrawObjects(camera, *this->Pipeline.Environment.Shaders["GBuffer"_id], this->Pipeline.OpaqueObjects, true);
+                this->DrawObjects(camera, *this->Pipeline.Environment.Shaders["GBufferMask"_id], this->Pipeline.MaskedObjects, true);
+            }
             this->DrawParticles(camera, this->Pipeline.OpaqueParticleSystems, *this->Pipeline.Environment.Shaders["ParticleOpaque"_id]);
 
             this->PerformLightPass(camera);
@@ -32,6 +32,7 @@
 #include "Platform/OpenGL/Renderer.h"
 #include "RenderPipeline.h"
 #include "RenderObjects/DebugBuffer.h"
+#include "Utilities/Array/ArrayView.h"
 
 namespace MxEngine
 {
@@ -49,17 +50,30 @@ namespace MxEngine
 
     class RenderController
     {
+    public:
+        constexpr static size_t InvalidRenderUnit = std::numeric_limits<size_t>::max();
+    private:
         Renderer renderer;
         RenderPipeline Pipeline;
 
         void PrepareShadowMaps();
         void DrawSkybox(const CameraUnit& camera);
-        void ComputeParticles(const MxVector<ParticleSystemUnit>& particleSystems);
-        void SortParticles(const CameraUnit& camera, MxVector<ParticleSystemUnit>& particleSystems);
-        void DrawParticles(const CameraUnit& camera, MxVector<ParticleSystemUnit>& particleSystems, const Shader& shader);
-        void DrawObjects(const CameraUnit& camera, const Shader& shader, const RenderList& objects);
+        void ComputeParticles(const FrameVector<ParticleSystemUnit>& particleSystems);
+        void SortParticles(const CameraUnit& camera, FrameVector<ParticleSystemUnit>& particleSystems);
+        void DrawParticles(const CameraUnit& camera, FrameVector<ParticleSystemUnit>& particleSystems, const Shader& shader);
+        void DrawObjects(const CameraUnit& camera, const Shader& shader, const RenderList& objects, bool sortByState);
+        void DrawObjectsIndirect(const CameraUnit& camera, const Shader& shader, const RenderList& objects);
+        void BindObjectsShader(const CameraUnit& camera, const Shader& shader);
+        void CollectDrawCommands(const CameraUnit& camera, const RenderList& objects);
+        void SortDrawCommands();
         void DrawDebugBuffer(const CameraUnit& camera);
         void DrawObject(const RenderUnit& unit, size_t instanceCount, size_t baseInstance, const Shader& shader);
+        void BindMaterial(size_t materialIndex, const Shader& shader);
+        void SetDisplacement(float displacement, const Shader& shader);
+        void UploadRenderUnitData();
+        void PlaceRenderUnit(size_t unitIndex, RenderUnitClass unitClass);
+        void UnplaceRenderUnit(size_t unitIndex);
+        void MarkRenderUnitChanged(size_t unitIndex);
         void ComputeBloomEffect(CameraUnit& camera, const TextureHandle& output);
         TextureHandle ComputeAverageWhite(CameraUnit& camera);
         void PerformPostProcessing(CameraUnit& camera);
@@ -83,8 +97,9 @@ namespace MxEngine
         void SubmitInstancedLights();
         void BindGBuffer(const CameraUnit& camera, const Shader& shader, Texture::TextureBindId& startId);
         void BindSkyboxInformation(const CameraUnit& camera, const Shader& shader, Texture::TextureBindId& startId);
-        void BindCameraInformation(const CameraUnit& camera, const Shader& shader);
-        void BindFogInformation(const CameraUnit& camera, const Shader& shader);
+        void UpdateCameraUniformBlocks(const CameraUnit& camera);
+        void UpdateLightingUniformBlock();
+        void BindDirectionalLightShadowMaps(const Shader& shader, Texture::TextureBindId& startId);
         void AttachDefaultVAO();
         void RenderToAttachedFrameBuffer(const Shader& shader);
     public:
@@ -113,11 +128,18 @@ namespace MxEngine
         void ApplyGaussianBlur(const TextureHandle& inputOutput, const TextureHandle& temporary, size_t iterations, size_t lod = 0);
         void DrawVertices(RenderPrimitive primitive, size_t vertexCount, size_t vertexOffset, size_t instanceCount, size_t baseInstance);
         void DrawIndices(RenderPrimitive primitive, size_t indexCount, size_t indexOffset, size_t baseVertex, size_t instanceCount, size_t baseInstance);
+        void SubmitIndirectCommands(ArrayView<DrawCommand> commands);
+        void DrawIndicesIndirect(const Shader& shader, size_t commandOffset, size_t commandCount);
+        bool IsIndirectDrawingActive() const;
 
         EnvironmentUnit& GetEnvironment();
         const EnvironmentUnit& GetEnvironment() const;
         LightingSystem& GetLightInformation();
         const LightingSystem& GetLightInformation() const;
+        IndirectDrawUnit& GetIndirectDrawInformation();
+        const IndirectDrawUnit& GetIndirectDrawInformation() const;
+        InstanceCuller& GetInstanceCuller();
+        const InstanceCuller& GetInstanceCuller() const;
         const RenderStatistics& GetRenderStatistics() const;
         RenderStatistics& GetRenderStatistics();
         void ResetPipeline();
@@ -128,8 +150,26 @@ namespace MxEngine
         void SubmitCamera(const CameraController& controller, const Transform& parentTransform, 
             const Skybox* skybox, const CameraEffects* effects, const CameraToneMapping* toneMapping,
             const CameraSSR* ssr, const CameraSSGI* ssgi, const CameraSSAO* ssao);
-        size_t SubmitRenderGroup(const Mesh& mesh, size_t instanceOffset, size_t instanceCount);
-        void SubmitRenderUnit(size_t renderGroupIndex, const SubMesh& object, const Material& material, const Transform& parentTransform, bool castsShadow, const char* debugName = nullptr);
+        /*!
+        adds render unit which is kept in pipeline until RemoveRenderUnit() is called. Geometry of unit must be set by UpdateRenderUnit()
+        \param submesh submesh which is drawn by unit
+        \param material material of unit. Unit is moved between render lists if material transparency or alpha mode changes
+        \param castsShadow if unit should be drawn to shadow maps
+        \param instanceBucket bucket of InstanceCuller with instances of unit or InstanceCuller::InvalidBucket for non-instanced objects
+        \returns index of unit in pipeline
+        */
+        size_t AddRenderUnit(const SubMesh& submesh, const MaterialHandle& material, bool castsShadow, size_t instanceBucket);
+        void UpdateRenderUnit(size_t unitIndex, const RenderUnitGeometry& geometry);
+        void RemoveRenderUnit(size_t unitIndex);
+        size_t GetRenderUnitCount() const;
+        static void ComputeRenderUnitGeometry(const SubMesh& submesh, const Matrix4x4& parentMatrix, const Matrix3x3& parentNormalMatrix, RenderUnitGeometry& geometry);
+        /*!
+        checks materials of render units for changes. Called once per frame, as materials can be edited without notifying renderer
+        */
+        void UpdateRenderUnitMaterials();
+        size_t SubmitMaterial(const Material& material);
+        void ResolveMaterial(Material& renderMaterial, bool isParticleMaterial) const;
+        void ReleaseUnusedMaterials();
         void SubmitImage(const TextureHandle& texture);
         void StartPipeline();
         void EndPipeline();
@@ -487,7 +487,8 @@ namespace MxEngine
 
     void DebugBuffer::ClearBuffer()
     {
-        this->storage.clear();
+        // storage is replaced instead of cleared, as its memory is reused by frame arena two frames later
+        this->storage = FrontendStorage();
     }
 
     void DebugBuffer::SubmitBuffer()
@@ -27,6 +27,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Platform/GraphicAPI.h"
+#include "Utilities/Memory/FrameArena.h"
 
 #pragma once
 
@@ -51,7 +52,8 @@ namespace MxEngine
             Vector4 color;
         };
 
-        using FrontendStorage = MxVector<Point>;
+        // points are uploaded and cleared every frame, so they are kept in frame arena
+        using FrontendStorage = FrameVector<Point>;
 
         VertexBufferHandle VBO;
         VertexArrayHandle VAO;
@@ -29,15 +29,19 @@
 #pragma once
 
 #include "Core/BoundingObjects/FrustrumCuller.h"
+#include "Core/BoundingObjects/AABB.h"
+#include "Core/Components/Transform.h"
 #include "RenderObjects/RectangleObject.h"
 #include "RenderObjects/SkyboxObject.h"
 #include "RenderObjects/RenderHelperObject.h"
 #include "RenderObjects/PointLightInstancedObject.h"
 #include "RenderObjects/SpotLightInstancedObject.h"
 #include "RenderUtilities/RenderStatistics.h"
+#include "RenderUtilities/InstanceCuller.h"
 #include "Core/Resources/ACESCurve.h"
-#include "Core/Resources/Material.h"
+#include "Core/Resources/AssetManager.h"
 #include "Utilities/String/String.h"
+#include "Utilities/Memory/FrameArena.h"
 
 namespace MxEngine
 {
@@ -67,6 +71,7 @@ namespace MxEngine
         TextureHandle SwapTexture2;
 
         FrustrumCuller Culler;
+        VisibilityMask Visibility;
         Matrix4x4 InverseViewProjMatrix;
         Matrix4x4 ViewProjectionMatrix;
         Matrix4x4 StaticViewProjectionMatrix;
@@ -109,6 +114,9 @@ namespace MxEngine
 
         VertexArrayHandle RenderVAO;
         ShaderStorageBufferHandle RenderSSBO;
+        UniformBufferHandle CameraUniformBuffer;
+        UniformBufferHandle EnvironmentUniformBuffer;
+        UniformBufferHandle LightingUniformBuffer;
 
         FrameBufferHandle DepthFrameBuffer;
         FrameBufferHandle PostProcessFrameBuffer;
@@ -126,6 +134,7 @@ namespace MxEngine
         uint8_t MainCameraIndex;
         bool OverlayDebugDraws;
         bool RenderToDefaultFrameBuffer;
+        bool UseIndirectDrawing;
     };
 
     struct DirectionalLightUnit
@@ -154,22 +163,16 @@ namespace MxEngine
 
     struct LightingSystem
     {
-        MxVector<DirectionalLightUnit> DirectionalLights;
-        MxVector<PointLightUnit> PointLights;
-        MxVector<SpotLightUnit> SpotLights;
+        // light lists are submitted and rendered in one frame, so they live in frame arena
+        FrameVector<DirectionalLightUnit> DirectionalLights;
+        FrameVector<PointLightUnit> PointLights;
+        FrameVector<SpotLightUnit> SpotLights;
         SpotLightInstancedObject SpotLightsInstanced;
         PointLightInstancedObject PointLightsInstanced;
         RenderHelperObject PointLight;
         RenderHelperObject SpotLight;
     };
 
-    struct RenderGroup
-    {
-        size_t BaseInstance;
-        size_t InstanceCount;
-        size_t UnitCount;
-    };
-
     struct RenderUnit
     {
         size_t MaterialIndex;
@@ -182,15 +185,174 @@ namespace MxEngine
         Matrix3x3 NormalMatrix;
 
         Vector3 MinAABB, MaxAABB;
-        #if defined(MXENGINE_DEBUG)
-        const char* DebugName;
-        #endif
+        float DisplacementScale;
     };
 
+    // world space data of render unit which depends on transform of parent object and submesh
+    struct RenderUnitGeometry
+    {
+        Matrix4x4 ModelMatrix;
+        Matrix3x3 NormalMatrix;
+        Vector3 MinAABB, MaxAABB;
+        float DisplacementScale;
+    };
+
+    struct RenderListEntry
+    {
+        size_t UnitIndex;
+        // bucket of InstanceCuller with culled instances of unit or InstanceCuller::InvalidBucket for non-instanced objects
+        size_t InstanceBucket;
+    };
+
+    // units are kept in lists between frames, so list is unordered and unit is removed by moving last entry to its place
     struct RenderList
     {
-        MxVector<RenderGroup> Groups;
-        MxVector<size_t> UnitsIndex;
+        MxVector<RenderListEntry> Entries;
+    };
+
+    enum class RenderUnitClass : uint8_t
+    {
+        INVISIBLE,
+        OPAQUE,
+        MASKED,
+        TRANSPARENT,
+    };
+
+    // location of render unit in render lists and material table, so unit can be moved or removed without searching for it
+    struct RenderUnitPlacement
+    {
+        RenderList* DrawList;
+        RenderList* ShadowList;
+        size_t DrawListIndex;
+        size_t ShadowListIndex;
+        size_t MaterialKey;
+        size_t MaterialUnitIndex;
+        size_t InstanceBucket;
+        bool CastsShadow;
+        bool IsAllocated;
+    };
+
+    struct RenderMeshDependent
+    {
+        size_t Object;
+        size_t MeshIndex;
+    };
+
+    // submesh data which render units are built from
+    struct RenderSubMeshState
+    {
+        Transform SubMeshTransform;
+        AABB SubMeshAABB;
+        size_t MaterialId;
+        size_t VertexOffset;
+        size_t VertexCount;
+        size_t IndexOffset;
+        size_t IndexCount;
+    };
+
+    /*!
+    mesh used by render units of at least one object. Submesh state is compared with mesh once per frame,
+    and units of all dependent objects are rebuilt if mesh was changed (i.e. loaded asynchronously or edited)
+    */
+    struct RenderMeshRecord
+    {
+        MeshHandle Mesh;
+        MxVector<RenderSubMeshState> SubMeshes;
+        MxVector<RenderMeshDependent> Dependents;
+    };
+
+    // units of one mesh drawn by object, one per submesh. Submeshes without material have RenderController::InvalidRenderUnit
+    struct RenderObjectMesh
+    {
+        size_t MeshKey;
+        ResourceId MeshId;
+        size_t DependentIndex;
+        MxVector<size_t> Units;
+    };
+
+    // render units of one object kept between frames. Regular objects draw one mesh, instanced objects draw one mesh per LOD
+    struct RenderObjectRecord
+    {
+        MxVector<RenderObjectMesh> Meshes;
+        size_t InstancedSlot = std::numeric_limits<size_t>::max();
+        bool IsRebuildQueued = false;
+        bool IsGeometryQueued = false;
+    };
+
+    /*!
+    bounds and LODs of instances of InstanceFactory. Bounds are rebuilt only when instances, object transform or mesh change,
+    LODs depend on viewport, so they are selected every frame
+    */
+    struct RenderInstancedRecord
+    {
+        size_t Object = std::numeric_limits<size_t>::max();
+        AABBArray InstanceAABBs;
+        MxVector<uint8_t> InstanceLODs;
+        ResourceId MeshId = ResourceIdGenerator::GetNull();
+        uint32_t InstanceVersion = 0;
+        uint32_t ParentVersion = 0;
+        bool IsBoundsValid = false;
+    };
+
+    // geometry of render units computed by one worker thread. Applied to pipeline in order after all workers finish
+    struct RenderGeometryBatch
+    {
+        MxVector<size_t> Units;
+        MxVector<RenderUnitGeometry> Geometry;
+    };
+
+    struct DrawCommand
+    {
+        size_t UnitIndex;
+        size_t MaterialIndex;
+        size_t VertexOffset;
+        float Depth;
+        size_t InstanceCount;
+        size_t BaseInstance;
+    };
+
+    // tracks material state set by last drawn unit to skip redundant texture binds and uniform uploads
+    struct DrawStateTracker
+    {
+        constexpr static size_t MaterialUniformCount = 6;
+
+        size_t MaterialIndex;
+        float Displacement;
+        std::array<Texture::BindableId, Material::TextureCount> BoundTextures;
+        size_t AvoidedTextureBinds;
+        size_t AvoidedUniformCalls;
+
+        void Reset()
+        {
+            this->MaterialIndex = std::numeric_limits<size_t>::max();
+            this->Displacement = std::numeric_limits<float>::quiet_NaN();
+            this->BoundTextures.fill(0);
+            this->AvoidedTextureBinds = 0;
+            this->AvoidedUniformCalls = 0;
+        }
+    };
+
+    // per-unit data read by indirect shaders from RenderUnitBuffer. Normal matrix is stored as mat4 to match std430 layout
+    // Params.x is displacement scale of unit, it is multiplied by displacement of material in shader, so unit data does not depend on material
+    struct RenderUnitGPUData
+    {
+        Matrix4x4 Model;
+        Matrix4x4 Normal;
+        Vector4 Params;
+    };
+
+    // GPU buffers for multi-draw indirect path. Only changed units are uploaded each frame, commands are uploaded once per pass
+    struct IndirectDrawUnit
+    {
+        // copy of RenderUnitBuffer, grown geometrically, so buffer is rarely reallocated
+        MxVector<RenderUnitGPUData> UnitData;
+        MxVector<size_t> ChangedUnits;
+        MxVector<uint8_t> IsUnitChanged;
+        MxVector<DrawElementsIndirectCommand> Commands;
+        MxVector<uint32_t> DrawUnitIndices;
+        ShaderStorageBufferHandle UnitDataBuffer;
+        ShaderStorageBufferHandle DrawUnitIndexBuffer;
+        DrawIndirectBufferHandle CommandBuffer;
     };
 
     struct ParticleSystemUnit
@@ -204,6 +366,37 @@ namespace MxEngine
         bool IsRelative;
     };
 
+    struct MaterialTableEntry
+    {
+        Material Source;
+        size_t MaterialIndex;
+        size_t LastUsedFrame;
+    };
+
+    // material of retained render units. Handle keeps source material alive while any unit uses it
+    struct RenderUnitMaterialEntry
+    {
+        MaterialHandle SourceHandle;
+        Material Source;
+        size_t MaterialIndex;
+        RenderUnitClass Class;
+        MxVector<size_t> Units;
+    };
+
+    /*!
+    maps source materials to resolved copies in MaterialUnits. Kept between frames, so material is copied only when it is first used or changed
+    render unit materials are keyed by material handle and released when last unit using them is removed, particle materials are submitted every frame
+    */
+    struct MaterialTable
+    {
+        MxHashMap<size_t, RenderUnitMaterialEntry> RenderUnitMaterials;
+        MxHashMap<const Material*, MaterialTableEntry> ParticleMaterials;
+        MxVector<size_t> FreeIndices;
+        size_t CurrentFrame = 0;
+        size_t ResolvedCount = 0;
+        size_t ReusedCount = 0;
+    };
+
     struct RenderPipeline
     {
         EnvironmentUnit Environment;
@@ -214,12 +407,22 @@ namespace MxEngine
         RenderList TransparentObjects;
         RenderList MaskedObjects;
         RenderList OpaqueObjects;
+        // render units are kept between frames. Removed units are not referenced by lists and their slots are reused
         MxVector<RenderUnit> RenderUnits;
+        MxVector<RenderUnitPlacement> RenderUnitPlacements;
+        MxVector<size_t> FreeRenderUnits;
+        AABBArray RenderUnitsAABB;
+        InstanceCuller InstancedObjects;
 
-        MxVector<ParticleSystemUnit> OpaqueParticleSystems;
-        MxVector<ParticleSystemUnit> TransparentParticleSystems;
+        // particle systems and cameras are submitted every frame, so they live in frame arena
+        FrameVector<ParticleSystemUnit> OpaqueParticleSystems;
+        FrameVector<ParticleSystemUnit> TransparentParticleSystems;
         MxVector<Material> MaterialUnits;
-        MxVector<CameraUnit> Cameras;
+        MaterialTable Materials;
+        MxVector<DrawCommand> DrawCommands;
+        DrawStateTracker DrawState;
+        IndirectDrawUnit IndirectDraw;
+        FrameVector<CameraUnit> Cameras;
         RenderStatistics Statistics;
     };
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "InstanceCuller.h"
+#include "Core/Components/Instancing/InstanceFactory.h"
+#include "Core/Resources/BufferAllocator.h"
+#include "Platform/Compute/Compute.h"
+
+namespace MxEngine
+{
+    constexpr static size_t InstanceDataSize = InstanceFactory::InstanceDataSize;
+    constexpr static size_t GatherGroupSize = 64;
+
+    void InstanceCuller::Init(const ComputeShaderHandle& gatherShader)
+    {
+        this->gatherShader = gatherShader;
+        this->indexBuffer = Factory<ShaderStorageBuffer>::Create((uint32_t*)nullptr, 0, UsageType::STREAM_DRAW);
+    }
+
+    size_t InstanceCuller::AddObject(const InstancedObjectUnit& object)
+    {
+        size_t objectIndex = this->objects.size();
+        this->objects.push_back(object);
+
+        if (this->visibility.size() <= objectIndex)
+            this->visibility.resize(objectIndex + 1);
+        this->visibility[objectIndex].resize((object.InstanceCount + 31) / 32);
+
+        for (size_t begin = 0; begin < object.InstanceCount; begin += ChunkSize)
+        {
+            auto& chunk = this->chunks.emplace_back();
+            chunk.ObjectIndex = objectIndex;
+            chunk.Begin = begin;
+            chunk.End = Min(begin + ChunkSize, object.InstanceCount);
+            chunk.LODOffsets.fill(0);
+        }
+
+        size_t firstBucket = this->buckets.size();
+        this->buckets.resize(firstBucket + MaxLODCount, InstanceRange{ 0, 0 });
+        return firstBucket;
+    }
+
+    size_t InstanceCuller::GetObjectCount() const
+    {
+        return this->objects.size();
+    }
+
+    void InstanceCuller::Clear()
+    {
+        this->objects.clear();
+        this->chunks.clear();
+        this->buckets.clear();
+        this->allocationCursor = 0;
+    }
+
+    void InstanceCuller::Cull(const FrustrumCuller& frustrum, RenderStatistics& statistics)
+    {
+        this->Cull(&frustrum, [](const Vector3&, const Vector3&) { return true; }, statistics);
+    }
+
+    InstanceRange InstanceCuller::GetInstanceRange(size_t bucket) const
+    {
+        MX_ASSERT(bucket < this->buckets.size());
+        return this->buckets[bucket];
+    }
+
+    void InstanceCuller::ReserveAllocation(size_t instanceCount)
+    {
+        if (this->allocationCursor + instanceCount <= this->allocationSize) return;
+
+        // draws of previous passes are already issued, so their instances can be overwritten
+        if (this->allocationSize != 0)
+            BufferAllocator::DeallocateInInstanceVBO({ this->allocationOffset * InstanceDataSize, this->allocationSize * InstanceDataSize });
+
+        auto allocation = BufferAllocator::AllocateInInstanceVBO(Max(instanceCount, this->allocationSize * 2) * InstanceDataSize);
+        this->allocationOffset = allocation.Offset / InstanceDataSize;
+        this->allocationSize = allocation.Size / InstanceDataSize;
+        this->allocationCursor = 0;
+    }
+
+    void InstanceCuller::CompactInstances(RenderStatistics& statistics)
+    {
+        // all chunks of one object are stored together, so instances of each LOD of object form one contiguous range
+        std::array<size_t, MaxLODCount> lodInstanceCount{ };
+        size_t visibleCount = 0;
+        size_t totalCount = 0;
+        size_t chunkIndex = 0;
+        for (size_t objectIndex = 0; objectIndex < this->objects.size(); objectIndex++)
+        {
+            size_t firstChunk = chunkIndex;
+            while (chunkIndex < this->chunks.size() && this->chunks[chunkIndex].ObjectIndex == objectIndex)
+                chunkIndex++;
+
+            for (size_t lod = 0; lod < MaxLODCount; lod++)
+            {
+                size_t lodBegin = visibleCount;
+                for (size_t chunk = firstChunk; chunk < chunkIndex; chunk++)
+                {
+                    auto& offset = this->chunks[chunk].LODOffsets[lod];
+                    size_t count = offset;
+                    offset = visibleCount;
+                    visibleCount += count;
+                }
+                this->buckets[objectIndex * MaxLODCount + lod] = InstanceRange{ lodBegin, visibleCount - lodBegin };
+                lodInstanceCount[lod] += visibleCount - lodBegin;
+            }
+            totalCount += this->objects[objectIndex].InstanceCount;
+        }
+
+        this->ReserveAllocation(visibleCount);
+        this->compactedIndices.resize(visibleCount);
+
+        ThreadPool::GetGlobal().ParallelFor(this->chunks.size(), [this](size_t chunkIndex)
+        {
+            auto& chunk = this->chunks[chunkIndex];
+            const auto& object = this->objects[chunk.ObjectIndex];
+            const auto& mask = this->visibility[chunk.ObjectIndex];
+            for (size_t i = chunk.Begin; i < chunk.End; i++)
+            {
+                if (!FrustrumCuller::IsVisible(mask, i)) continue;
+
+                size_t target = chunk.LODOffsets[object.InstanceLODs[i]]++;
+                this->compactedIndices[target] = uint32_t(object.InstanceBufferOffset + i);
+            }
+        });
+
+        size_t baseInstance = this->allocationOffset + this->allocationCursor;
+        for (auto& bucket : this->buckets)
+            bucket.BaseInstance += baseInstance;
+
+        if (visibleCount != 0)
+            this->GatherInstances(baseInstance);
+        this->allocationCursor += visibleCount;
+
+        statistics.AddEntry("uploaded instance indices", visibleCount);
+        constexpr static std::array<const char*, MaxLODCount> lodEntryNames = {
+            "instances in lod 0", "instances in lod 1", "instances in lod 2", "instances in lod 3",
+            "instances in lod 4", "instances in lod 5", "instances in lod 6",
+        };
+        statistics.AddEntry("culled instances", totalCount - visibleCount);
+        for (size_t lod = 0; lod < MaxLODCount; lod++)
+            statistics.AddEntry(lodEntryNames[lod], lodInstanceCount[lod]);
+    }
+
+    void InstanceCuller::GatherInstances(size_t baseInstance)
+    {
+        MAKE_SCOPE_PROFILER("InstanceCuller::GatherInstances()");
+        MX_ASSERT(this->gatherShader.IsValid());
+
+        // instance data is already in factory ranges, so only indices are sent. Buffer is respecified to not wait for previous passes
+        this->indexBuffer->Load(this->compactedIndices.data(), this->compactedIndices.size(), UsageType::STREAM_DRAW);
+
+        this->gatherShader->Bind();
+        this->gatherShader->SetUniform(UNIFORM_ID("indexCount"), (int)this->compactedIndices.size());
+        this->gatherShader->SetUniform(UNIFORM_ID("targetOffset"), (int)baseInstance);
+        this->gatherShader->SetUniform(UNIFORM_ID("instanceSize"), (int)InstanceDataSize);
+        BufferAllocator::GetInstanceVBO()->BindBase(BufferType::SHADER_STORAGE, 3);
+        this->indexBuffer->BindBase(4);
+
+        size_t groupCount = (this->compactedIndices.size() + GatherGroupSize - 1) / GatherGroupSize;
+        Compute::Dispatch(this->gatherShader, groupCount, 1, 1);
+        // compacted range is read as instance vertex attributes by draws of this pass
+        Compute::SetMemoryBarrier(BarrierType::VERTEX_ARRAY);
+    }
+}
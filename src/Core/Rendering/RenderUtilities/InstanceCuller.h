@@ -0,0 +1,176 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/BoundingObjects/FrustrumCuller.h"
+#include "Platform/GraphicAPI.h"
+#include "Utilities/Concurrency/ThreadPool.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "RenderStatistics.h"
+
+namespace MxEngine
+{
+    // instances of one InstanceFactory submitted for current frame. Bounds and LODs are owned by instanced record of RenderAdaptor
+    struct InstancedObjectUnit
+    {
+        size_t InstanceBufferOffset; // offset of InstanceFactory range in instance buffer, in instances
+        const AABBArray* InstanceAABBs;
+        const uint8_t* InstanceLODs;
+        size_t InstanceCount;
+    };
+
+    struct InstanceRange
+    {
+        size_t BaseInstance;
+        size_t InstanceCount;
+    };
+
+    /*!
+    instance culler tests instances of all submitted instanced objects against frustrum of each render pass. Visible instances
+    are compacted into per-frame range of instance buffer and grouped by LOD, so each LOD of object is drawn by one instanced call.
+    Instance data stays in persistent ranges of instance factories, culler uploads only indices of visible instances
+    and compute shader copies instances from factory ranges to compacted range on GPU
+    */
+    class InstanceCuller
+    {
+    public:
+        /*!
+        maximum number of LODs of instanced object (base mesh + MeshLOD::MaxLODLevel levels)
+        */
+        constexpr static size_t MaxLODCount = 7;
+        /*!
+        number of instances culled by one task. Multiple of 32, so tasks never share visibility mask word
+        */
+        constexpr static size_t ChunkSize = 4096;
+        constexpr static size_t InvalidBucket = std::numeric_limits<size_t>::max();
+    private:
+        struct CullingChunk
+        {
+            size_t ObjectIndex;
+            size_t Begin;
+            size_t End;
+            // count of visible instances per LOD after culling, write offsets in compacted instances after prefix sum
+            std::array<size_t, MaxLODCount> LODOffsets;
+        };
+
+        MxVector<InstancedObjectUnit> objects;
+        MxVector<VisibilityMask> visibility;
+        MxVector<CullingChunk> chunks;
+        /*!
+        range of visible instances of each LOD of each object, MaxLODCount entries per object
+        */
+        MxVector<InstanceRange> buckets;
+        /*!
+        indices of visible instances in instance buffer, in order of compacted range
+        */
+        MxVector<uint32_t> compactedIndices;
+        ShaderStorageBufferHandle indexBuffer;
+        ComputeShaderHandle gatherShader;
+        /*!
+        region of instance buffer where compacted instances are stored. Each pass appends its instances, region is reused every frame
+        */
+        size_t allocationOffset = 0;
+        size_t allocationSize = 0;
+        size_t allocationCursor = 0;
+
+        void CompactInstances(RenderStatistics& statistics);
+        void GatherInstances(size_t baseInstance);
+        void ReserveAllocation(size_t instanceCount);
+    public:
+        /*!
+        creates index buffer of culler
+        \param gatherShader compute shader which copies instances by their indices into compacted range
+        */
+        void Init(const ComputeShaderHandle& gatherShader);
+        /*!
+        adds instanced object for current frame
+        \param object instance buffer range, bounds and LODs of object. They must stay valid until Clear() is called
+        \returns index of first bucket of object. Bucket of LOD i is returned value + i
+        */
+        size_t AddObject(const InstancedObjectUnit& object);
+        size_t GetObjectCount() const;
+        void Clear();
+
+        /*!
+        culls instances of all objects and gathers visible ones into compacted range of instance buffer
+        \param frustrum frustrum of render pass or nullptr if only isVisible test should be used
+        \param isVisible additional test for instances which are inside frustrum, accepts min and max of instance world AABB
+        \param statistics statistics of renderer, where culled and per-LOD instance counts are added
+        */
+        template<typename CullFunc>
+        void Cull(const FrustrumCuller* frustrum, const CullFunc& isVisible, RenderStatistics& statistics);
+        void Cull(const FrustrumCuller& frustrum, RenderStatistics& statistics);
+
+        /*!
+        gets range of instances in instance buffer which were compacted by last Cull() call
+        \param bucket instance bucket of render group
+        */
+        InstanceRange GetInstanceRange(size_t bucket) const;
+    };
+
+    template<typename CullFunc>
+    inline void InstanceCuller::Cull(const FrustrumCuller* frustrum, const CullFunc& isVisible, RenderStatistics& statistics)
+    {
+        if (this->objects.empty()) return;
+        MAKE_SCOPE_PROFILER("InstanceCuller::Cull()");
+
+        ThreadPool::GetGlobal().ParallelFor(this->chunks.size(), [this, frustrum, &isVisible](size_t chunkIndex)
+        {
+            auto& chunk = this->chunks[chunkIndex];
+            const auto& object = this->objects[chunk.ObjectIndex];
+            const auto& boxes = *object.InstanceAABBs;
+            auto& mask = this->visibility[chunk.ObjectIndex];
+
+            if (frustrum != nullptr)
+            {
+                frustrum->CullAABBs(boxes, chunk.Begin, chunk.End, mask);
+            }
+            else
+            {
+                for (size_t i = chunk.Begin; i < chunk.End; i++)
+                    mask[i / 32] |= 1u << (i % 32);
+            }
+
+            chunk.LODOffsets.fill(0);
+            for (size_t i = chunk.Begin; i < chunk.End; i++)
+            {
+                if (!FrustrumCuller::IsVisible(mask, i)) continue;
+
+                Vector3 minp{ boxes.MinX[i], boxes.MinY[i], boxes.MinZ[i] };
+                Vector3 maxp{ boxes.MaxX[i], boxes.MaxY[i], boxes.MaxZ[i] };
+                if (isVisible(minp, maxp))
+                    chunk.LODOffsets[object.InstanceLODs[i]]++;
+                else
+                    mask[i / 32] &= ~(1u << (i % 32));
+            }
+        });
+
+        this->CompactInstances(statistics);
+    }
+}
@@ -29,12 +29,13 @@
 #include "ShadowMapGenerator.h"
 #include "Core/Application/Rendering.h"
 #include "Core/Rendering/RenderPipeline.h"
-#include "Core/BoundingObjects/FrustrumCuller.h"
 
 namespace MxEngine
 {
-    ShadowMapGenerator::ShadowMapGenerator(const RenderList& shadowCasters, ArrayView<RenderUnit> renderUnits, ArrayView<Material> materials)
-        : shadowCasters(shadowCasters), renderUnits(renderUnits), materials(materials)
+    ShadowMapGenerator::ShadowMapGenerator(const RenderList& shadowCasters, const RenderList& maskedShadowCasters, ArrayView<RenderUnit> renderUnits, const AABBArray& renderUnitsAABB, 
+        InstanceCuller& instanceCuller, ArrayView<Material> materials, MxVector<DrawCommand>& drawCommands, bool useIndirectDrawing)
+        : shadowCasters(shadowCasters), maskedShadowCasters(maskedShadowCasters), renderUnits(renderUnits), renderUnitsAABB(renderUnitsAABB), 
+          instanceCuller(instanceCuller), materials(materials), drawCommands(drawCommands), useIndirectDrawing(useIndirectDrawing)
     {
         Rendering::GetController().ToggleReversedDepth(false);
         Rendering::GetController().ToggleDepthOnlyMode(true);
@@ -45,31 +46,31 @@ namespace MxEngine
         Rendering::GetController().ToggleDepthOnlyMode(false);
     }
 
-    void RenderUnitToDepthMap(const Shader& shader, size_t instanceCount, size_t baseInstance, const RenderUnit& unit, ArrayView<Material> materials)
+    void BindDepthMaterial(const Shader& shader, const Material& material)
     {
-        shader.IgnoreNonExistingUniform("alphaCutoff");
-        shader.IgnoreNonExistingUniform("map_albedo");
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("alphaCutoff"));
+        shader.IgnoreNonExistingUniform(UNIFORM_ID("map_albedo"));
 
-        const auto& material = materials[unit.MaterialIndex];
         material.HeightMap->Bind(0);
         material.AlbedoMap->Bind(1);
-        shader.SetUniform("alphaCutoff", 1.0f - material.Transparency);
-        shader.SetUniform("displacement", material.Displacement);
-        shader.SetUniform("uvMultipliers", material.UVMultipliers);
-        shader.SetUniform("map_height", material.HeightMap->GetBoundId());
-        shader.SetUniform("map_albedo", material.AlbedoMap->GetBoundId());
-        shader.SetUniform("parentModel", unit.ModelMatrix);
-        shader.SetUniform("parentNormal", unit.NormalMatrix);
+        shader.SetUniform(UNIFORM_ID("alphaCutoff"), 1.0f - material.Transparency);
+        shader.SetUniform(UNIFORM_ID("uvMultipliers"), material.UVMultipliers);
+        shader.SetUniform(UNIFORM_ID("map_height"), material.HeightMap->GetBoundId());
+        shader.SetUniform(UNIFORM_ID("map_albedo"), material.AlbedoMap->GetBoundId());
+    }
+
+    void RenderUnitToDepthMap(const Shader& shader, size_t instanceCount, size_t baseInstance, const RenderUnit& unit, ArrayView<Material> materials)
+    {
+        const auto& material = materials[unit.MaterialIndex];
+        BindDepthMaterial(shader, material);
+        shader.SetUniform(UNIFORM_ID("displacement"), material.Displacement * unit.DisplacementScale);
+        shader.SetUniform(UNIFORM_ID("parentModel"), unit.ModelMatrix);
+        shader.SetUniform(UNIFORM_ID("parentNormal"), unit.NormalMatrix);
 
         Rendering::GetController().DrawIndices(RenderPrimitive::TRIANGLES, unit.IndexCount, unit.IndexOffset, unit.VertexOffset, instanceCount, baseInstance);
         Rendering::GetController().GetRenderStatistics().AddEntry("shadow casts", 1);
     }
 
-    bool InOrthoFrustrum(const FrustrumCuller& culler, const Vector3& minAABB, const Vector3& maxAABB)
-    {
-        return culler.IsAABBVisible(minAABB, maxAABB);
-    };
-
     bool InSphereBounds(const PointLightUnit& pointLight, const Vector3& minAABB, const Vector3& maxAABB)
     {
         auto halfSize = 0.5f * (maxAABB - minAABB);
@@ -96,13 +97,13 @@ namespace MxEngine
     }
 
     template<typename CullFunc>
-    void CastShadowsPerUnit(const CullFunc& culler, const Shader& shader, const RenderUnit& unit, size_t instanceCount, size_t baseInstance, ArrayView<Material> materials)
+    void CastShadowsPerUnit(const CullFunc& culler, const Shader& shader, const RenderUnit& unit, size_t unitIndex, const InstanceRange& instances, ArrayView<Material> materials)
     {
-        // do not cull instanced objects, as their position may differ
-        bool culled = instanceCount == 0 && !culler(unit.MinAABB, unit.MaxAABB);
+        // instanced objects are culled per instance by InstanceCuller
+        bool culled = instances.InstanceCount == 0 && !culler(unit, unitIndex);
         if (!culled)
         {
-            RenderUnitToDepthMap(shader, instanceCount, baseInstance, unit, materials);
+            RenderUnitToDepthMap(shader, instances.InstanceCount, instances.BaseInstance, unit, materials);
         }
         else
         {
@@ -110,113 +111,183 @@ namespace MxEngine
         }
     }
 
+    InstanceRange GetEntryInstances(const RenderListEntry& entry, const InstanceCuller& instanceCuller)
+    {
+        if (entry.InstanceBucket == InstanceCuller::InvalidBucket) return InstanceRange{ 0, 0 };
+        return instanceCuller.GetInstanceRange(entry.InstanceBucket);
+    }
+
     template<typename CullFunc>
-    void CastsShadowsPerGroup(const CullFunc& culler, const Shader& shader, const RenderList& shadowCasters, ArrayView<RenderUnit> units, ArrayView<Material> materials)
+    void CastShadowsPerList(const CullFunc& culler, const Shader& shader, const RenderList& shadowCasters, const InstanceCuller& instanceCuller, ArrayView<RenderUnit> units, ArrayView<Material> materials)
     {
-        size_t currentUnit = 0;
-        for (const auto& group : shadowCasters.Groups)
+        for (const auto& entry : shadowCasters.Entries)
         {
-            if (group.UnitCount == 0) continue;
+            // instanced unit without visible instances in its LOD is skipped entirely
+            auto instances = GetEntryInstances(entry, instanceCuller);
+            if (entry.InstanceBucket != InstanceCuller::InvalidBucket && instances.InstanceCount == 0) continue;
 
-            for (size_t i = 0; i < group.UnitCount; i++, currentUnit++)
+            const RenderUnit& unit = units[entry.UnitIndex];
+            CastShadowsPerUnit(culler, shader, unit, entry.UnitIndex, instances, materials);
+        }
+    }
+
+    template<typename CullFunc>
+    void CastShadowsIndirect(const CullFunc& culler, const Shader& shader, const RenderList& shadowCasters, const InstanceCuller& instanceCuller, ArrayView<RenderUnit> units, ArrayView<Material> materials, MxVector<DrawCommand>& drawCommands)
+    {
+        auto& controller = Rendering::GetController();
+        drawCommands.clear();
+
+        size_t culledUnits = 0;
+        for (const auto& entry : shadowCasters.Entries)
+        {
+            auto instances = GetEntryInstances(entry, instanceCuller);
+            if (entry.InstanceBucket != InstanceCuller::InvalidBucket && instances.InstanceCount == 0) continue;
+
+            const RenderUnit& unit = units[entry.UnitIndex];
+            // instanced objects are culled per instance by InstanceCuller
+            if (instances.InstanceCount == 0 && !culler(unit, entry.UnitIndex))
             {
-                const RenderUnit& unit = units[shadowCasters.UnitsIndex[currentUnit]];
-                CastShadowsPerUnit(culler, shader, unit, group.InstanceCount, group.BaseInstance, materials);
+                culledUnits++;
+                continue;
             }
+
+            auto& command = drawCommands.emplace_back();
+            command.UnitIndex = entry.UnitIndex;
+            command.MaterialIndex = unit.MaterialIndex;
+            command.VertexOffset = unit.VertexOffset;
+            command.Depth = 0.0f;
+            command.InstanceCount = instances.InstanceCount;
+            command.BaseInstance = instances.BaseInstance;
+        }
+        controller.GetRenderStatistics().AddEntry("culled from shadow cast", culledUnits);
+        controller.GetRenderStatistics().AddEntry("shadow casts", drawCommands.size());
+        if (drawCommands.empty()) return;
+
+        std::sort(drawCommands.begin(), drawCommands.end(), [](const DrawCommand& c1, const DrawCommand& c2)
+        {
+            if (c1.MaterialIndex != c2.MaterialIndex) return c1.MaterialIndex < c2.MaterialIndex;
+            return c1.VertexOffset < c2.VertexOffset;
+        });
+        controller.SubmitIndirectCommands(drawCommands);
+
+        size_t bucketBegin = 0;
+        while (bucketBegin < drawCommands.size())
+        {
+            size_t materialIndex = drawCommands[bucketBegin].MaterialIndex;
+            size_t bucketEnd = bucketBegin + 1;
+            while (bucketEnd < drawCommands.size() && drawCommands[bucketEnd].MaterialIndex == materialIndex)
+                bucketEnd++;
+
+            BindDepthMaterial(shader, materials[materialIndex]);
+            shader.SetUniform(UNIFORM_ID("displacement"), materials[materialIndex].Displacement);
+            controller.DrawIndicesIndirect(shader, bucketBegin, bucketEnd - bucketBegin);
+            bucketBegin = bucketEnd;
         }
     }
 
-    void ShadowMapGenerator::GenerateFor(const Shader& shader, ArrayView<DirectionalLightUnit> directionalLights, LoadStoreOptions options)
+    template<typename CullFunc>
+    void ShadowMapGenerator::CastShadows(const CullFunc& culler, const Shader& shader, const RenderList& shadowCasters)
+    {
+        if (this->useIndirectDrawing)
+            CastShadowsIndirect(culler, shader, shadowCasters, this->instanceCuller, this->renderUnits, this->materials, this->drawCommands);
+        else
+            CastShadowsPerList(culler, shader, shadowCasters, this->instanceCuller, this->renderUnits, this->materials);
+    }
+
+    void ShadowMapGenerator::GenerateFor(const Shader& shader, const Shader& maskShader, ArrayView<DirectionalLightUnit> directionalLights)
     {
         auto& controller = Rendering::GetController();
 
-        shader.Bind();
         for (auto& directionalLight : directionalLights)
         {
-            if (options & LoadStoreOptions::LOAD)
-                controller.AttachDepthMapNoClear(directionalLight.ShadowMap);
-            else
-                controller.AttachDepthMap(directionalLight.ShadowMap);
+            controller.AttachDepthMap(directionalLight.ShadowMap);
             size_t splitSize = directionalLight.ShadowMap->GetWidth() / directionalLight.ProjectionMatrices.size();
 
             for (size_t i = 0; i < directionalLight.ProjectionMatrices.size(); i++)
             {
                 controller.SetViewport(int(i * splitSize), 0, splitSize, splitSize);
-
                 const auto& projection = directionalLight.ProjectionMatrices[i];
-                shader.SetUniform("LightProjMatrix", projection);
 
-                auto CullingFunction = [culler = FrustrumCuller(projection)](const Vector3& min, const Vector3& max)
+                FrustrumCuller frustrumCuller(projection);
+                frustrumCuller.CullAABBs(this->renderUnitsAABB, this->visibility);
+                this->instanceCuller.Cull(frustrumCuller, controller.GetRenderStatistics());
+                auto CullingFunction = [this](const RenderUnit& unit, size_t unitIndex)
                 {
-                    return InOrthoFrustrum(culler, min, max);
+                    return FrustrumCuller::IsVisible(this->visibility, unitIndex);
                 };
 
-                CastsShadowsPerGroup(CullingFunction, shader, this->shadowCasters, this->renderUnits, this->materials);
-            }
+                shader.Bind();
+                shader.SetUniform(UNIFORM_ID("LightProjMatrix"), projection);
+                this->CastShadows(CullingFunction, shader, this->shadowCasters);
 
+                maskShader.Bind();
+                maskShader.SetUniform(UNIFORM_ID("LightProjMatrix"), projection);
+                this->CastShadows(CullingFunction, maskShader, this->maskedShadowCasters);
+            }
         }
     }
 
-    void ShadowMapGenerator::GenerateFor(const Shader& shader, ArrayView<SpotLightUnit> spotLights, LoadStoreOptions options)
+    void ShadowMapGenerator::GenerateFor(const Shader& shader, const Shader& maskShader, ArrayView<SpotLightUnit> spotLights)
     {
         auto& controller = Rendering::GetController();
 
-        shader.Bind();
         for (auto& spotLight : spotLights)
         {
-            if (options & LoadStoreOptions::LOAD)
-                controller.AttachDepthMapNoClear(spotLight.ShadowMap);
-            else
-                controller.AttachDepthMap(spotLight.ShadowMap);
+            controller.AttachDepthMap(spotLight.ShadowMap);
 
-            shader.SetUniform("LightProjMatrix", spotLight.ProjectionMatrix);
-
-            auto CullingFunction = [&spotLight](const Vector3& min, const Vector3& max)
+            // frustrum test is done for all units at once, cone test is tighter, so it is applied to remaining ones
+            FrustrumCuller frustrumCuller(spotLight.ProjectionMatrix);
+            frustrumCuller.CullAABBs(this->renderUnitsAABB, this->visibility);
+            this->instanceCuller.Cull(&frustrumCuller, [&spotLight](const Vector3& minAABB, const Vector3& maxAABB)
+            {
+                return InConeBounds(spotLight, minAABB, maxAABB);
+            }, controller.GetRenderStatistics());
+            auto CullingFunction = [this, &spotLight](const RenderUnit& unit, size_t unitIndex)
             {
-                return InConeBounds(spotLight, min, max);
+                return FrustrumCuller::IsVisible(this->visibility, unitIndex) && InConeBounds(spotLight, unit.MinAABB, unit.MaxAABB);
             };
 
-            CastsShadowsPerGroup(CullingFunction, shader, this->shadowCasters, this->renderUnits, this->materials);
+            shader.Bind();
+            shader.SetUniform(UNIFORM_ID("LightProjMatrix"), spotLight.ProjectionMatrix);
+            this->CastShadows(CullingFunction, shader, this->shadowCasters);
+
+            maskShader.Bind();
+            maskShader.SetUniform(UNIFORM_ID("LightProjMatrix"), spotLight.ProjectionMatrix);
+            this->CastShadows(CullingFunction, maskShader, this->maskedShadowCasters);
         }
     }
 
-    void ShadowMapGenerator::GenerateFor(const Shader& shader, ArrayView<PointLightUnit> pointLights, LoadStoreOptions options)
+    void ShadowMapGenerator::GenerateFor(const Shader& shader, ArrayView<PointLightUnit> pointLights)
     {
+        // cubemap depth shader renders through geometry shader and uses per-unit uniforms, so point lights are never drawn indirectly
         auto& controller = Rendering::GetController();
 
-        shader.Bind();
         for (auto& pointLight : pointLights)
         {
-            if (options & LoadStoreOptions::LOAD)
-                controller.AttachDepthMapNoClear(pointLight.ShadowMap);
-            else
-                controller.AttachDepthMap(pointLight.ShadowMap);
-
-            shader.SetUniform("LightProjMatrix[0]", pointLight.ProjectionMatrices[0]);
-            shader.SetUniform("LightProjMatrix[1]", pointLight.ProjectionMatrices[1]);
-            shader.SetUniform("LightProjMatrix[2]", pointLight.ProjectionMatrices[2]);
-            shader.SetUniform("LightProjMatrix[3]", pointLight.ProjectionMatrices[3]);
-            shader.SetUniform("LightProjMatrix[4]", pointLight.ProjectionMatrices[4]);
-            shader.SetUniform("LightProjMatrix[5]", pointLight.ProjectionMatrices[5]);
-            shader.SetUniform("zFar", pointLight.Radius);
-            shader.SetUniform("lightPos", pointLight.Position);
-
-            auto CullingFunction = [&pointLight](const Vector3& min, const Vector3& max)
+            controller.AttachDepthMap(pointLight.ShadowMap);
+
+            // instances are gathered by compute shader, so depth shader is bound after culling
+            this->instanceCuller.Cull(nullptr, [&pointLight](const Vector3& minAABB, const Vector3& maxAABB)
+            {
+                return InSphereBounds(pointLight, minAABB, maxAABB);
+            }, controller.GetRenderStatistics());
+            auto CullingFunction = [&pointLight](const RenderUnit& unit, size_t unitIndex)
             {
-                return InSphereBounds(pointLight, min, max);
+                return InSphereBounds(pointLight, unit.MinAABB, unit.MaxAABB);
             };
 
-            CastsShadowsPerGroup(CullingFunction, shader, this->shadowCasters, this->renderUnits, this->materials);
+            shader.Bind();
+            shader.SetUniform(UNIFORM_ID("LightProjMatrix[0]"), pointLight.ProjectionMatrices[0]);
+            shader.SetUniform(UNIFORM_ID("LightProjMatrix[1]"), pointLight.ProjectionMatrices[1]);
+            shader.SetUniform(UNIFORM_ID("LightProjMatrix[2]"), pointLight.ProjectionMatrices[2]);
+            shader.SetUniform(UNIFORM_ID("LightProjMatrix[3]"), pointLight.ProjectionMatrices[3]);
+            shader.SetUniform(UNIFORM_ID("LightProjMatrix[4]"), pointLight.ProjectionMatrices[4]);
+            shader.SetUniform(UNIFORM_ID("LightProjMatrix[5]"), pointLight.ProjectionMatrices[5]);
+            shader.SetUniform(UNIFORM_ID("zFar"), pointLight.Radius);
+            shader.SetUniform(UNIFORM_ID("lightPos"), pointLight.Position);
+
+            CastShadowsPerList(CullingFunction, shader, this->shadowCasters, this->instanceCuller, this->renderUnits, this->materials);
+            CastShadowsPerList(CullingFunction, shader, this->maskedShadowCasters, this->instanceCuller, this->renderUnits, this->materials);
         }
     }
-
-    ShadowMapGenerator::LoadStoreOptions operator|(ShadowMapGenerator::LoadStoreOptions options1, ShadowMapGenerator::LoadStoreOptions options2)
-    {
-        return ShadowMapGenerator::LoadStoreOptions(uint32_t(options1) | uint32_t(options2));
-    }
-
-    bool operator&(ShadowMapGenerator::LoadStoreOptions options1, ShadowMapGenerator::LoadStoreOptions options2)
-    {
-        return bool(uint32_t(options1) & uint32_t(options2));
-    }
 }
\ No newline at end of file
@@ -27,6 +27,9 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Utilities/Array/ArrayView.h"
+#include "Utilities/STL/MxVector.h"
+#include "Core/BoundingObjects/FrustrumCuller.h"
+#include "InstanceCuller.h"
 
 namespace MxEngine
 {
@@ -37,27 +40,36 @@ namespace MxEngine
     struct SpotLightUnit;
     struct RenderList;
     struct RenderUnit;
+    struct DrawCommand;
 
+    /*!
+    shadow map generator draws opaque and masked shadow casters into shadow maps of lights. Both lists are drawn after one culling
+    pass per light projection, so render units and instances are tested against each light frustrum only once
+    */
     class ShadowMapGenerator
     {
         const RenderList& shadowCasters;
+        const RenderList& maskedShadowCasters;
         ArrayView<RenderUnit> renderUnits;
+        const AABBArray& renderUnitsAABB;
+        InstanceCuller& instanceCuller;
         ArrayView<Material> materials;
-    public:
-        enum class LoadStoreOptions
-        {
-            CLEAR = 1 << 0, 
-            LOAD = 1 << 1,
-        };
+        MxVector<DrawCommand>& drawCommands;
+        VisibilityMask visibility;
+        bool useIndirectDrawing;
 
-        ShadowMapGenerator(const RenderList& shadowCasters, ArrayView<RenderUnit> renderUnits, ArrayView<Material> materials);
+        template<typename CullFunc>
+        void CastShadows(const CullFunc& culler, const Shader& shader, const RenderList& shadowCasters);
+    public:
+        ShadowMapGenerator(const RenderList& shadowCasters, const RenderList& maskedShadowCasters, ArrayView<RenderUnit> renderUnits, const AABBArray& renderUnitsAABB, 
+            InstanceCuller& instanceCuller, ArrayView<Material> materials, MxVector<DrawCommand>& drawCommands, bool useIndirectDrawing);
         ~ShadowMapGenerator();
 
-        void GenerateFor(const Shader& shader, ArrayView<DirectionalLightUnit> directionalLights, LoadStoreOptions options);
-        void GenerateFor(const Shader& shader, ArrayView<PointLightUnit> pointLights, LoadStoreOptions options);
-        void GenerateFor(const Shader& shader, ArrayView<SpotLightUnit> spotLights, LoadStoreOptions options);
+        void GenerateFor(const Shader& shader, const Shader& maskShader, ArrayView<DirectionalLightUnit> directionalLights);
+        void GenerateFor(const Shader& shader, const Shader& maskShader, ArrayView<SpotLightUnit> spotLights);
+        /*!
+        point light depth shader handles both opaque and masked casters, so one shader is used for both lists
+        */
+        void GenerateFor(const Shader& shader, ArrayView<PointLightUnit> pointLights);
     };
-
-    ShadowMapGenerator::LoadStoreOptions operator|(ShadowMapGenerator::LoadStoreOptions options1, ShadowMapGenerator::LoadStoreOptions options2);
-    bool operator&(ShadowMapGenerator::LoadStoreOptions options1, ShadowMapGenerator::LoadStoreOptions options2);
 }
\ No newline at end of file
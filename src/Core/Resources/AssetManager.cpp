@@ -27,6 +27,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssetManager.h"
+#include "AsyncAssetLoader.h"
 #include "Utilities/FileSystem/FileManager.h"
 #include "Core/Components/Rendering/MeshRenderer.h"
 
@@ -139,6 +140,30 @@ namespace MxEngine
         return AssetManager::LoadTexture(FilePath(path), format);
     }
 
+    TextureHandle AssetManager::LoadTextureAsync(StringId hash, TextureFormat format, TextureLoadCallback callback)
+    {
+        auto texture = Factory<Texture>::Create();
+        auto& path = FileManager::GetFilePath(hash);
+        AsyncAssetLoader::LoadTexture(texture, path, format, std::move(callback));
+        return texture;
+    }
+
+    TextureHandle AssetManager::LoadTextureAsync(const FilePath& path, TextureFormat format, TextureLoadCallback callback)
+    {
+        auto hash = FileManager::RegisterExternalResource(path);
+        return AssetManager::LoadTextureAsync(hash, format, std::move(callback));
+    }
+
+    TextureHandle AssetManager::LoadTextureAsync(const MxString& path, TextureFormat format, TextureLoadCallback callback)
+    {
+        return AssetManager::LoadTextureAsync(ToFilePath(path), format, std::move(callback));
+    }
+
+    TextureHandle AssetManager::LoadTextureAsync(const char* path, TextureFormat format, TextureLoadCallback callback)
+    {
+        return AssetManager::LoadTextureAsync(FilePath(path), format, std::move(callback));
+    }
+
     ShaderHandle AssetManager::LoadShader(StringId vertex, StringId fragment)
     {
         auto shader = Factory<Shader>::Create();
@@ -269,6 +294,31 @@ namespace MxEngine
         return AssetManager::LoadMesh(FilePath(path));
     }
 
+    MeshHandle AssetManager::LoadMeshAsync(StringId hash, MeshLoadCallback callback)
+    {
+        auto mesh = Factory<Mesh>::Create();
+        auto& path = FileManager::GetFilePath(hash);
+        AsyncAssetLoader::LoadMesh(mesh, std::filesystem::proximate(path), std::move(callback));
+        return mesh;
+    }
+
+    MeshHandle AssetManager::LoadMeshAsync(const FilePath& path, MeshLoadCallback callback)
+    {
+        auto localPath = RegisterExternalFolder(path);
+        auto hash = FileManager::RegisterExternalResource(localPath);
+        return AssetManager::LoadMeshAsync(hash, std::move(callback));
+    }
+
+    MeshHandle AssetManager::LoadMeshAsync(const MxString& path, MeshLoadCallback callback)
+    {
+        return AssetManager::LoadMeshAsync(ToFilePath(path), std::move(callback));
+    }
+
+    MeshHandle AssetManager::LoadMeshAsync(const char* path, MeshLoadCallback callback)
+    {
+        return AssetManager::LoadMeshAsync(FilePath(path), std::move(callback));
+    }
+
     MxVector<MaterialHandle> AssetManager::LoadMaterials(StringId hash)
     {
         auto& path = FileManager::GetFilePath(hash);
@@ -34,6 +34,7 @@
 #include "Platform/GraphicAPI.h"
 #include "Platform/AudioAPI.h"
 #include "Utilities/FileSystem/File.h"
+#include "Utilities/STL/MxFunction.h"
 
 namespace MxEngine
 {
@@ -43,6 +44,9 @@ namespace MxEngine
     class AssetManager
     {
     public:
+        using TextureLoadCallback = MxFunction<void(const TextureHandle&)>;
+        using MeshLoadCallback = MxFunction<void(const MeshHandle&)>;
+
         static CubeMapHandle LoadCubeMap(StringId hash);
         static CubeMapHandle LoadCubeMap(const FilePath& path);
         static CubeMapHandle LoadCubeMap(const MxString& path);
@@ -57,6 +61,15 @@ namespace MxEngine
         static TextureHandle LoadTexture(const MxString& path, TextureFormat format = TextureFormat::RGB);
         static TextureHandle LoadTexture(const char* path, TextureFormat format = TextureFormat::RGB);
 
+        /*!
+        loads texture without blocking calling thread. Returned texture contains 1x1 placeholder until image is decoded and uploaded
+        \param callback function invoked on main thread when texture is ready (can be empty)
+        */
+        static TextureHandle LoadTextureAsync(StringId hash, TextureFormat format = TextureFormat::RGB, TextureLoadCallback callback = { });
+        static TextureHandle LoadTextureAsync(const FilePath& path, TextureFormat format = TextureFormat::RGB, TextureLoadCallback callback = { });
+        static TextureHandle LoadTextureAsync(const MxString& path, TextureFormat format = TextureFormat::RGB, TextureLoadCallback callback = { });
+        static TextureHandle LoadTextureAsync(const char* path, TextureFormat format = TextureFormat::RGB, TextureLoadCallback callback = { });
+
         static ShaderHandle LoadShader(StringId vertex, StringId fragment);
         static ShaderHandle LoadShader(const FilePath& vertex, const FilePath& fragment);
         static ShaderHandle LoadShader(const MxString& vertex, const MxString& fragment);
@@ -81,6 +94,15 @@ namespace MxEngine
         static MeshHandle LoadMesh(const MxString& path);
         static MeshHandle LoadMesh(const char* path);
 
+        /*!
+        loads mesh without blocking calling thread. Returned mesh has no submeshes until it is decoded and uploaded
+        \param callback function invoked on main thread when mesh is ready (can be empty)
+        */
+        static MeshHandle LoadMeshAsync(StringId hash, MeshLoadCallback callback = { });
+        static MeshHandle LoadMeshAsync(const FilePath& path, MeshLoadCallback callback = { });
+        static MeshHandle LoadMeshAsync(const MxString& path, MeshLoadCallback callback = { });
+        static MeshHandle LoadMeshAsync(const char* path, MeshLoadCallback callback = { });
+
         static MxVector<MaterialHandle> LoadMaterials(StringId hash);
         static MxVector<MaterialHandle> LoadMaterials(const FilePath& path);
         static MxVector<MaterialHandle> LoadMaterials(const MxString& path);
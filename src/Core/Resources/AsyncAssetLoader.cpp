@@ -0,0 +1,231 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AsyncAssetLoader.h"
+#include "Core/Components/Rendering/MeshRenderer.h"
+#include "Core/Resources/MeshCache.h"
+#include "Utilities/Image/ImageLoader.h"
+#include "Utilities/Concurrency/ThreadPool.h"
+#include "Utilities/Concurrency/MpscQueue.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/STL/MxHashMap.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+
+namespace MxEngine
+{
+    /*!
+    result of asset decoding produced by worker thread. Only one of image, mesh cache and object info is filled depending on request type
+    */
+    struct DecodedAsset
+    {
+        size_t RequestId = 0;
+        Image TextureImage;
+        MeshCacheFile MeshCache;
+        ObjectInfo MeshInfo;
+    };
+
+    struct AsyncAssetLoaderImpl
+    {
+        struct PendingTexture
+        {
+            TextureHandle Texture;
+            FilePath Path;
+            TextureFormat Format;
+            AssetManager::TextureLoadCallback Callback;
+        };
+
+        struct PendingMesh
+        {
+            MeshHandle Mesh;
+            FilePath Path;
+            AssetManager::MeshLoadCallback Callback;
+        };
+
+        // requests waiting for upload, accessed only by main thread
+        MxHashMap<size_t, PendingTexture> PendingTextures;
+        MxHashMap<size_t, PendingMesh> PendingMeshes;
+
+        MpscQueue<UniqueRef<DecodedAsset>> DecodedAssets;
+        size_t LastRequestId = 0;
+        float UploadTimeBudget = 4.0f;
+        float LastUploadTime = 0.0f;
+        float LastLongestUploadTime = 0.0f;
+    };
+
+    void AsyncAssetLoader::Init()
+    {
+        impl = Alloc<AsyncAssetLoaderImpl>();
+    }
+
+    void AsyncAssetLoader::Destroy()
+    {
+        Free(impl);
+        impl = nullptr;
+    }
+
+    AsyncAssetLoaderImpl* AsyncAssetLoader::GetImpl()
+    {
+        return impl;
+    }
+
+    void AsyncAssetLoader::Clone(AsyncAssetLoaderImpl* other)
+    {
+        impl = other;
+    }
+
+    void AsyncAssetLoader::LoadTexture(const TextureHandle& texture, const FilePath& path, TextureFormat format, AssetManager::TextureLoadCallback callback)
+    {
+        // placeholder is white, so materials which multiply by texture keep their base color until image is uploaded
+        std::array<Texture::RawData, 4> placeholder = { 255, 255, 255, 255 };
+        texture->Load(placeholder.data(), 1, 1, (int)placeholder.size(), false, format);
+
+        size_t requestId = ++impl->LastRequestId;
+        impl->PendingTextures.emplace(requestId, AsyncAssetLoaderImpl::PendingTexture{ texture, path, format, std::move(callback) });
+
+        ThreadPool::GetGlobal().SubmitBackground([requestId, path]()
+        {
+            MAKE_SCOPE_PROFILER("AsyncAssetLoader::DecodeTexture()");
+            auto decoded = MakeUnique<DecodedAsset>();
+            decoded->RequestId = requestId;
+            decoded->TextureImage = ImageLoader::LoadImage(path);
+            impl->DecodedAssets.Push(std::move(decoded));
+        });
+    }
+
+    void AsyncAssetLoader::LoadMesh(const MeshHandle& mesh, const FilePath& path, AssetManager::MeshLoadCallback callback)
+    {
+        size_t requestId = ++impl->LastRequestId;
+        impl->PendingMeshes.emplace(requestId, AsyncAssetLoaderImpl::PendingMesh{ mesh, path, std::move(callback) });
+
+        ThreadPool::GetGlobal().SubmitBackground([requestId, path]()
+        {
+            MAKE_SCOPE_PROFILER("AsyncAssetLoader::DecodeMesh()");
+            auto decoded = MakeUnique<DecodedAsset>();
+            decoded->RequestId = requestId;
+            FilePath materialLibPath = path.native() + MeshRenderer::GetMaterialFileExtenstion().native();
+            auto sourceHash = MeshCache::ComputeCacheKey(path);
+
+            if (MeshCache::Open(decoded->MeshCache, path, sourceHash))
+            {
+                if (!File::Exists(materialLibPath))
+                    ObjectLoader::DumpMaterials(decoded->MeshCache.ReadMaterials(), materialLibPath);
+            }
+            else
+            {
+                decoded->MeshInfo = ObjectLoader::Load(path);
+
+                // dump all material to let user retrieve them for MeshRenderer component
+                ObjectLoader::DumpMaterials(decoded->MeshInfo.materials, materialLibPath);
+                MeshCache::Store(decoded->MeshInfo, path, sourceHash);
+            }
+
+            impl->DecodedAssets.Push(std::move(decoded));
+        });
+    }
+
+    static void UploadDecodedAsset(AsyncAssetLoaderImpl& loader, DecodedAsset& decoded)
+    {
+        // pending request is removed before callback is invoked, as callback may schedule new loads
+        auto texture = loader.PendingTextures.find(decoded.RequestId);
+        if (texture != loader.PendingTextures.end())
+        {
+            auto pending = std::move(texture->second);
+            loader.PendingTextures.erase(texture);
+
+            pending.Texture->Load(decoded.TextureImage, pending.Path, pending.Format);
+            if (pending.Callback) pending.Callback(pending.Texture);
+            return;
+        }
+
+        auto mesh = loader.PendingMeshes.find(decoded.RequestId);
+        if (mesh != loader.PendingMeshes.end())
+        {
+            auto pending = std::move(mesh->second);
+            loader.PendingMeshes.erase(mesh);
+
+            if (decoded.MeshCache.IsOpen())
+                pending.Mesh->Load(decoded.MeshCache, pending.Path);
+            else
+                pending.Mesh->Load(decoded.MeshInfo, pending.Path);
+            if (pending.Callback) pending.Callback(pending.Mesh);
+        }
+    }
+
+    void AsyncAssetLoader::ProcessUploads()
+    {
+        impl->LastUploadTime = 0.0f;
+        impl->LastLongestUploadTime = 0.0f;
+        if (impl->DecodedAssets.Empty()) return;
+        MAKE_SCOPE_PROFILER("AsyncAssetLoader::ProcessUploads()");
+
+        using Clock = std::chrono::steady_clock;
+        using Milliseconds = std::chrono::duration<float, std::milli>;
+        auto start = Clock::now();
+        auto deadline = start + std::chrono::duration_cast<Clock::duration>(Milliseconds(impl->UploadTimeBudget));
+        auto longestUpload = Clock::duration::zero();
+
+        UniqueRef<DecodedAsset> decoded;
+        while (Clock::now() < deadline && impl->DecodedAssets.TryPop(decoded))
+        {
+            auto uploadStart = Clock::now();
+            UploadDecodedAsset(*impl, *decoded);
+            longestUpload = std::max(longestUpload, Clock::now() - uploadStart);
+        }
+
+        impl->LastUploadTime = Milliseconds(Clock::now() - start).count();
+        impl->LastLongestUploadTime = Milliseconds(longestUpload).count();
+    }
+
+    void AsyncAssetLoader::SetUploadTimeBudget(float milliseconds)
+    {
+        impl->UploadTimeBudget = milliseconds;
+    }
+
+    float AsyncAssetLoader::GetUploadTimeBudget()
+    {
+        return impl->UploadTimeBudget;
+    }
+
+    float AsyncAssetLoader::GetLastUploadTime()
+    {
+        return impl->LastUploadTime;
+    }
+
+    float AsyncAssetLoader::GetLastLongestUploadTime()
+    {
+        return impl->LastLongestUploadTime;
+    }
+
+    size_t AsyncAssetLoader::GetPendingCount()
+    {
+        return impl->PendingTextures.size() + impl->PendingMeshes.size();
+    }
+}
@@ -0,0 +1,94 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Core/Resources/AssetManager.h"
+
+namespace MxEngine
+{
+    struct AsyncAssetLoaderImpl;
+
+    /*!
+    async asset loader decodes textures and meshes on global thread pool and uploads them to GPU on main thread
+    decoded assets are queued by worker threads and uploaded in AsyncAssetLoader::ProcessUploads(), which is called once per frame
+    uploads are limited by time budget, so streaming large number of assets does not produce frame spikes
+    resource handles are never touched by worker threads, all of them are stored in main-thread tables until upload is finished
+    */
+    class AsyncAssetLoader
+    {
+        inline static AsyncAssetLoaderImpl* impl = nullptr;
+    public:
+        static void Init();
+        static void Destroy();
+        static AsyncAssetLoaderImpl* GetImpl();
+        static void Clone(AsyncAssetLoaderImpl* other);
+
+        /*!
+        schedules texture decoding. Texture is filled with 1x1 placeholder until upload is finished
+        \param texture texture which will receive decoded image
+        \param path path to image on disk
+        \param format format of texture
+        \param callback function invoked on main thread after texture is uploaded
+        */
+        static void LoadTexture(const TextureHandle& texture, const FilePath& path, TextureFormat format, AssetManager::TextureLoadCallback callback);
+        /*!
+        schedules mesh decoding. Mesh has no submeshes until upload is finished
+        \param mesh mesh which will receive decoded geometry
+        \param path path to mesh file on disk
+        \param callback function invoked on main thread after mesh is uploaded
+        */
+        static void LoadMesh(const MeshHandle& mesh, const FilePath& path, AssetManager::MeshLoadCallback callback);
+
+        /*!
+        uploads decoded assets to GPU and invokes completion callbacks. Must be called from main thread
+        uploads are performed until time budget is exceeded, so one upload may overrun budget by its own duration
+        */
+        static void ProcessUploads();
+        /*!
+        sets maximum time spent on uploads per ProcessUploads() call
+        \param milliseconds time budget in milliseconds
+        */
+        static void SetUploadTimeBudget(float milliseconds);
+        static float GetUploadTimeBudget();
+        /*!
+        gets time spent by last ProcessUploads() call
+        \returns time in milliseconds, 0 if nothing was uploaded
+        */
+        static float GetLastUploadTime();
+        /*!
+        gets duration of the longest single upload performed by last ProcessUploads() call, including its callback
+        \returns time in milliseconds, 0 if nothing was uploaded
+        */
+        static float GetLastLongestUploadTime();
+        /*!
+        gets number of assets which are requested but not uploaded yet
+        */
+        static size_t GetPendingCount();
+    };
+}
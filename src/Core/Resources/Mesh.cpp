@@ -28,6 +28,7 @@
 
 #include "Mesh.h"
 #include "Utilities/ObjectLoading/ObjectLoader.h"
+#include "Core/Resources/MeshCache.h"
 #include "Utilities/Profiler/Profiler.h"
 #include "Platform/GraphicAPI.h"
 #include "Utilities/Format/Format.h"
@@ -41,10 +42,8 @@
 namespace MxEngine
 {
     template<>
-    void Mesh::LoadFromFile(const std::filesystem::path& filepath)
+    void Mesh::Load(const ObjectInfo& objectInfo, const std::filesystem::path& filepath)
     {
-        ObjectInfo objectInfo = ObjectLoader::Load(filepath);
-
         this->filepath = ToMxString(filepath);
         std::replace(this->filepath.begin(), this->filepath.end(), '\\', '/');
 
@@ -63,10 +62,6 @@ namespace MxEngine
             }
         }
 
-        // dump all material to let user retrieve them for MeshRenderer component
-        FilePath materialLibPath = filepath.native() + MeshRenderer::GetMaterialFileExtenstion().native();
-        ObjectLoader::DumpMaterials(objectInfo.materials, materialLibPath);
-
         // optimize transform additions
         this->subMeshTransforms.reserve(objectInfo.meshes.size());
 
@@ -78,37 +73,89 @@ namespace MxEngine
             totalVerticies += meshInfo.vertecies.size();
             totalIndicies += meshInfo.indicies.size();
         }
-        // create CPU-side array for verticies and indicies, and GPU-size VBO/IBO
-        MxVector<Vertex> verticies;
-        MxVector<IndexBuffer::IndexType> indicies;
-        verticies.reserve(totalVerticies);
-        indicies.reserve(totalIndicies);
         this->ReserveData(totalVerticies, totalIndicies);
 
-        // insert all verticies and indicies into single VBO/IBO
+        // upload each submesh into its range of single VBO/IBO, no intermediate CPU-side copy is needed
+        size_t vertexOffset = this->vertexAllocation.Offset;
+        size_t indexOffset = this->indexAllocation.Offset;
         for (size_t i = 0; i < objectInfo.meshes.size(); i++)
         {
             auto& meshInfo = objectInfo.meshes[i];
             auto& materialId = materialIds[i];
 
             MeshData meshData{
-                meshInfo.vertecies.size(), verticies.size() + this->vertexAllocation.Offset,
-                meshInfo.indicies.size(), indicies.size() + this->indexAllocation.Offset
+                meshInfo.vertecies.size(), vertexOffset,
+                meshInfo.indicies.size(), indexOffset
             };
-            meshData.UpdateBoundingGeometry(meshInfo.vertecies);
+            meshData.SetBoundingGeometry(meshInfo.boundingBox, meshInfo.boundingSphere);
+            meshData.BufferVertecies(meshInfo.vertecies);
+            meshData.BufferIndicies(meshInfo.indicies);
 
-            indicies.insert(indicies.end(), meshInfo.indicies.begin(), meshInfo.indicies.end());
-            verticies.insert(verticies.end(), meshInfo.vertecies.begin(), meshInfo.vertecies.end());
+            vertexOffset += meshInfo.vertecies.size();
+            indexOffset += meshInfo.indicies.size();
 
             this->AddSubMesh(materialId, std::move(meshData));
         }
-        // load verticies and indicies to GPU
-        BufferAllocator::GetVBO()->BufferSubData((float*)verticies.data(), verticies.size() * Vertex::Size, this->vertexAllocation.Offset * Vertex::Size);
-        BufferAllocator::GetIBO()->BufferSubData(indicies.data(), indicies.size(), this->indexAllocation.Offset);
 
         this->UpdateBoundingGeometry(); // use submeshes boundings to update mesh boundings
     }
 
+    template<>
+    void Mesh::Load(const MeshCacheFile& cache, const std::filesystem::path& filepath)
+    {
+        this->filepath = ToMxString(filepath);
+        std::replace(this->filepath.begin(), this->filepath.end(), '\\', '/');
+
+        auto submeshes = cache.GetSubMeshes();
+        this->subMeshTransforms.reserve(submeshes.size());
+        this->ReserveData(cache.GetVertexCount(), cache.GetIndexCount());
+
+        for (const auto& submesh : submeshes)
+        {
+            MeshData meshData{
+                (size_t)submesh.VertexCount, (size_t)submesh.VertexOffset + this->vertexAllocation.Offset,
+                (size_t)submesh.IndexCount, (size_t)submesh.IndexOffset + this->indexAllocation.Offset
+            };
+            AABB box{ submesh.BoxMin, submesh.BoxMax };
+            meshData.SetBoundingGeometry(box, BoundingSphere(submesh.SphereCenter, submesh.SphereRadius));
+
+            this->AddSubMesh((SubMesh::MaterialId)submesh.MaterialId, std::move(meshData));
+        }
+        // cache stores all submeshes contiguously, so whole mesh is uploaded with one call per buffer
+        BufferAllocator::GetVBO()->BufferSubData((const float*)cache.GetVertecies(), cache.GetVertexCount() * Vertex::Size, this->vertexAllocation.Offset * Vertex::Size);
+        BufferAllocator::GetIBO()->BufferSubData(cache.GetIndicies(), cache.GetIndexCount(), this->indexAllocation.Offset);
+
+        this->UpdateBoundingGeometry();
+    }
+
+    template<>
+    void Mesh::LoadFromFile(const std::filesystem::path& filepath)
+    {
+        FilePath materialLibPath = filepath.native() + MeshRenderer::GetMaterialFileExtenstion().native();
+        auto sourceHash = MeshCache::ComputeCacheKey(filepath);
+
+        MeshCacheFile cache;
+        if (MeshCache::Open(cache, filepath, sourceHash))
+        {
+            MAKE_SCOPE_TIMER("MxEngine::Mesh", "Mesh::LoadFromCache()");
+            // material library can be deleted by user, restore it from table baked into cache
+            if (!File::Exists(materialLibPath))
+                ObjectLoader::DumpMaterials(cache.ReadMaterials(), materialLibPath);
+
+            this->Load(cache, filepath);
+            return;
+        }
+
+        MAKE_SCOPE_TIMER("MxEngine::Mesh", "Mesh::LoadFromSource()");
+        ObjectInfo objectInfo = ObjectLoader::Load(filepath);
+
+        // dump all material to let user retrieve them for MeshRenderer component
+        ObjectLoader::DumpMaterials(objectInfo.materials, materialLibPath);
+
+        this->Load(objectInfo, filepath);
+        MeshCache::Store(objectInfo, filepath, sourceHash);
+    }
+
     void Mesh::FreeBuffers()
     {
         if (this->vertexAllocation.Size != 0) BufferAllocator::DeallocateInVBO({ this->vertexAllocation.Offset * Vertex::Size, this->vertexAllocation.Size * Vertex::Size });
@@ -37,6 +37,8 @@
 namespace MxEngine
 {
     class MeshRenderer;
+    struct ObjectInfo;
+    class MeshCacheFile;
     
     struct MoveOnlyAllocation
     {
@@ -78,6 +80,18 @@ namespace MxEngine
         
         void Load(const MxString& filepath);
         template<typename FilePath> void Load(const FilePath& filepath);
+        /*!
+        uploads already decoded object to GPU. Used by async asset loading, where decoding is performed on worker threads
+        \param objectInfo decoded object data
+        \param filepath path from which object was loaded
+        */
+        template<typename FilePath> void Load(const ObjectInfo& objectInfo, const FilePath& filepath);
+        /*!
+        uploads mesh from binary cache. Vertex and index data is streamed to GPU directly from mapped cache file
+        \param cache opened and validated mesh cache
+        \param filepath path to source file from which cache was baked
+        */
+        template<typename FilePath> void Load(const MeshCacheFile& cache, const FilePath& filepath);
 
         void ReserveData(size_t vertexCount, size_t indexCount);
         void UpdateBoundingGeometry();
@@ -0,0 +1,439 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MeshCache.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Json/Json.h"
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <cctype>
+
+namespace MxEngine
+{
+    constexpr char MeshCacheMagic[8] = { 'M', 'X', 'M', 'E', 'S', 'H', '\0', '\0' };
+    constexpr size_t MeshCacheAlignment = 16;
+    constexpr uint64_t InvalidCacheMaterialId = std::numeric_limits<uint64_t>::max();
+
+    static uint64_t AlignCacheOffset(uint64_t offset)
+    {
+        return (offset + MeshCacheAlignment - 1) & ~uint64_t(MeshCacheAlignment - 1);
+    }
+
+    template<typename T>
+    static void WritePod(std::ostream& stream, const T& value)
+    {
+        stream.write((const char*)&value, sizeof(T));
+    }
+
+    static void WriteString(std::ostream& stream, const MxString& str)
+    {
+        WritePod(stream, (uint32_t)str.size());
+        stream.write(str.data(), str.size());
+    }
+
+    static void WritePadding(std::ostream& stream, uint64_t& offset)
+    {
+        constexpr char zeros[MeshCacheAlignment] = { };
+        auto aligned = AlignCacheOffset(offset);
+        stream.write(zeros, aligned - offset);
+        offset = aligned;
+    }
+
+    /*!
+    bounds-checked reader of material table. Cache file can be truncated or corrupted, so every read is validated
+    */
+    class MeshCacheReader
+    {
+        const uint8_t* current;
+        const uint8_t* end;
+    public:
+        MeshCacheReader(const uint8_t* begin, const uint8_t* end)
+            : current(begin), end(end) { }
+
+        template<typename T>
+        bool Read(T& value)
+        {
+            if (size_t(this->end - this->current) < sizeof(T)) return false;
+            std::memcpy(&value, this->current, sizeof(T));
+            this->current += sizeof(T);
+            return true;
+        }
+
+        bool Read(MxString& str)
+        {
+            uint32_t length = 0;
+            if (!this->Read(length) || size_t(this->end - this->current) < length) return false;
+            str.assign((const char*)this->current, length);
+            this->current += length;
+            return true;
+        }
+
+        bool Read(FilePath& path)
+        {
+            MxString str;
+            if (!this->Read(str)) return false;
+            path = ToFilePath(str);
+            return true;
+        }
+    };
+
+    bool MeshCacheFile::Open(const FilePath& path, uint64_t sourceHash)
+    {
+        this->header = nullptr;
+        if (!this->file.Open(path)) return false;
+
+        auto fileSize = (uint64_t)this->file.GetSize();
+        if (fileSize < sizeof(MeshCacheHeader)) return false;
+
+        auto header = (const MeshCacheHeader*)this->file.GetData();
+        bool isValid =
+            std::memcmp(header->Magic, MeshCacheMagic, sizeof(MeshCacheMagic)) == 0 &&
+            header->Version == MeshCache::Version &&
+            header->VertexSize == sizeof(Vertex) &&
+            header->SourceHash == sourceHash &&
+            header->FileSize == fileSize;
+
+        auto sectionFits = [fileSize](uint64_t offset, uint64_t count, uint64_t elementSize)
+        {
+            return offset % MeshCacheAlignment == 0 && offset <= fileSize && count <= (fileSize - offset) / elementSize;
+        };
+
+        isValid = isValid &&
+            sectionFits(header->SubMeshOffset, header->SubMeshCount, sizeof(MeshCacheSubMesh)) &&
+            sectionFits(header->VertexOffset, header->VertexCount, sizeof(Vertex)) &&
+            sectionFits(header->IndexOffset, header->IndexCount, sizeof(uint32_t)) &&
+            header->MaterialOffset <= fileSize;
+        if (!isValid) return false;
+
+        this->header = header;
+        for (const auto& submesh : this->GetSubMeshes())
+        {
+            // offsets and counts are read from file, so checks are written in a way they cannot overflow
+            if (submesh.VertexOffset > header->VertexCount || header->VertexCount - submesh.VertexOffset < submesh.VertexCount ||
+                submesh.IndexOffset > header->IndexCount || header->IndexCount - submesh.IndexOffset < submesh.IndexCount ||
+                (submesh.MaterialId != InvalidCacheMaterialId && submesh.MaterialId >= header->MaterialCount))
+            {
+                this->header = nullptr;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool MeshCacheFile::IsOpen() const
+    {
+        return this->header != nullptr;
+    }
+
+    ArrayView<const MeshCacheSubMesh> MeshCacheFile::GetSubMeshes() const
+    {
+        MX_ASSERT(this->IsOpen());
+        auto submeshes = (const MeshCacheSubMesh*)(this->file.GetData() + this->header->SubMeshOffset);
+        return ArrayView<const MeshCacheSubMesh>(submeshes, (size_t)this->header->SubMeshCount);
+    }
+
+    const Vertex* MeshCacheFile::GetVertecies() const
+    {
+        MX_ASSERT(this->IsOpen());
+        return (const Vertex*)(this->file.GetData() + this->header->VertexOffset);
+    }
+
+    size_t MeshCacheFile::GetVertexCount() const
+    {
+        MX_ASSERT(this->IsOpen());
+        return (size_t)this->header->VertexCount;
+    }
+
+    const uint32_t* MeshCacheFile::GetIndicies() const
+    {
+        MX_ASSERT(this->IsOpen());
+        return (const uint32_t*)(this->file.GetData() + this->header->IndexOffset);
+    }
+
+    size_t MeshCacheFile::GetIndexCount() const
+    {
+        MX_ASSERT(this->IsOpen());
+        return (size_t)this->header->IndexCount;
+    }
+
+    MaterialLibrary MeshCacheFile::ReadMaterials() const
+    {
+        MX_ASSERT(this->IsOpen());
+        MeshCacheReader reader(this->file.GetData() + this->header->MaterialOffset, this->file.GetData() + this->file.GetSize());
+
+        MaterialLibrary materials(this->header->MaterialCount);
+        for (auto& material : materials)
+        {
+            bool isValid =
+                reader.Read(material.Name) &&
+                reader.Read(material.AlbedoMap) &&
+                reader.Read(material.EmissiveMap) &&
+                reader.Read(material.HeightMap) &&
+                reader.Read(material.NormalMap) &&
+                reader.Read(material.AmbientOcclusionMap) &&
+                reader.Read(material.MetallicMap) &&
+                reader.Read(material.RoughnessMap) &&
+                reader.Read(material.AlphaMask) &&
+                reader.Read(material.Transparency) &&
+                reader.Read(material.Displacement) &&
+                reader.Read(material.Emission) &&
+                reader.Read(material.BaseColor) &&
+                reader.Read(material.UVMultipliers) &&
+                reader.Read(material.MetallicFactor) &&
+                reader.Read(material.RoughnessFactor);
+
+            if (!isValid)
+            {
+                MXLOG_WARNING("MxEngine::MeshCache", "material table of mesh cache is corrupted");
+                return MaterialLibrary{ };
+            }
+        }
+        return materials;
+    }
+
+    FilePath MeshCache::GetCachePath(const FilePath& source)
+    {
+        return source.native() + FilePath(".mxmesh").native();
+    }
+
+    uint64_t MeshCache::ComputeSourceHash(const FilePath& source)
+    {
+        MAKE_SCOPE_PROFILER("MeshCache::ComputeSourceHash()");
+
+        MappedFile file;
+        if (!file.Open(source)) return 0;
+
+        // FNV-1a applied to 8-byte words: content is already mapped, so hashing is bound by memory bandwidth
+        constexpr uint64_t prime = 0x100000001B3ull;
+        uint64_t hash = 0xCBF29CE484222325ull ^ (uint64_t)file.GetSize();
+
+        const uint8_t* data = file.GetData();
+        size_t wordCount = file.GetSize() / sizeof(uint64_t);
+        for (size_t i = 0; i < wordCount; i++)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i * sizeof(uint64_t), sizeof(uint64_t));
+            hash = (hash ^ word) * prime;
+        }
+        for (size_t i = wordCount * sizeof(uint64_t); i < file.GetSize(); i++)
+        {
+            hash = (hash ^ data[i]) * prime;
+        }
+        return hash != 0 ? hash : 1; // zero is reserved for unreadable files
+    }
+
+    static void CollectMaterialLibraries(const FilePath& source, MxVector<FilePath>& dependencies)
+    {
+        MappedFile file;
+        if (!file.Open(source)) return;
+
+        // material libraries are declared by 'mtllib <name>' lines, name may contain spaces
+        constexpr std::string_view directive = "mtllib";
+        std::string_view text((const char*)file.GetData(), file.GetSize());
+        for (size_t line = 0; line < text.size(); )
+        {
+            size_t lineEnd = text.find('\n', line);
+            if (lineEnd == text.npos) lineEnd = text.size();
+
+            auto current = text.substr(line, lineEnd - line);
+            if (current.substr(0, directive.size()) == directive && current.size() > directive.size() && std::isspace((unsigned char)current[directive.size()]))
+            {
+                auto name = current.substr(directive.size());
+                while (!name.empty() && std::isspace((unsigned char)name.front())) name.remove_prefix(1);
+                while (!name.empty() && std::isspace((unsigned char)name.back())) name.remove_suffix(1);
+                if (!name.empty()) dependencies.push_back(source.parent_path() / std::string(name));
+            }
+            line = lineEnd + 1;
+        }
+    }
+
+    static void CollectExternalBuffers(const FilePath& source, MxVector<FilePath>& dependencies)
+    {
+        // gltf stores geometry in external binary buffers, which are loaded by Assimp together with source
+        auto gltf = JsonFile::parse(File::ReadAllText(source).c_str(), nullptr, false);
+        if (gltf.is_discarded() || !gltf.contains("buffers")) return;
+
+        for (const auto& buffer : gltf["buffers"])
+        {
+            if (!buffer.contains("uri") || !buffer["uri"].is_string()) continue;
+            auto uri = buffer["uri"].get<std::string>();
+            if (uri.rfind("data:", 0) == 0) continue; // embedded buffer
+            dependencies.push_back(source.parent_path() / uri);
+        }
+    }
+
+    void MeshCache::CollectDependencies(const FilePath& source, MxVector<FilePath>& dependencies)
+    {
+        auto extension = source.extension();
+        if (extension == ".gltf")
+            CollectExternalBuffers(source, dependencies);
+        else if (extension == ".obj")
+            CollectMaterialLibraries(source, dependencies);
+    }
+
+    uint64_t MeshCache::ComputeCacheKey(const FilePath& source)
+    {
+        MAKE_SCOPE_PROFILER("MeshCache::ComputeCacheKey()");
+
+        uint64_t key = MeshCache::ComputeSourceHash(source);
+        if (key == 0) return 0;
+
+        // missing dependencies are mixed in as zero hash, so cache is rebuilt when they appear
+        constexpr uint64_t prime = 0x100000001B3ull;
+        MxVector<FilePath> dependencies;
+        MeshCache::CollectDependencies(source, dependencies);
+        for (const auto& dependency : dependencies)
+            key = (key ^ MeshCache::ComputeSourceHash(dependency)) * prime;
+
+        return key != 0 ? key : 1;
+    }
+
+    bool MeshCache::Open(MeshCacheFile& cache, const FilePath& source, uint64_t sourceHash)
+    {
+        if (sourceHash == 0) return false;
+        return cache.Open(MeshCache::GetCachePath(source), sourceHash);
+    }
+
+    bool MeshCache::Store(const ObjectInfo& object, const FilePath& source, uint64_t sourceHash)
+    {
+        MAKE_SCOPE_PROFILER("MeshCache::Store()");
+        if (sourceHash == 0) return false;
+
+        MeshCacheHeader header{ };
+        std::memcpy(header.Magic, MeshCacheMagic, sizeof(MeshCacheMagic));
+        header.Version = MeshCache::Version;
+        header.VertexSize = sizeof(Vertex);
+        header.SourceHash = sourceHash;
+        header.SubMeshCount = object.meshes.size();
+        header.MaterialCount = object.materials.size();
+
+        MxVector<MeshCacheSubMesh> submeshes;
+        submeshes.reserve(object.meshes.size());
+        for (const auto& meshInfo : object.meshes)
+        {
+            auto& submesh = submeshes.emplace_back();
+            submesh.VertexOffset = header.VertexCount;
+            submesh.VertexCount = meshInfo.vertecies.size();
+            submesh.IndexOffset = header.IndexCount;
+            submesh.IndexCount = meshInfo.indicies.size();
+            submesh.MaterialId = (meshInfo.useTexture && meshInfo.material != nullptr) ?
+                uint64_t(meshInfo.material - object.materials.data()) : InvalidCacheMaterialId;
+            submesh.BoxMin = meshInfo.boundingBox.Min;
+            submesh.BoxMax = meshInfo.boundingBox.Max;
+            submesh.SphereCenter = meshInfo.boundingSphere.Center;
+            submesh.SphereRadius = meshInfo.boundingSphere.Radius;
+
+            header.VertexCount += submesh.VertexCount;
+            header.IndexCount += submesh.IndexCount;
+        }
+
+        header.SubMeshOffset = AlignCacheOffset(sizeof(MeshCacheHeader));
+        header.VertexOffset = AlignCacheOffset(header.SubMeshOffset + header.SubMeshCount * sizeof(MeshCacheSubMesh));
+        header.IndexOffset = AlignCacheOffset(header.VertexOffset + header.VertexCount * sizeof(Vertex));
+        header.MaterialOffset = AlignCacheOffset(header.IndexOffset + header.IndexCount * sizeof(uint32_t));
+
+        // write to temporary file first, so other processes never observe partially written cache
+        auto cachePath = MeshCache::GetCachePath(source);
+        auto tempPath = File::GetTemporaryPath(cachePath);
+        bool isWritten = false;
+        {
+            File file(tempPath, File::WRITE | File::BINARY);
+            if (!file.IsOpen())
+            {
+                MXLOG_WARNING("MxEngine::MeshCache", "cannot create mesh cache file: " + ToMxString(tempPath));
+                return false;
+            }
+            auto& stream = file.GetStream();
+            uint64_t offset = 0;
+
+            WritePod(stream, header); // FileSize is patched after material table is written
+            offset += sizeof(MeshCacheHeader);
+
+            WritePadding(stream, offset);
+            stream.write((const char*)submeshes.data(), submeshes.size() * sizeof(MeshCacheSubMesh));
+            offset += submeshes.size() * sizeof(MeshCacheSubMesh);
+
+            WritePadding(stream, offset);
+            for (const auto& meshInfo : object.meshes)
+            {
+                stream.write((const char*)meshInfo.vertecies.data(), meshInfo.vertecies.size() * sizeof(Vertex));
+                offset += meshInfo.vertecies.size() * sizeof(Vertex);
+            }
+
+            WritePadding(stream, offset);
+            for (const auto& meshInfo : object.meshes)
+            {
+                stream.write((const char*)meshInfo.indicies.data(), meshInfo.indicies.size() * sizeof(uint32_t));
+                offset += meshInfo.indicies.size() * sizeof(uint32_t);
+            }
+
+            WritePadding(stream, offset);
+            for (const auto& material : object.materials)
+            {
+                WriteString(stream, material.Name);
+                WriteString(stream, ToMxString(material.AlbedoMap));
+                WriteString(stream, ToMxString(material.EmissiveMap));
+                WriteString(stream, ToMxString(material.HeightMap));
+                WriteString(stream, ToMxString(material.NormalMap));
+                WriteString(stream, ToMxString(material.AmbientOcclusionMap));
+                WriteString(stream, ToMxString(material.MetallicMap));
+                WriteString(stream, ToMxString(material.RoughnessMap));
+                WritePod(stream, material.AlphaMask);
+                WritePod(stream, material.Transparency);
+                WritePod(stream, material.Displacement);
+                WritePod(stream, material.Emission);
+                WritePod(stream, material.BaseColor);
+                WritePod(stream, material.UVMultipliers);
+                WritePod(stream, material.MetallicFactor);
+                WritePod(stream, material.RoughnessFactor);
+            }
+
+            header.FileSize = (uint64_t)stream.tellp();
+            stream.seekp(0);
+            WritePod(stream, header);
+
+            isWritten = stream.good();
+            if (!isWritten)
+                MXLOG_WARNING("MxEngine::MeshCache", "failed to write mesh cache file: " + ToMxString(tempPath));
+        }
+
+        std::error_code error;
+        if (isWritten)
+            std::filesystem::rename(tempPath, cachePath, error);
+        if (!isWritten || error)
+        {
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,143 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/FileSystem/MappedFile.h"
+#include "Utilities/ObjectLoading/ObjectLoader.h"
+#include "Utilities/Array/ArrayView.h"
+#include "Core/Resources/Vertex.h"
+
+namespace MxEngine
+{
+    /*!
+    header of .mxmesh file. All offsets are in bytes from the beginning of the file
+    */
+    struct MeshCacheHeader
+    {
+        char Magic[8];
+        uint32_t Version;
+        uint32_t VertexSize;
+        uint64_t SourceHash;
+        uint64_t FileSize;
+        uint64_t SubMeshCount;
+        uint64_t SubMeshOffset;
+        uint64_t VertexCount;
+        uint64_t VertexOffset;
+        uint64_t IndexCount;
+        uint64_t IndexOffset;
+        uint64_t MaterialCount;
+        uint64_t MaterialOffset;
+    };
+
+    /*!
+    submesh range inside .mxmesh vertex and index blobs with precomputed bounding geometry
+    */
+    struct MeshCacheSubMesh
+    {
+        uint64_t VertexOffset;
+        uint64_t VertexCount;
+        uint64_t IndexOffset;
+        uint64_t IndexCount;
+        uint64_t MaterialId;
+        Vector3 BoxMin;
+        Vector3 BoxMax;
+        Vector3 SphereCenter;
+        float SphereRadius;
+    };
+
+    /*!
+    validated view of .mxmesh file. Vertex and index data point directly into mapped file, so they can be uploaded to GPU without copies
+    */
+    class MeshCacheFile
+    {
+        MappedFile file;
+        const MeshCacheHeader* header = nullptr;
+    public:
+        /*!
+        maps cache file and validates its layout
+        \param path path to .mxmesh file
+        \param sourceHash expected hash of source file. Cache is rejected if it was baked from different source
+        \returns true if cache is valid and can be used
+        */
+        bool Open(const FilePath& path, uint64_t sourceHash);
+        bool IsOpen() const;
+
+        ArrayView<const MeshCacheSubMesh> GetSubMeshes() const;
+        const Vertex* GetVertecies() const;
+        size_t GetVertexCount() const;
+        const uint32_t* GetIndicies() const;
+        size_t GetIndexCount() const;
+        /*!
+        deserializes material table baked with mesh
+        \returns list of materials in the same order as source object had
+        */
+        MaterialLibrary ReadMaterials() const;
+    };
+
+    /*!
+    mesh cache stores meshes imported by ObjectLoader in binary .mxmesh files next to their sources
+    cache is keyed by hash of source file contents combined with hashes of files it references (external buffers of .gltf, material libraries of .obj),
+    so it is rebuilt automatically when source file or any of its dependencies is changed
+    */
+    class MeshCache
+    {
+    public:
+        constexpr static uint32_t Version = 2;
+
+        static FilePath GetCachePath(const FilePath& source);
+        /*!
+        computes hash of file contents
+        \param source path to source file
+        \returns 64-bit hash or 0 if file cannot be read
+        */
+        static uint64_t ComputeSourceHash(const FilePath& source);
+        /*!
+        collects files which are read by importer together with source file
+        \param source path to source file
+        \param dependencies vector where paths of external .gltf buffers and .obj material libraries are added
+        */
+        static void CollectDependencies(const FilePath& source, MxVector<FilePath>& dependencies);
+        /*!
+        computes key of source cache: hash of source file combined with hashes of its dependencies
+        \param source path to source file
+        \returns 64-bit key or 0 if source file cannot be read
+        */
+        static uint64_t ComputeCacheKey(const FilePath& source);
+        /*!
+        opens cache of source file if it exists and is up to date
+        \returns true if cache was opened
+        */
+        static bool Open(MeshCacheFile& cache, const FilePath& source, uint64_t sourceHash);
+        /*!
+        bakes imported object into .mxmesh file. File is written to temporary path first, so concurrent readers never see partial cache
+        \returns true if cache was written
+        */
+        static bool Store(const ObjectInfo& object, const FilePath& source, uint64_t sourceHash);
+    };
+}
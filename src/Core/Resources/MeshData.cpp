@@ -93,25 +93,41 @@ namespace MxEngine
 
     void MeshData::UpdateBoundingGeometry(const VertexData& vertecies)
     {
-        this->boundingBox = { MakeVector3(0.0f), MakeVector3(0.0f) };
-        if (vertecies.size() > 0)
+        this->boundingBox = MeshData::ComputeAABB(vertecies.data(), vertecies.size());
+        this->boundingSphere = MeshData::ComputeBoundingSphere(vertecies.data(), vertecies.size(), this->boundingBox);
+    }
+
+    void MeshData::SetBoundingGeometry(const AABB& boundingBox, const BoundingSphere& boundingSphere)
+    {
+        this->boundingBox = boundingBox;
+        this->boundingSphere = boundingSphere;
+    }
+
+    AABB MeshData::ComputeAABB(const Vertex* vertecies, size_t vertexCount)
+    {
+        AABB box = { MakeVector3(0.0f), MakeVector3(0.0f) };
+        if (vertexCount > 0)
         {
-            this->boundingBox = { vertecies[0].Position, vertecies[0].Position };
-            for (const auto& vertex : vertecies)
+            box = { vertecies[0].Position, vertecies[0].Position };
+            for (size_t i = 0; i < vertexCount; i++)
             {
-                this->boundingBox.Min = VectorMin(this->boundingBox.Min, vertex.Position);
-                this->boundingBox.Max = VectorMax(this->boundingBox.Max, vertex.Position);
+                box.Min = VectorMin(box.Min, vertecies[i].Position);
+                box.Max = VectorMax(box.Max, vertecies[i].Position);
             }
         }
+        return box;
+    }
 
-        auto center = this->boundingBox.GetCenter();
+    BoundingSphere MeshData::ComputeBoundingSphere(const Vertex* vertecies, size_t vertexCount, const AABB& boundingBox)
+    {
+        auto center = boundingBox.GetCenter();
         float maxRadius = 0.0f;
-        for (const auto& vertex : vertecies)
+        for (size_t i = 0; i < vertexCount; i++)
         {
-            auto distance = vertex.Position - center;
+            auto distance = vertecies[i].Position - center;
             maxRadius = Max(maxRadius, Length2(distance));
         }
-        this->boundingSphere = BoundingSphere(center, std::sqrt(maxRadius));
+        return BoundingSphere(center, std::sqrt(maxRadius));
     }
 
     MeshData::VertexData MeshData::GetVerteciesFromGPU() const
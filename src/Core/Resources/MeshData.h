@@ -61,10 +61,13 @@ namespace MxEngine
         void BufferVertecies(const VertexData& vertecies);
         void BufferIndicies(const IndexData& indicies);
         void UpdateBoundingGeometry(const VertexData& vertecies);
+        void SetBoundingGeometry(const AABB& boundingBox, const BoundingSphere& boundingSphere);
 
         VertexData GetVerteciesFromGPU() const;
         IndexData GetIndiciesFromGPU() const;
 
+        static AABB ComputeAABB(const Vertex* vertecies, size_t vertexCount);
+        static BoundingSphere ComputeBoundingSphere(const Vertex* vertecies, size_t vertexCount, const AABB& boundingBox);
         static void RegenerateNormals(VertexData& vertecies, const IndexData& indicies);
         static void RegenerateTangentSpace(VertexData& vertecies, const IndexData& indicies);
     };
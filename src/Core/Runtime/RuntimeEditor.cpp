@@ -142,6 +142,7 @@ namespace MxEngine
                 ImGui::Begin("Profiling Tools", &isProfilerOpened);
                 
                 GUI_TREE_NODE("Profiler", GUI::DrawProfiler("fps profiler"));
+                GUI_TREE_NODE("Frame Statistics", GUI::DrawFrameStatistics("scope filter"));
                 GUI_TREE_NODE("Render Statistics", GUI::DrawRenderStatistics("render statistics"));
                 this->logger->Draw("Event Logger", 20);
 
@@ -165,7 +166,7 @@ namespace MxEngine
         {
             Rendering::SetRenderToDefaultFrameBuffer(this->cachedUseDefaultFrameBufferVariable);
             auto windowSize = WindowManager::GetSize();
-            Event::AddEvent(MakeUnique<WindowResizeEvent>(this->cachedViewportSize, windowSize));
+            Event::AddEvent<WindowResizeEvent>(this->cachedViewportSize, windowSize);
             this->cachedViewportSize = windowSize;
         }
         else
@@ -465,9 +466,14 @@ namespace MxEngine
         if (!IsInstanced(object))
         {
             auto transform = GetGlobalTransform(object);
-            auto parentTransform = GetGlobalTransform(GetInstanceParent(object));
-            this->DrawTransformManipulator(transform);
-            object->LocalTransform = WorldToLocal(parentTransform, transform);
+            auto manipulatedTransform = transform;
+            this->DrawTransformManipulator(manipulatedTransform);
+            // local transform is only written back if it was changed, as conversion to parent space is not exact
+            if (manipulatedTransform != transform)
+            {
+                auto parent = IsInstance(object) ? GetInstanceParent(object) : object->GetParent();
+                object->LocalTransform = WorldToLocal(GetGlobalTransform(parent), manipulatedTransform);
+            }
         }
         // instanciate by middle button click TODO: add docs
         if (ImGui::IsMouseClicked(ImGuiMouseButton_Middle))
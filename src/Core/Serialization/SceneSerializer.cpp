@@ -67,13 +67,26 @@ namespace MxEngine
 
         auto& objects = json["mxobjects"];
         auto view = MxObject::GetObjects();
+        MxHashMap<MxObject::EngineHandle, size_t> serializedIndices;
         for (auto& object : view)
         {
             if (object.IsSerialized && !IsInstance(object))
             {
+                serializedIndices[object.GetNativeHandle()] = objects.size();
                 objects.push_back(SceneSerializer::SerializeMxObject(object));
             }
         }
+
+        // object handles are not preserved between runs, so parent is stored as index of serialized object
+        for (const auto& [handle, index] : serializedIndices)
+        {
+            auto parent = MxObject::GetByHandle(handle)->GetParent();
+            if (!parent.IsValid()) continue;
+
+            auto parentIndex = serializedIndices.find(parent->GetNativeHandle());
+            if (parentIndex != serializedIndices.end())
+                objects[index]["parent"] = parentIndex->second;
+        }
     }
 
     void SceneSerializer::SerializeResources(JsonFile& json)
@@ -114,9 +127,18 @@ namespace MxEngine
         MAKE_SCOPE_TIMER("MxEngine::SceneSerializer", "SceneSerializer::DeserializeObjects()");
 
         const auto& jsonObjects = json["mxobjects"];
+        MxVector<MxObject::Handle> objects;
         for (const auto& entry : jsonObjects)
         {
-            (void)SceneSerializer::DeserializeMxObject(entry, MxObject::Create(), mappings);
+            auto object = MxObject::Create();
+            SceneSerializer::DeserializeMxObject(entry, object, mappings);
+            objects.push_back(std::move(object));
+        }
+
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            if (jsonObjects[i].contains("parent"))
+                objects[i]->SetParent(objects[jsonObjects[i]["parent"].get<size_t>()]);
         }
     }
 
@@ -183,7 +205,10 @@ namespace MxEngine
     JsonFile SceneSerializer::SerializeMxObject(MxObject& object)
     {
         JsonFile json;
-        json["name"] = object.Name;
+        if (object.Name.empty()) object.Name = UUIDGenerator::Get();
+        json["name"] = object.Name.Get();
+        for (const auto& tag : object.GetTags())
+            json["tags"].push_back(tag);
         json["displayed"] = object.IsDisplayedInEditor;
 
         MxEngine::Serialize(json["transform"], object.LocalTransform);
@@ -199,6 +224,11 @@ namespace MxEngine
     void SceneSerializer::DeserializeMxObject(const JsonFile& json, MxObject::Handle object, HandleMappings& mappings)
     {
         object->Name = json["name"].get<MxString>();
+        if (json.contains("tags"))
+        {
+            for (const auto& tag : json["tags"])
+                object->AddTag(tag.get<MxString>());
+        }
         object->IsDisplayedInEditor = json["displayed"];
 
         MxEngine::Deserialize(json["transform"], object->LocalTransform, mappings);
@@ -213,6 +243,8 @@ namespace MxEngine
     {
         target->LocalTransform = origin->LocalTransform;
         target->Name = origin->Name;
+        for (const auto& tag : origin->GetTags())
+            target->AddTag(tag);
         target->IsDisplayedInEditor = origin->IsDisplayedInEditor;
         target->IsSerialized = origin->IsSerialized;
 
@@ -263,6 +295,7 @@ namespace MxEngine
     {
         auto clone = MxObject::Create();
         clone->Name = object->Name;
+        clone->SetParent(object->GetParent());
         SceneSerializer::CloneMxObjectAsCopy(object, clone);
         return clone;
     }
@@ -39,6 +39,8 @@
 #include "Platform/OpenGL/VertexArray.h"
 #include "Platform/OpenGL/VertexBuffer.h"
 #include "Platform/OpenGL/ShaderStorageBuffer.h"
+#include "Platform/OpenGL/DrawIndirectBuffer.h"
+#include "Platform/OpenGL/UniformBuffer.h"
 #include "Platform/OpenGL/ComputeShader.h"
 #include "Platform/OpenGL/VertexAttribute.h"
 
@@ -53,6 +55,8 @@ namespace MxEngine
     MXENGINE_MAKE_FACTORY(VertexArray);
     MXENGINE_MAKE_FACTORY(VertexBuffer);
     MXENGINE_MAKE_FACTORY(ShaderStorageBuffer);
+    MXENGINE_MAKE_FACTORY(DrawIndirectBuffer);
+    MXENGINE_MAKE_FACTORY(UniformBuffer);
     MXENGINE_MAKE_FACTORY(ComputeShader);
 
     #undef MAKE_FACTORY
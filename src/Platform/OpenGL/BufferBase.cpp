@@ -37,6 +37,8 @@ namespace MxEngine
         GL_ARRAY_BUFFER,
         GL_ELEMENT_ARRAY_BUFFER,
         GL_SHADER_STORAGE_BUFFER,
+        GL_DRAW_INDIRECT_BUFFER,
+        GL_UNIFORM_BUFFER,
     };
 
     GLenum UsageTypeToEnum[] = {
@@ -117,6 +119,11 @@ namespace MxEngine
         GLCALL(glBindBufferBase(BufferTypeToEnum[(size_t)this->type], index, this->id));
     }
 
+    void BufferBase::BindBase(BufferType type, size_t index) const
+    {
+        GLCALL(glBindBufferBase(BufferTypeToEnum[(size_t)type], index, this->id));
+    }
+
     BufferBase::BindableId BufferBase::GetNativeHandle() const
     {
         return this->id;
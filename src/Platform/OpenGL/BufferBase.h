@@ -52,6 +52,8 @@ namespace MxEngine
         ARRAY,
         ELEMENT_ARRAY,
         SHADER_STORAGE,
+        DRAW_INDIRECT,
+        UNIFORM,
     };
 
     class BufferBase
@@ -75,6 +77,7 @@ namespace MxEngine
         void Bind() const;
         void Unbind() const;
         void BindBase(size_t index) const;
+        void BindBase(BufferType type, size_t index) const;
         BindableId GetNativeHandle() const;
         BufferType GetBufferType() const;
         UsageType GetUsageType() const;
@@ -179,6 +179,17 @@ namespace MxEngine
         ));
     }
 
+    void Renderer::DrawIndicesMultiIndirect(RenderPrimitive primitive, size_t commandOffset, size_t commandCount)
+    {
+        GLCALL(glMultiDrawElementsIndirect(
+            PrimitiveTable[(size_t)primitive],
+            GetGLType<IndexBuffer::IndexType>(),
+            (const void*)(commandOffset * sizeof(DrawElementsIndirectCommand)),
+            commandCount,
+            0
+        ));
+    }
+
     Renderer& Renderer::UseColorMask(bool r, bool g, bool b, bool a)
     {
         GLCALL(glColorMask(r, g, b, a));
@@ -91,6 +91,7 @@ namespace MxEngine
         void DrawIndicesInstanced(RenderPrimitive primitive, size_t indexCount, size_t indexOffset, size_t instanceCount, size_t baseInstance);
         void DrawIndicesBaseVertex(RenderPrimitive primitive, size_t indexCount, size_t indexOffset, size_t baseVertex);
         void DrawIndicesBaseVertexInstanced(RenderPrimitive primitive, size_t indexCount, size_t indexOffset, size_t baseVertex, size_t instanceCount, size_t baseInstance);
+        void DrawIndicesMultiIndirect(RenderPrimitive primitive, size_t commandOffset, size_t commandCount);
 
         void SetDefaultVertexAttribute(size_t index, float v) const;
         void SetDefaultVertexAttribute(size_t index, const Vector2& vec) const;
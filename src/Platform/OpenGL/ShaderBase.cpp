@@ -31,6 +31,9 @@
 #include "Utilities/Logging/Logger.h"
 #include "Core/Config/GlobalConfig.h"
 #include "Utilities/Parsing/ShaderPreprocessor.h"
+#include "Platform/OpenGL/UniformBlocks.h"
+
+#include <algorithm>
 
 namespace MxEngine
 {
@@ -67,6 +70,125 @@ namespace MxEngine
         return location;
     }
 
+    bool ShaderBase::UniformLocationTable::Insert(StringId hash, UniformIdType location)
+    {
+        size_t mask = this->entries.size() - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask)
+        {
+            auto& entry = this->entries[i];
+            if (entry.Location == UniformCache::InvalidLocation)
+            {
+                entry.Hash = hash;
+                entry.Location = location;
+                return true;
+            }
+            if (entry.Hash == hash) return false;
+        }
+    }
+
+    bool ShaderBase::UniformLocationTable::IsReportedMissing(StringId hash) const
+    {
+        return std::find(this->reportedMissing.begin(), this->reportedMissing.end(), hash) != this->reportedMissing.end();
+    }
+
+    void ShaderBase::UniformLocationTable::Load(BindableId shaderId)
+    {
+        this->entries.clear();
+        this->reportedMissing.clear();
+        if (shaderId == 0) return;
+
+        GLint uniformCount = 0, maxNameLength = 0;
+        GLCALL(glGetProgramiv(shaderId, GL_ACTIVE_UNIFORMS, &uniformCount));
+        GLCALL(glGetProgramiv(shaderId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength));
+
+        MxVector<Entry> uniforms;
+        MxVector<MxString> uniformNames;
+        MxString name;
+        for (GLint i = 0; i < uniformCount; i++)
+        {
+            GLint size = 0, length = 0;
+            GLenum type = 0;
+            name.resize(maxNameLength);
+            GLCALL(glGetActiveUniform(shaderId, (GLuint)i, maxNameLength, &length, &size, &type, &name[0]));
+            name.resize(length);
+
+            GLCALL(UniformIdType location = glGetUniformLocation(shaderId, name.c_str()));
+            if (location == UniformCache::InvalidLocation) continue; // uniform block member
+
+            uniforms.push_back(Entry{ MakeStringId(name), location });
+            uniformNames.push_back(name);
+
+            // arrays are reported once as name[0], so base name and all other elements are added separately
+            constexpr const char* FirstElement = "[0]";
+            if (size > 1 && name.size() > 3 && name.compare(name.size() - 3, 3, FirstElement) == 0)
+            {
+                auto baseName = name.substr(0, name.size() - 3);
+                uniforms.push_back(Entry{ MakeStringId(baseName), location });
+                uniformNames.push_back(baseName);
+                for (GLint element = 1; element < size; element++)
+                {
+                    auto elementName = baseName + '[' + ToMxString(element) + ']';
+                    GLCALL(UniformIdType elementLocation = glGetUniformLocation(shaderId, elementName.c_str()));
+                    if (elementLocation != UniformCache::InvalidLocation)
+                    {
+                        uniforms.push_back(Entry{ MakeStringId(elementName), elementLocation });
+                        uniformNames.push_back(elementName);
+                    }
+                }
+            }
+        }
+
+        // keep load factor below 0.5, so probe sequences stay short
+        size_t tableSize = 16;
+        while (tableSize < 2 * uniforms.size()) tableSize *= 2;
+        this->entries.resize(tableSize, Entry{ 0, UniformCache::InvalidLocation });
+
+        for (size_t i = 0; i < uniforms.size(); i++)
+        {
+            if (this->Insert(uniforms[i].Hash, uniforms[i].Location)) continue;
+
+            // table stores only hashes, so uniform which name hash collides with other uniform cannot be found by its UniformId
+            auto first = std::find_if(uniforms.begin(), uniforms.begin() + i, [&](const Entry& e) { return e.Hash == uniforms[i].Hash; });
+            const auto& firstName = uniformNames[size_t(first - uniforms.begin())];
+            if (firstName != uniformNames[i])
+            {
+                MXLOG_ERROR("OpenGL::Shader", "uniform name hash collision: " + firstName + " and " + uniformNames[i] + ", use string-based SetUniform() for " + uniformNames[i]);
+                MX_ASSERT(false); // uniform name hash collision
+            }
+        }
+    }
+
+    void ShaderBase::UniformLocationTable::Ignore(UniformId uniform)
+    {
+        auto location = this->GetUniformLocationSilent(uniform);
+        if (location == UniformCache::InvalidLocation && !this->IsReportedMissing(uniform.Hash))
+            this->reportedMissing.push_back(uniform.Hash);
+    }
+
+    ShaderBase::UniformIdType ShaderBase::UniformLocationTable::GetUniformLocationSilent(UniformId uniform)
+    {
+        if (this->entries.empty()) return UniformCache::InvalidLocation;
+
+        size_t mask = this->entries.size() - 1;
+        for (size_t i = uniform.Hash & mask; ; i = (i + 1) & mask)
+        {
+            const auto& entry = this->entries[i];
+            if (entry.Location == UniformCache::InvalidLocation) return UniformCache::InvalidLocation;
+            if (entry.Hash == uniform.Hash) return entry.Location;
+        }
+    }
+
+    ShaderBase::UniformIdType ShaderBase::UniformLocationTable::GetUniformLocation(UniformId uniform)
+    {
+        auto location = this->GetUniformLocationSilent(uniform);
+        if (location == UniformCache::InvalidLocation && !this->IsReportedMissing(uniform.Hash))
+        {
+            MXLOG_WARNING("OpenGL::Shader", "uniform was not found: " + MxString(uniform.Name));
+            this->reportedMissing.push_back(uniform.Hash);
+        }
+        return location;
+    }
+
     MxString ShaderBase::GetShaderVersionString()
     {
         return "#version " + ToMxString(GlobalConfig::GetGraphicAPIMajorVersion() * 100 + GlobalConfig::GetGraphicAPIMinorVersion() * 10);
@@ -173,6 +295,7 @@ namespace MxEngine
 
         auto modifiedSourceCode = preprocessor
             .LoadIncludes(path.parent_path())
+            .LoadUniformBlocks(UniformBlockSources, std::size(UniformBlockSources))
             .EmitPrefixLine(ShaderBase::GetShaderVersionString())
             .GetResult();
 
@@ -197,6 +320,7 @@ namespace MxEngine
         this->FreeProgram();
         this->id = id;
         this->uniformCache = UniformCache{ this->id };
+        this->uniformTable.Load(this->id);
     }
 
     void ShaderBase::Bind() const
@@ -220,7 +344,7 @@ namespace MxEngine
     }
 
     ShaderBase::ShaderBase(ShaderBase&& other) noexcept
-        : id(other.id), uniformCache(std::move(other.uniformCache))
+        : id(other.id), uniformCache(std::move(other.uniformCache)), uniformTable(std::move(other.uniformTable))
     {
         other.id = 0;
     }
@@ -231,6 +355,7 @@ namespace MxEngine
 
         this->id = other.id;
         this->uniformCache = std::move(other.uniformCache);
+        this->uniformTable = std::move(other.uniformTable);
 
         other.id = 0;
 
@@ -242,6 +367,61 @@ namespace MxEngine
         return this->id;
     }
 
+    static void UploadUniform(ShaderBase::UniformIdType location, int i)
+    {
+        GLCALL(glUniform1i(location, i));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, float f)
+    {
+        GLCALL(glUniform1f(location, f));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, const Vector2& v)
+    {
+        GLCALL(glUniform2f(location, v[0], v[1]));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, const Vector3& v)
+    {
+        GLCALL(glUniform3f(location, v[0], v[1], v[2]));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, const Vector4& v)
+    {
+        GLCALL(glUniform4f(location, v[0], v[1], v[2], v[3]));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, const VectorInt2& v)
+    {
+        GLCALL(glUniform2i(location, v[0], v[1]));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, const VectorInt3& v)
+    {
+        GLCALL(glUniform3i(location, v[0], v[1], v[2]));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, const VectorInt4& v)
+    {
+        GLCALL(glUniform4i(location, v[0], v[1], v[2], v[3]));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, const Matrix2x2& m)
+    {
+        GLCALL(glUniformMatrix2fv(location, 1, false, &m[0][0]));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, const Matrix3x3& m)
+    {
+        GLCALL(glUniformMatrix3fv(location, 1, false, &m[0][0]));
+    }
+
+    static void UploadUniform(ShaderBase::UniformIdType location, const Matrix4x4& m)
+    {
+        GLCALL(glUniformMatrix4fv(location, 1, false, &m[0][0]));
+    }
+
     void ShaderBase::SetUniform(const MxString& name, int i) const
     {
         MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
@@ -249,7 +429,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniform1i(location, i));
+        UploadUniform(location, i);
     }
 
     void ShaderBase::SetUniform(const MxString& name, bool b) const
@@ -264,7 +444,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniform1f(location, f));
+        UploadUniform(location, f);
     }
 
     void ShaderBase::SetUniform(const MxString& name, const Vector2& v) const
@@ -274,7 +454,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniform2f(location, v[0], v[1]));
+        UploadUniform(location, v);
     }
 
     void ShaderBase::SetUniform(const MxString& name, const Vector3& v) const
@@ -284,7 +464,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniform3f(location, v[0], v[1], v[2]));
+        UploadUniform(location, v);
     }
 
     void ShaderBase::SetUniform(const MxString& name, const Vector4& v) const
@@ -294,7 +474,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniform4f(location, v[0], v[1], v[2], v[3]));
+        UploadUniform(location, v);
     }
 
     void ShaderBase::SetUniform(const MxString& name, const VectorInt2& v) const
@@ -304,7 +484,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniform2i(location, v[0], v[1]));
+        UploadUniform(location, v);
     }
 
     void ShaderBase::SetUniform(const MxString& name, const VectorInt3& v) const
@@ -314,7 +494,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniform3i(location, v[0], v[1], v[2]));
+        UploadUniform(location, v);
     }
 
     void ShaderBase::SetUniform(const MxString& name, const VectorInt4& v) const
@@ -324,7 +504,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniform4i(location, v[0], v[1], v[2], v[3]));
+        UploadUniform(location, v);
     }
 
     void ShaderBase::SetUniform(const MxString& name, const Matrix2x2& m) const
@@ -334,7 +514,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniformMatrix2fv(location, 1, false, &m[0][0]));
+        UploadUniform(location, m);
     }
 
     void ShaderBase::SetUniform(const MxString& name, const Matrix3x3& m) const
@@ -344,7 +524,7 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniformMatrix3fv(location, 1, false, &m[0][0]));
+        UploadUniform(location, m);
     }
 
     void ShaderBase::SetUniform(const MxString& name, const Matrix4x4& m) const
@@ -354,7 +534,122 @@ namespace MxEngine
         if (location == ShaderBase::UniformCache::InvalidLocation)
             return;
 
-        GLCALL(glUniformMatrix4fv(location, 1, false, &m[0][0]));
+        UploadUniform(location, m);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, int i) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, i);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, bool b) const
+    {
+        this->SetUniform(uniform, (int)b);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, float f) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, f);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, const Vector2& v) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, v);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, const Vector3& v) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, v);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, const Vector4& v) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, v);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, const VectorInt2& v) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, v);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, const VectorInt3& v) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, v);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, const VectorInt4& v) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, v);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, const Matrix2x2& m) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, m);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, const Matrix3x3& m) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, m);
+    }
+
+    void ShaderBase::SetUniform(UniformId uniform, const Matrix4x4& m) const
+    {
+        MX_ASSERT(this->id == ShaderBase::CurrentlyAttachedShader);
+        auto location = this->GetUniformLocation(uniform);
+        if (location == ShaderBase::UniformCache::InvalidLocation)
+            return;
+
+        UploadUniform(location, m);
     }
 
     void ShaderBase::IgnoreNonExistingUniform(const MxString& name) const
@@ -377,8 +672,19 @@ namespace MxEngine
         return this->uniformCache.GetUniformLocation(name);
     }
 
+    void ShaderBase::IgnoreNonExistingUniform(UniformId uniform) const
+    {
+        this->uniformTable.Ignore(uniform);
+    }
+
+    ShaderBase::UniformIdType ShaderBase::GetUniformLocation(UniformId uniform) const
+    {
+        return this->uniformTable.GetUniformLocation(uniform);
+    }
+
     void ShaderBase::InvalidateUniformCache()
     {
         this->uniformCache = UniformCache{ this->id };
+        this->uniformTable.Load(this->id);
     }
 }
\ No newline at end of file
@@ -33,9 +33,22 @@
 #include "Utilities/STL/MxString.h"
 #include "Utilities/STL/MxVector.h"
 #include "Utilities/STL/MxHashMap.h"
+#include "Utilities/String/String.h"
 
 namespace MxEngine
 {
+    /*!
+    uniform name with precomputed hash. Should be created with UNIFORM_ID macro, so hash is computed at compile time
+    */
+    struct UniformId
+    {
+        StringId Hash;
+        const char* Name;
+    };
+
+    // uniform id of string literal, hash is computed at compile time
+    #define UNIFORM_ID(x) MxEngine::UniformId{ STRING_ID(x), x }
+
     class ShaderBase
     {
     public:
@@ -57,11 +70,36 @@ namespace MxEngine
             UniformIdType GetUniformLocation(const char* uniformName);
             UniformIdType GetUniformLocationSilent(const char* uniformName);
         };
+
+        /*!
+        open-addressing table of all active uniforms of linked program, filled once when native handle is set.
+        Lookup by UniformId uses precomputed hash, so it neither allocates nor hashes strings at runtime
+        */
+        class UniformLocationTable
+        {
+            struct Entry
+            {
+                StringId Hash;
+                UniformIdType Location;
+            };
+
+            MxVector<Entry> entries;
+            MxVector<StringId> reportedMissing;
+
+            bool Insert(StringId hash, UniformIdType location);
+            bool IsReportedMissing(StringId hash) const;
+        public:
+            void Load(BindableId shaderId);
+            void Ignore(UniformId uniform);
+            UniformIdType GetUniformLocation(UniformId uniform);
+            UniformIdType GetUniformLocationSilent(UniformId uniform);
+        };
     private:
         static BindableId CurrentlyAttachedShader;
 
         BindableId id = 0;
         mutable UniformCache uniformCache;
+        mutable UniformLocationTable uniformTable;
 
         void FreeProgram();
     protected:
@@ -90,6 +128,8 @@ namespace MxEngine
         void IgnoreNonExistingUniform(const char* name) const;
         UniformIdType GetUniformLocation(const MxString& name) const;
         UniformIdType GetUniformLocation(const char* name) const;
+        void IgnoreNonExistingUniform(UniformId uniform) const;
+        UniformIdType GetUniformLocation(UniformId uniform) const;
 
         void SetUniform(const MxString& name, float             f) const;
         void SetUniform(const MxString& name, const Vector2&    v) const;
@@ -103,5 +143,18 @@ namespace MxEngine
         void SetUniform(const MxString& name, const Matrix4x4&  m) const;
         void SetUniform(const MxString& name, int               i) const;
         void SetUniform(const MxString& name, bool              b) const;
+
+        void SetUniform(UniformId uniform, float             f) const;
+        void SetUniform(UniformId uniform, const Vector2&    v) const;
+        void SetUniform(UniformId uniform, const Vector3&    v) const;
+        void SetUniform(UniformId uniform, const Vector4&    v) const;
+        void SetUniform(UniformId uniform, const VectorInt2& v) const;
+        void SetUniform(UniformId uniform, const VectorInt3& v) const;
+        void SetUniform(UniformId uniform, const VectorInt4& v) const;
+        void SetUniform(UniformId uniform, const Matrix2x2&  m) const;
+        void SetUniform(UniformId uniform, const Matrix3x3&  m) const;
+        void SetUniform(UniformId uniform, const Matrix4x4&  m) const;
+        void SetUniform(UniformId uniform, int               i) const;
+        void SetUniform(UniformId uniform, bool              b) const;
     };
 }
@@ -1,14 +1,5 @@
 #include "Library/ibl_lighting.glsl"
-
-const int DirLightCascadeMapCount = 3;
-const int MaxDirLightCount = 4;
-
-struct DirLight
-{
-    mat4 transform[DirLightCascadeMapCount];
-    vec4 color;
-    vec3 direction;
-};
+#uniform_block lighting
 
 float calcShadowFactorCascade(vec4 position, DirLight light, sampler2D shadowMap)
 {
@@ -1,4 +1,5 @@
 #include "Library/lighting.glsl"
+#uniform_block environment
 
 vec3 calculateIBL(FragmentInfo fragment, vec3 viewDirection, EnvironmentInfo environment, float gamma)
 {
@@ -11,17 +12,17 @@ vec3 calculateIBL(FragmentInfo fragment, vec3 viewDirection, EnvironmentInfo env
     vec3 F0 = mix(vec3(0.04f), fragment.albedo, metallic);
     vec3 F = fresnelSchlickRoughness(F0, NV, roughness);
     
-    vec3 prefilteredColor = calcReflectionColor(environment.skybox, environment.skyboxRotation, viewDirection, fragment.normal, lod);
+    vec3 prefilteredColor = calcReflectionColor(environment.skybox, environmentData.skyboxRotation, viewDirection, fragment.normal, lod);
     prefilteredColor = pow(prefilteredColor, vec3(gamma));
     vec2 envBRDF = texture2D(environment.envBRDFLUT, vec2(NV, 1.0 - roughness)).rg;
     vec3 specularColor = prefilteredColor * (F * envBRDF.x + envBRDF.y);
 
-    vec3 irradianceColor = calcReflectionColor(environment.irradiance, environment.skyboxRotation, viewDirection, fragment.normal);
+    vec3 irradianceColor = calcReflectionColor(environment.irradiance, environmentData.skyboxRotation, viewDirection, fragment.normal);
     irradianceColor = pow(irradianceColor, vec3(gamma));
     
     float diffuseCoef = 1.0f - metallic;
     vec3 diffuseColor = fragment.albedo * (irradianceColor - irradianceColor * envBRDF.y) * diffuseCoef;
-    vec3 iblColor = (diffuseColor + specularColor) * environment.intensity;
+    vec3 iblColor = (diffuseColor + specularColor) * environmentData.skyboxIntensity;
 
     return fragment.emmisionFactor * fragment.albedo + iblColor * fragment.ambientOcclusion;
 }
\ No newline at end of file
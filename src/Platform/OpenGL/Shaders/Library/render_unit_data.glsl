@@ -0,0 +1,23 @@
+struct RenderUnitData
+{
+    mat4 model;
+    mat4 normal;
+    vec4 params;
+};
+
+layout(std430, binding = 1) readonly buffer RenderUnitBuffer
+{
+    RenderUnitData renderUnits[];
+};
+
+layout(std430, binding = 2) readonly buffer DrawUnitIndexBuffer
+{
+    uint drawUnitIndices[];
+};
+
+uniform int drawOffset;
+
+RenderUnitData getRenderUnitData()
+{
+    return renderUnits[drawUnitIndices[drawOffset + gl_DrawID]];
+}
\ No newline at end of file
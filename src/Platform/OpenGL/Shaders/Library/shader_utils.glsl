@@ -120,8 +120,6 @@ struct EnvironmentInfo
 {
     samplerCube skybox;
     samplerCube irradiance;
-    mat3 skyboxRotation;
-    float intensity;
     sampler2D envBRDFLUT;
 };
 
@@ -0,0 +1,26 @@
+#include "Library/displacement.glsl"
+#include "Library/render_unit_data.glsl"
+
+layout(location = 0)  in vec4 position;
+layout(location = 1)  in vec2 texCoord;
+layout(location = 2)  in vec3 normal;
+layout(location = 5)  in mat4 model;
+layout(location = 9)  in mat3 normalMatrix;
+
+uniform mat4 LightProjMatrix;
+uniform vec2 uvMultipliers;
+uniform sampler2D map_height;
+uniform float displacement;
+
+out vec2 TexCoord;
+
+void main()
+{
+    RenderUnitData unit = getRenderUnitData();
+    TexCoord = texCoord * uvMultipliers;
+
+    vec4 modelPos = unit.model * model * position;
+    vec3 normalObjectSpace = mat3(unit.normal) * normalMatrix * normal;
+    modelPos.xyz += normalObjectSpace * getDisplacement(TexCoord, uvMultipliers, map_height, displacement * unit.params.x);
+    gl_Position = LightProjMatrix * modelPos;
+}
\ No newline at end of file
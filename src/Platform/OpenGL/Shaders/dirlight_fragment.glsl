@@ -3,22 +3,13 @@
 out vec4 OutColor;
 in vec2 TexCoord;
 
-struct Camera
-{
-    vec3 position;
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-
 uniform sampler2D albedoTex;
 uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-uniform int lightCount;
-uniform Camera camera;
+#uniform_block camera
 
-uniform DirLight lights[MaxDirLightCount];
 uniform sampler2D lightDepthMaps[MaxDirLightCount];
 
 void main()
@@ -27,11 +18,12 @@ void main()
     vec3 viewDirection = normalize(camera.position - fragment.position);
 
     vec3 totalColor = vec3(0.0);
-    for (int i = 0; i < lightCount; i++)
+    for (int i = 0; i < lighting.lightCount; i++)
     {
+        DirLight light = lighting.lights[i];
         vec4 pos = vec4(fragment.position, 1.0);
-        float shadowFactor = calcShadowFactorCascade(pos, lights[i], lightDepthMaps[i]);
-        totalColor += calculateLighting(fragment, viewDirection, lights[i].direction, lights[i].color.rgb, lights[i].color.a, shadowFactor);
+        float shadowFactor = calcShadowFactorCascade(pos, light, lightDepthMaps[i]);
+        totalColor += calculateLighting(fragment, viewDirection, light.direction, light.color.rgb, light.color.a, shadowFactor);
     }
     
     OutColor = vec4(totalColor, 1.0);
@@ -9,16 +9,9 @@ uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 
-struct Camera
-{
-    vec3 position;
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-
 uniform sampler2D cameraOutput;
-uniform Fog fog;
-uniform Camera camera;
+#uniform_block camera
+#uniform_block environment
 
 void main()
 {
@@ -26,7 +19,7 @@ void main()
     float fragDistance = length(camera.position - fragment.position);
 
     vec3 currentColor = texture(cameraOutput, TexCoord).rgb;
-    currentColor = applyFog(currentColor, fragDistance, fog);
+    currentColor = applyFog(currentColor, fragDistance, Fog(environmentData.fogDistance, environmentData.fogDensity, environmentData.fogColor));
 
     OutColor = vec4(currentColor, 1.0f);
 }
\ No newline at end of file
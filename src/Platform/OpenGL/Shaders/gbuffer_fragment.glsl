@@ -21,13 +21,6 @@ struct Material
     float transparency;
 };
 
-struct Camera
-{
-    vec3 position;
-    mat4 viewProjMatrix;
-    mat4 invViewProjMatrix;
-};
-
 uniform sampler2D map_albedo;
 uniform sampler2D map_roughness;
 uniform sampler2D map_metallic;
@@ -38,8 +31,7 @@ uniform sampler2D map_height;
 uniform Material material;
 uniform vec2 uvMultipliers;
 uniform float displacement;
-uniform float gamma;
-uniform Camera camera;
+#uniform_block camera
 
 vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
 {
@@ -69,7 +61,7 @@ void main()
     float roughness = material.roughness * roughnessTex;
     float metallic = material.metallic * metallicTex;
 
-    vec3 albedo = pow(fsin.RenderColor * albedoTex, vec3(gamma));
+    vec3 albedo = pow(fsin.RenderColor * albedoTex, vec3(camera.gamma));
 
     OutAlbedo = vec4(fsin.RenderColor * albedo, emmisive / (emmisive + 1.0f));
     OutNormal = vec4(0.5f * normal + 0.5f, 1.0f);
@@ -9,14 +9,7 @@ layout(location = 5)  in mat4 model;
 layout(location = 9)  in mat3 normalMatrix;
 layout(location = 12) in vec3 renderColor;
 
-struct Camera
-{
-    vec3 position;
-    mat4 viewProjMatrix;
-    mat4 invViewProjMatrix;
-};
-
-uniform Camera camera;
+#uniform_block camera
 uniform float displacement;
 uniform mat4 parentModel;
 uniform mat3 parentNormal;
@@ -3,7 +3,7 @@ in vec2 TexCoord;
 
 uniform sampler2D HDRTex;
 uniform sampler2D averageWhiteTex;
-uniform float gamma;
+#uniform_block camera
 uniform float colorMultiplier;
 uniform float whitePoint;
 uniform float minLuminance;
@@ -48,6 +48,6 @@ void main()
         DEFcoefsACES.x, DEFcoefsACES.y, DEFcoefsACES.z, 
         luma * HDRColor, colorMultiplier);
 
-    vec3 gammaCorrectedColor = pow(LDRColor.rgb, vec3(1.0f / gamma));
+    vec3 gammaCorrectedColor = pow(LDRColor.rgb, vec3(1.0f / camera.gamma));
     OutColor = vec4(gammaCorrectedColor.rgb, 1.0f);
 }
\ No newline at end of file
@@ -7,16 +7,8 @@ uniform sampler2D albedoTex;
 uniform sampler2D normalTex;
 uniform sampler2D materialTex;
 uniform sampler2D depthTex;
-uniform float gamma;
 
-struct Camera
-{
-    vec3 position;
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-
-uniform Camera camera;
+#uniform_block camera
 uniform EnvironmentInfo environment;
 
 void main()
@@ -24,7 +16,7 @@ void main()
     FragmentInfo fragment = getFragmentInfo(TexCoord, albedoTex, normalTex, materialTex, depthTex, camera.invViewProjMatrix);
     vec3 viewDirection = normalize(camera.position - fragment.position);
 
-    vec3 IBL = calculateIBL(fragment, viewDirection, environment, gamma);
+    vec3 IBL = calculateIBL(fragment, viewDirection, environment, camera.gamma);
 
     OutColor = vec4(IBL, 1.0f);
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+layout(local_size_x = 64) in;
+
+uniform int indexCount;
+uniform int targetOffset;
+uniform int instanceSize;
+
+layout(std430, binding = 3) buffer InstanceData
+{
+    float instanceData[];
+};
+
+layout(std430, binding = 4) readonly buffer InstanceIndices
+{
+    uint instanceIndices[];
+};
+
+void main()
+{
+    uint idx = gl_GlobalInvocationID.x;
+    if (idx >= uint(indexCount)) return;
+
+    uint source = instanceIndices[idx] * uint(instanceSize);
+    uint target = (uint(targetOffset) + idx) * uint(instanceSize);
+    for (uint i = 0; i < uint(instanceSize); i++)
+    {
+        instanceData[target + i] = instanceData[source + i];
+    }
+}
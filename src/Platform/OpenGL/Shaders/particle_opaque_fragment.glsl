@@ -11,7 +11,7 @@ uniform float transparency;
 uniform float metallness;
 uniform float roughness;
 uniform vec3 color;
-uniform float gamma;
+#uniform_block camera
 uniform sampler2D albedoTex;
 uniform vec3 normal;
 
@@ -21,7 +21,7 @@ void main()
     float alphaCutoff = 1.0 - transparency;
     if (albedo.a <= alphaCutoff) discard; // mask fragments with opacity less than cutoff
 
-    OutAlbedo = vec4(color * pow(albedo.rgb, vec3(gamma)), emmision / (emmision + 1.0));
+    OutAlbedo = vec4(color * pow(albedo.rgb, vec3(camera.gamma)), emmision / (emmision + 1.0));
     OutNormal = vec4(0.5 * normal + 0.5, 1.0);
     OutMaterial = vec4(1.0, roughness, metallness, 1.0);
 }
\ No newline at end of file
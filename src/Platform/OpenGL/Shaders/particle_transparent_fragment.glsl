@@ -12,7 +12,7 @@ uniform float emmision;
 uniform float metallness;
 uniform float roughness;
 uniform float transparency;
-uniform float gamma;
+#uniform_block camera
 uniform vec3 color;
 uniform vec2 viewportSize;
 uniform sampler2D albedoTex;
@@ -26,7 +26,7 @@ void main()
     vec4 albedoAlphaTex = texture(albedoTex, TexCoord).rgba;
     
     FragmentInfo fragment;
-    fragment.albedo = pow(color * albedoAlphaTex.rgb, vec3(gamma));
+    fragment.albedo = pow(color * albedoAlphaTex.rgb, vec3(camera.gamma));
     fragment.ambientOcclusion = 1.0;
     fragment.roughnessFactor = roughness;
     fragment.metallicFactor = metallness;
@@ -38,7 +38,7 @@ void main()
     float oldDepth = 1.0 / texture(depthTex, gl_FragCoord.xy / viewportSize).r;
     float depthFading = smoothstep(0.0, 1.5, oldDepth - LinearDepth);
 
-    vec3 IBLColor = calculateIBL(fragment, normal, environment, gamma);
+    vec3 IBLColor = calculateIBL(fragment, normal, environment, camera.gamma);
 
     vec3 totalColor = IBLColor + light * fragment.albedo;
 
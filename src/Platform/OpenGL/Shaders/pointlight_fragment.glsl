@@ -21,16 +21,9 @@ struct PointLight
     vec4 color;
 };
 
-struct Camera
-{
-    vec3 position;
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-
 uniform samplerCube lightDepthMap;
 uniform bool castsShadows;
-uniform Camera camera;
+#uniform_block camera
 uniform int pcfDistance;
 uniform vec2 viewportSize;
 
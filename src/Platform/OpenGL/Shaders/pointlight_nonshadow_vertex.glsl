@@ -10,14 +10,7 @@ out PointLightInfo
     vec4 color;
 } pointLight;
 
-struct Camera
-{
-    vec3 position;
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-
-uniform Camera camera;
+#uniform_block camera
 
 void main()
 {
@@ -7,14 +7,7 @@ out PointLightInfo
     vec4 color;
 } pointLight;
 
-struct Camera
-{
-    vec3 position;
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-
-uniform Camera camera;
+#uniform_block camera
 uniform mat4 transform;
 uniform vec4 sphereParameters;
 uniform vec4 colorParameters;
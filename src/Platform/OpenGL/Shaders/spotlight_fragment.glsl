@@ -27,17 +27,10 @@ struct SpotLight
     float maxDistance;
 };
 
-struct Camera
-{
-    vec3 position;
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-
 uniform mat4 worldToLightTransform;
 uniform bool castsShadows;
 uniform sampler2D lightDepthMap;
-uniform Camera camera;
+#uniform_block camera
 uniform vec2 viewportSize;
 
 vec3 calcColorUnderSpotLight(FragmentInfo fragment, SpotLight light, vec3 viewDirection, vec3 fragLightSpace, sampler2D map_shadow, bool computeShadow)
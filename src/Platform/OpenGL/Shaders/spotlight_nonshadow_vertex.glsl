@@ -14,14 +14,7 @@ out SpotLightInfo
     float maxDistance;
 } spotLight;
 
-struct Camera
-{
-    vec3 position;
-    mat4 invViewProjMatrix;
-    mat4 viewProjMatrix;
-};
-
-uniform Camera camera;
+#uniform_block camera
 uniform mat4 worldToLightTransform;
 
 void main()
@@ -3,13 +3,6 @@
 in vec2 TexCoord;
 out vec4 OutColor;
 
-struct Camera
-{
-    vec3 position;
-    mat4 viewProjMatrix;
-    mat4 invViewProjMatrix;
-};
-
 
 uniform sampler2D albedoTex;
 uniform sampler2D normalTex;
@@ -17,7 +10,7 @@ uniform sampler2D materialTex;
 uniform sampler2D depthTex;
 uniform sampler2D HDRTex;
 
-uniform Camera camera;
+#uniform_block camera
 uniform EnvironmentInfo environment;
 
 uniform int   steps;
@@ -28,25 +28,14 @@ uniform sampler2D map_transparency;
 uniform sampler2D map_occlusion;
 uniform Material material;
 uniform vec2 uvMultipliers;
-uniform float gamma;
+#uniform_block camera
 
-struct Camera
-{
-    vec3 position;
-    mat4 invProjMatrix;
-    mat4 invViewMatrix;
-    mat4 viewProjMatrix;
-};
-
-uniform int lightCount;
 uniform vec3 viewportPosition;
 uniform sampler2D envBRDFLUT;
 
 uniform EnvironmentInfo environment;
 
-const int MaxLightCount = 4;
-uniform DirLight lights[MaxLightCount];
-uniform sampler2D lightDepthMaps[MaxLightCount];
+uniform sampler2D lightDepthMaps[MaxDirLightCount];
 
 vec3 calcNormal(vec2 texcoord, mat3 TBN, sampler2D normalMap)
 {
@@ -61,7 +50,7 @@ void main()
     vec4 albedoAlphaTex = texture(map_albedo, TexCoord).rgba;
 
     FragmentInfo fragment;
-    fragment.albedo = pow(fsin.RenderColor * albedoAlphaTex.rgb, vec3(gamma));
+    fragment.albedo = pow(fsin.RenderColor * albedoAlphaTex.rgb, vec3(camera.gamma));
     fragment.ambientOcclusion = texture(map_occlusion, TexCoord).r;
     fragment.roughnessFactor = material.roughness * texture(map_roughness, TexCoord).r;
     fragment.metallicFactor = material.metallic * texture(map_metallic, TexCoord).r;
@@ -73,14 +62,15 @@ void main()
     float transparency = material.transparency * albedoAlphaTex.a;
     vec3 viewDirection = normalize(viewportPosition - fragment.position);
     
-    vec3 IBLColor = calculateIBL(fragment, viewDirection, environment, gamma);
+    vec3 IBLColor = calculateIBL(fragment, viewDirection, environment, camera.gamma);
 
     vec3 totalColor = IBLColor;
-    for (int i = 0; i < lightCount; i++)
+    for (int i = 0; i < lighting.lightCount; i++)
     {
+        DirLight light = lighting.lights[i];
         vec4 pos = vec4(fragment.position, 1.0f);
-        float shadowFactor = calcShadowFactorCascade(pos, lights[i], lightDepthMaps[i]);
-        totalColor += calculateLighting(fragment, viewDirection, lights[i].direction, lights[i].color.rgb, lights[i].color.a, shadowFactor);
+        float shadowFactor = calcShadowFactorCascade(pos, light, lightDepthMaps[i]);
+        totalColor += calculateLighting(fragment, viewDirection, light.direction, light.color.rgb, light.color.a, shadowFactor);
     }
 
     OutColor = vec4(totalColor, transparency);
@@ -128,6 +128,15 @@ namespace MxEngine
         this->FreeTexture();
     }
 
+    template<>
+    void Texture::Load(const Image& image, const std::filesystem::path& filepath, TextureFormat format)
+    {
+        this->Load(image, format);
+
+        this->filepath = ToMxString(std::filesystem::proximate(filepath));
+        std::replace(this->filepath.begin(), this->filepath.end(), '\\', '/');
+    }
+
     template<>
     void Texture::Load(const std::filesystem::path& filepath, TextureFormat format)
     {
@@ -140,40 +149,7 @@ namespace MxEngine
             MXLOG_ERROR("Texture", "file with name '" + ToMxString(filepath) + "' was not found or cannot be loaded");
         }
 
-        this->filepath = ToMxString(std::filesystem::proximate(filepath));
-        std::replace(this->filepath.begin(), this->filepath.end(), '\\', '/');
-
-        this->format = format;
-        this->width = image.GetWidth();
-        this->height = image.GetHeight();
-        this->textureType = GL_TEXTURE_2D;
-
-        size_t channels = image.GetChannelCount();
-        GLenum pixelType = image.IsFloatingPoint() ? GL_FLOAT : GL_UNSIGNED_BYTE;
-        GLenum pixelFormat = GL_RGBA;
-        switch (channels)
-        {
-        case 1:
-            pixelFormat = GL_RED;
-            break;
-        case 2:
-            pixelFormat = GL_RG;
-            break;
-        case 3:
-            pixelFormat = GL_RGB;
-            break;
-        case 4:
-            pixelFormat = GL_RGBA;
-            break;
-        default:
-            MXLOG_ERROR("OpenGL::Texture", "invalid channel count: " + ToMxString(channels));
-            break;
-        }
-
-        GLCALL(glBindTexture(GL_TEXTURE_2D, id));
-        GLCALL(glTexImage2D(GL_TEXTURE_2D, 0, formatTable[(int)this->format], (GLsizei)width, (GLsizei)height, 0, pixelFormat, pixelType, image.GetRawData()));
-
-        this->GenerateMipmaps();
+        this->Load(image, filepath, format);
     }
 
     template<>
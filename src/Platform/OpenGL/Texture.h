@@ -107,6 +107,8 @@ namespace MxEngine
         
         template<typename FilePath>
         void Load(const FilePath& filepath, TextureFormat format);
+        template<typename FilePath>
+        void Load(const Image& image, const FilePath& filepath, TextureFormat format);
 
         void Load(RawDataPointer data, int width, int height, int channels, bool isFloating, TextureFormat format = TextureFormat::RGB);
         void Load(const Image& image, TextureFormat format = TextureFormat::RGB);
@@ -0,0 +1,131 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/Math/Math.h"
+#include "Utilities/Parsing/ShaderPreprocessor.h"
+
+namespace MxEngine
+{
+    /*!
+    fixed binding points of shared uniform blocks. Must match layout(binding = N) in UniformBlockSources
+    */
+    enum class UniformBlockBinding : uint8_t
+    {
+        CAMERA = 0,
+        ENVIRONMENT,
+        LIGHTING,
+    };
+
+    // std140 layout of CameraBlock, updated once per camera
+    struct CameraUniformBlock
+    {
+        Vector3 Position;
+        float Gamma;
+        Matrix4x4 ViewProjMatrix;
+        Matrix4x4 InvViewProjMatrix;
+    };
+
+    // std140 layout of EnvironmentBlock, updated once per camera. mat3 columns are padded to vec4
+    struct EnvironmentUniformBlock
+    {
+        Vector4 SkyboxRotation[3];
+        float SkyboxIntensity;
+        float FogDistance;
+        float FogDensity;
+        float Padding0;
+        Vector3 FogColor;
+        float Padding1;
+    };
+
+    struct DirLightUniformData
+    {
+        Matrix4x4 Transform[3];
+        Vector4 Color;
+        Vector3 Direction;
+        float Padding;
+    };
+
+    // std140 layout of LightingBlock, updated once per frame
+    struct LightingUniformBlock
+    {
+        constexpr static size_t MaxDirLightCount = 4;
+
+        DirLightUniformData Lights[MaxDirLightCount];
+        int LightCount;
+        int Padding[3];
+    };
+
+    static_assert(sizeof(CameraUniformBlock) == 144, "CameraUniformBlock must match std140 layout");
+    static_assert(sizeof(EnvironmentUniformBlock) == 80, "EnvironmentUniformBlock must match std140 layout");
+    static_assert(sizeof(DirLightUniformData) == 224, "DirLightUniformData must match std140 layout");
+    static_assert(sizeof(LightingUniformBlock) == 912, "LightingUniformBlock must match std140 layout");
+
+    /*!
+    glsl declarations injected by ShaderPreprocessor for each "#uniform_block name" directive
+    */
+    inline constexpr ShaderBlockSource UniformBlockSources[] = {
+        { "camera", R"(
+layout(std140, binding = 0) uniform CameraBlock
+{
+    vec3 position;
+    float gamma;
+    mat4 viewProjMatrix;
+    mat4 invViewProjMatrix;
+} camera;
+)" },
+        { "environment", R"(
+layout(std140, binding = 1) uniform EnvironmentBlock
+{
+    mat3 skyboxRotation;
+    float skyboxIntensity;
+    float fogDistance;
+    float fogDensity;
+    vec3 fogColor;
+} environmentData;
+)" },
+        { "lighting", R"(
+const int DirLightCascadeMapCount = 3;
+const int MaxDirLightCount = 4;
+
+struct DirLight
+{
+    mat4 transform[DirLightCascadeMapCount];
+    vec4 color;
+    vec3 direction;
+};
+
+layout(std140, binding = 2) uniform LightingBlock
+{
+    DirLight lights[MaxDirLightCount];
+    int lightCount;
+} lighting;
+)" },
+    };
+}
@@ -0,0 +1,61 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "BufferBase.h"
+
+namespace MxEngine
+{
+    class UniformBuffer : public BufferBase
+    {
+    public:
+        template<typename T>
+        UniformBuffer(const T* data, size_t count, UsageType usage)
+        {
+            this->Load<T>(data, count, usage);
+        }
+
+        template<typename T>
+        void Load(const T* data, size_t count, UsageType usage)
+        {
+            BufferBase::Load(BufferType::UNIFORM, (const uint8_t*)data, count * sizeof(T), usage);
+        }
+
+        template<typename T>
+        void BufferSubData(const T* data, size_t count, size_t offsetCount = 0)
+        {
+            BufferBase::BufferSubData((const uint8_t*)data, count * sizeof(T), offsetCount * sizeof(T));
+        }
+
+        void BindBase(size_t index) const
+        {
+            BufferBase::BindBase(index);
+        }
+    };
+}
@@ -58,7 +58,8 @@ namespace MxEngine
         template<size_t N>
         array_view(std::array<T, N>& array);
         array_view(std::vector<T>& vec);
-        array_view(MxVector<T>& vec);
+        template<typename Allocator>
+        array_view(MxVector<T, Allocator>& vec);
         template<typename RandomIt>
         array_view(RandomIt begin, RandomIt end);
         size_t size() const;
@@ -103,7 +104,8 @@ namespace MxEngine
     }
 
     template<typename T>
-    inline array_view<T>::array_view(MxVector<T>& vec)
+    template<typename Allocator>
+    inline array_view<T>::array_view(MxVector<T, Allocator>& vec)
     {
         this->_data = vec.data();
         this->_size = vec.size();
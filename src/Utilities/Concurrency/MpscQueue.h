@@ -0,0 +1,160 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace MxEngine
+{
+    /*!
+    unbounded lock-free multiple producer / single consumer queue
+    any thread can push values, but only one thread (owner of the queue) can pop them. Push never blocks and performs exactly one allocation,
+    pop never allocates. Values are popped in the order their pushes were linearized
+    */
+    template<typename T>
+    class MpscQueue
+    {
+        struct Node
+        {
+            std::atomic<Node*> Next{ nullptr };
+            T Value;
+        };
+
+        /*!
+        last pushed node. Modified by producers
+        */
+        alignas(64) std::atomic<Node*> head;
+        /*!
+        first node which was not popped yet. Modified only by consumer
+        */
+        alignas(64) Node* tail;
+        /*!
+        approximate number of values in the queue
+        */
+        std::atomic<size_t> count{ 0 };
+        /*!
+        empty node which is kept in the queue, so producers never observe null head
+        */
+        Node stub;
+
+        void PushNode(Node* node)
+        {
+            node->Next.store(nullptr, std::memory_order_relaxed);
+            Node* previous = this->head.exchange(node, std::memory_order_acq_rel);
+            // between exchange and store list is temporary broken, consumer will see it as empty until producer links the node
+            previous->Next.store(node, std::memory_order_release);
+        }
+
+        Node* PopNode()
+        {
+            Node* current = this->tail;
+            Node* next = current->Next.load(std::memory_order_acquire);
+            if (current == &this->stub)
+            {
+                if (next == nullptr) return nullptr;
+                this->tail = next;
+                current = next;
+                next = next->Next.load(std::memory_order_acquire);
+            }
+            if (next != nullptr)
+            {
+                this->tail = next;
+                return current;
+            }
+            // current is the last node. It can be popped only after stub is pushed behind it
+            if (current != this->head.load(std::memory_order_acquire))
+                return nullptr;
+
+            this->PushNode(&this->stub);
+            next = current->Next.load(std::memory_order_acquire);
+            if (next != nullptr)
+            {
+                this->tail = next;
+                return current;
+            }
+            return nullptr;
+        }
+    public:
+        MpscQueue()
+            : head(&this->stub), tail(&this->stub) { }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue(MpscQueue&&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+        MpscQueue& operator=(MpscQueue&&) = delete;
+
+        ~MpscQueue()
+        {
+            T value;
+            while (this->TryPop(value));
+        }
+
+        /*!
+        pushes value to the queue. Can be called from any thread
+        \param value value to push
+        */
+        void Push(T value)
+        {
+            Node* node = new Node();
+            node->Value = std::move(value);
+            this->count.fetch_add(1, std::memory_order_relaxed);
+            this->PushNode(node);
+        }
+
+        /*!
+        pops first value from the queue. Must be called only from consumer thread
+        \param value reference where popped value is moved
+        \returns true if value was popped, false if queue is empty or producer has not finished its push yet
+        */
+        bool TryPop(T& value)
+        {
+            Node* node = this->PopNode();
+            if (node == nullptr) return false;
+
+            value = std::move(node->Value);
+            delete node;
+            this->count.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /*!
+        gets approximate number of values in the queue. Value may be outdated if producers are pushing concurrently
+        */
+        size_t Size() const
+        {
+            return this->count.load(std::memory_order_relaxed);
+        }
+
+        bool Empty() const
+        {
+            return this->Size() == 0;
+        }
+    };
+}
@@ -0,0 +1,174 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "ThreadPool.h"
+
+namespace MxEngine
+{
+    ThreadPool::ThreadPool(size_t threadCount)
+    {
+        // one worker is reserved for regular tasks if pool has more than one thread
+        this->maxBackgroundTasks = threadCount > 1 ? threadCount - 1 : 1;
+        this->workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; i++)
+        {
+            this->workers.emplace_back([this]() { this->WorkerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->isStopped = true;
+        }
+        this->condition.notify_all();
+
+        for (auto& worker : this->workers)
+        {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            Task task;
+            bool isBackgroundTask = false;
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->condition.wait(lock, [this]()
+                {
+                    return !this->tasks.empty() || this->CanStartBackgroundTask() ||
+                        (this->isStopped && this->backgroundTasks.empty());
+                });
+                if (this->tasks.empty() && this->backgroundTasks.empty()) return; // pool is stopped and all tasks are finished
+
+                // regular tasks are always preferred, as someone may wait for them right now
+                if (!this->tasks.empty())
+                {
+                    task = std::move(this->tasks.front());
+                    this->tasks.pop_front();
+                }
+                else
+                {
+                    task = std::move(this->backgroundTasks.front());
+                    this->backgroundTasks.pop_front();
+                    this->runningBackgroundTasks++;
+                    isBackgroundTask = true;
+                }
+            }
+            task();
+
+            if (isBackgroundTask)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(this->mutex);
+                    this->runningBackgroundTasks--;
+                }
+                // other worker may wait for background slot to be released
+                this->condition.notify_one();
+            }
+        }
+    }
+
+    bool ThreadPool::CanStartBackgroundTask() const
+    {
+        return !this->backgroundTasks.empty() && this->runningBackgroundTasks < this->maxBackgroundTasks;
+    }
+
+    size_t ThreadPool::GetThreadCount() const
+    {
+        return this->workers.size();
+    }
+
+    void ThreadPool::Submit(Task task)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->tasks.push_back(std::move(task));
+        }
+        this->condition.notify_one();
+    }
+
+    void ThreadPool::SubmitBackground(Task task)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->backgroundTasks.push_back(std::move(task));
+        }
+        this->condition.notify_one();
+    }
+
+    bool ThreadPool::TryExecutePending()
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            if (this->tasks.empty()) return false;
+
+            task = std::move(this->tasks.front());
+            this->tasks.pop_front();
+        }
+        task();
+        return true;
+    }
+
+    ThreadPool& ThreadPool::GetGlobal()
+    {
+        MX_ASSERT(ThreadPool::global != nullptr);
+        return *ThreadPool::global;
+    }
+
+    void ThreadPool::Init()
+    {
+        if (ThreadPool::global != nullptr) return;
+
+        // leave one hardware thread for the main thread, which also participates in ParallelFor
+        size_t hardwareThreads = (size_t)std::thread::hardware_concurrency();
+        size_t workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        ThreadPool::global = Alloc<ThreadPool>(workerCount);
+    }
+
+    void ThreadPool::Destroy()
+    {
+        Free(ThreadPool::global);
+        ThreadPool::global = nullptr;
+    }
+
+    ThreadPool* ThreadPool::GetImpl()
+    {
+        return ThreadPool::global;
+    }
+
+    void ThreadPool::Clone(ThreadPool* other)
+    {
+        ThreadPool::global = other;
+    }
+}
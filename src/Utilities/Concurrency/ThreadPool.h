@@ -0,0 +1,212 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/STL/MxFunction.h"
+#include "Utilities/Memory/Memory.h"
+
+namespace MxEngine
+{
+    /*!
+    thread pool is a fixed set of worker threads which execute submitted tasks in FIFO order
+    engine creates one global thread pool on startup, which is shared between all subsystems (rendering, asset loading and etc.)
+    long-running tasks (like asset decoding) go to separate background queue, which is served only by worker threads when no
+    regular tasks are pending. At least one worker is always left for regular tasks, so frame work is never stuck behind them
+    */
+    class ThreadPool
+    {
+    public:
+        using Task = MxFunction<void()>;
+    private:
+        /*!
+        global engine thread pool, created in ThreadPool::Init()
+        */
+        inline static ThreadPool* global = nullptr;
+        /*!
+        worker threads which wait for tasks until pool is destroyed
+        */
+        MxVector<std::thread> workers;
+        /*!
+        queue of pending tasks. Guarded by mutex
+        */
+        std::deque<Task> tasks;
+        /*!
+        queue of pending background tasks. Guarded by mutex
+        */
+        std::deque<Task> backgroundTasks;
+        /*!
+        number of background tasks which are currently executed by workers. Guarded by mutex
+        */
+        size_t runningBackgroundTasks = 0;
+        /*!
+        maximum number of background tasks executed at the same time
+        */
+        size_t maxBackgroundTasks = 0;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool isStopped = false;
+
+        /*!
+        main loop of each worker thread. Waits for tasks and executes them until pool is stopped
+        */
+        void WorkerLoop();
+        /*!
+        checks if worker can start background task. Must be called with mutex locked
+        */
+        bool CanStartBackgroundTask() const;
+    public:
+        /*!
+        creates thread pool with fixed count of worker threads
+        \param threadCount number of worker threads (caller thread is not counted)
+        */
+        explicit ThreadPool(size_t threadCount);
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+        /*!
+        finishes all pending tasks and joins worker threads
+        */
+        ~ThreadPool();
+
+        /*!
+        gets count of worker threads
+        \returns number of threads owned by the pool
+        */
+        size_t GetThreadCount() const;
+        /*!
+        enqueues task for asynchronous execution on one of the worker threads
+        \param task function to execute
+        */
+        void Submit(Task task);
+        /*!
+        enqueues long-running task which does not block anyone (i.e. asset decoding). Such tasks are executed only by worker threads
+        after regular tasks, and never by TryExecutePending(), so threads waiting for their own work never pick them up
+        \param task function to execute
+        */
+        void SubmitBackground(Task task);
+        /*!
+        executes one pending task on the calling thread if any exists. Background tasks are never executed by this method
+        \returns true if task was executed, false if task queue was empty
+        */
+        bool TryExecutePending();
+
+        /*!
+        splits work into chunks and executes them on worker threads and the calling thread. Blocks until all chunks are processed
+        calling thread only helps with chunks of this call, so ParallelFor can be safely nested inside tasks of the pool
+        \param chunkCount number of chunks to process. Each chunk index is passed to func exactly once
+        \param func function which accepts chunk index
+        \param maxThreads maximum number of threads used, including calling thread (0 means all worker threads + calling thread)
+        */
+        template<typename Func>
+        void ParallelFor(size_t chunkCount, Func&& func, size_t maxThreads = 0);
+        /*!
+        same as ParallelFor(), but calling thread first executes callerFunc after helper tasks are submitted and only then helps with chunks
+        used when some work must be done by calling thread (i.e. main thread) concurrently with chunks processed by workers
+        \param callerFunc function which is executed exactly once on the calling thread
+        */
+        template<typename Func, typename CallerFunc>
+        void ParallelFor(size_t chunkCount, Func&& func, size_t maxThreads, CallerFunc&& callerFunc);
+
+        /*!
+        computes number of chunks required to process elements with chunks of fixed size
+        \param elementCount total number of elements
+        \param chunkSize number of elements in one chunk
+        \returns number of chunks (last chunk may contain less elements)
+        */
+        static constexpr size_t GetChunkCount(size_t elementCount, size_t chunkSize)
+        {
+            return (elementCount + chunkSize - 1) / chunkSize;
+        }
+
+        static ThreadPool& GetGlobal();
+        static void Init();
+        static void Destroy();
+        static ThreadPool* GetImpl();
+        static void Clone(ThreadPool* other);
+    };
+
+    template<typename Func>
+    inline void ThreadPool::ParallelFor(size_t chunkCount, Func&& func, size_t maxThreads)
+    {
+        this->ParallelFor(chunkCount, std::forward<Func>(func), maxThreads, []() { });
+    }
+
+    template<typename Func, typename CallerFunc>
+    inline void ThreadPool::ParallelFor(size_t chunkCount, Func&& func, size_t maxThreads, CallerFunc&& callerFunc)
+    {
+        size_t threadCount = (maxThreads == 0) ? this->GetThreadCount() + 1 : maxThreads;
+        size_t helperCount = std::min(std::min(threadCount, this->GetThreadCount() + 1), chunkCount);
+        if (helperCount <= 1)
+        {
+            callerFunc();
+            for (size_t chunk = 0; chunk < chunkCount; chunk++)
+                func(chunk);
+            return;
+        }
+        helperCount--; // calling thread processes chunks too
+
+        // state is shared with helper tasks, as they may start after the caller already returned
+        struct ParallelForState
+        {
+            std::atomic<size_t> nextChunk{ 0 };
+            std::atomic<size_t> completedChunks{ 0 };
+        };
+        auto state = MakeRef<ParallelForState>();
+
+        // func is only invoked for chunks which are not yet completed, so reference to it never dangles
+        auto ProcessChunks = [state, chunkCount, &func]()
+        {
+            size_t chunk = 0;
+            while ((chunk = state->nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunkCount)
+            {
+                func(chunk);
+                state->completedChunks.fetch_add(1, std::memory_order_release);
+            }
+        };
+
+        for (size_t i = 0; i < helperCount; i++)
+            this->Submit(ProcessChunks);
+
+        callerFunc();
+        ProcessChunks();
+
+        // all chunks are claimed at this point, so only chunks which are already executed by other threads are waited.
+        // Unrelated pending tasks are not executed here, so nested calls never pick up unbounded amount of foreign work
+        while (state->completedChunks.load(std::memory_order_acquire) < chunkCount)
+            std::this_thread::yield();
+    }
+}
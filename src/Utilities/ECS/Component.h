@@ -29,6 +29,7 @@
 #pragma once
 
 #include "Utilities/ECS/ComponentFactory.h"
+#include "Utilities/ECS/ComponentUpdateInfo.h"
 
 namespace MxEngine
 {
@@ -39,27 +40,43 @@ namespace MxEngine
         using Deleter = void (*)(void*);
 
         std::aligned_storage_t<sizeof(Resource<char, ComponentFactory>)> resource;
-        size_t type;
+        size_t typeIndex;
         Deleter deleter;
 
         template<typename T>
-        Component(size_t type, Resource<T, ComponentFactory>&& component)
+        Component(size_t typeIndex, Resource<T, ComponentFactory>&& component)
         {
             static_assert(sizeof(Resource<T, ComponentFactory>) == sizeof(Component::resource), "storage must fit resource size");
 
-            this->type = type;
+            this->typeIndex = typeIndex;
             this->deleter = [](void* ptr) { ComponentFactory::Destroy(*std::launder(reinterpret_cast<Resource<T, ComponentFactory>*>(ptr))); };
             auto* replace = new (&resource) Resource<T, ComponentFactory>();
             *replace = std::move(component);
         }
     };
 
+    /*!
+    component manager owns components of a single object
+    components are kept sorted by type index, and ComponentMask tells which types are present, so lookup is O(1) without scanning
+    each component is also registered in ComponentFactory owner set of its type, which allows iterating objects by component types
+    */
     class ComponentManager
     {
         template<typename T>
         using ComponentList = MxVector<T>;
 
+        constexpr static size_t InvalidOwner = std::numeric_limits<size_t>::max();
+
         ComponentList<std::aligned_storage_t<sizeof(Component)>> components;
+        ComponentMask mask;
+        size_t owner = InvalidOwner;
+
+        template<typename T>
+        auto& GetResource(size_t position) const
+        {
+            const auto& componentRef = *std::launder(reinterpret_cast<const Component*>(&this->components[position]));
+            return *std::launder(reinterpret_cast<const Resource<T, ComponentFactory>*>(&componentRef.resource));
+        }
     public:
         ComponentManager() = default;
         ComponentManager(const ComponentManager&) = delete;
@@ -67,54 +84,67 @@ namespace MxEngine
         ComponentManager& operator=(const ComponentManager&) = delete;
         ComponentManager& operator=(ComponentManager&&) = default;
 
+        /*!
+        sets handle of object which owns components. Must be called before any component is added
+        \param owner handle of owner object
+        */
+        void SetOwner(size_t owner)
+        {
+            MX_ASSERT(this->components.empty());
+            this->owner = owner;
+        }
+
         template<typename T, typename... Args>
         auto AddComponent(Args&&... args)
         {
             this->RemoveComponent<T>();
             
+            size_t typeIndex = ComponentFactory::GetTypeIndex<T>();
             auto component = ComponentFactory::CreateComponent<T>(std::forward<Args>(args)...);
-            auto& data = components.emplace_back();
-            Component* result = new (&data) Component(T::ComponentId, std::move(component));
+            if (this->owner != InvalidOwner)
+                ComponentFactory::GetOwnerSet(typeIndex).Insert(this->owner, component.GetHandle());
+
+            size_t position = this->mask.CountBefore(typeIndex);
+            auto& data = *components.emplace(components.begin() + position);
+            Component* result = new (&data) Component(typeIndex, std::move(component));
+            this->mask.Set(typeIndex);
             return *std::launder(reinterpret_cast<Resource<T, ComponentFactory>*>(&result->resource));
         }
 
         template<typename T>
         auto GetComponent() const
         {
-            for (const auto& component : components)
-            {
-                const auto& componentRef = *reinterpret_cast<const Component*>(&component);
-                if (componentRef.type == T::ComponentId)
-                {
-                    return *std::launder(reinterpret_cast<const Resource<T, ComponentFactory>*>(&componentRef.resource));
-                }
-            }
-            return Resource<T, ComponentFactory>{ };
+            size_t typeIndex = ComponentFactory::GetTypeIndex<T>();
+            if (!this->mask.Test(typeIndex))
+                return Resource<T, ComponentFactory>{ };
+
+            return this->GetResource<T>(this->mask.CountBefore(typeIndex));
         }
 
         template<typename T>
         void RemoveComponent()
         {
-            for (auto it = components.begin(); it != components.end(); it++)
+            size_t typeIndex = ComponentFactory::GetTypeIndex<T>();
+            if (!this->mask.Test(typeIndex)) return;
+
+            auto it = components.begin() + this->mask.CountBefore(typeIndex);
+            auto& componentRef = *std::launder(reinterpret_cast<Component*>(&*it));
+            auto& resource = *std::launder(reinterpret_cast<Resource<T, ComponentFactory>*>(&componentRef.resource));
+            if (resource.IsValid())
             {
-                auto& componentRef = *reinterpret_cast<Component*>(&*it);
-                if (componentRef.type == T::ComponentId)
-                {
-                    auto& resource = *std::launder(reinterpret_cast<Resource<T, ComponentFactory>*>(&componentRef.resource));
-                    if (resource.IsValid())
-                    {
-                        ComponentFactory::Destroy(resource);
-                    }
-                    components.erase(it);
-                    return;
-                }
+                ComponentFactory::Destroy(resource);
             }
+            components.erase(it);
+            this->mask.Reset(typeIndex);
+            if (this->owner != InvalidOwner)
+                ComponentFactory::GetOwnerSet(typeIndex).Erase(this->owner);
         }
 
         template<typename T>
         bool HasComponent() const
         {
-            return this->GetComponent<T>().IsValid();
+            size_t typeIndex = ComponentFactory::GetTypeIndex<T>();
+            return this->mask.Test(typeIndex) && this->GetResource<T>(this->mask.CountBefore(typeIndex)).IsValid();
         }
 
         void RemoveAllComponents()
@@ -123,8 +153,11 @@ namespace MxEngine
             {
                 auto& componentRef = *std::launder(reinterpret_cast<Component*>(&component));
                 componentRef.deleter(static_cast<void*>(&componentRef.resource));
+                if (this->owner != InvalidOwner)
+                    ComponentFactory::GetOwnerSet(componentRef.typeIndex).Erase(this->owner);
             }
             components.clear();
+            this->mask.Clear();
         }
 
         ~ComponentManager()
@@ -32,41 +32,152 @@
 #include "Utilities/String/String.h"
 #include "Utilities/Factory/Factory.h"
 #include "Utilities/ECS/ComponentView.h"
+#include "Utilities/ECS/ComponentSparseSet.h"
+#include "Utilities/Memory/Memory.h"
+
+#include <mutex>
 
 namespace MxEngine
 {
     class ComponentFactory
     {
-        static constexpr size_t VectorPoolSize = sizeof(VectorPool<char>);
+        static constexpr size_t VectorPoolSize = sizeof(ComponentPool<char>);
     public:
-        using PoolMap = MxHashMap<StringId, std::aligned_storage_t<VectorPoolSize>>;
+        /*!
+        type-erased component pool with function to compact it, as pools are stored in one map regardless of component type
+        */
+        struct PoolStorage
+        {
+            std::aligned_storage_t<VectorPoolSize> Pool;
+            bool (*CompactIfFragmented)(void*) = nullptr;
+        };
+        using PoolMap = MxHashMap<StringId, PoolStorage>;
+
+        struct ComponentFactoryImpl
+        {
+            PoolMap Pools;
+            /*!
+            dense index of each component type, used as bit index in ComponentMask
+            */
+            MxHashMap<StringId, size_t> TypeIndices;
+            /*!
+            owner sets of each component type, indexed by type index
+            */
+            MxVector<UniqueRef<ComponentSparseSet>> OwnerSets;
+            std::mutex TypeMutex;
+        };
     private:
-        inline static PoolMap* pools = nullptr;
+        inline static ComponentFactoryImpl* impl = nullptr;
     public:
         template<typename T>
         static auto& GetPool()
         {
-            if (pools->find(T::ComponentId) == pools->end())
+            auto& pools = impl->Pools;
+            if (pools.find(T::ComponentId) == pools.end())
             {
-                 (void)new(&(*pools)[T::ComponentId]) VectorPool<ManagedResource<T>>();
+                auto& storage = pools[T::ComponentId];
+                (void)new(&storage.Pool) ComponentPool<T>();
+                storage.CompactIfFragmented = [](void* pool) { return reinterpret_cast<ComponentPool<T>*>(pool)->CompactIfFragmented(); };
             }
-            auto pool = std::launder(reinterpret_cast<VectorPool<ManagedResource<T>>*>(&(*pools)[T::ComponentId]));
+            auto pool = std::launder(reinterpret_cast<ComponentPool<T>*>(&pools[T::ComponentId].Pool));
             return *pool;
         }
 
+        /*!
+        compacts component pools which have too many holes after components were destroyed
+        must not be called while iterating over components, as they are relocated in memory
+        \returns number of compacted pools
+        */
+        static size_t CompactPools()
+        {
+            size_t compacted = 0;
+            for (auto& [componentId, storage] : impl->Pools)
+            {
+                if (storage.CompactIfFragmented(&storage.Pool))
+                    compacted++;
+            }
+            return compacted;
+        }
+
+        /*!
+        gets dense index of component type, registering type on first call
+        \returns index in range [0, ComponentMask::MaxTypeCount)
+        */
+        template<typename T>
+        static size_t GetTypeIndex()
+        {
+            // index is cached per thread and module, but validated against current impl, as it may be replaced by Clone() or Init()
+            static thread_local const ComponentFactoryImpl* cachedImpl = nullptr;
+            static thread_local size_t cachedIndex = 0;
+            if (cachedImpl == impl) return cachedIndex;
+
+            // components may be first requested from worker threads (i.e. during parallel render submission)
+            std::lock_guard lock(impl->TypeMutex);
+            auto it = impl->TypeIndices.find(T::ComponentId);
+            if (it == impl->TypeIndices.end())
+            {
+                MX_ASSERT(impl->OwnerSets.size() < ComponentMask::MaxTypeCount);
+                it = impl->TypeIndices.insert({ T::ComponentId, impl->OwnerSets.size() }).first;
+                impl->OwnerSets.push_back(MakeUnique<ComponentSparseSet>());
+            }
+            cachedImpl = impl;
+            cachedIndex = it->second;
+            return cachedIndex;
+        }
+
+        /*!
+        gets set of objects which own component with specified type index
+        */
+        static ComponentSparseSet& GetOwnerSet(size_t typeIndex)
+        {
+            return *impl->OwnerSets[typeIndex];
+        }
+
+        template<typename T>
+        static ComponentSparseSet& GetOwnerSet()
+        {
+            return GetOwnerSet(GetTypeIndex<T>());
+        }
+
+        /*!
+        records owner of component in journal of its type, see ComponentSparseSet::EnableJournal()
+        components which are not attached to object yet are skipped, as they are recorded when attached
+        */
         template<typename T>
-        static ComponentView<T> GetView()
+        static void MarkChanged(const T& component)
+        {
+            auto owner = reinterpret_cast<uintptr_t>(component.UserData);
+            if (owner == std::numeric_limits<uintptr_t>::max()) return;
+            GetOwnerSet<T>().MarkChanged((size_t)owner);
+        }
+
+        template<typename T>
+        static ComponentView<T, ComponentPool<T>> GetView()
+        {
+            return ComponentView<T, ComponentPool<T>>{ GetPool<T>() };
+        }
+
+        /*!
+        creates view over objects which own all of requested components
+        \returns view which yields std::tuple<T&, U&, Ts&...> for each object
+        */
+        template<typename T, typename U, typename... Ts>
+        static MultiComponentView<T, U, Ts...> GetView()
         {
-            return ComponentView{ GetPool<T>() };
+            return MultiComponentView<T, U, Ts...>(
+                typename MultiComponentView<T, U, Ts...>::Pools{ GetPool<T>(), GetPool<U>(), GetPool<Ts>()... },
+                { &GetOwnerSet<T>(), &GetOwnerSet<U>(), &GetOwnerSet<Ts>()... }
+            );
         }
 
         template<typename T, typename... Args>
         static auto CreateComponent(Args&&... args)
         {
-            UUID uuid = UUIDGenerator::Get();
             auto& pool = GetPool<T>();
-            size_t index = pool.Allocate(uuid, std::forward<Args>(args)...);
-            return Resource<T, ComponentFactory>(uuid, index);
+            size_t index = pool.Allocate(ResourceIdGenerator::GetNull(), std::forward<Args>(args)...);
+            ResourceId id = ResourceIdGenerator::Get(pool, index);
+            pool[index].id = id;
+            return Resource<T, ComponentFactory>(id, index);
         }
 
         template<typename T>
@@ -77,22 +188,22 @@ namespace MxEngine
 
         static void Init()
         {
-            pools = new PoolMap();
+            impl = new ComponentFactoryImpl();
         }
 
-        static PoolMap* GetImpl()
+        static ComponentFactoryImpl* GetImpl()
         {
-            return pools;
+            return impl;
         }
 
-        static void Clone(PoolMap* other)
+        static void Clone(ComponentFactoryImpl* other)
         {
-            pools = other;
+            impl = other;
         }
 
         static void Destroy()
         {
-            delete pools;
+            delete impl;
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include "Utilities/STL/MxVector.h"
+#include "Core/Macro/Macro.h"
+
+#include <array>
+#include <bitset>
+#include <limits>
+#include <mutex>
+
+namespace MxEngine
+{
+    /*!
+    component mask stores which component types are attached to an object. Each bit corresponds to component type index
+    components of an object are stored in order of their type indices, so position of component is a number of bits set before its type bit
+    */
+    class ComponentMask
+    {
+    public:
+        constexpr static size_t MaxTypeCount = 128;
+    private:
+        constexpr static size_t WordSize = 64;
+        std::array<uint64_t, MaxTypeCount / WordSize> words{ };
+    public:
+        bool Test(size_t typeIndex) const
+        {
+            return (this->words[typeIndex / WordSize] >> (typeIndex % WordSize)) & 1;
+        }
+
+        void Set(size_t typeIndex)
+        {
+            this->words[typeIndex / WordSize] |= uint64_t(1) << (typeIndex % WordSize);
+        }
+
+        void Reset(size_t typeIndex)
+        {
+            this->words[typeIndex / WordSize] &= ~(uint64_t(1) << (typeIndex % WordSize));
+        }
+
+        void Clear()
+        {
+            this->words.fill(0);
+        }
+
+        /*!
+        counts components with type index less than passed one
+        \param typeIndex component type index
+        \returns position of component with typeIndex in sorted component list
+        */
+        size_t CountBefore(size_t typeIndex) const
+        {
+            size_t result = 0;
+            size_t word = typeIndex / WordSize;
+            for (size_t i = 0; i < word; i++)
+                result += std::bitset<WordSize>(this->words[i]).count();
+
+            uint64_t lowerBits = (uint64_t(1) << (typeIndex % WordSize)) - 1;
+            result += std::bitset<WordSize>(this->words[word] & lowerBits).count();
+            return result;
+        }
+    };
+
+    /*!
+    component sparse set maps object handles to components of one type and keeps list of owners densely packed
+    it allows O(1) check if object owns component and iteration over all owners without touching objects which do not have it
+    set can also keep journal of owners which component was added, removed or changed, so systems caching component data can update only them
+    */
+    class ComponentSparseSet
+    {
+    public:
+        constexpr static size_t InvalidIndex = std::numeric_limits<size_t>::max();
+    private:
+        /*!
+        dense index of each object handle, InvalidIndex if object has no component
+        */
+        MxVector<size_t> sparse;
+        /*!
+        object handles which own component, densely packed
+        */
+        MxVector<size_t> owners;
+        /*!
+        component pool index for each owner in dense array
+        */
+        MxVector<size_t> components;
+        /*!
+        owners changed since last ConsumeJournal() call. Journal flag is indexed by object handle, so each owner is stored once
+        */
+        MxVector<uint8_t> journalFlags;
+        MxVector<size_t> journal;
+        std::mutex journalMutex;
+        bool isJournalEnabled = false;
+    public:
+        /*!
+        adds component of object to the set. Object must not be in the set already
+        \param owner object handle
+        \param component index of component in ComponentFactory pool
+        */
+        void Insert(size_t owner, size_t component)
+        {
+            if (owner >= this->sparse.size())
+                this->sparse.resize(owner + 1, InvalidIndex);
+
+            MX_ASSERT(this->sparse[owner] == InvalidIndex);
+            this->sparse[owner] = this->owners.size();
+            this->owners.push_back(owner);
+            this->components.push_back(component);
+            this->MarkChanged(owner);
+        }
+
+        /*!
+        removes object from the set by swapping it with last dense element
+        \param owner object handle
+        */
+        void Erase(size_t owner)
+        {
+            if (!this->Contains(owner)) return;
+
+            size_t index = this->sparse[owner];
+            size_t last = this->owners.size() - 1;
+            this->owners[index] = this->owners[last];
+            this->components[index] = this->components[last];
+            this->sparse[this->owners[index]] = index;
+
+            this->owners.pop_back();
+            this->components.pop_back();
+            this->sparse[owner] = InvalidIndex;
+            this->MarkChanged(owner);
+        }
+
+        bool Contains(size_t owner) const
+        {
+            return owner < this->sparse.size() && this->sparse[owner] != InvalidIndex;
+        }
+
+        /*!
+        finds component of object
+        \param owner object handle
+        \returns index of component in ComponentFactory pool or InvalidIndex if object has no component
+        */
+        size_t Find(size_t owner) const
+        {
+            return this->Contains(owner) ? this->components[this->sparse[owner]] : InvalidIndex;
+        }
+
+        size_t Size() const
+        {
+            return this->owners.size();
+        }
+
+        const MxVector<size_t>& GetOwners() const
+        {
+            return this->owners;
+        }
+
+        const MxVector<size_t>& GetComponents() const
+        {
+            return this->components;
+        }
+
+        /*!
+        enables journal of changed owners. Journal is disabled by default, so component types nobody listens to are not tracked
+        */
+        void EnableJournal()
+        {
+            this->isJournalEnabled = true;
+        }
+
+        /*!
+        records owner in journal if it is enabled. Components may be changed from worker threads, so journal is guarded by mutex
+        \param owner object handle
+        */
+        void MarkChanged(size_t owner)
+        {
+            if (!this->isJournalEnabled) return;
+
+            std::lock_guard lock(this->journalMutex);
+            if (owner >= this->journalFlags.size())
+                this->journalFlags.resize(owner + 1, 0);
+
+            if (this->journalFlags[owner] == 0)
+            {
+                this->journalFlags[owner] = 1;
+                this->journal.push_back(owner);
+            }
+        }
+
+        /*!
+        moves owners recorded since last call to result. Owners may not own component anymore, so caller must check them with Contains()
+        \param result vector where owner handles are stored. It is cleared before owners are added
+        */
+        void ConsumeJournal(MxVector<size_t>& result)
+        {
+            std::lock_guard lock(this->journalMutex);
+            result.clear();
+            std::swap(result, this->journal);
+            for (size_t owner : result)
+                this->journalFlags[owner] = 0;
+        }
+    };
+}
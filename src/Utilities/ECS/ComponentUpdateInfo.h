@@ -0,0 +1,101 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace MxEngine
+{
+    /*!
+    engine state which is accessed by components in OnUpdate(). Used to find component types which can be updated concurrently
+    state of the component itself is not listed, as each component type is updated by only one task
+    */
+    struct UpdateAccess
+    {
+        enum Bits : uint32_t
+        {
+            NONE = 0,
+            TRANSFORM = 1 << 0, // MxObject::LocalTransform
+            PHYSICS = 1 << 1, // rigid bodies, colliders and physics world
+            AUDIO = 1 << 2, // audio players and listener
+            CAMERA = 1 << 3, // camera controllers and viewport
+            RENDERING = 1 << 4, // graphic API state and GPU buffers
+            OBJECTS = 1 << 5, // creation and destruction of objects or components
+            ALL = 0xFFFFFFFF,
+        };
+    };
+
+    using UpdateAccessMask = uint32_t;
+
+    /*!
+    describes which engine state component reads and writes during OnUpdate() and how its update can be scheduled
+    default values describe component which may access anything, so it is updated serially on main thread
+    */
+    struct ComponentUpdateInfo
+    {
+        UpdateAccessMask Reads = UpdateAccess::ALL;
+        UpdateAccessMask Writes = UpdateAccess::ALL;
+        /*!
+        if set, OnUpdate() of different components of this type may be called concurrently, so large views are split between threads
+        */
+        bool IsThreadSafe = false;
+        /*!
+        if set, components of this type are always updated by main thread (i.e. they use graphic API)
+        */
+        bool RequiresMainThread = true;
+
+        /*!
+        checks if updates of two component types must not be executed concurrently
+        \param other update info of other component type
+        \returns true if one of component types writes state accessed by the other one
+        */
+        constexpr bool ConflictsWith(const ComponentUpdateInfo& other) const
+        {
+            return (this->Writes & (other.Reads | other.Writes)) != 0 || (other.Writes & this->Reads) != 0;
+        }
+    };
+
+    /*!
+    update info of component type. Components declare it as `constexpr static ComponentUpdateInfo UpdateInfo`
+    or it can be specialized for types which cannot be modified
+    */
+    template<typename T, typename = void>
+    struct ComponentUpdateTraits
+    {
+        constexpr static ComponentUpdateInfo Info{ };
+    };
+
+    template<typename T>
+    struct ComponentUpdateTraits<T, std::void_t<decltype(T::UpdateInfo)>>
+    {
+        constexpr static ComponentUpdateInfo Info = T::UpdateInfo;
+    };
+}
@@ -29,19 +29,29 @@
 #pragma once
 
 #include "Utilities/Factory/Factory.h"
+#include "Utilities/ECS/ComponentSparseSet.h"
+#include "Utilities/VectorPool/CompactVectorPool.h"
+
+#include <tuple>
 
 namespace MxEngine
 {
+    /*!
+    components are stored densely packed, so iteration over them does not walk through destroyed components
+    */
+    template<typename T>
+    using ComponentPool = CompactVectorPool<ManagedResource<T>>;
+
     /*!
     component view class is used as a wrapper for vector Pool container.
     It was created because vector Pool contains ManagedResource<T> objects,
     but we want to see only T when iterating over components in a Pool
     */
-    template<typename T>
+    template<typename T, typename PoolType = VectorPool<ManagedResource<T>>>
     class ComponentView
     {
     public:
-        using Pool = VectorPool<ManagedResource<T>>;
+        using Pool = PoolType;
 
         /*!
         wrapper around vector Pool iterator. Actually does nothing more than forwards all methods to wrapped iterator
@@ -206,4 +216,142 @@ namespace MxEngine
             return ComponentIterator{ ref.end() };
         }
     };
+
+    /*!
+    multi component view iterates over objects which own all requested component types at once
+    iteration walks owners of the smallest component set and skips objects which miss any other component,
+    so its cost is proportional to the rarest component, not to total object count
+    component sets must not be modified (components added or removed) while view is iterated
+    */
+    template<typename... Ts>
+    class MultiComponentView
+    {
+    public:
+        constexpr static size_t TypeCount = sizeof...(Ts);
+        using Pools = std::tuple<ComponentPool<Ts>&...>;
+        using Sets = std::array<const ComponentSparseSet*, TypeCount>;
+
+        /*!
+        iterator over dense owner list of the smallest set. Dereferences into tuple of component references
+        */
+        class MultiComponentIterator
+        {
+            size_t index;
+            const MultiComponentView* view;
+
+            /*!
+            skips owners which do not have all requested components
+            */
+            void SkipMissing()
+            {
+                const auto& owners = this->view->GetSmallestSet().GetOwners();
+                while (this->index < owners.size() && !this->view->ContainsAll(owners[this->index]))
+                    this->index++;
+            }
+
+            template<size_t... I>
+            std::tuple<Ts&...> Dereference(std::index_sequence<I...>) const
+            {
+                size_t owner = this->GetOwner();
+                return std::tuple<Ts&...>(std::get<I>(this->view->pools)[this->view->FindComponent(I, owner)].value...);
+            }
+        public:
+            MultiComponentIterator(size_t index, const MultiComponentView& view)
+                : index(index), view(&view)
+            {
+                this->SkipMissing();
+            }
+
+            /*!
+            getter for object handle which owns current components
+            \returns object handle (see MxObject::GetByHandle)
+            */
+            size_t GetOwner() const
+            {
+                return this->view->GetSmallestSet().GetOwners()[this->index];
+            }
+
+            MultiComponentIterator operator++(int)
+            {
+                MultiComponentIterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            MultiComponentIterator operator++()
+            {
+                this->index++;
+                this->SkipMissing();
+                return *this;
+            }
+
+            /*!
+            getter for components of current object
+            \returns tuple of references in order of view template arguments
+            */
+            std::tuple<Ts&...> operator*() const
+            {
+                return this->Dereference(std::index_sequence_for<Ts...>{ });
+            }
+
+            bool operator==(const MultiComponentIterator& other) const
+            {
+                return this->index == other.index;
+            }
+
+            bool operator!=(const MultiComponentIterator& other) const
+            {
+                return this->index != other.index;
+            }
+        };
+    private:
+        Pools pools;
+        Sets sets;
+        size_t smallestSet = 0;
+
+        const ComponentSparseSet& GetSmallestSet() const
+        {
+            return *this->sets[this->smallestSet];
+        }
+
+        bool ContainsAll(size_t owner) const
+        {
+            for (size_t i = 0; i < TypeCount; i++)
+            {
+                if (i != this->smallestSet && !this->sets[i]->Contains(owner))
+                    return false;
+            }
+            return true;
+        }
+
+        size_t FindComponent(size_t setIndex, size_t owner) const
+        {
+            return this->sets[setIndex]->Find(owner);
+        }
+    public:
+        /*!
+        constructs view over component pools
+        \param pools component pools of each type
+        \param sets owner sets of each type, in the same order as pools
+        */
+        MultiComponentView(Pools pools, const Sets& sets)
+            : pools(pools), sets(sets)
+        {
+            for (size_t i = 1; i < TypeCount; i++)
+            {
+                if (this->sets[i]->Size() < this->sets[this->smallestSet]->Size())
+                    this->smallestSet = i;
+            }
+        }
+
+        MultiComponentIterator begin() const
+        {
+            return MultiComponentIterator{ 0, *this };
+        }
+
+        MultiComponentIterator end() const
+        {
+            return MultiComponentIterator{ this->GetSmallestSet().Size(), *this };
+        }
+    };
 }
\ No newline at end of file
@@ -30,14 +30,170 @@
 
 #include <functional>
 #include <algorithm>
+#include <chrono>
 
 #include "Utilities/Profiler/Profiler.h"
 #include "Utilities/Memory/Memory.h"
 #include "Utilities/STL/MxHashMap.h"
 #include "Utilities/STL/MxVector.h"
+#include "Utilities/STL/MxFunction.h"
+#include "Utilities/Concurrency/MpscQueue.h"
 
 namespace MxEngine
 {
+    /*!
+    handle of event listener. Higher 32 bits store event type of listener, lower 32 bits store listener id
+    */
+    using EventListenerHandle = uint64_t;
+
+    /*!
+    base class of event channels. Channel owns all listeners and all queued events of one event type
+    */
+    template<typename EventBase>
+    class EventChannelBase
+    {
+    public:
+        virtual ~EventChannelBase() = default;
+        /*!
+        immediately invokes all listeners of channel. Event must have type of channel
+        */
+        virtual void InvokeBase(EventBase& event) = 0;
+        /*!
+        invokes all listeners with event from dispatch queue
+        \param index index of event returned by AddEvent() before queues were swapped
+        */
+        virtual void InvokeQueued(size_t index) = 0;
+        /*!
+        moves queued events to dispatch queue. Events which are added later are stored separately, so dispatched events are never relocated
+        */
+        virtual void SwapQueues() = 0;
+        /*!
+        removes listeners marked as removed and activates listeners added since last flush
+        */
+        virtual void FlushListeners() = 0;
+        virtual bool RemoveListener(uint32_t id) = 0;
+        virtual bool HasListener(uint32_t id) const = 0;
+    };
+
+    /*!
+    event channel stores events of one type in contiguous arrays, which are reused between frames. Listeners are identified by integer id,
+    so dispatch performs no string comparisons and no allocations once arrays reached their peak size
+    */
+    template<typename EventBase, typename EventType>
+    class EventChannel : public EventChannelBase<EventBase>
+    {
+        struct Listener
+        {
+            MxFunction<void(EventType&)> Callback;
+            uint32_t Id;
+            bool IsRemoved;
+        };
+
+        MxVector<Listener> listeners;
+        /*!
+        listeners which will be added on next flush. Exists to prevent crushes when user adds new listener inside other listener callback
+        */
+        MxVector<Listener> pendingListeners;
+        MxVector<EventType> queuedEvents;
+        MxVector<EventType> dispatchedEvents;
+        /*!
+        name of event type, used as profiler scope name
+        */
+        const char* name;
+        bool hasRemovedListeners = false;
+
+        static bool RemoveFromList(MxVector<Listener>& list, uint32_t id)
+        {
+            for (auto& listener : list)
+            {
+                if (listener.Id == id && !listener.IsRemoved)
+                {
+                    listener.IsRemoved = true;
+                    return true;
+                }
+            }
+            return false;
+        }
+    public:
+        explicit EventChannel(const char* name) : name(name) { }
+
+        void AddListener(uint32_t id, MxFunction<void(EventType&)>&& callback)
+        {
+            this->pendingListeners.push_back(Listener{ std::move(callback), id, false });
+        }
+
+        template<typename... Args>
+        size_t AddEvent(Args&&... args)
+        {
+            this->queuedEvents.emplace_back(std::forward<Args>(args)...);
+            return this->queuedEvents.size() - 1;
+        }
+
+        void Invoke(EventType& event)
+        {
+            MAKE_SCOPE_PROFILER(this->name);
+            // listeners removed inside callbacks are only marked, so list is never modified during dispatch
+            for (const auto& listener : this->listeners)
+            {
+                if (!listener.IsRemoved)
+                    listener.Callback(event);
+            }
+        }
+
+        virtual void InvokeBase(EventBase& event) override
+        {
+            this->Invoke(static_cast<EventType&>(event));
+        }
+
+        virtual void InvokeQueued(size_t index) override
+        {
+            this->Invoke(this->dispatchedEvents[index]);
+        }
+
+        virtual void SwapQueues() override
+        {
+            this->dispatchedEvents.clear();
+            std::swap(this->queuedEvents, this->dispatchedEvents);
+        }
+
+        virtual void FlushListeners() override
+        {
+            if (this->hasRemovedListeners)
+            {
+                auto it = std::remove_if(this->listeners.begin(), this->listeners.end(), [](const Listener& listener)
+                {
+                    return listener.IsRemoved;
+                });
+                this->listeners.erase(it, this->listeners.end());
+                this->hasRemovedListeners = false;
+            }
+
+            for (auto& listener : this->pendingListeners)
+            {
+                if (!listener.IsRemoved)
+                    this->listeners.push_back(std::move(listener));
+            }
+            this->pendingListeners.clear();
+        }
+
+        virtual bool RemoveListener(uint32_t id) override
+        {
+            if (RemoveFromList(this->listeners, id))
+            {
+                this->hasRemovedListeners = true;
+                return true;
+            }
+            return RemoveFromList(this->pendingListeners, id);
+        }
+
+        virtual bool HasListener(uint32_t id) const override
+        {
+            auto isSame = [id](const Listener& listener) { return listener.Id == id && !listener.IsRemoved; };
+            return std::any_of(this->listeners.begin(), this->listeners.end(), isSame) ||
+                   std::any_of(this->pendingListeners.begin(), this->pendingListeners.end(), isSame);
+        }
+    };
+
     /*!
     EventDispatcher class is used to handle all events inside MxEngine. Events can either be dispatch for Application (global) or
     for currently active scene. Note that events are NOT dispatched when developer console is opened and instead sheduled until it close
@@ -45,111 +201,180 @@ namespace MxEngine
     template<typename EventBase>
     class EventDispatcherImpl
     {
-        using CallbackBaseFunction = std::function<void(EventBase&)>;
-        using NamedCallback = std::pair<MxString, CallbackBaseFunction>;
-        using CallbackList = MxVector<NamedCallback>;
-        using EventList = MxVector<UniqueRef<EventBase>>;
         using EventTypeIndex = uint32_t;
+        using ChannelBase = EventChannelBase<EventBase>;
+
+        struct QueuedEvent
+        {
+            /*!
+            channel which stores event or nullptr if event was added as UniqueRef<EventBase>
+            */
+            ChannelBase* Channel;
+            size_t Index;
+        };
 
         /*!
-        list of scheduled all events
+        maps event id to channel with listeners and events of that id
         */
-        EventList events;
+        MxHashMap<EventTypeIndex, UniqueRef<ChannelBase>> channels;
         /*!
-        maps event id to list of event listeners of that id 
+        list of all scheduled events in the order they were added
         */
-        MxHashMap<EventTypeIndex, CallbackList> callbacks;
+        MxVector<QueuedEvent> queuedEvents;
+        MxVector<QueuedEvent> dispatchedEvents;
         /*!
-        schedules listeners which will be added next frame. 
-        This cache exists to prevent crushes when user wants to add new listener inside other listener callback.
+        events which were added through type-erased AddEvent() overload
         */
-        MxHashMap<EventTypeIndex, CallbackList> toAddCache;
+        MxVector<UniqueRef<EventBase>> queuedDynamicEvents;
+        MxVector<UniqueRef<EventBase>> dispatchedDynamicEvents;
         /*!
-        shedules listeners which will be removed next frame. 
-        This cache exists to prevent crushes when user wants to remove event listener inside other listener callback (or even perform self-removal).
+        events posted from any thread. Drained to event queue by InvokeAll() on main thread
         */
-        MxVector<MxString> toRemoveCache;
-
+        MpscQueue<UniqueRef<EventBase>> postedEvents;
         /*!
-        immediately invokes all listeners of event, if any exists
-        \param event event to dispatch
+        maximum time in milliseconds spent on draining posted events per InvokeAll() call
+        */
+        float postedEventsTimeLimit = 2.0f;
+        /*!
+        maximum number of posted events drained per InvokeAll() call
         */
-        inline void ProcessEvent(EventBase& event)
+        size_t postedEventsCountLimit = 4096;
+        /*!
+        maps listener names to their handles. Used only when listeners are added or removed by name
+        */
+        MxHashMap<MxString, MxVector<EventListenerHandle>> namedListeners;
+        /*!
+        maps handles of named listeners to their names, so listener removed by handle is also removed from its name bucket
+        */
+        MxHashMap<EventListenerHandle, MxString> listenerNames;
+        uint32_t lastListenerId = 0;
+        /*!
+        number of nested dispatches. Listener lists are not flushed until all dispatches are finished
+        */
+        size_t dispatchDepth = 0;
+
+        template<typename EventType>
+        EventChannel<EventBase, EventType>& GetChannel()
+        {
+            auto& channel = this->channels[EventType::eventType];
+            if (channel == nullptr)
+                channel = MakeUnique<EventChannel<EventBase, EventType>>(EventType::eventName);
+            return static_cast<EventChannel<EventBase, EventType>&>(*channel);
+        }
+
+        ChannelBase* FindChannel(EventTypeIndex eventType)
         {
-            MAKE_SCOPE_PROFILER(typeid(event).name());
-            auto& eventCallbacks = this->callbacks[event.GetEventType()];
-            for (const auto& [name, callback] : eventCallbacks)
+            auto it = this->channels.find(eventType);
+            return it != this->channels.end() ? it->second.get() : nullptr;
+        }
+
+        static EventListenerHandle MakeListenerHandle(EventTypeIndex eventType, uint32_t id)
+        {
+            return ((EventListenerHandle)eventType << 32) | (EventListenerHandle)id;
+        }
+
+        void AddListenerName(const MxString& name, EventListenerHandle handle)
+        {
+            this->namedListeners[name].push_back(handle);
+            this->listenerNames[handle] = name;
+        }
+
+        void RemoveListenerName(EventListenerHandle handle)
+        {
+            auto name = this->listenerNames.find(handle);
+            if (name == this->listenerNames.end()) return;
+
+            auto bucket = this->namedListeners.find(name->second);
+            if (bucket != this->namedListeners.end())
             {
-                if (std::find(this->toRemoveCache.begin(), this->toRemoveCache.end(), name) == this->toRemoveCache.end())
+                auto& handles = bucket->second;
+                auto it = std::find(handles.begin(), handles.end(), handle);
+                if (it != handles.end())
                 {
-                    callback(event);
+                    *it = handles.back();
+                    handles.pop_back();
                 }
+                if (handles.empty()) this->namedListeners.erase(bucket);
             }
+            this->listenerNames.erase(name);
         }
 
-        /*!
-        adds new listener callback to cache queue
-        \param name callback name (used for removal)
-        \param func callback functor
-        */
-        template<typename EventType>
-        inline void AddCallbackImpl(MxString name, CallbackBaseFunction&& func)
+        void RemoveChannelListener(EventListenerHandle handle)
         {
-            this->toAddCache[EventType::eventType].emplace_back(std::move(name), std::move(func));
+            auto* channel = this->FindChannel(EventTypeIndex(handle >> 32));
+            if (channel != nullptr) channel->RemoveListener(uint32_t(handle));
         }
 
-        /*!
-        immediately removes all listeners with same name from list
-        \param callbacks list of listeners callbacks
-        \param name name of listeners to search for
-        */
-        inline void RemoveEventByName(CallbackList& callbacks, const MxString& name)
+        void DispatchQueuedEvent(const QueuedEvent& queued)
         {
-            auto it = std::remove_if(callbacks.begin(), callbacks.end(), [&name](const auto& p)
+            if (queued.Channel != nullptr)
             {
-                return p.first == name;
-            });
-            callbacks.erase(it, callbacks.end());
+                queued.Channel->InvokeQueued(queued.Index);
+            }
+            else
+            {
+                auto& event = *this->dispatchedDynamicEvents[queued.Index];
+                auto* channel = this->FindChannel(event.GetEventType());
+                if (channel != nullptr) channel->InvokeBase(event);
+            }
         }
 
         /*!
-        wraps event listener into callback with base event as argument. Actual type is retrieved inside callback
-        \param name name of listener to add
-        \param func listener callback function
+        moves events posted from other threads to event queue. Stops when time or count limit is reached, rest of events stay for next call
         */
-        template<typename EventType>
-        void AddEventListenerImpl(const MxString& name, std::function<void(EventType&)> func)
+        void DrainPostedEvents()
         {
-            this->template AddCallbackImpl<EventType>(name, [func = std::move(func)](EventBase& e)
+            if (this->postedEvents.Empty()) return;
+            MAKE_SCOPE_PROFILER("EventDispatcher::DrainPostedEvents");
+
+            // checking clock is more expensive than moving one event, so time limit is checked in small batches
+            constexpr size_t TimeCheckPeriod = 32;
+            using Clock = std::chrono::steady_clock;
+            auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<float, std::milli>(this->postedEventsTimeLimit));
+
+            UniqueRef<EventBase> event;
+            for (size_t drained = 0; drained < this->postedEventsCountLimit; drained++)
             {
-                if (e.GetEventType() == EventType::eventType)
-                    func(static_cast<EventType&>(e));
-            });
+                if (drained % TimeCheckPeriod == TimeCheckPeriod - 1 && Clock::now() > deadline)
+                    break;
+                if (!this->postedEvents.TryPop(event))
+                    break;
+                this->AddEvent(std::move(event));
+            }
+        }
+
+        void SwapQueues()
+        {
+            this->dispatchedEvents.clear();
+            std::swap(this->queuedEvents, this->dispatchedEvents);
+            this->dispatchedDynamicEvents.clear();
+            std::swap(this->queuedDynamicEvents, this->dispatchedDynamicEvents);
+            for (auto& [eventType, channel] : this->channels)
+                channel->SwapQueues();
         }
     public:
         /*!
-        performs cache update, removing events from toRemoveCache list and adding events from toAddCache list
+        performs cache update, removing listeners which were marked as removed and adding new listeners
         */
         inline void FlushEvents()
         {
-            for (auto it = this->toRemoveCache.begin(); it != this->toRemoveCache.end(); it++)
-            {
-                for (auto& [event, callbacks] : this->callbacks)
-                {
-                    RemoveEventByName(callbacks, *it);
-                }
-            }
-            this->toRemoveCache.clear();
+            if (this->dispatchDepth != 0) return;
+            for (auto& [eventType, channel] : this->channels)
+                channel->FlushListeners();
+        }
 
-            for (auto it = this->toAddCache.begin(); it != this->toAddCache.end(); it++)
-            {
-                auto& [event, funcs] = *it;
-                for (auto& func : funcs)
-                {
-                    callbacks[event].push_back(std::move(func));
-                }
-            }
-            for (auto& list : this->toAddCache) list.second.clear();
+        /*!
+        adds new event listener to dispatcher
+        \param func listener callback functor
+        \returns handle which can be used to remove listener
+        */
+        template<typename EventType>
+        EventListenerHandle AddEventListener(MxFunction<void(EventType&)> func)
+        {
+            uint32_t id = ++this->lastListenerId;
+            this->GetChannel<EventType>().AddListener(id, std::move(func));
+            return MakeListenerHandle(EventType::eventType, id);
         }
 
         /*!
@@ -157,11 +382,14 @@ namespace MxEngine
         Note that multiple listeners may have same name. If so, deleting by name will result in removing all of them
         \param name name of listener (used for deleting listener)
         \param func listener callback functor
+        \returns handle which can be used to remove listener
         */
         template<typename EventType>
-        void AddEventListener(const MxString& name, std::function<void(EventType&)> func)
+        EventListenerHandle AddEventListener(const MxString& name, std::function<void(EventType&)> func)
         {
-            this->AddEventListenerImpl(name, std::move(func));
+            auto handle = this->AddEventListener<EventType>(MxFunction<void(EventType&)>{ std::move(func) });
+            this->AddListenerName(name, handle);
+            return handle;
         }
 
         /*!
@@ -169,11 +397,24 @@ namespace MxEngine
         Note that multiple listeners may have same name. If so, deleting by name will result in removing all of them
         \param name name of listener (used for deleting listener)
         \param func listener callback functor
+        \returns handle which can be used to remove listener
         */
         template<typename T, typename FunctionType>
-        void AddEventListener(const MxString& name, FunctionType&& func)
+        EventListenerHandle AddEventListener(const MxString& name, FunctionType&& func)
+        {
+            auto handle = this->AddEventListener<T>(MxFunction<void(T&)>{ std::forward<FunctionType>(func) });
+            this->AddListenerName(name, handle);
+            return handle;
+        }
+
+        /*!
+        removes event listener by its handle. Listener is not invoked after this call, even if it is removed inside other listener
+        \param handle handle returned by AddEventListener()
+        */
+        void RemoveEventListener(EventListenerHandle handle)
         {
-            this->AddEventListenerImpl(name, std::function<void(T&)>{ std::forward<FunctionType>(func) });
+            this->RemoveChannelListener(handle);
+            this->RemoveListenerName(handle);
         }
 
         /*!
@@ -182,14 +423,17 @@ namespace MxEngine
         */
         void RemoveEventListener(const MxString& name)
         {
-            this->toRemoveCache.push_back(name);
-            
-            for (auto& [event, callbacks] : this->toAddCache)
+            auto it = this->namedListeners.find(name);
+            if (it == this->namedListeners.end()) return;
+
+            for (auto handle : it->second)
             {
-                RemoveEventByName(callbacks, name);
+                this->RemoveChannelListener(handle);
+                this->listenerNames.erase(handle);
             }
+            this->namedListeners.erase(it);
         }
-        
+
         /*!
         Immediately invokes event of specific type
         \param event event to dispatch
@@ -198,7 +442,29 @@ namespace MxEngine
         void Invoke(Event& event)
         {
             this->FlushEvents();
-            this->ProcessEvent(event);
+            this->dispatchDepth++;
+            if constexpr (std::is_same_v<Event, EventBase>)
+            {
+                auto* channel = this->FindChannel(event.GetEventType());
+                if (channel != nullptr) channel->InvokeBase(event);
+            }
+            else
+            {
+                this->GetChannel<Event>().Invoke(event);
+            }
+            this->dispatchDepth--;
+        }
+
+        /*!
+        Adds event to event queue. Event is constructed in storage of its channel, so no allocation is performed
+        \param args arguments passed to event constructor
+        */
+        template<typename EventType, typename... Args>
+        void AddEvent(Args&&... args)
+        {
+            auto& channel = this->GetChannel<EventType>();
+            size_t index = channel.AddEvent(std::forward<Args>(args)...);
+            this->queuedEvents.push_back(QueuedEvent{ &channel, index });
         }
 
         /*!
@@ -207,21 +473,78 @@ namespace MxEngine
         */
         void AddEvent(UniqueRef<EventBase> event)
         {
-            this->events.push_back(std::move(event));
+            this->queuedEvents.push_back(QueuedEvent{ nullptr, this->queuedDynamicEvents.size() });
+            this->queuedDynamicEvents.push_back(std::move(event));
+        }
+
+        /*!
+        Adds event to thread-safe event queue. Can be called from any thread. Event will be dispatched on main thread by next InvokeAll() call,
+        after all events which were added with AddEvent() before that call
+        \param event event to shedule dispatch
+        */
+        void PostEvent(UniqueRef<EventBase> event)
+        {
+            this->postedEvents.Push(std::move(event));
+        }
+
+        /*!
+        Constructs event and adds it to thread-safe event queue. Can be called from any thread
+        \param args arguments passed to event constructor
+        */
+        template<typename EventType, typename... Args>
+        void PostEvent(Args&&... args)
+        {
+            this->PostEvent(MakeUnique<EventType>(std::forward<Args>(args)...));
         }
 
         /*!
-        Invokes all shedules events in the order they were added
+        sets limits of posted events processing per InvokeAll() call. Events which do not fit into limits are dispatched in the next calls
+        \param timeLimit maximum time in milliseconds spent on moving posted events to event queue
+        \param countLimit maximum number of posted events moved to event queue
+        */
+        void SetPostedEventsLimit(float timeLimit, size_t countLimit)
+        {
+            this->postedEventsTimeLimit = timeLimit;
+            this->postedEventsCountLimit = countLimit;
+        }
+
+        /*!
+        gets approximate number of events posted from other threads which are waiting for dispatch
+        */
+        size_t GetPostedEventsCount() const
+        {
+            return this->postedEvents.Size();
+        }
+
+        /*!
+        Invokes all shedules events in the order they were added. Events added by listeners are dispatched in the same call
+        Events posted from other threads are dispatched after them, limited by SetPostedEventsLimit()
         */
         void InvokeAll()
         {
+            if (this->dispatchDepth != 0) return;
             this->FlushEvents();
+            this->DrainPostedEvents();
 
-            for (size_t i = 0; i < this->events.size(); i++)
+            this->dispatchDepth++;
+            while (!this->queuedEvents.empty())
             {
-                this->ProcessEvent(*this->events[i]);
+                this->SwapQueues();
+                for (const auto& queued : this->dispatchedEvents)
+                    this->DispatchQueuedEvent(queued);
             }
-            this->events.clear();
+            this->dispatchDepth--;
+        }
+
+        /*!
+        Checks if event listener is present
+        \param handle handle of event listener
+        \returns true if event listener present, false otherwise
+        */
+        bool HasEventListener(EventListenerHandle handle) const
+        {
+            auto it = this->channels.find(EventTypeIndex(handle >> 32));
+            return it != this->channels.end() && it->second->HasListener(uint32_t(handle));
         }
 
         /*!
@@ -229,18 +552,15 @@ namespace MxEngine
         \param name name of event
         \returns true if event listener present, false otherwise
         */
-        bool HasEventListenerWithName(const MxString& name) 
+        bool HasEventListenerWithName(const MxString& name) const
         {
-            this->FlushEvents();
-            for (const auto& [event, callbacks] : this->callbacks)
+            auto it = this->namedListeners.find(name);
+            if (it == this->namedListeners.end()) return false;
+
+            return std::any_of(it->second.begin(), it->second.end(), [this](EventListenerHandle handle)
             {
-                for (const auto& [callbackName, func] : callbacks)
-                {
-                    if (callbackName == name)
-                        return true;
-                }
-            }
-            return false;
+                return this->HasEventListener(handle);
+            });
         }
     };
 }
\ No newline at end of file
@@ -37,10 +37,12 @@ namespace MxEngine
 
     /*
     inserted into class body of derived classes from base event. Using compile-time hash from class name to generate type id
+    class name is also kept as event name, which is used as profiler scope name of event dispatch
     */
     #define MAKE_EVENT(class_name) \
     template<typename T> friend class MxEngine::EventDispatcherImpl;\
     public: inline virtual uint32_t GetEventType() const override { return eventType; } private:\
+    constexpr static const char* eventName = #class_name;\
     constexpr static uint32_t eventType = STRING_ID(#class_name)
 
     template<typename EventBase>
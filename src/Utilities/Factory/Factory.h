@@ -33,36 +33,91 @@
 
 namespace MxEngine
 {
+    #if defined(MXENGINE_COMPACT_HANDLES)
+    /*!
+    in compact handle mode resources are identified by 32-bit pool index and 32-bit generation of pool slot,
+    so resource handle takes 8 bytes and validity check is a single integer compare
+    */
+    using ResourceId = uint32_t;
+    using ResourceIndex = uint32_t;
+    #else
+    using ResourceId = UUID;
+    using ResourceIndex = size_t;
+    #endif
+
+    /*!
+    generates ids for newly created resources. By default ids are random UUIDs, in compact handle mode - generations of pool slots
+    */
+    struct ResourceIdGenerator
+    {
+        template<typename Pool>
+        static ResourceId Get(const Pool& pool, size_t index)
+        {
+            #if defined(MXENGINE_COMPACT_HANDLES)
+            return pool.GetGeneration(index);
+            #else
+            (void)pool; (void)index;
+            return UUIDGenerator::Get();
+            #endif
+        }
+
+        static ResourceId GetNull()
+        {
+            #if defined(MXENGINE_COMPACT_HANDLES)
+            return 0;
+            #else
+            return UUIDGenerator::GetNull();
+            #endif
+        }
+    };
+
     template<typename T>
     struct ManagedResource
     {
-        UUID uuid;
+        ResourceId id;
         T value;
         size_t refCount = 0;
 
+        /*!
+        offset of value field, used to get managed resource from its value
+        */
+        constexpr static size_t ValueOffset = (sizeof(ResourceId) + alignof(T) - 1) / alignof(T) * alignof(T);
+
         template<typename... Args>
-        ManagedResource(const UUID& uuid, Args&&... value)
-            : uuid(uuid), value(std::forward<Args>(value)...) { }
+        ManagedResource(const ResourceId& id, Args&&... value)
+            : id(id), value(std::forward<Args>(value)...) { }
 
         ManagedResource(const ManagedResource&) = delete;
         ManagedResource(ManagedResource&&) noexcept(std::is_nothrow_move_constructible_v<T>) = default;
         ManagedResource& operator=(const ManagedResource&) = delete;
         ManagedResource& operator=(ManagedResource&&) noexcept(std::is_nothrow_move_assignable_v<T>) = default;
 
-        ~ManagedResource() { this->uuid = UUIDGenerator::GetNull(); }
+        ~ManagedResource() { this->id = ResourceIdGenerator::GetNull(); }
+    };
+
+    #if defined(MXENGINE_PROFILING_ENABLED)
+    /*!
+    counts IncRef() and DecRef() calls made by current thread on valid handles of resource type T
+    used to measure refcount traffic, counter is thread local, so it does not add contention between threads
+    */
+    template<typename T>
+    struct ResourceRefCounter
+    {
+        inline static thread_local size_t Operations = 0;
     };
+    #endif
 
     template<typename T, typename F>
     class Resource
     {
-        UUID uuid;
-        size_t handle;
+        ResourceId id;
+        ResourceIndex handle;
 
         #if defined(MXENGINE_DEBUG)
         mutable ManagedResource<T>* _resourcePtr = nullptr;
         #endif
 
-        static constexpr size_t InvalidHandle = std::numeric_limits<size_t>::max();
+        static constexpr ResourceIndex InvalidHandle = std::numeric_limits<ResourceIndex>::max();
 
         void IncRef();
         void DecRef();
@@ -74,7 +129,7 @@ namespace MxEngine
         using Factory = F;
 
         Resource();
-        Resource(UUID uuid, size_t handle);
+        Resource(ResourceId id, size_t handle);
         Resource(const Resource& wrapper);
         Resource& operator=(const Resource& wrapper);
         Resource(Resource&& wrapper) noexcept;
@@ -89,7 +144,7 @@ namespace MxEngine
         [[nodiscard]] T* GetUnchecked();
         [[nodiscard]] const T* GetUnchecked() const;
         [[nodiscard]] size_t GetHandle() const;
-        [[nodiscard]] const UUID& GetUUID() const;
+        [[nodiscard]] const ResourceId& GetUUID() const;
         [[nodiscard]] bool operator==(const Resource& wrapper) const;
         [[nodiscard]] bool operator!=(const Resource& wrapper) const;
         [[nodiscard]] bool operator<(const Resource& wrapper) const;
@@ -126,9 +181,11 @@ namespace MxEngine
         template<typename... Args>
         [[nodiscard]] static Resource<T, typename Factory<T>::ThisType> Create(Args&&... args)
         {
-            UUID uuid = UUIDGenerator::Get();
-            size_t index = Factory<T>::GetPool().Allocate(uuid, std::forward<Args>(args)...);
-            return Resource<T, ThisType>(uuid, index);
+            auto& pool = Factory<T>::GetPool();
+            size_t index = pool.Allocate(ResourceIdGenerator::GetNull(), std::forward<Args>(args)...);
+            ResourceId id = ResourceIdGenerator::Get(pool, index);
+            pool[index].id = id;
+            return Resource<T, ThisType>(id, index);
         }
     };
 
@@ -36,7 +36,12 @@ namespace MxEngine
     void Resource<T, F>::IncRef()
     {
         if (this->IsValid())
+        {
             ++this->Dereference().refCount;
+            #if defined(MXENGINE_PROFILING_ENABLED)
+            ResourceRefCounter<T>::Operations++;
+            #endif
+        }
     }
 
     template<typename T, typename F>
@@ -45,6 +50,9 @@ namespace MxEngine
         if (this->IsValid())
         {
             auto& resource = this->Dereference();
+            #if defined(MXENGINE_PROFILING_ENABLED)
+            ResourceRefCounter<T>::Operations++;
+            #endif
             if ((--resource.refCount) == 0)
                 DestroyThis(*this);
         }
@@ -76,18 +84,18 @@ namespace MxEngine
 
     template<typename T, typename F>
     Resource<T, F>::Resource()
-        : uuid(UUIDGenerator::GetNull()), handle(Resource<T, F>::InvalidHandle) { }
+        : id(ResourceIdGenerator::GetNull()), handle(Resource<T, F>::InvalidHandle) { }
 
     template<typename T, typename F>
-    Resource<T, F>::Resource(UUID uuid, size_t handle)
-        : uuid(uuid), handle(handle)
+    Resource<T, F>::Resource(ResourceId id, size_t handle)
+        : id(id), handle((ResourceIndex)handle)
     {
         this->IncRef();
     }
 
     template<typename T, typename F>
     Resource<T, F>::Resource(const Resource<T, F>& wrapper)
-        : uuid(wrapper.uuid), handle(wrapper.handle)
+        : id(wrapper.id), handle(wrapper.handle)
     {
         this->IncRef();
         #if defined(MXENGINE_DEBUG)
@@ -104,7 +112,7 @@ namespace MxEngine
         this->_resourcePtr = wrapper._resourcePtr;
         #endif
 
-        this->uuid = wrapper.uuid;
+        this->id = wrapper.id;
         this->handle = wrapper.handle;
         this->IncRef();
 
@@ -113,7 +121,7 @@ namespace MxEngine
 
     template<typename T, typename F>
     Resource<T, F>::Resource(Resource<T, F>&& wrapper) noexcept
-        : uuid(wrapper.uuid), handle(wrapper.handle)
+        : id(wrapper.id), handle(wrapper.handle)
     {
         #if defined(MXENGINE_DEBUG)
         this->_resourcePtr = wrapper._resourcePtr;
@@ -126,7 +134,7 @@ namespace MxEngine
     Resource<T, F>& Resource<T, F>::operator=(Resource<T, F>&& wrapper) noexcept
     {
         this->DecRef();
-        this->uuid = wrapper.uuid;
+        this->id = wrapper.id;
         this->handle = wrapper.handle;
         wrapper.handle = InvalidHandle;
 
@@ -140,7 +148,13 @@ namespace MxEngine
     template<typename T, typename F>
     [[nodiscard]] bool Resource<T, F>::IsValid() const
     {
-        return handle != InvalidHandle && Dereference().uuid == uuid;
+        #if defined(MXENGINE_COMPACT_HANDLES)
+        // slot generation changes when resource is destroyed, so it is enough to validate handle without accessing slot itself
+        return handle != InvalidHandle && F::template GetPool<T>().GetGeneration(this->handle) == id;
+        #else
+        // stale handle may point to destroyed or already released slot, so pool is checked before slot is accessed
+        return handle != InvalidHandle && F::template GetPool<T>().IsAllocated(this->handle) && Dereference().id == id;
+        #endif
     }
 
     template<typename T, typename F>
@@ -198,15 +212,15 @@ namespace MxEngine
     }
 
     template<typename T, typename F>
-    [[nodiscard]] const UUID& Resource<T, F>::GetUUID() const
+    [[nodiscard]] const ResourceId& Resource<T, F>::GetUUID() const
     {
-        return this->uuid;
+        return this->id;
     }
 
     template<typename T, typename F>
     [[nodiscard]] bool Resource<T, F>::operator==(const Resource<T, F>& wrapper) const
     {
-        return this->handle == wrapper.handle && this->uuid == wrapper.uuid;
+        return this->handle == wrapper.handle && this->id == wrapper.id;
     }
 
     template<typename T, typename F>
@@ -218,7 +232,7 @@ namespace MxEngine
     template<typename T, typename F>
     [[nodiscard]] bool Resource<T, F>::operator<(const Resource<T, F>& wrapper) const
     {
-        return (this->handle != wrapper.handle) ? (this->handle < wrapper.handle) : (this->uuid < wrapper.uuid);
+        return (this->handle != wrapper.handle) ? (this->handle < wrapper.handle) : (this->id < wrapper.id);
     }
 
     template<typename T, typename F>
@@ -283,14 +297,14 @@ namespace MxEngine
     {
         auto& pool = Factory<T>::GetPool();
         size_t index = pool.IndexOf(object);
-        return Resource<T, ThisType>(pool[index].uuid, index);
+        return Resource<T, ThisType>(pool[index].id, index);
     }
     
     template<typename T>
     [[nodiscard]] Resource<T, typename Factory<T>::ThisType> Factory<T>::GetHandle(const T& object)
     {
         auto ptr = (const uint8_t*)std::addressof(object);
-        auto resourcePtr = (const ManagedResource<T>*)(ptr - sizeof(UUID));
+        auto resourcePtr = (const ManagedResource<T>*)(ptr - ManagedResource<T>::ValueOffset);
         return Factory<T>::GetHandle(*resourcePtr);
     }
     
@@ -30,6 +30,9 @@
 #include "Utilities/Logging/Logger.h"
 
 #include <map>
+#include <atomic>
+#include <random>
+#include <string>
 
 namespace MxEngine
 {
@@ -182,6 +185,15 @@ namespace MxEngine
         return std::filesystem::is_directory(path);
     }
 
+    FilePath File::GetTemporaryPath(const FilePath& path)
+    {
+        // each writer gets its own file, so concurrent writers in one or several processes never write to the same file
+        static const uint64_t processSalt = std::random_device{ }();
+        static std::atomic<uint64_t> writerCounter{ 0 };
+        auto suffix = "." + std::to_string(processSalt) + "." + std::to_string(writerCounter++) + ".tmp";
+        return path.native() + FilePath(suffix).native();
+    }
+
     FileSystemTime File::LastModifiedTime(const FilePath& path)
     {
         if (!File::Exists(path))
@@ -235,6 +235,12 @@ namespace MxEngine
         \returns platform-dependent time point of last file modification
         */
         static FileSystemTime LastModifiedTime(const char* path);
+        /*!
+        generates unique path near the file, which can be written and then renamed to replace the file atomically
+        \param path path to a file which will be replaced
+        \returns path which is not shared with other writers of this or any other process
+        */
+        static FilePath GetTemporaryPath(const FilePath& path);
         /*
         creates directory is it is not exist
         \param path path to directory
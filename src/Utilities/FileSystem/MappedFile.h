@@ -0,0 +1,75 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/FileSystem/File.h"
+
+#include <cstdint>
+
+namespace MxEngine
+{
+    /*!
+    MappedFile is a read-only view of file contents mapped into process memory. Pages are loaded by OS on first access,
+    so large binary files can be consumed directly without copying them into intermediate buffers
+    */
+    class MappedFile
+    {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        /*!
+        platform-specific handles of file and its mapping (unused on POSIX systems)
+        */
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+
+        void Unmap();
+    public:
+        MappedFile() = default;
+        /*!
+        maps whole file into memory
+        \param path path to a file
+        */
+        explicit MappedFile(const FilePath& path);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        ~MappedFile();
+
+        /*!
+        maps new file into memory, previous file is unmapped automatically
+        \param path path to a file
+        \returns true if file was mapped, false if it does not exist, is empty or cannot be opened
+        */
+        bool Open(const FilePath& path);
+        bool IsOpen() const;
+        const uint8_t* GetData() const;
+        size_t GetSize() const;
+    };
+}
@@ -29,8 +29,10 @@
 #pragma once
 
 #include "Utilities/STL/MxString.h"
+#include "Utilities/Memory/FrameArena.h"
 #undef char8_t
 #include <fmt/format.h>
+#include <iterator>
 
 namespace MxEngine
 {
@@ -51,6 +53,21 @@ namespace MxEngine
     {
         return MxString { Format(formatStr, std::forward<Args>(args)...).c_str() };
     }
+
+    /*!
+    formats string into frame arena. Short strings are formatted on stack, so no heap allocations are performed
+    resulting string is valid until the end of next frame and can be used only on main thread
+    \param formatStr formatting string
+    \param args variadic argument list
+    \returns formatted string object
+    */
+    template<typename S, typename... Args, typename Char = fmt::char_t<S>>
+    inline FrameString FrameFormat(const S& formatStr, Args&&... args)
+    {
+        fmt::basic_memory_buffer<Char> buffer;
+        fmt::format_to(std::back_inserter(buffer), formatStr, std::forward<Args>(args)...);
+        return FrameString(buffer.data(), buffer.data() + buffer.size());
+    }
 }
 
 template <>
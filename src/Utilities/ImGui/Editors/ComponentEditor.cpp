@@ -133,7 +133,7 @@ namespace MxEngine::GUI
     rttr::variant Edit(const char* name, MxString val, const ReflectionMeta& meta)
     {
         static MxString text;
-        bool edited = GUI::InputTextOnClick(MxFormat("{}: {}", name, val).c_str(), text, 128);
+        bool edited = GUI::InputTextOnClick(FrameFormat("{}: {}", name, val).c_str(), text, 128);
         return edited ? rttr::variant{ text } : rttr::variant{ };
     }
 
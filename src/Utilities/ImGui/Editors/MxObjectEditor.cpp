@@ -46,7 +46,7 @@ namespace MxEngine::GUI
             auto object = MxObject::Create();
             object->Name = ToMxString(ToFilePath(filepath).stem());
             auto meshSource = object->AddComponent<MeshSource>(AssetManager::LoadMesh(filepath));
-            auto meshRenderer = object->AddComponent<MeshRenderer>(AssetManager::LoadMaterials(meshSource->Mesh->GetFilePath()));
+            auto meshRenderer = object->AddComponent<MeshRenderer>(AssetManager::LoadMaterials(meshSource->GetMesh()->GetFilePath()));
         }
     }
 
@@ -60,8 +60,8 @@ namespace MxEngine::GUI
     {
         AABB aabb;
         auto meshSource = (IsInstance(object) ? *GetInstanceParent(object) : object).GetComponent<MeshSource>();
-        if (meshSource.IsValid() && meshSource->Mesh.IsValid())
-            aabb = meshSource->Mesh->MeshAABB;
+        if (meshSource.IsValid() && meshSource->GetMesh().IsValid())
+            aabb = meshSource->GetMesh()->MeshAABB;
         else
             aabb = { MakeVector3(-0.5f), MakeVector3(0.5f) };
 
@@ -30,6 +30,7 @@
 #include "Utilities/ImGui/ImGuiBase.h"
 #include "Core/Application/Event.h"
 #include "Core/Events/FpsUpdateEvent.h"
+#include "Utilities/Profiler/FrameStatistics.h"
 
 namespace MxEngine::GUI
 {
@@ -48,4 +49,30 @@ namespace MxEngine::GUI
         ImGui::PlotLines("", fpsData.data(), (int)fpsData.size(), 0, name,
             FLT_MAX, FLT_MAX, { ImGui::GetWindowWidth() - 15.0f, (float)ProfilerGraphRecordSize + 15.0f });
     }
+
+    void DrawFrameStatistics(const char* name)
+    {
+        static ImGuiTextFilter filter;
+        filter.Draw(name);
+
+        ImGui::Columns(5, name);
+        ImGui::Text("scope"); ImGui::NextColumn();
+        ImGui::Text("p50, ms"); ImGui::NextColumn();
+        ImGui::Text("p95, ms"); ImGui::NextColumn();
+        ImGui::Text("p99, ms"); ImGui::NextColumn();
+        ImGui::Text("max, ms"); ImGui::NextColumn();
+        ImGui::Separator();
+
+        for (const auto& statistics : FrameStatistics::GetAllStatistics())
+        {
+            if (!filter.PassFilter(statistics.Name)) continue;
+
+            ImGui::Text("%s", statistics.Name); ImGui::NextColumn();
+            ImGui::Text("%.3f", statistics.P50); ImGui::NextColumn();
+            ImGui::Text("%.3f", statistics.P95); ImGui::NextColumn();
+            ImGui::Text("%.3f", statistics.P99); ImGui::NextColumn();
+            ImGui::Text("%.3f", statistics.Max); ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+    }
 }
\ No newline at end of file
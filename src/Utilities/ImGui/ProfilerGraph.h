@@ -35,4 +35,10 @@ namespace MxEngine::GUI
     \param name drawn graph discription name
     */
     void DrawProfiler(const char* name);
+
+    /*!
+    draws table with p50/p95/p99/max execution time of profiled scopes over last frames
+    \param name drawn table discription name
+    */
+    void DrawFrameStatistics(const char* name);
 }
\ No newline at end of file
@@ -46,7 +46,7 @@ namespace MxEngine::GUI
             Vector2 newWindowSize = ImGui::GetWindowSize();
             if (newWindowSize != viewportSize) // notify application that viewport size has been changed
             {
-                Event::AddEvent(MakeUnique<WindowResizeEvent>(viewportSize, newWindowSize));
+                Event::AddEvent<WindowResizeEvent>(viewportSize, newWindowSize);
                 viewportSize = newWindowSize;
             }
             viewportPosition = (newWindowSize - viewportSize) * 0.5f;
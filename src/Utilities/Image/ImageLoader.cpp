@@ -43,7 +43,7 @@ namespace MxEngine
         MAKE_SCOPE_TIMER("MxEngine::ImageLoader", "ImageLoader::LoadImage()");
         MXLOG_INFO("MxEngine::ImageLoader", "loading image from file: " + ToMxString(filepath));
 
-        stbi_set_flip_vertically_on_load(flipImage);
+        stbi_set_flip_vertically_on_load_thread(flipImage);
         int width, height, channels;
         uint8_t* data = stbi_load(filepath.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
         if (data == nullptr) { width = height = 0; }
@@ -57,7 +57,7 @@ namespace MxEngine
         MAKE_SCOPE_TIMER("MxEngine::ImageLoader", "ImageLoader::LoadImage()");
         MXLOG_INFO("MxEngine::ImageLoader", "loading image from memory");
 
-        stbi_set_flip_vertically_on_load(flipImage);
+        stbi_set_flip_vertically_on_load_thread(flipImage);
         int width, height, channels;
         uint8_t* data = stbi_load_from_memory(memory, (int)byteSize, &width, &height, &channels, STBI_rgb_alpha);
         if (data == nullptr) { width = height = 0; }
@@ -217,6 +217,16 @@ namespace MxEngine
         return glm::eulerAngles(q);
     }
 
+    /*!
+    extracts euler angles (in radians) from quaternion. Unlike MakeEulerAngles(), uses same rotation order as MakeRotationMatrix()
+    */
+    inline Vector3 MakeRotationAngles(const Quaternion& q)
+    {
+        Vector3 angles;
+        glm::extractEulerAngleYXZ(glm::toMat4(q), angles.y, angles.x, angles.z);
+        return angles;
+    }
+
     inline Quaternion Lerp(const Quaternion& q1, const Quaternion& q2, float a)
     {
         return glm::lerp(q1, q2, a);
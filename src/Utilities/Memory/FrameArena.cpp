@@ -0,0 +1,155 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "FrameArena.h"
+#include "Utilities/Profiler/Profiler.h"
+
+#include <algorithm>
+
+namespace MxEngine
+{
+    FrameArena::FrameArena(size_t blockSize)
+        : ownerThread(std::this_thread::get_id())
+    {
+        for (auto& region : this->regions)
+            this->AddBlock(region, blockSize);
+        this->blockAllocations = 0;
+    }
+
+    void FrameArena::AddBlock(Region& region, size_t bytes)
+    {
+        region.FilledBytes += region.Allocator.GetUsedBytes();
+        region.Blocks.push_back(UniqueRef<uint8_t[]>(new uint8_t[bytes]));
+        region.Allocator.Init(region.Blocks.back().get(), bytes);
+        region.Capacity += bytes;
+        this->blockAllocations++;
+    }
+
+    void* FrameArena::Allocate(size_t bytes, size_t align)
+    {
+        MX_ASSERT(std::this_thread::get_id() == this->ownerThread);
+        auto& region = this->regions[this->currentRegion];
+
+        if (this->isHeapFallbackEnabled)
+        {
+            auto& memory = region.FallbackAllocations.emplace_back(new uint8_t[bytes + align]);
+            uintptr_t address = (uintptr_t)memory.get();
+            return (void*)((address + align - 1) & ~(uintptr_t)(align - 1));
+        }
+
+        void* result = region.Allocator.TryRawAlloc(bytes, align);
+        if (result == nullptr)
+        {
+            // region will be merged into a single block on reset, so growth happens only while frame size increases
+            size_t blockSize = std::max(region.Allocator.GetSize() * 2, bytes + align);
+            this->AddBlock(region, blockSize);
+            result = region.Allocator.RawAlloc(bytes, align);
+        }
+        return result;
+    }
+
+    void FrameArena::NextFrame()
+    {
+        MX_ASSERT(std::this_thread::get_id() == this->ownerThread);
+        this->lastFrameUsedBytes = this->GetUsedBytes();
+        this->lastFrameBlockAllocations = this->blockAllocations;
+        this->blockAllocations = 0;
+
+        this->currentRegion = (this->currentRegion + 1) % this->regions.size();
+        auto& region = this->regions[this->currentRegion];
+        if (region.Blocks.size() > 1)
+        {
+            MAKE_SCOPE_PROFILER("FrameArena::MergeBlocks()");
+            size_t capacity = region.Capacity;
+            region = Region{ };
+            this->AddBlock(region, capacity);
+        }
+        region.Allocator.Reset();
+        region.FilledBytes = 0;
+        region.FallbackAllocations.clear();
+    }
+
+    size_t FrameArena::GetUsedBytes() const
+    {
+        const auto& region = this->regions[this->currentRegion];
+        return region.FilledBytes + region.Allocator.GetUsedBytes();
+    }
+
+    size_t FrameArena::GetLastFrameUsedBytes() const
+    {
+        return this->lastFrameUsedBytes;
+    }
+
+    size_t FrameArena::GetLastFrameBlockAllocations() const
+    {
+        return this->lastFrameBlockAllocations;
+    }
+
+    size_t FrameArena::GetCapacity() const
+    {
+        return this->regions[0].Capacity + this->regions[1].Capacity;
+    }
+
+    void FrameArena::SetHeapFallback(bool value)
+    {
+        this->isHeapFallbackEnabled = value;
+    }
+
+    bool FrameArena::IsHeapFallbackEnabled() const
+    {
+        return this->isHeapFallbackEnabled;
+    }
+
+    FrameArena& FrameArena::GetGlobal()
+    {
+        MX_ASSERT(FrameArena::global != nullptr);
+        return *FrameArena::global;
+    }
+
+    void FrameArena::Init()
+    {
+        if (FrameArena::global != nullptr) return;
+        FrameArena::global = Alloc<FrameArena>();
+    }
+
+    void FrameArena::Destroy()
+    {
+        Free(FrameArena::global);
+        FrameArena::global = nullptr;
+    }
+
+    FrameArena* FrameArena::GetImpl()
+    {
+        return FrameArena::global;
+    }
+
+    void FrameArena::Clone(FrameArena* other)
+    {
+        FrameArena::global = other;
+    }
+}
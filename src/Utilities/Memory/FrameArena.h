@@ -0,0 +1,181 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/Memory/LinearAllocator.h"
+#include "Utilities/Memory/Memory.h"
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/STL/MxString.h"
+
+#include <array>
+#include <cstddef>
+#include <thread>
+
+namespace MxEngine
+{
+    /*!
+    frame arena is a double-buffered linear allocator for transient data of main thread
+    memory allocated during frame N stays valid until the end of frame N + 1, so data produced in one frame can be consumed in the next one
+    arena grows by allocating additional blocks when frame does not fit into it. On reset all blocks of the region are merged into one,
+    so after first few frames arena stops touching general heap at all
+    */
+    class FrameArena
+    {
+    public:
+        constexpr static size_t DefaultBlockSize = 1024 * 1024;
+    private:
+        /*!
+        global engine frame arena, created in FrameArena::Init()
+        */
+        inline static FrameArena* global = nullptr;
+
+        struct Region
+        {
+            /*!
+            memory blocks of region. Allocator always uses the last one
+            */
+            MxVector<UniqueRef<uint8_t[]>> Blocks;
+            LinearAllocator Allocator;
+            /*!
+            total size of all blocks of the region
+            */
+            size_t Capacity = 0;
+            /*!
+            bytes used in all blocks except the last one
+            */
+            size_t FilledBytes = 0;
+            /*!
+            separate heap allocations made while heap fallback is enabled, freed when region is reused
+            */
+            MxVector<UniqueRef<uint8_t[]>> FallbackAllocations;
+        };
+
+        std::array<Region, 2> regions;
+        size_t currentRegion = 0;
+        std::thread::id ownerThread;
+
+        size_t lastFrameUsedBytes = 0;
+        size_t lastFrameBlockAllocations = 0;
+        size_t blockAllocations = 0;
+        bool isHeapFallbackEnabled = false;
+
+        void AddBlock(Region& region, size_t bytes);
+    public:
+        explicit FrameArena(size_t blockSize = DefaultBlockSize);
+        FrameArena(const FrameArena&) = delete;
+        FrameArena(FrameArena&&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+        FrameArena& operator=(FrameArena&&) = delete;
+
+        /*!
+        allocates memory in current frame region. Must be called only from thread which created the arena
+        \param bytes size of memory block
+        \param align alignment of memory block (must be power of two)
+        \returns pointer to memory which is valid until the end of next frame
+        */
+        [[nodiscard]] void* Allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+        /*!
+        switches arena to the next frame. Memory allocated two frames ago is reused, so no pointers to it must exist
+        */
+        void NextFrame();
+        /*!
+        gets number of bytes allocated in current frame
+        */
+        size_t GetUsedBytes() const;
+        /*!
+        gets number of bytes allocated during previous frame
+        */
+        size_t GetLastFrameUsedBytes() const;
+        /*!
+        gets number of blocks arena allocated to fit previous frame (0 in steady state). Heap allocations of other code are not counted
+        */
+        size_t GetLastFrameBlockAllocations() const;
+        /*!
+        gets total memory reserved by both regions of the arena
+        */
+        size_t GetCapacity() const;
+        /*!
+        makes each allocation a separate general heap allocation, as if frame-scoped containers did not use the arena
+        memory lifetime stays the same. Used to measure how many heap allocations arena saves
+        \param value true to allocate from general heap, false to allocate from arena blocks
+        */
+        void SetHeapFallback(bool value);
+        /*!
+        checks if allocations are done from general heap instead of arena blocks
+        */
+        bool IsHeapFallbackEnabled() const;
+
+        static FrameArena& GetGlobal();
+        static void Init();
+        static void Destroy();
+        static FrameArena* GetImpl();
+        static void Clone(FrameArena* other);
+    };
+
+    /*!
+    EASTL-compatible allocator which takes memory from global frame arena. Deallocation does nothing, memory is reclaimed when arena region is reused
+    containers using it must not outlive the next frame and must be used only from main thread
+    */
+    class FrameAllocator
+    {
+    public:
+        FrameAllocator(const char* name = nullptr) { }
+        FrameAllocator(const FrameAllocator& other, const char* name) { }
+
+        void* allocate(size_t bytes, int flags = 0)
+        {
+            return FrameArena::GetGlobal().Allocate(bytes);
+        }
+
+        void* allocate(size_t bytes, size_t alignment, size_t offset, int flags = 0)
+        {
+            MX_ASSERT(offset == 0);
+            return FrameArena::GetGlobal().Allocate(bytes, alignment);
+        }
+
+        void deallocate(void* ptr, size_t bytes) { }
+
+        const char* get_name() const { return "FrameAllocator"; }
+        void set_name(const char* name) { }
+    };
+
+    inline bool operator==(const FrameAllocator&, const FrameAllocator&) { return true; }
+    inline bool operator!=(const FrameAllocator&, const FrameAllocator&) { return false; }
+
+    /*!
+    vector which stores its elements in frame arena. Valid until the end of next frame
+    */
+    template<typename T>
+    using FrameVector = MxVector<T, FrameAllocator>;
+
+    /*!
+    string which stores its characters in frame arena. Valid until the end of next frame
+    */
+    using FrameString = eastl::basic_string<char, FrameAllocator>;
+}
@@ -141,6 +141,47 @@ namespace MxEngine
             return aligned;
         }
 
+        /*!
+        returns pointer to raw allocated memory if memory chunk has enough space left
+        \param bytes minimal requested block size
+        \param align minimal alignment of pointer (defaults to 1)
+        \returns pointer to memory or nullptr if block does not fit into memory chunk
+        */
+        [[nodiscard]] DataPointer TryRawAlloc(size_t bytes, size_t align = 1)
+        {
+            if (this->base == nullptr) return nullptr;
+
+            DataPointer aligned = AlignPointer(this->top, align);
+            if (aligned + bytes > this->base + this->size) return nullptr;
+
+            this->top = aligned + bytes;
+            return aligned;
+        }
+
+        /*!
+        marks all memory chunk as free. Destructors of allocated objects are not called
+        */
+        void Reset()
+        {
+            this->top = this->base;
+        }
+
+        /*!
+        gets how many bytes of memory chunk are currently in use (including alignment padding)
+        */
+        size_t GetUsedBytes() const
+        {
+            return size_t(this->top - this->base);
+        }
+
+        /*!
+        gets total size in bytes of memory chunk
+        */
+        size_t GetSize() const
+        {
+            return this->size;
+        }
+
         /*!
         constructs object of type T in memory and returns pointer to it
         \param args arguments for object construction
@@ -1,12 +1,13 @@
 #include "Memory.h"
-#include <cstdlib>
+#include <new>
 
+// EASTL frees memory with delete[], so allocations are also done by global operator new[]. This also lets applications count all heap allocations
 void* operator new[](size_t size, const char* name, int flags, unsigned int debugFlags, const char* file, int line)
 {
-    return malloc(size);
+    return ::operator new[](size);
 }
 
 void* operator new[](size_t size, size_t align, size_t offset, const char* name, int flags, unsigned int debugFlags, const char* file, int line)
 {
-    return malloc(size);
+    return ::operator new[](size);
 }
@@ -0,0 +1,219 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AssetImporter.h"
+#include "Utilities/ObjectLoading/ObjectLoader.h"
+#include "Utilities/Concurrency/ThreadPool.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Profiler/Profiler.h"
+#include "Utilities/Format/Format.h"
+#include "Utilities/Json/Json.h"
+#include "Core/Components/Rendering/MeshRenderer.h"
+#include "Core/Resources/MeshCache.h"
+
+namespace MxEngine
+{
+    /*!
+    single source processed by importer. Record is the manifest entry of source, which is rebuilt if source is stale
+    */
+    struct AssetImportJob
+    {
+        FilePath Source;
+        MxString Key;
+        uint64_t SourceHash = 0;
+        bool IsUpToDate = false;
+        bool IsFailed = false;
+        JsonFile Record;
+    };
+
+    static MxString GetManifestKey(const FilePath& path, const FilePath& directory)
+    {
+        return ToMxString(std::filesystem::proximate(path, directory).generic_string());
+    }
+
+    static FilePath GetMaterialLibraryPath(const FilePath& source)
+    {
+        return source.native() + MeshRenderer::GetMaterialFileExtenstion().native();
+    }
+
+    static bool IsRecordUpToDate(const AssetImportJob& job, const FilePath& directory)
+    {
+        const auto& record = job.Record;
+        if (!record.is_object() || record.value("hash", uint64_t(0)) != job.SourceHash)
+            return false;
+
+        if (!File::Exists(GetMaterialLibraryPath(job.Source)))
+            return false;
+
+        MeshCacheFile cache;
+        if (!MeshCache::Open(cache, job.Source, job.SourceHash))
+            return false;
+
+        if (record.contains("outputs"))
+        {
+            for (const auto& output : record["outputs"])
+            {
+                if (!File::Exists(directory / output.get<std::string>()))
+                    return false;
+            }
+        }
+
+        if (!record.contains("dependencies")) return true;
+        for (const auto& dependency : record["dependencies"].items())
+        {
+            if (MeshCache::ComputeSourceHash(directory / dependency.key()) != dependency.value().get<uint64_t>())
+                return false;
+        }
+        return true;
+    }
+
+    static void ImportSource(AssetImportJob& job, const FilePath& directory)
+    {
+        MAKE_SCOPE_PROFILER("AssetImporter::ImportSource()");
+
+        auto object = ObjectLoader::Load(job.Source);
+        if (object.meshes.empty())
+        {
+            job.IsFailed = true;
+            return;
+        }
+
+        ObjectLoader::DumpMaterials(object.materials, GetMaterialLibraryPath(job.Source));
+        if (!MeshCache::Store(object, job.Source, job.SourceHash))
+        {
+            job.IsFailed = true;
+            return;
+        }
+
+        // textures written by loader are outputs of import, other textures referenced by materials are its dependencies
+        MxVector<FilePath> dependencies;
+        MxVector<FilePath> outputs;
+        for (const auto& material : object.materials)
+        {
+            for (const auto* texture : { &material.AlbedoMap, &material.EmissiveMap, &material.HeightMap, &material.NormalMap,
+                &material.AmbientOcclusionMap, &material.MetallicMap, &material.RoughnessMap })
+            {
+                if (texture->empty()) continue;
+                if (ObjectLoader::IsExtractedTexture(job.Source, *texture))
+                    outputs.push_back(*texture);
+                else
+                    dependencies.push_back(*texture);
+            }
+        }
+        MeshCache::CollectDependencies(job.Source, dependencies);
+
+        // missing dependencies are recorded with zero hash, so source is reimported once they appear
+        job.Record = JsonFile::object();
+        job.Record["hash"] = job.SourceHash;
+        job.Record["dependencies"] = JsonFile::object();
+        for (const auto& dependency : dependencies)
+        {
+            job.Record["dependencies"][GetManifestKey(dependency, directory).c_str()] = MeshCache::ComputeSourceHash(dependency);
+        }
+        job.Record["outputs"] = JsonFile::array();
+        for (const auto& output : outputs)
+        {
+            job.Record["outputs"].push_back(GetManifestKey(output, directory).c_str());
+        }
+    }
+
+    FilePath AssetImporter::GetManifestPath(const FilePath& directory)
+    {
+        return directory / ".mximport";
+    }
+
+    AssetImportResult AssetImporter::ImportDirectory(const FilePath& directory, bool forceRebuild)
+    {
+        MAKE_SCOPE_PROFILER("AssetImporter::ImportDirectory()");
+        MAKE_SCOPE_TIMER("MxEngine::AssetImporter", "AssetImporter::ImportDirectory()");
+        AssetImportResult result;
+
+        if (!File::IsDirectory(directory))
+        {
+            MXLOG_ERROR("MxEngine::AssetImporter", "directory does not exist: " + ToMxString(directory));
+            return result;
+        }
+
+        auto manifestPath = AssetImporter::GetManifestPath(directory);
+        JsonFile manifest;
+        if (!forceRebuild && File::Exists(manifestPath))
+        {
+            manifest = JsonFile::parse(File::ReadAllText(manifestPath).c_str(), nullptr, false);
+            if (manifest.is_discarded() || !manifest.is_object() || manifest.value("version", 0u) != AssetImporter::ManifestVersion)
+                manifest = JsonFile{ };
+        }
+
+        MxVector<AssetImportJob> jobs;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+        {
+            if (!entry.is_regular_file() || !ObjectLoader::IsFormatSupported(entry.path())) continue;
+
+            auto& job = jobs.emplace_back();
+            job.Source = entry.path();
+            job.Key = GetManifestKey(entry.path(), directory);
+            if (manifest.contains("assets") && manifest["assets"].contains(job.Key.c_str()))
+                job.Record = manifest["assets"][job.Key.c_str()];
+        }
+
+        // first pass only hashes files, so unchanged sources are skipped without touching Assimp
+        ThreadPool::GetGlobal().ParallelFor(jobs.size(), [&jobs, &directory](size_t index)
+        {
+            auto& job = jobs[index];
+            job.SourceHash = MeshCache::ComputeCacheKey(job.Source);
+            job.IsUpToDate = IsRecordUpToDate(job, directory);
+        });
+
+        ThreadPool::GetGlobal().ParallelFor(jobs.size(), [&jobs, &directory](size_t index)
+        {
+            auto& job = jobs[index];
+            if (!job.IsUpToDate) ImportSource(job, directory);
+        });
+
+        // manifest is rebuilt from scratch, so removed and failed sources are dropped from it
+        JsonFile updatedManifest;
+        updatedManifest["version"] = AssetImporter::ManifestVersion;
+        updatedManifest["assets"] = JsonFile::object();
+        for (const auto& job : jobs)
+        {
+            if (job.IsFailed)
+            {
+                MXLOG_WARNING("MxEngine::AssetImporter", "failed to import asset: " + ToMxString(job.Source));
+                result.Failed++;
+                continue;
+            }
+            if (job.IsUpToDate) result.UpToDate++; else result.Imported++;
+            updatedManifest["assets"][job.Key.c_str()] = job.Record;
+        }
+
+        File manifestFile(manifestPath, File::WRITE);
+        SaveJson(manifestFile, updatedManifest);
+
+        MXLOG_INFO("MxEngine::AssetImporter", MxFormat("imported {} assets ({} up to date, {} failed)", result.Imported, result.UpToDate, result.Failed));
+        return result;
+    }
+}
@@ -0,0 +1,77 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include "Utilities/FileSystem/File.h"
+
+namespace MxEngine
+{
+    /*!
+    summary of AssetImporter::ImportDirectory() call
+    */
+    struct AssetImportResult
+    {
+        /*!
+        number of sources which were baked during this call
+        */
+        size_t Imported = 0;
+        /*!
+        number of sources which outputs are up to date and were skipped
+        */
+        size_t UpToDate = 0;
+        /*!
+        number of sources which failed to import
+        */
+        size_t Failed = 0;
+    };
+
+    /*!
+    asset importer bakes object files into runtime-ready outputs: .mxmesh cache, material library and textures extracted from the source
+    each imported source is recorded in import manifest together with content hashes of the source itself and its dependencies (textures, external buffers)
+    and with paths of extracted textures, so next import reprocesses only sources which were changed or which outputs are missing. Runtime picks baked outputs automatically (see MeshCache)
+    */
+    class AssetImporter
+    {
+    public:
+        constexpr static uint32_t ManifestVersion = 2;
+
+        /*!
+        gets path to import manifest of directory
+        \param directory root directory of imported assets
+        */
+        static FilePath GetManifestPath(const FilePath& directory);
+        /*!
+        recursively bakes all object files in directory. Sources are processed in parallel on global thread pool
+        \param directory root directory of assets. Outputs are written next to their sources
+        \param forceRebuild if true, manifest is ignored and all sources are reprocessed
+        \returns number of imported, skipped and failed sources
+        */
+        static AssetImportResult ImportDirectory(const FilePath& directory, bool forceRebuild = false);
+    };
+}
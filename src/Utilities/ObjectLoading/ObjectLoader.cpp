@@ -36,12 +36,16 @@
 #include "Utilities/Json/Json.h"
 #include "Utilities/Image/ImageLoader.h"
 #include "Utilities/Image/ImageManager.h"
+#include "Utilities/Concurrency/ThreadPool.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/pbrmaterial.h>
 
+#include <cstring>
+#include <cctype>
+
 namespace MxEngine
 {
     const char* const AlbedoTexName = "albedo";
@@ -59,32 +63,22 @@ namespace MxEngine
         if (File::Exists(roughnessPath) || File::Exists(metallicPath))
             return; // avoid rewriting existing textures
 
-        auto roughnessData = (uint8_t*)std::malloc(image.GetTotalByteSize());
-        auto metallicData = (uint8_t*)std::malloc(image.GetTotalByteSize());
+        // pixels of single-channel images are laid out in the same order as source pixels, so channels are copied with one linear pass
+        size_t pixelCount = image.GetWidth() * image.GetHeight();
+        size_t channelSize = image.GetChannelSize();
+        size_t pixelSize = image.GetPixelSize();
+        auto roughnessData = (uint8_t*)std::calloc(pixelCount, channelSize);
+        auto metallicData = (uint8_t*)std::calloc(pixelCount, channelSize);
         Image roughness(roughnessData, image.GetWidth(), image.GetHeight(), 1, image.IsFloatingPoint());
         Image metallic(metallicData, image.GetWidth(), image.GetHeight(), 1, image.IsFloatingPoint());
 
-        for (size_t x = 0; x < image.GetWidth(); x++)
+        const uint8_t* source = image.GetRawData();
+        bool hasRoughness = image.GetChannelCount() > 1; // G channel
+        bool hasMetallic = image.GetChannelCount() > 2; // B channel
+        for (size_t i = 0; i < pixelCount; i++, source += pixelSize)
         {
-            for (size_t y = 0; y < image.GetHeight(); y++)
-            {
-                if (image.IsFloatingPoint())
-                {
-                    auto pixel = image.GetPixelFloat(x, y);
-                    // G channel
-                    roughness.SetPixelFloat(x, y, pixel[1], 0.0f, 0.0f, 0.0f);
-                    // B channel
-                    metallic.SetPixelFloat(x, y, pixel[2], 0.0f, 0.0f, 0.0f);
-                }
-                else
-                {
-                    auto pixel = image.GetPixelByte(x, y);
-                    // G channel
-                    roughness.SetPixelByte(x, y, pixel[1], 0, 0, 0);
-                    // B channel
-                    metallic.SetPixelByte(x, y, pixel[2], 0, 0, 0);
-                }
-            }
+            if (hasRoughness) std::memcpy(roughnessData + i * channelSize, source + 1 * channelSize, channelSize);
+            if (hasMetallic) std::memcpy(metallicData + i * channelSize, source + 2 * channelSize, channelSize);
         }
         ImageManager::SaveImage(roughnessPath, roughness, PreferredFormat);
         ImageManager::SaveImage(metallicPath, metallic, PreferredFormat);
@@ -157,6 +151,134 @@ namespace MxEngine
         }
     }
 
+    static void LoadMaterialInfo(MaterialInfo& materialInfo, size_t i, const FilePath& directory, const MxString& texturePrefix, const aiScene* scene)
+    {
+        auto& material = scene->mMaterials[i];
+
+        materialInfo.Name = material->GetName().C_Str();
+        if (materialInfo.Name.empty()) materialInfo.Name = MxFormat("material #{}", i);
+        
+        #define GET_FLOAT(type, field)\
+        { ai_real val;\
+            if (material->Get(type, val) == aiReturn_SUCCESS)\
+            {\
+                materialInfo.field = (float)val;\
+            }\
+        }
+
+        GET_FLOAT(AI_MATKEY_OPACITY, Transparency);
+        GET_FLOAT(AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_METALLIC_FACTOR, MetallicFactor);
+        GET_FLOAT(AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_ROUGHNESS_FACTOR, RoughnessFactor);
+
+        // TODO: this is workaround, because some object formats export alpha channel as 0, but its actually means 1
+        if (materialInfo.Transparency == 0.0f) materialInfo.Transparency = 1.0f;
+
+        aiColor4D baseColorPBR;
+        if (material->Get(AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_BASE_COLOR_FACTOR, baseColorPBR) == aiReturn_SUCCESS)
+        {
+            materialInfo.BaseColor[0]  = baseColorPBR[0];
+            materialInfo.BaseColor[1]  = baseColorPBR[1];
+            materialInfo.BaseColor[2]  = baseColorPBR[2];
+            materialInfo.Transparency *= baseColorPBR[3];
+        }
+        
+        aiString alphaMode;
+        if (material->Get(AI_MATKEY_GLTF_ALPHAMODE, alphaMode) == aiReturn_SUCCESS)
+        {
+            if (strcmp(alphaMode.C_Str(), "MASK") == 0)
+                materialInfo.AlphaMask = true;
+            else
+                materialInfo.AlphaMask = false;
+        }
+
+        float alphaCutoff = 0.0f;
+        if (material->Get(AI_MATKEY_GLTF_ALPHACUTOFF, alphaCutoff) == aiReturn_SUCCESS)
+        {
+            materialInfo.Transparency *= alphaCutoff;
+        }
+
+        aiColor3D emissiveColor;
+        if (material->Get(AI_MATKEY_COLOR_EMISSIVE, emissiveColor) == aiReturn_SUCCESS)
+        {
+            materialInfo.Emission = Max(emissiveColor.r, emissiveColor.g, emissiveColor.b);
+        }
+
+        // extracted textures are prefixed with source file name, as multiple objects can be located in the same directory
+        auto TextureName = [&texturePrefix, i](const char* name) { return MxFormat("{}_{}_{}", texturePrefix, name, i); };
+
+        // process first to make sure metallic / roughness will present when checking for existing textures in GetActualTexturePath
+        SplitRoughnessMetallicTexture(directory, TextureName(RoughnessTexName), TextureName(MetallicTexName), scene, material, aiTextureType_UNKNOWN);
+
+        materialInfo.AlbedoMap           = GetActualTexturePath(directory, TextureName(AlbedoTexName),    scene, material, aiTextureType_DIFFUSE);
+        materialInfo.EmissiveMap         = GetActualTexturePath(directory, TextureName(EmissiveTexName),  scene, material, aiTextureType_EMISSIVE);
+        materialInfo.HeightMap           = GetActualTexturePath(directory, TextureName(HeightTexName),    scene, material, aiTextureType_HEIGHT);
+        materialInfo.NormalMap           = GetActualTexturePath(directory, TextureName(NormalTexName),    scene, material, aiTextureType_NORMALS);
+        materialInfo.AmbientOcclusionMap = GetActualTexturePath(directory, TextureName(AOTexName),        scene, material, aiTextureType_AMBIENT_OCCLUSION);
+        materialInfo.RoughnessMap        = GetActualTexturePath(directory, TextureName(RoughnessTexName), scene, material, aiTextureType_DIFFUSE_ROUGHNESS);
+        materialInfo.MetallicMap         = GetActualTexturePath(directory, TextureName(MetallicTexName),  scene, material, aiTextureType_METALNESS);
+
+        // if aiTextureType_AMBIENT_OCCLUSION failed to load, try aiTextureType_LIGHTMAP as alternative, as it also can store ambient occlusion
+        if(materialInfo.AmbientOcclusionMap.empty()) materialInfo.AmbientOcclusionMap = GetActualTexturePath(directory, TextureName(AOTexName), scene, material, aiTextureType_LIGHTMAP);
+
+        // if emmision texture provided, set emmision to some non-zero value
+        if (!materialInfo.EmissiveMap.empty() && materialInfo.Emission == 0.0f) materialInfo.Emission = 1.0f;
+    }
+
+    static void LoadMeshInfo(MeshInfo& meshInfo, size_t meshIndex, const aiMesh* mesh, ObjectInfo& object, const Vector3& objectCenter)
+    {
+        meshInfo.name = mesh->mName.C_Str();
+        // check if mesh name was generated by assimp or is missing (UUIDGenerator is not used, as meshes are converted in parallel)
+        if (meshInfo.name.empty() || meshInfo.name.find("meshes_") != meshInfo.name.npos)
+            meshInfo.name = MxFormat("mesh #{}", meshIndex);
+
+        meshInfo.useNormal = mesh->HasNormals();
+        meshInfo.useTexture = mesh->HasTextureCoords(0);
+        meshInfo.material = object.materials.data() + (size_t)mesh->mMaterialIndex;
+
+        MX_ASSERT(mesh->mNormals != nullptr);
+        MX_ASSERT(mesh->mVertices != nullptr);
+        MX_ASSERT(mesh->mNumFaces > 0);
+
+        MxVector<Vertex> vertex;
+        vertex.resize((size_t)mesh->mNumVertices);
+        for (size_t i = 0; i < (size_t)mesh->mNumVertices; i++)
+        {
+            vertex[i].Position = ((Vector3*)mesh->mVertices)[i];
+            vertex[i].Position -= objectCenter;
+            vertex[i].Normal    = ((Vector3*)mesh->mNormals)[i];
+
+            if (meshInfo.useTexture)
+            {
+                vertex[i].TexCoord = MakeVector2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+                vertex[i].Tangent = ((Vector3*)mesh->mTangents)[i];
+                vertex[i].Bitangent = ((Vector3*)mesh->mBitangents)[i];
+            }
+            else
+            {
+                auto randomVec = Random::GetUnitVector3();
+                vertex[i].Tangent = Cross(vertex[i].Normal, randomVec);
+                vertex[i].Bitangent = Cross(vertex[i].Normal, vertex[i].Tangent);
+            }
+        }
+
+        meshInfo.indicies.resize((size_t)mesh->mNumFaces * 3);
+        for (size_t i = 0; i < (size_t)mesh->mNumFaces; i++)
+        {
+            if (mesh->mFaces[i].mNumIndices == 3)
+            {
+                meshInfo.indicies[3 * i + 0] = mesh->mFaces[i].mIndices[0];
+                meshInfo.indicies[3 * i + 1] = mesh->mFaces[i].mIndices[1];
+                meshInfo.indicies[3 * i + 2] = mesh->mFaces[i].mIndices[2];
+            }
+            else continue;
+        }
+        meshInfo.useTexture = true;
+        meshInfo.vertecies = std::move(vertex);
+
+        meshInfo.boundingBox = MeshData::ComputeAABB(meshInfo.vertecies.data(), meshInfo.vertecies.size());
+        meshInfo.boundingSphere = MeshData::ComputeBoundingSphere(meshInfo.vertecies.data(), meshInfo.vertecies.size(), meshInfo.boundingBox);
+    }
+
     ObjectInfo ObjectLoader::Load(const FilePath& filepath)
     {
         auto directory = filepath.parent_path();
@@ -172,7 +294,8 @@ namespace MxEngine
         MAKE_SCOPE_TIMER("MxEngine::ObjectLoader", "ObjectLoader::LoadObject");
         MXLOG_INFO("Assimp::Importer", "loading object from file: " + ToMxString(filepath));
 
-        static Assimp::Importer importer; // TODO: not thread safe
+        // importer is created per call, so multiple objects can be loaded concurrently
+        Assimp::Importer importer;
         const aiScene* scene = importer.ReadFile(filepath.string().c_str(), 
             aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices |
             aiProcess_OptimizeMeshes | aiProcess_ImproveCacheLocality | aiProcess_GenUVCoords | aiProcess_CalcTangentSpace);
@@ -184,149 +307,82 @@ namespace MxEngine
 
         object.meshes.resize((size_t)scene->mNumMeshes);
         object.materials.resize((size_t)scene->mNumMaterials);
+        auto& threadPool = ThreadPool::GetGlobal();
+        auto texturePrefix = ToMxString(filepath.stem());
 
-        for (size_t i = 0; i < object.materials.size(); i++)
+        // each material resolves and extracts only its own textures, so materials are processed independently
+        threadPool.ParallelFor(object.materials.size(), [&object, &directory, &texturePrefix, scene](size_t i)
         {
-            auto& materialInfo = object.materials[i];
-            auto& material = scene->mMaterials[i];
-
-            materialInfo.Name = material->GetName().C_Str();
-            if (materialInfo.Name.empty()) materialInfo.Name = MxFormat("material #{}", i);
-            
-            #define GET_FLOAT(type, field)\
-            { ai_real val;\
-                if (material->Get(type, val) == aiReturn_SUCCESS)\
-                {\
-                    materialInfo.field = (float)val;\
-                }\
-            }
-
-            GET_FLOAT(AI_MATKEY_OPACITY, Transparency);
-            GET_FLOAT(AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_METALLIC_FACTOR, MetallicFactor);
-            GET_FLOAT(AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_ROUGHNESS_FACTOR, RoughnessFactor);
+            LoadMaterialInfo(object.materials[i], i, directory, texturePrefix, scene);
+        });
 
-            // TODO: this is workaround, because some object formats export alpha channel as 0, but its actually means 1
-            if (materialInfo.Transparency == 0.0f) materialInfo.Transparency = 1.0f;
-
-            aiColor4D baseColorPBR;
-            if (material->Get(AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_BASE_COLOR_FACTOR, baseColorPBR) == aiReturn_SUCCESS)
-            {
-                materialInfo.BaseColor[0]  = baseColorPBR[0];
-                materialInfo.BaseColor[1]  = baseColorPBR[1];
-                materialInfo.BaseColor[2]  = baseColorPBR[2];
-                materialInfo.Transparency *= baseColorPBR[3];
-            }
-            
-            aiString alphaMode;
-            if (material->Get(AI_MATKEY_GLTF_ALPHAMODE, alphaMode) == aiReturn_SUCCESS)
-            {
-                if (strcmp(alphaMode.C_Str(), "MASK") == 0)
-                    materialInfo.AlphaMask = true;
-                else
-                    materialInfo.AlphaMask = false;
-            }
-
-            float alphaCutoff = 0.0f;
-            if (material->Get(AI_MATKEY_GLTF_ALPHACUTOFF, alphaCutoff) == aiReturn_SUCCESS)
-            {
-                materialInfo.Transparency *= alphaCutoff;
-            }
-
-            aiColor3D emissiveColor;
-            if (material->Get(AI_MATKEY_COLOR_EMISSIVE, emissiveColor) == aiReturn_SUCCESS)
-            {
-                materialInfo.Emission = Max(emissiveColor.r, emissiveColor.g, emissiveColor.b);
-            }
-
-            // process first to make sure metallic / roughness will present when checking for existing textures in GetActualTexturePath
-            SplitRoughnessMetallicTexture(directory, MxFormat("{}_{}", RoughnessTexName, i), MxFormat("{}_{}", MetallicTexName, i), scene, material, aiTextureType_UNKNOWN);
-
-            materialInfo.AlbedoMap           = GetActualTexturePath(directory, MxFormat("{}_{}", AlbedoTexName,    i), scene, material, aiTextureType_DIFFUSE);
-            materialInfo.EmissiveMap         = GetActualTexturePath(directory, MxFormat("{}_{}", EmissiveTexName,  i), scene, material, aiTextureType_EMISSIVE);
-            materialInfo.HeightMap           = GetActualTexturePath(directory, MxFormat("{}_{}", HeightTexName,    i), scene, material, aiTextureType_HEIGHT);
-            materialInfo.NormalMap           = GetActualTexturePath(directory, MxFormat("{}_{}", NormalTexName,    i), scene, material, aiTextureType_NORMALS);
-            materialInfo.AmbientOcclusionMap = GetActualTexturePath(directory, MxFormat("{}_{}", AOTexName,        i), scene, material, aiTextureType_AMBIENT_OCCLUSION);
-            materialInfo.RoughnessMap        = GetActualTexturePath(directory, MxFormat("{}_{}", RoughnessTexName, i), scene, material, aiTextureType_DIFFUSE_ROUGHNESS);
-            materialInfo.MetallicMap         = GetActualTexturePath(directory, MxFormat("{}_{}", MetallicTexName,  i), scene, material, aiTextureType_METALNESS);
-
-            // if aiTextureType_AMBIENT_OCCLUSION failed to load, try aiTextureType_LIGHTMAP as alternative, as it also can store ambient occlusion
-            if(materialInfo.AmbientOcclusionMap.empty()) materialInfo.AmbientOcclusionMap = GetActualTexturePath(directory, MxFormat("{}_{}", AOTexName, i), scene, material, aiTextureType_LIGHTMAP);
-
-            // if emmision texture provided, set emmision to some non-zero value
-            if (!materialInfo.EmissiveMap.empty() && materialInfo.Emission == 0.0f) materialInfo.Emission = 1.0f;
-        }
+        MxVector<std::pair<Vector3, Vector3>> meshCoords(object.meshes.size());
+        threadPool.ParallelFor(object.meshes.size(), [&meshCoords, scene](size_t i)
+        {
+            auto& mesh = scene->mMeshes[i];
+            meshCoords[i] = MinMaxComponents((Vector3*)mesh->mVertices, (size_t)mesh->mNumVertices);
+        });
 
         Vector3 minCoords = MakeVector3(std::numeric_limits<float>::max());
         Vector3 maxCoords = MakeVector3(-1.0f * std::numeric_limits<float>::max());
-        for (size_t i = 0; i < object.meshes.size(); i++)
+        for (const auto& coords : meshCoords)
         {
-            auto& mesh = scene->mMeshes[i];
-            auto coords = MinMaxComponents((Vector3*)mesh->mVertices, (size_t)mesh->mNumVertices);
-
             minCoords = VectorMin(minCoords, coords.first);
             maxCoords = VectorMax(maxCoords, coords.second);
         }
         auto objectCenter = (minCoords + maxCoords) * 0.5f;
 
-        for (size_t i = 0; i < object.meshes.size(); i++)
+        threadPool.ParallelFor(object.meshes.size(), [&object, &objectCenter, scene](size_t i)
         {
-            auto& mesh = scene->mMeshes[i];
-            auto& meshInfo = object.meshes[i];
+            LoadMeshInfo(object.meshes[i], i, scene->mMeshes[i], object, objectCenter);
+        });
 
-            meshInfo.name = mesh->mName.C_Str();
-            // check if mesh name was generated by assimp
-            if (meshInfo.name.find("meshes_") != meshInfo.name.npos)
-                meshInfo.name = MxFormat("mesh #{}", i);
+        return object;
+    }
 
-            meshInfo.useNormal = mesh->HasNormals();
-            meshInfo.useTexture = mesh->HasTextureCoords(0);
-            meshInfo.material = object.materials.data() + (size_t)mesh->mMaterialIndex;
+    MxVector<ObjectInfo> ObjectLoader::LoadMany(const MxVector<FilePath>& paths)
+    {
+        MAKE_SCOPE_PROFILER("ObjectLoader::LoadMany");
+        MAKE_SCOPE_TIMER("MxEngine::ObjectLoader", "ObjectLoader::LoadMany");
 
-            MX_ASSERT(mesh->mNormals != nullptr);
-            MX_ASSERT(mesh->mVertices != nullptr);
-            MX_ASSERT(mesh->mNumFaces > 0);
+        MxVector<ObjectInfo> objects(paths.size());
+        ThreadPool::GetGlobal().ParallelFor(paths.size(), [&objects, &paths](size_t i)
+        {
+            objects[i] = ObjectLoader::Load(paths[i]);
+        });
+        return objects;
+    }
 
-            MxVector<Vertex> vertex;
-            vertex.resize((size_t)mesh->mNumVertices);
-            for (size_t i = 0; i < (size_t)mesh->mNumVertices; i++)
-            {
-                vertex[i].Position = ((Vector3*)mesh->mVertices)[i];
-                vertex[i].Position -= objectCenter;
-                vertex[i].Normal    = ((Vector3*)mesh->mNormals)[i];
+    bool ObjectLoader::IsFormatSupported(const FilePath& path)
+    {
+        static const Assimp::Importer formatQuery; // separate instance, as it is never used for loading
+        auto extension = path.extension().string();
+        return !extension.empty() && formatQuery.IsExtensionSupported(extension.c_str());
+    }
 
-                if (meshInfo.useTexture)
-                {
-                    vertex[i].TexCoord = MakeVector2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
-                    vertex[i].Tangent = ((Vector3*)mesh->mTangents)[i];
-                    vertex[i].Bitangent = ((Vector3*)mesh->mBitangents)[i];
-                }
-                else
-                {
-                    auto randomVec = Random::GetUnitVector3();
-                    vertex[i].Tangent = Cross(vertex[i].Normal, randomVec);
-                    vertex[i].Bitangent = Cross(vertex[i].Normal, vertex[i].Tangent);
-                }
-            }
+    bool ObjectLoader::IsExtractedTexture(const FilePath& source, const FilePath& texture)
+    {
+        if (texture.parent_path() != source.parent_path() || texture.extension() != PreferredExtension)
+            return false;
 
-            meshInfo.indicies.resize((size_t)mesh->mNumFaces * 3);
-            for (size_t i = 0; i < (size_t)mesh->mNumFaces; i++)
-            {
-                if (mesh->mFaces[i].mNumIndices == 3)
-                {
-                    meshInfo.indicies[3 * i + 0] = mesh->mFaces[i].mIndices[0];
-                    meshInfo.indicies[3 * i + 1] = mesh->mFaces[i].mIndices[1];
-                    meshInfo.indicies[3 * i + 2] = mesh->mFaces[i].mIndices[2];
-                }
-                else continue;
-            }
-            if (meshInfo.name.empty())
-                meshInfo.name = UUIDGenerator::Get();
-            meshInfo.useTexture = true;
-            meshInfo.vertecies = std::move(vertex);
+        // extracted textures are named as <source stem>_<texture name>_<material index>, see LoadMaterialInfo()
+        auto name = ToMxString(texture.stem());
+        auto prefix = ToMxString(source.stem()) + '_';
+        if (name.compare(0, prefix.size(), prefix) != 0) return false;
+
+        auto indexBegin = name.rfind('_');
+        if (indexBegin < prefix.size() || indexBegin + 1 == name.size()) return false;
+        for (size_t i = indexBegin + 1; i < name.size(); i++)
+        {
+            if (!std::isdigit((unsigned char)name[i])) return false;
         }
-        importer.FreeScene();
 
-        return object;
+        auto textureName = name.substr(prefix.size(), indexBegin - prefix.size());
+        for (const char* extractedName : { AlbedoTexName, EmissiveTexName, HeightTexName, NormalTexName, AOTexName, RoughnessTexName, MetallicTexName })
+        {
+            if (textureName == extractedName) return true;
+        }
+        return false;
     }
 
     MaterialLibrary ObjectLoader::LoadMaterials(const FilePath& path)
@@ -376,7 +432,6 @@ namespace MxEngine
     void ObjectLoader::DumpMaterials(const MaterialLibrary& materials, const FilePath& path)
     {
         JsonFile json;
-        File file(path, File::WRITE);
         MXLOG_INFO("MxEngine::ObjectLoader", "dumping materials to file: " + ToMxString(path));
 
         #define DUMP(index, name) json[index][#name] = materials[index].name
@@ -404,6 +459,24 @@ namespace MxEngine
             DUMP(i, Name);
         }
 
-        SaveJson(file, json);
+        // materials may be dumped from background loading threads, so readers must never observe partially written file
+        auto tempPath = File::GetTemporaryPath(path);
+        {
+            File file(tempPath, File::WRITE);
+            if (!file.IsOpen())
+            {
+                MXLOG_WARNING("MxEngine::ObjectLoader", "cannot create material file: " + ToMxString(tempPath));
+                return;
+            }
+            SaveJson(file, json);
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            MXLOG_WARNING("MxEngine::ObjectLoader", "cannot replace material file: " + ToMxString(path));
+            std::filesystem::remove(tempPath, error);
+        }
     }
 }
\ No newline at end of file
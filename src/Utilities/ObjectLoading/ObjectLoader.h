@@ -142,6 +142,14 @@ namespace MxEngine
         has the mesh normal data (and tangent space) or not
         */
         bool useNormal = false;
+        /*!
+        bounding box of mesh vertecies, computed by loader
+        */
+        AABB boundingBox;
+        /*!
+        bounding sphere of mesh vertecies, computed by loader
+        */
+        BoundingSphere boundingSphere;
     };
 
     using MaterialLibrary = MxVector<MaterialInfo>;
@@ -173,9 +181,28 @@ namespace MxEngine
         loads object from disk by its file path
         \param path absoulute or relative to executable folder path to a file to load
         \returns ObjectInfo instance
-        \warning this function is not thread safe
+        \note function is thread safe. Materials and meshes of object are processed in parallel on global thread pool
         */
         static ObjectInfo Load(const FilePath& path);
+        /*!
+        loads multiple objects concurrently on global thread pool
+        \param paths list of files to load. Paths should be unique, as loader may extract textures next to object file
+        \returns list of ObjectInfo instances in the same order as paths
+        */
+        static MxVector<ObjectInfo> LoadMany(const MxVector<FilePath>& paths);
+        /*!
+        checks if object file format is supported by loader
+        \param path path to a file (only extension is checked)
+        \returns true if object can be loaded with ObjectLoader::Load()
+        */
+        static bool IsFormatSupported(const FilePath& path);
+        /*!
+        checks if texture was written by loader when object was loaded, i.e. extracted from object file or split from combined metallic-roughness texture
+        \param source path to object file
+        \param texture path to texture referenced by material of object
+        \returns true if texture is an output of loading source
+        */
+        static bool IsExtractedTexture(const FilePath& source, const FilePath& texture);
         static MaterialLibrary LoadMaterials(const FilePath& path);
         static void DumpMaterials(const MaterialLibrary& materials, const FilePath& path);
     };
@@ -30,6 +30,7 @@
 #include "Utilities/STL/MxVector.h"
 #include "Utilities/Logging/Logger.h"
 #include <regex>
+#include <algorithm>
 
 namespace MxEngine
 {
@@ -88,6 +89,55 @@ namespace MxEngine
         return *this;
     }
 
+    ShaderPreprocessor& ShaderPreprocessor::LoadUniformBlocks(const ShaderBlockSource* blocks, size_t blockCount)
+    {
+        // #uniform_block directives may appear in shader and in included files. Each requested block is declared once at the top of source
+        std::regex r(R"(#uniform_block\s+(\w+))");
+        MxVector<MxString> requestedBlocks;
+        {
+            std::regex_iterator nameIt(this->source.cbegin(), this->source.cend(), r);
+            std::regex_iterator<MxString::const_iterator> nameEnd;
+            for (; nameIt != nameEnd; nameIt++)
+            {
+                MxString name(this->source.begin() + nameIt->position(1), this->source.begin() + nameIt->position(1) + nameIt->length(1));
+                if (std::find(requestedBlocks.begin(), requestedBlocks.end(), name) == requestedBlocks.end())
+                    requestedBlocks.push_back(std::move(name));
+            }
+        }
+        if (requestedBlocks.empty()) return *this;
+
+        MxString result;
+        result.reserve(this->source.size());
+        auto sourceIt = this->source.cbegin();
+        std::regex_iterator directiveIt(this->source.cbegin(), this->source.cend(), r);
+        std::regex_iterator<MxString::const_iterator> directiveEnd;
+        for (; directiveIt != directiveEnd; directiveIt++)
+        {
+            auto directiveBegin = this->source.cbegin() + directiveIt->position(0);
+            result.append(sourceIt, directiveBegin);
+            sourceIt = directiveBegin + directiveIt->length(0);
+        }
+        result.append(sourceIt, this->source.cend());
+
+        MxString declarations;
+        for (size_t i = 0; i < blockCount; i++)
+        {
+            auto it = std::find(requestedBlocks.begin(), requestedBlocks.end(), blocks[i].Name);
+            if (it == requestedBlocks.end()) continue;
+
+            declarations += blocks[i].Declaration;
+            declarations += '\n';
+            requestedBlocks.erase(it);
+        }
+        for (const auto& name : requestedBlocks)
+        {
+            MXLOG_ERROR("ShaderPreprocessor::LoadUniformBlocks", "requested uniform block was not found: " + name);
+        }
+
+        this->source = declarations + result;
+        return *this;
+    }
+
     ShaderPreprocessor& ShaderPreprocessor::EmitPrefixLine(const MxString& line)
     {
         this->source = line + '\n' + this->source;
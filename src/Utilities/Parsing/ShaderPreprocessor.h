@@ -31,6 +31,12 @@
 
 namespace MxEngine
 {
+    struct ShaderBlockSource
+    {
+        const char* Name;
+        const char* Declaration;
+    };
+
     class ShaderPreprocessor
     {
     public:
@@ -43,6 +49,7 @@ namespace MxEngine
     public:
         ShaderPreprocessor(const MxString& shaderSource);
         ShaderPreprocessor& LoadIncludes(const FilePath& lookupPath);
+        ShaderPreprocessor& LoadUniformBlocks(const ShaderBlockSource* blocks, size_t blockCount);
         ShaderPreprocessor& EmitPrefixLine(const MxString& line);
         ShaderPreprocessor& EmitPostfixLine(const MxString& line);
         const MxVector<MxString>& GetIncludeFiles() const;
@@ -0,0 +1,287 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "FrameStatistics.h"
+#include "Utilities/FileSystem/File.h"
+#include "Utilities/Logging/Logger.h"
+#include "Utilities/Format/Format.h"
+
+#include "Utilities/STL/MxHashMap.h"
+#include "Utilities/Memory/Memory.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace MxEngine
+{
+    /*!
+    time accumulated by one thread for one scope in current frame
+    function is written once by owning thread, duration is added by owning thread and taken by EndFrame()
+    */
+    struct ScopeSlot
+    {
+        std::atomic<const char*> Function{ nullptr };
+        std::atomic<uint64_t> Duration{ 0 };
+    };
+
+    /*!
+    open addressing table of scope slots of one thread, keyed by function name pointer
+    slots are never removed, so recording a scope is a probe and an uncontended atomic add without any locks
+    */
+    struct ThreadAccumulator
+    {
+        constexpr static size_t Capacity = 1024;
+        static_assert((Capacity & (Capacity - 1)) == 0, "thread accumulator capacity must be power of two");
+
+        std::array<ScopeSlot, Capacity> slots;
+        /*!
+        indices of occupied slots, so EndFrame() does not scan whole table. Appended only by owning thread
+        */
+        std::array<uint16_t, Capacity> usedSlots;
+        std::atomic<size_t> usedCount{ 0 };
+        std::atomic<bool> isOverflowed{ false };
+        bool isOverflowReported = false;
+    };
+
+    /*!
+    rolling history of per-frame scope times
+    */
+    struct ScopeHistory
+    {
+        const char* Name = nullptr;
+        std::array<float, FrameStatistics::FrameHistorySize> Samples{ };
+        size_t SampleCount = 0;
+        size_t NextSample = 0;
+        float CurrentFrame = 0.0f;
+        bool IsExecuted = false;
+    };
+
+    struct FrameStatisticsImpl
+    {
+        /*!
+        unique id of statistics instance, so threads do not reuse accumulators of destroyed instance allocated at the same address
+        */
+        uint64_t Id = 0;
+        std::mutex Mutex;
+        MxVector<UniqueRef<ThreadAccumulator>> ThreadAccumulators;
+        MxHashMap<MxString, ScopeHistory> Scopes;
+        MxHashMap<const void*, ScopeHistory*> ScopesByPointer;
+    };
+
+    void FrameStatistics::Init()
+    {
+        static std::atomic<uint64_t> lastId{ 0 };
+        impl = Alloc<FrameStatisticsImpl>();
+        impl->Id = ++lastId;
+    }
+
+    void FrameStatistics::Destroy()
+    {
+        Free(impl);
+        impl = nullptr;
+    }
+
+    FrameStatisticsImpl* FrameStatistics::GetImpl()
+    {
+        return impl;
+    }
+
+    void FrameStatistics::Clone(FrameStatisticsImpl* other)
+    {
+        impl = other;
+    }
+
+    static ThreadAccumulator& GetThreadAccumulator(FrameStatisticsImpl& statistics)
+    {
+        // accumulators are owned by statistics instance, which keeps them until it is destroyed
+        thread_local ThreadAccumulator* accumulator = nullptr;
+        thread_local uint64_t statisticsId = 0;
+        if (statisticsId != statistics.Id)
+        {
+            std::lock_guard lock(statistics.Mutex);
+            statistics.ThreadAccumulators.push_back(MakeUnique<ThreadAccumulator>());
+            accumulator = statistics.ThreadAccumulators.back().get();
+            statisticsId = statistics.Id;
+        }
+        return *accumulator;
+    }
+
+    static ScopeHistory& GetScopeHistory(FrameStatisticsImpl& statistics, const char* function)
+    {
+        // the same scope name may be stored at different addresses in different translation units
+        auto it = statistics.ScopesByPointer.find(function);
+        if (it != statistics.ScopesByPointer.end())
+            return *it->second;
+
+        auto& history = statistics.Scopes[MxString(function)];
+        history.Name = function;
+        statistics.ScopesByPointer[function] = &history;
+        return history;
+    }
+
+    static ScopeTimingStatistics ComputeStatistics(const ScopeHistory& history)
+    {
+        ScopeTimingStatistics result;
+        result.Name = history.Name;
+        result.SampleCount = history.SampleCount;
+        if (history.SampleCount == 0) return result;
+
+        std::array<float, FrameStatistics::FrameHistorySize> sorted;
+        std::copy(history.Samples.begin(), history.Samples.begin() + history.SampleCount, sorted.begin());
+        std::sort(sorted.begin(), sorted.begin() + history.SampleCount);
+
+        auto Percentile = [&sorted, count = history.SampleCount](float percentile)
+        {
+            return sorted[std::min(count - 1, size_t(percentile * (float)count))];
+        };
+
+        result.P50 = Percentile(0.50f);
+        result.P95 = Percentile(0.95f);
+        result.P99 = Percentile(0.99f);
+        result.Max = sorted[history.SampleCount - 1];
+        return result;
+    }
+
+    void FrameStatistics::Record(const char* function, uint64_t duration)
+    {
+        // scopes may be executed before engine is initialized or after it is destroyed
+        if (impl == nullptr) return;
+
+        auto& accumulator = GetThreadAccumulator(*impl);
+        constexpr size_t mask = ThreadAccumulator::Capacity - 1;
+        size_t index = size_t(((uintptr_t)function >> 3) * 0x9E3779B97F4A7C15ull) & mask;
+        for (size_t probe = 0; probe < ThreadAccumulator::Capacity; probe++)
+        {
+            auto& slot = accumulator.slots[(index + probe) & mask];
+            // only owning thread writes slot function, so relaxed load always sees its own stores
+            const char* slotFunction = slot.Function.load(std::memory_order_relaxed);
+            if (slotFunction == nullptr)
+            {
+                size_t usedCount = accumulator.usedCount.load(std::memory_order_relaxed);
+                slot.Function.store(function, std::memory_order_relaxed);
+                accumulator.usedSlots[usedCount] = uint16_t((index + probe) & mask);
+                accumulator.usedCount.store(usedCount + 1, std::memory_order_release);
+                slotFunction = function;
+            }
+            if (slotFunction == function)
+            {
+                slot.Duration.fetch_add(duration, std::memory_order_relaxed);
+                return;
+            }
+        }
+        accumulator.isOverflowed.store(true, std::memory_order_relaxed);
+    }
+
+    void FrameStatistics::EndFrame()
+    {
+        std::lock_guard lock(impl->Mutex);
+        for (auto& accumulator : impl->ThreadAccumulators)
+        {
+            if (accumulator->isOverflowed.load(std::memory_order_relaxed) && !accumulator->isOverflowReported)
+            {
+                MXLOG_WARNING("MxEngine::FrameStatistics", "too many different scopes are recorded by one thread, some of them are not measured");
+                accumulator->isOverflowReported = true;
+            }
+
+            size_t usedCount = accumulator->usedCount.load(std::memory_order_acquire);
+            for (size_t i = 0; i < usedCount; i++)
+            {
+                auto& slot = accumulator->slots[accumulator->usedSlots[i]];
+                const char* function = slot.Function.load(std::memory_order_relaxed);
+                uint64_t duration = slot.Duration.exchange(0, std::memory_order_relaxed);
+                if (duration == 0) continue;
+
+                auto& history = GetScopeHistory(*impl, function);
+                history.CurrentFrame += float(duration) * 0.000001f;
+                history.IsExecuted = true;
+            }
+        }
+
+        // only frames in which scope was executed are recorded, so rarely called scopes are not dominated by zeros
+        for (auto& [name, history] : impl->Scopes)
+        {
+            if (!history.IsExecuted) continue;
+
+            history.Samples[history.NextSample] = history.CurrentFrame;
+            history.NextSample = (history.NextSample + 1) % FrameHistorySize;
+            history.SampleCount = std::min(history.SampleCount + 1, FrameHistorySize);
+            history.CurrentFrame = 0.0f;
+            history.IsExecuted = false;
+        }
+    }
+
+    ScopeTimingStatistics FrameStatistics::GetStatistics(std::string_view function)
+    {
+        std::lock_guard lock(impl->Mutex);
+        auto it = impl->Scopes.find(MxString(function.data(), function.size()));
+        if (it == impl->Scopes.end()) return ScopeTimingStatistics{ };
+        return ComputeStatistics(it->second);
+    }
+
+    MxVector<ScopeTimingStatistics> FrameStatistics::GetAllStatistics()
+    {
+        MxVector<ScopeTimingStatistics> result;
+        {
+            std::lock_guard lock(impl->Mutex);
+            result.reserve(impl->Scopes.size());
+            for (const auto& [name, history] : impl->Scopes)
+                result.push_back(ComputeStatistics(history));
+        }
+
+        std::sort(result.begin(), result.end(), [](const auto& s1, const auto& s2) { return s1.P95 > s2.P95; });
+        return result;
+    }
+
+    void FrameStatistics::DumpCSV(const MxString& filename)
+    {
+        File output(filename, File::WRITE);
+        if (!output.IsOpen())
+        {
+            MXLOG_WARNING("MxEngine::FrameStatistics", "cannot open file to write frame statistics: " + filename);
+            return;
+        }
+
+        output << "scope,samples,p50_ms,p95_ms,p99_ms,max_ms\n";
+        for (const auto& statistics : GetAllStatistics())
+        {
+            // scope names may contain commas (i.e. template arguments), so they are always quoted
+            output << MxFormat("\"{}\",{},{:.4f},{:.4f},{:.4f},{:.4f}\n",
+                statistics.Name, statistics.SampleCount, statistics.P50, statistics.P95, statistics.P99, statistics.Max);
+        }
+    }
+
+    void FrameStatistics::Clear()
+    {
+        std::lock_guard lock(impl->Mutex);
+        impl->ScopesByPointer.clear();
+        impl->Scopes.clear();
+    }
+}
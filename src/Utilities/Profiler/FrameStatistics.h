@@ -0,0 +1,105 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include "Utilities/STL/MxString.h"
+#include "Utilities/STL/MxVector.h"
+
+#include <string_view>
+
+namespace MxEngine
+{
+    /*!
+    timings of one profiled scope over last frames, all values are measured in milliseconds
+    */
+    struct ScopeTimingStatistics
+    {
+        const char* Name = nullptr;
+        size_t SampleCount = 0;
+        float P50 = 0.0f;
+        float P95 = 0.0f;
+        float P99 = 0.0f;
+        float Max = 0.0f;
+    };
+
+    struct FrameStatisticsImpl;
+
+    /*!
+    frame statistics collect time spent in each MAKE_SCOPE_PROFILER scope per frame into fixed-size rolling histories
+    unlike ProfileSession it does not write anything to disk while application is running, so it can be always kept enabled
+    scopes can be recorded from any thread, frame boundaries are set by application main loop
+    */
+    class FrameStatistics
+    {
+        inline static FrameStatisticsImpl* impl = nullptr;
+    public:
+        /*!
+        number of last frames which are kept for each scope
+        */
+        constexpr static size_t FrameHistorySize = 256;
+
+        static void Init();
+        static void Destroy();
+        static FrameStatisticsImpl* GetImpl();
+        static void Clone(FrameStatisticsImpl* other);
+
+        /*!
+        adds scope execution time to current frame. Safe to call from any thread, does not lock
+        if calling thread already recorded too many different scopes or FrameStatistics is not initialized, time is dropped
+        \param function scope name. Must point to a string with static storage duration
+        \param duration scope execution time in nanoseconds
+        */
+        static void Record(const char* function, uint64_t duration);
+        /*!
+        ends current frame, moving accumulated scope times to rolling histories. Called once per frame by application
+        */
+        static void EndFrame();
+        /*!
+        computes percentiles of scope execution time over last frames
+        \param function scope name, as passed to MAKE_SCOPE_PROFILER
+        \returns scope statistics (empty if scope was never executed)
+        */
+        static ScopeTimingStatistics GetStatistics(std::string_view function);
+        /*!
+        computes percentiles for all recorded scopes
+        \returns scope statistics sorted by p95 in descending order
+        */
+        static MxVector<ScopeTimingStatistics> GetAllStatistics();
+        /*!
+        writes statistics of all recorded scopes to csv file
+        \param filename path to output csv file
+        */
+        static void DumpCSV(const MxString& filename);
+        /*!
+        removes all recorded scope histories
+        */
+        static void Clear();
+    };
+}
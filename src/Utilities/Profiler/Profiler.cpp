@@ -28,6 +28,7 @@
 
 #include "Profiler.h"
 #include "Utilities/STL/MxString.h"
+#include "Utilities/Format/Format.h"
 
 namespace MxEngine
 {
@@ -45,6 +46,80 @@ namespace MxEngine
         output << '}';
     }
 
+    void ProfileSession::WriteJsonEntry(const ProfileEvent& event)
+    {
+        // chrome tracing expects microseconds, fractional part keeps nanosecond precision for short scopes
+        auto FormatMicroseconds = [](uint64_t nanoseconds)
+        {
+            auto fraction = std::to_string(nanoseconds % 1000);
+            return std::to_string(nanoseconds / 1000) + '.' + std::string(3 - fraction.size(), '0') + fraction;
+        };
+
+        if (this->entriesCount.load(std::memory_order_relaxed) > 0)
+        {
+            output << ",\n";
+        }
+        this->entriesCount.fetch_add(1, std::memory_order_relaxed);
+
+        output << "    {";
+        output << "\"pid\": 0, ";
+        output << "\"tid\": " << std::to_string(event.ThreadId) << ", ";
+        output << "\"ts\": " << FormatMicroseconds(event.Begin) << ", ";
+        output << "\"dur\": " << FormatMicroseconds(event.Duration) << ", ";
+        output << "\"ph\": \"X\", ";
+        output << "\"name\": \"" << event.Function << '\"';
+        output << "}";
+    }
+
+    void ProfileSession::FlushEvents()
+    {
+        if (!this->IsValid()) return;
+
+        // buffers are never removed, so only the vector itself must be protected while other threads register
+        std::unique_lock lock(this->bufferMutex);
+        size_t bufferCount = this->threadBuffers.size();
+        lock.unlock();
+
+        for (size_t i = 0; i < bufferCount; i++)
+        {
+            lock.lock();
+            auto* buffer = this->threadBuffers[i].get();
+            lock.unlock();
+
+            buffer->Drain([this](const ProfileEvent& event) { this->WriteJsonEntry(event); });
+        }
+    }
+
+    void ProfileSession::FlusherLoop()
+    {
+        std::unique_lock lock(this->flusherMutex);
+        while (!this->isFlusherStopped)
+        {
+            this->flusherCondition.wait_for(lock, FlushInterval);
+            lock.unlock();
+            this->FlushEvents();
+            lock.lock();
+        }
+    }
+
+    ProfileEventBuffer& ProfileSession::GetThreadBuffer()
+    {
+        thread_local ProfileEventBuffer* threadBuffer = nullptr;
+        if (threadBuffer == nullptr)
+        {
+            std::lock_guard lock(this->bufferMutex);
+            auto threadId = (uint32_t)this->threadBuffers.size();
+            this->threadBuffers.push_back(MakeUnique<ProfileEventBuffer>(threadId));
+            threadBuffer = this->threadBuffers.back().get();
+        }
+        return *threadBuffer;
+    }
+
+    ProfileSession::~ProfileSession()
+    {
+        this->EndSession();
+    }
+
     bool ProfileSession::IsValid() const
     {
         return this->output.IsOpen();
@@ -52,41 +127,61 @@ namespace MxEngine
 
     size_t ProfileSession::GetEntryCount() const
     {
-        return this->entriesCount;
+        return this->entriesCount.load(std::memory_order_relaxed);
     }
 
-    void ProfileSession::StartSession(const MxString& filename)
+    size_t ProfileSession::GetDroppedCount() const
     {
-        if (output.IsOpen()) output.Close();
-        output.Open(filename.c_str(), File::WRITE);
-        this->WriteJsonHeader();
+        return this->droppedCount.load(std::memory_order_relaxed);
     }
 
-    void ProfileSession::WriteJsonEntry(const char* function, TimeStep begin, TimeStep delta)
+    void ProfileSession::StartSession(const MxString& filename)
     {
-        if (!this->IsValid()) return;
+        this->EndSession();
 
-        if (this->GetEntryCount() > 0)
+        output.Open(filename.c_str(), File::WRITE);
+        this->WriteJsonHeader();
+
+        // events recorded after previous session ended must not leak into the new one
         {
-            output << ",\n";
+            std::lock_guard lock(this->bufferMutex);
+            for (auto& buffer : this->threadBuffers)
+                buffer->Discard();
         }
-        this->entriesCount++;
+        this->entriesCount = 0;
+        this->droppedCount = 0;
 
-        output << "    {";
-        output << "\"pid\": 0, ";
-        output << "\"tid\": 0, ";
-        output << "\"ts\": " << std::to_string(uint64_t((double)begin * 1000000)) << ", ";
-        output << "\"dur\": " << std::to_string(uint64_t((double)delta * 1000000)) << ", ";
-        output << "\"ph\": \"X\", ";
-        output << "\"name\": \"" << function << '\"';
-        output << "}";
+        this->isFlusherStopped = false;
+        this->flusher = std::thread([this]() { this->FlusherLoop(); });
+        this->isActive.store(true, std::memory_order_release);
+    }
+
+    void ProfileSession::RecordEvent(const char* function, uint64_t begin, uint64_t duration)
+    {
+        if (!this->GetThreadBuffer().Push(function, begin, duration))
+            this->droppedCount.fetch_add(1, std::memory_order_relaxed);
     }
 
     void ProfileSession::EndSession()
     {
+        this->isActive.store(false, std::memory_order_release);
+        if (this->flusher.joinable())
+        {
+            {
+                std::lock_guard lock(this->flusherMutex);
+                this->isFlusherStopped = true;
+            }
+            this->flusherCondition.notify_one();
+            this->flusher.join();
+        }
+
         if (!this->IsValid()) return;
+        this->FlushEvents();
         this->WriteJsonFooter();
         output.Close();
+
+        if (this->GetDroppedCount() > 0)
+            MXLOG_WARNING("MxEngine::Profiler", MxFormat("{} profile events were dropped because thread buffers overflowed", this->GetDroppedCount()));
     }
 
     ScopeTimer::~ScopeTimer()
@@ -32,23 +32,133 @@
 #include "Utilities/Time/Time.h"
 #include "Utilities/Logging/Logger.h"
 #include "Utilities/FileSystem/File.h"
+#include "Utilities/Profiler/FrameStatistics.h"
+#include "Utilities/STL/MxVector.h"
+#include "Utilities/Memory/Memory.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 
 namespace MxEngine
 {
     /*!
-    profile session is a special singleton object which periodically writes log to a json file
-    it is used inside ScopeProfiler to write time measurements. After application exit log can be viewed at chrome://tracing page
+    binary profile event, recorded by ScopeProfiler. Function name is not copied, so it must point to a string literal
+    */
+    struct ProfileEvent
+    {
+        const char* Function;
+        uint64_t Begin;
+        uint64_t Duration;
+        uint32_t ThreadId;
+    };
+
+    /*!
+    fixed-size single producer / single consumer ring buffer of profile events
+    each thread which records events owns exactly one buffer, which is drained by ProfileSession flusher thread
+    */
+    class ProfileEventBuffer
+    {
+    public:
+        constexpr static size_t Capacity = 8192;
+    private:
+        static_assert((Capacity & (Capacity - 1)) == 0, "profile event buffer capacity must be power of two");
+
+        std::array<ProfileEvent, Capacity> events;
+        /*!
+        index of next event to write. Modified only by owning thread
+        */
+        alignas(64) std::atomic<size_t> head{ 0 };
+        /*!
+        index of next event to read. Modified only by flusher thread
+        */
+        alignas(64) std::atomic<size_t> tail{ 0 };
+        uint32_t threadId;
+    public:
+        explicit ProfileEventBuffer(uint32_t threadId) : threadId(threadId) { }
+
+        /*!
+        pushes new event to buffer. Must be called only from owning thread
+        \returns false if buffer is full and event was dropped, true either
+        */
+        bool Push(const char* function, uint64_t begin, uint64_t duration)
+        {
+            size_t currentHead = this->head.load(std::memory_order_relaxed);
+            if (currentHead - this->tail.load(std::memory_order_acquire) == Capacity)
+                return false;
+
+            auto& event = this->events[currentHead & (Capacity - 1)];
+            event.Function = function;
+            event.Begin = begin;
+            event.Duration = duration;
+            event.ThreadId = this->threadId;
+
+            this->head.store(currentHead + 1, std::memory_order_release);
+            return true;
+        }
+
+        /*!
+        pops all events which are currently in the buffer. Must be called only from flusher thread
+        \param func callback which accepts const ProfileEvent&
+        \returns number of events popped
+        */
+        template<typename Func>
+        size_t Drain(Func&& func)
+        {
+            size_t currentTail = this->tail.load(std::memory_order_relaxed);
+            size_t currentHead = this->head.load(std::memory_order_acquire);
+            for (size_t i = currentTail; i != currentHead; i++)
+                func(this->events[i & (Capacity - 1)]);
+
+            this->tail.store(currentHead, std::memory_order_release);
+            return currentHead - currentTail;
+        }
+
+        /*!
+        drops all events in the buffer. Can be called only when no flusher thread is running
+        */
+        void Discard()
+        {
+            this->tail.store(this->head.load(std::memory_order_acquire), std::memory_order_release);
+        }
+    };
+
+    /*!
+    profile session is a special singleton object which collects profile events from all threads and writes them to a json file
+    events are recorded to per-thread lock-free buffers and streamed to disk by a background flusher thread, so measured scopes never wait for file I/O
+    After application exit log can be viewed at chrome://tracing page
     */
     class ProfileSession
     {
         /*!
-        json file to which profile log is outputted
+        json file to which profile log is outputted. Accessed only by flusher thread while session is active
         */
         File output;
         /*!
         count of json log entries (is used internally to create json file)
         */
-        size_t entriesCount = 0;
+        std::atomic<size_t> entriesCount{ 0 };
+        /*!
+        count of events which were dropped because thread buffer was full
+        */
+        std::atomic<size_t> droppedCount{ 0 };
+        /*!
+        true between StartSession and EndSession calls, checked by ScopeProfiler before measuring
+        */
+        std::atomic<bool> isActive{ false };
+        /*!
+        buffers of all threads which ever recorded events. Buffers are never freed, as threads store pointers to them
+        */
+        MxVector<UniqueRef<ProfileEventBuffer>> threadBuffers;
+        std::mutex bufferMutex;
+
+        std::thread flusher;
+        std::mutex flusherMutex;
+        std::condition_variable flusherCondition;
+        bool isFlusherStopped = false;
 
         /*!
         writes header of json file, i.e "{ traceEvents: [ ..."
@@ -58,31 +168,68 @@ namespace MxEngine
         writes footer of json file, i.e "] }"
         */
         void WriteJsonFooter();
+        /*!
+        writes json entry, consisting of process id, thread id, start/end time, function name
+        \param event profile event to write
+        */
+        void WriteJsonEntry(const ProfileEvent& event);
+        /*!
+        writes all events accumulated in thread buffers to json file
+        */
+        void FlushEvents();
+        /*!
+        main loop of flusher thread. Periodically flushes events until session is ended
+        */
+        void FlusherLoop();
+        /*!
+        gets buffer of calling thread, creating new one if thread has not recorded events before
+        */
+        ProfileEventBuffer& GetThreadBuffer();
     public:
+        /*!
+        interval between flushes of thread buffers to disk
+        */
+        constexpr static std::chrono::milliseconds FlushInterval{ 10 };
+
+        ProfileSession() = default;
+        ProfileSession(const ProfileSession&) = delete;
+        ProfileSession& operator=(const ProfileSession&) = delete;
+        ~ProfileSession();
+
         /*!
         checks if json file is opened
         \returns true if json file can be written to, false either
         */
         bool IsValid() const;
         /*!
+        checks if session is started and events should be recorded
+        \returns true if session is active
+        */
+        bool IsActive() const { return this->isActive.load(std::memory_order_relaxed); }
+        /*!
         getter for entriesCount
         \returns number of json entries
         */
         size_t GetEntryCount() const;
         /*!
-        creates json file or clears it if it exists and writes json header to it
+        getter for droppedCount
+        \returns number of events which were lost because thread buffer overflowed
+        */
+        size_t GetDroppedCount() const;
+        /*!
+        creates json file or clears it if it exists, writes json header to it and launches flusher thread
         \param filename file to output json to
         */
         void StartSession(const MxString& filename);
         /*!
-        writes json entry, consisting of process id, start/end time, function name
-        \param function called function name 
-        \param begin start timepoint of function execution
-        \param delta duration of function execution
+        records profile event to calling thread buffer. Safe to call from any thread
+        \param function called function name. Must point to a string with static storage duration
+        \param begin start timepoint of function execution in nanoseconds
+        \param duration duration of function execution in nanoseconds
         */
-        void WriteJsonEntry(const char* function, TimeStep begin, TimeStep delta);
+        void RecordEvent(const char* function, uint64_t begin, uint64_t duration);
         /*!
-        ends profile measurement, writing json footer and saving json file to disk
+        ends profile measurement, stopping flusher thread, writing remaining events, json footer and saving json file to disk
         */
         void EndSession();
     };
@@ -92,20 +239,30 @@ namespace MxEngine
         inline static ProfileSession impl;
     public:
         static void Start(const MxString& filename) { impl.StartSession(filename); }
-        static void WriteEntry(const char* function, TimeStep begin, TimeStep delta) { impl.WriteJsonEntry(function, begin, delta); }
+        static bool IsActive() { return impl.IsActive(); }
+        static void WriteEntry(const char* function, uint64_t begin, uint64_t duration) { impl.RecordEvent(function, begin, duration); }
         static void Finish() { impl.EndSession(); }
+
+        /*!
+        gets monotonic timestamp used by profiler. Unlike Time::EngineCurrent() it is safe to call from any thread
+        \returns nanoseconds since arbitrary point in time
+        */
+        static uint64_t Now()
+        {
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
     };
 
     /*!
     scope profiler is a class which measures how much time take the function execution 
-    it saves timestep om its creation, and writes json entry to ProfileSession on its destruction
+    it saves timestep om its creation, and on its destruction adds measured time to FrameStatistics and records profile event to ProfileSession
     */
     class ScopeProfiler
     {
         /*!
         construction time point and start of function execution
         */
-        TimeStep start;
+        uint64_t start;
         /*!
         function name which is measured
         */
@@ -113,19 +270,20 @@ namespace MxEngine
     public:
         /*!
         creates scope profiler and fixes timepoint as start of function call
-        \param profiler reference to json profile logger
         \param function function name which is measured
         */
         ScopeProfiler(const char* function)
-            : start(Time::EngineCurrent()), function(function) { }
+            : start(Profiler::Now()), function(function) { }
 
         /*!
-        destroyed scope profiler, forcing it to write json entry to profiler
+        destroyed scope profiler, forcing it to record profile event
         */
         ~ScopeProfiler()
         {
-            TimeStep end = Time::EngineCurrent();
-            Profiler::WriteEntry(this->function, this->start, end - start);
+            uint64_t duration = Profiler::Now() - this->start;
+            FrameStatistics::Record(this->function, duration);
+            if (Profiler::IsActive())
+                Profiler::WriteEntry(this->function, this->start, duration);
         }
     };
 
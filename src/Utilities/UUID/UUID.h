@@ -65,6 +65,11 @@ namespace MxEngine
 
     std::ostream& operator<<(std::ostream& out, const UUID& uuid);
 
+    inline MxString ToMxString(const UUID& uuid)
+    {
+        return uuid;
+    }
+
     struct UUIDGeneratorImpl
     {
         using type = uuids::basic_uuid_random_generator<Random::Generator>;
@@ -0,0 +1,478 @@
+// Copyright(c) 2019 - 2020, #Momo
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met :
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and /or other materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#pragma once
+
+#include "Utilities/STL/MxVector.h"
+#include "Core/Macro/Macro.h"
+
+#include <cstring>
+#include <limits>
+
+namespace MxEngine
+{
+    /*!
+    CompactVectorPool is an object Pool class with the same interface as VectorPool, but with objects kept densely packed
+    objects are accessed by stable handle, which is translated to position in dense storage through indirection table
+    deallocation leaves a hole in dense storage, holes are removed by Compact() which moves live objects to the front and shrinks memory
+    as with VectorPool, objects are relocated by memcpy, so they must not store pointers to themselves
+    */
+    template<typename T, template<typename, typename...> typename Container = MxVector>
+    class CompactVectorPool
+    {
+        using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+        constexpr static size_t InvalidIndex = std::numeric_limits<size_t>::max();
+    public:
+        /*!
+        minimal number of holes in dense storage before pool is considered fragmented
+        */
+        constexpr static size_t MinCompactHoleCount = 32;
+
+        /*!
+        iterator for CompactVectorPool class. Walks dense storage, skipping holes left since last Compact() call
+        */
+        class PoolIterator
+        {
+            /*!
+            current position in dense storage
+            */
+            size_t index = 0;
+            /*!
+            reference to vector Pool. This means that vector Pool must not be moved/deleted until iterator exists
+            */
+            CompactVectorPool<T, Container>* poolRef;
+        public:
+            /*!
+            gets handle of object iterator points to
+            \returns handle, which can be passed to operator[] or Deallocate()
+            */
+            size_t GetBase() const
+            {
+                return poolRef->denseHandles[index];
+            }
+
+            CompactVectorPool<T, Container>& GetPoolRef() const
+            {
+                return *poolRef;
+            }
+
+            /*!
+            construct new iterator of vector Pool
+            \param index position in dense storage (0 for begin(), dense size for end() methods)
+            \param ref reference to vector Pool
+            */
+            PoolIterator(size_t index, CompactVectorPool<T, Container>& ref)
+                : index(index), poolRef(&ref)
+            {
+                while (this->index < this->poolRef->denseHandles.size() && this->poolRef->denseHandles[this->index] == InvalidIndex)
+                {
+                    this->index++;
+                }
+            }
+
+            PoolIterator operator++(int)
+            {
+                PoolIterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            PoolIterator operator++()
+            {
+                do { index++; } while (index < poolRef->denseHandles.size() && poolRef->denseHandles[index] == InvalidIndex);
+                return *this;
+            }
+
+            PoolIterator operator--(int)
+            {
+                PoolIterator copy = *this;
+                --(*this);
+                return copy;
+            }
+
+            PoolIterator operator--()
+            {
+                do { index--; } while (index < poolRef->denseHandles.size() && poolRef->denseHandles[index] == InvalidIndex);
+                return *this;
+            }
+
+            T* operator->() const
+            {
+                return std::addressof(poolRef->GetDense(index));
+            }
+
+            T& operator*() const
+            {
+                return poolRef->GetDense(index);
+            }
+
+            bool operator==(const PoolIterator& it) const
+            {
+                return (index == it.index) && (poolRef == it.poolRef);
+            }
+
+            bool operator!=(const PoolIterator& it) const
+            {
+                return !(*this == it);
+            }
+        };
+
+        using value_type = T;
+        using iterator = PoolIterator;
+    private:
+        /*!
+        densely packed objects. May contain holes left by Deallocate() until Compact() is called
+        */
+        Container<Storage> dense;
+        /*!
+        handle of object at each dense position, InvalidIndex for holes
+        */
+        MxVector<size_t> denseHandles;
+        /*!
+        dense position of each handle, InvalidIndex for handles which are not in use
+        */
+        MxVector<size_t> sparse;
+        /*!
+        handles which can be reused by Allocate()
+        */
+        MxVector<size_t> freeHandles;
+        /*!
+        generation of each handle, incremented when element is destroyed. Not released by Compact(), so stale handles stay detectable after reuse
+        */
+        MxVector<uint32_t> generations;
+        /*!
+        number of constructed objects
+        */
+        size_t allocated = 0;
+
+        void NextGeneration(size_t handle)
+        {
+            // zero generation is never issued, as it is reserved for null ids
+            if (++this->generations[handle] == 0) this->generations[handle] = 1;
+        }
+
+        T& GetDense(size_t index)
+        {
+            MX_ASSERT(index < this->dense.size());
+            return *std::launder(reinterpret_cast<T*>(&this->dense[index]));
+        }
+
+        const T& GetDense(size_t index) const
+        {
+            MX_ASSERT(index < this->dense.size());
+            return *std::launder(reinterpret_cast<const T*>(&this->dense[index]));
+        }
+    public:
+        CompactVectorPool() = default;
+        CompactVectorPool(const CompactVectorPool&) = delete;
+        CompactVectorPool& operator=(const CompactVectorPool&) = delete;
+        CompactVectorPool(CompactVectorPool&&) = default;
+        CompactVectorPool& operator=(CompactVectorPool&&) = default;
+
+        /*!
+        constructs vector Pool with count elements preallocated in dense storage
+        \count number of preallocated elements (not constructed)
+        */
+        CompactVectorPool(size_t count)
+        {
+            this->Resize(count);
+        }
+
+        ~CompactVectorPool()
+        {
+            this->Clear();
+        }
+
+        /*!
+        reserves memory for count elements. If new count is less or equal than current, request is ignored
+        \param count new number of preallocated elements in container (not constructed)
+        */
+        void Resize(size_t count)
+        {
+            this->dense.reserve(count);
+            this->denseHandles.reserve(count);
+        }
+
+        /*!
+        gets how many elements are in use (constructed)
+        \returns count of currently allocated elements
+        */
+        size_t Allocated() const
+        {
+            return this->allocated;
+        }
+
+        /*!
+        gets total number of handles issued by the pool
+        \returns upper bound of handle values
+        */
+        size_t Capacity() const
+        {
+            return this->sparse.size();
+        }
+
+        /*!
+        gets total number in bytes allocated for container
+        \returns how many bytes are allocated for pool, including indirection table
+        */
+        size_t CapacityInBytes() const
+        {
+            return this->dense.capacity() * sizeof(Storage) + 
+                (this->denseHandles.capacity() + this->sparse.capacity() + this->freeHandles.capacity()) * sizeof(size_t) +
+                this->generations.capacity() * sizeof(uint32_t);
+        }
+
+        /*!
+        gets generation of handle, which changes each time element with this handle is destroyed
+        \param handle handle of element in vector Pool
+        \returns non-zero generation of handle or 0 if handle was never issued
+        */
+        uint32_t GetGeneration(size_t handle) const
+        {
+            return handle < this->generations.size() ? this->generations[handle] : 0;
+        }
+
+        /*!
+        gets number of holes in dense storage, which are removed by next Compact() call
+        */
+        size_t HoleCount() const
+        {
+            return this->dense.size() - this->allocated;
+        }
+
+        /*!
+        gets size of dense storage, including holes. Can be used to split iteration into ranges of dense indices
+        */
+        size_t DenseSize() const
+        {
+            return this->denseHandles.size();
+        }
+
+        /*!
+        gets element by its index in dense storage
+        \param index dense index in range [0, DenseSize())
+        \returns pointer to element or nullptr if there is a hole at this index
+        */
+        T* GetDenseOrNull(size_t index)
+        {
+            if (this->denseHandles[index] == InvalidIndex) return nullptr;
+            return std::addressof(this->GetDense(index));
+        }
+
+        T& operator[] (size_t handle)
+        {
+            MX_ASSERT(this->IsAllocated(handle));
+            return this->GetDense(this->sparse[handle]);
+        }
+
+        const T& operator[] (size_t handle) const
+        {
+            MX_ASSERT(this->IsAllocated(handle));
+            return this->GetDense(this->sparse[handle]);
+        }
+
+        /*!
+        clears container. All constructed elements are destroyed
+        */
+        void Clear()
+        {
+            for (size_t i = 0; i < this->denseHandles.size(); i++)
+            {
+                if (this->denseHandles[i] != InvalidIndex)
+                {
+                    this->GetDense(i).~T();
+                    this->NextGeneration(this->denseHandles[i]);
+                }
+            }
+            this->dense.clear();
+            this->denseHandles.clear();
+            this->sparse.clear();
+            this->freeHandles.clear();
+            this->allocated = 0;
+        }
+
+        /*!
+        checks if element is constructed
+        \param handle handle of element in vector Pool
+        \returns true if element is constructed, false either
+        */
+        bool IsAllocated(size_t handle) const
+        {
+            return handle < this->sparse.size() && this->sparse[handle] != InvalidIndex;
+        }
+
+        /*!
+        destroys element in vector Pool. Other elements are not moved until Compact() is called, so it is safe to deallocate while iterating
+        \param handle handle of element to destroy
+        */
+        void Deallocate(size_t handle)
+        {
+            if (!this->IsAllocated(handle)) return;
+
+            size_t index = this->sparse[handle];
+            this->GetDense(index).~T();
+            this->denseHandles[index] = InvalidIndex;
+            this->sparse[handle] = InvalidIndex;
+            this->NextGeneration(handle);
+            this->freeHandles.push_back(handle);
+            this->allocated--;
+        }
+
+        void Deallocate(const PoolIterator& it)
+        {
+            this->Deallocate(it.GetBase());
+        }
+
+        /*!
+        constructs element at the end of dense storage
+        \param args arguments for element constructor
+        \returns handle of element in vector Pool
+        */
+        template<typename... Args>
+        size_t Allocate(Args&&... args)
+        {
+            size_t handle = this->sparse.size();
+            if (!this->freeHandles.empty())
+            {
+                handle = this->freeHandles.back();
+                this->freeHandles.pop_back();
+            }
+            else
+            {
+                this->sparse.push_back(InvalidIndex);
+                if (handle >= this->generations.size())
+                    this->generations.push_back(1);
+            }
+
+            size_t index = this->dense.size();
+            this->dense.emplace_back();
+            (void)new(&this->dense[index]) T(std::forward<Args>(args)...);
+            this->denseHandles.push_back(handle);
+            this->sparse[handle] = index;
+            this->allocated++;
+            return handle;
+        }
+
+        /*!
+        retrieves handle of element in vector Pool by reference
+        \param obj element of vector Pool
+        \returns handle of element in vector Pool
+        \warning behaviour is undefined if Allocate() or Compact() were called between reference construction and IndexOf() call
+        */
+        size_t IndexOf(const T& obj)
+        {
+            const Storage* ptr = reinterpret_cast<const Storage*>(std::addressof(obj));
+            MX_ASSERT(this->dense.data() <= ptr && ptr < this->dense.data() + this->dense.size());
+            return this->denseHandles[ptr - this->dense.data()];
+        }
+
+        /*!
+        checks if dense storage has enough holes or unused memory to be worth compacting
+        \returns true if Compact() should be called
+        */
+        bool IsFragmented() const
+        {
+            size_t holes = this->HoleCount();
+            size_t unusedMemory = this->dense.capacity() - this->allocated;
+            return (holes >= MinCompactHoleCount && holes * 4 >= this->dense.size()) ||
+                (unusedMemory >= MinCompactHoleCount && this->allocated * 4 < this->dense.capacity());
+        }
+
+        /*!
+        moves all live elements to the front of dense storage, releases unused handles at the end of handle range and shrinks memory
+        handles stay valid, but references and iterators to elements are invalidated
+        */
+        void Compact()
+        {
+            size_t write = 0;
+            for (size_t read = 0; read < this->denseHandles.size(); read++)
+            {
+                size_t handle = this->denseHandles[read];
+                if (handle == InvalidIndex) continue;
+
+                if (write != read)
+                {
+                    std::memcpy(&this->dense[write], &this->dense[read], sizeof(Storage));
+                    this->denseHandles[write] = handle;
+                    this->sparse[handle] = write;
+                }
+                write++;
+            }
+            this->dense.resize(write);
+            this->denseHandles.resize(write);
+
+            // handles must stay stable, so only unused handles at the end of range can be released
+            while (!this->sparse.empty() && this->sparse.back() == InvalidIndex)
+                this->sparse.pop_back();
+
+            this->freeHandles.clear();
+            for (size_t handle = this->sparse.size(); handle > 0; handle--)
+            {
+                if (this->sparse[handle - 1] == InvalidIndex)
+                    this->freeHandles.push_back(handle - 1);
+            }
+
+            this->dense.shrink_to_fit();
+            this->denseHandles.shrink_to_fit();
+            this->sparse.shrink_to_fit();
+            this->freeHandles.shrink_to_fit();
+        }
+
+        /*!
+        compacts pool if it is fragmented
+        \returns true if pool was compacted, false either
+        */
+        bool CompactIfFragmented()
+        {
+            if (!this->IsFragmented()) return false;
+            this->Compact();
+            return true;
+        }
+
+        auto begin()
+        {
+            return PoolIterator{ 0, *this };
+        }
+
+        auto end()
+        {
+            return PoolIterator{ this->dense.size(), *this };
+        }
+
+        bool empty() const
+        {
+            return this->Allocated() == 0;
+        }
+
+        size_t size() const
+        {
+            return this->Allocated();
+        }
+    };
+}
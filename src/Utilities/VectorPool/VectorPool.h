@@ -175,10 +175,20 @@ namespace MxEngine
         */
         Allocator allocator;
         /*!
+        generation of each slot, incremented when element in slot is destroyed. Never shrinks, so stale indices of reused slots can be detected
+        */
+        Container<uint32_t> generations;
+        /*!
         number of constructed objects
         */
         size_t allocated = 0;
 
+        void NextGeneration(size_t index)
+        {
+            // zero generation is never issued, as it is reserved for null ids
+            if (++this->generations[index] == 0) this->generations[index] = 1;
+        }
+
         Block* GetBlockByIndex(size_t index)
         {
             size_t byteIndex = index * sizeof(Block);
@@ -244,7 +254,17 @@ namespace MxEngine
         */
         size_t CapacityInBytes() const
         {
-            return memoryStorage.size();
+            return memoryStorage.size() + this->generations.size() * sizeof(uint32_t);
+        }
+
+        /*!
+        gets generation of slot, which changes each time element in the slot is destroyed
+        \param index index of element in vector Pool
+        \returns non-zero generation of slot or 0 if slot was never used
+        */
+        uint32_t GetGeneration(size_t index) const
+        {
+            return index < this->generations.size() ? this->generations[index] : 0;
         }
 
         /*!
@@ -270,6 +290,10 @@ namespace MxEngine
         */
         void Clear()
         {
+            for (size_t i = 0; i < this->generations.size(); i++)
+            {
+                if (this->IsAllocated(i)) this->NextGeneration(i);
+            }
             this->allocator.~PoolAllocator();
             this->memoryStorage.clear();
             this->allocated = 0;
@@ -295,6 +319,7 @@ namespace MxEngine
             {
                 T& ptr = GetBlockByIndex(index)->data;
                 allocator.Free(&ptr);
+                this->NextGeneration(index);
                 this->allocated--;
             }
         }
@@ -320,7 +345,10 @@ namespace MxEngine
 
             T* obj = allocator.Alloc(std::forward<Args>(args)...);
             this->allocated++;
-            return this->IndexOf(*obj);
+            size_t index = this->IndexOf(*obj);
+            if (index >= this->generations.size())
+                this->generations.resize(index + 1, 1);
+            return index;
         }
 
         /*!
@@ -0,0 +1,32 @@
+#include <Utilities/ObjectLoading/AssetImporter.h>
+#include <Utilities/Concurrency/ThreadPool.h>
+#include <Utilities/Logging/Logger.h>
+#include <Utilities/UUID/UUID.h>
+
+#include <cstring>
+#include <iostream>
+
+/*
+mxengine-import bakes all object files in a directory into runtime-ready outputs (.mxmesh caches, material libraries and extracted textures)
+usage: mxengine-import <asset directory> [--force]
+*/
+int main(int argc, char** argv)
+{
+    using namespace MxEngine;
+
+    if (argc < 2)
+    {
+        std::cerr << "usage: mxengine-import <asset directory> [--force]" << std::endl;
+        return 1;
+    }
+    bool forceRebuild = argc > 2 && std::strcmp(argv[2], "--force") == 0;
+
+    Logger::Init();
+    UUIDGenerator::Init();
+    ThreadPool::Init();
+
+    auto result = AssetImporter::ImportDirectory(argv[1], forceRebuild);
+
+    ThreadPool::Destroy();
+    return result.Failed == 0 ? 0 : 2;
+}